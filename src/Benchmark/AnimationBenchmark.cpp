@@ -0,0 +1,164 @@
+#include "Benchmark.h"
+
+#include "DommusCore.h"
+
+#include <cmath>
+#include <vector>
+
+
+
+namespace DBenchmark
+{
+
+// Long clips (hundreds of keyframes) played by thousands of entities, each at its own time, ticked at 60 Hz.
+void RunAnimationBenchmarks()
+{
+	using keyframeType = DCore::Keyframe<float>;
+	using attributeAnimationType = DCore::AttributeAnimation<float>;
+	constexpr size_t numberOfRuns{5};
+	constexpr size_t numberOfEntities{4096};
+	constexpr size_t numberOfTracks{3};
+	constexpr size_t numberOfTicks{120};
+	constexpr float deltaTime{1.0f / 60.0f};
+	for (const size_t numberOfKeyframes : {30, 300, 1000})
+	{
+		const float duration(numberOfKeyframes / DCore::Animation::sampleRate);
+		std::vector<attributeAnimationType> attributeAnimations(numberOfTracks);
+		DCore::CompiledAnimation compiledAnimation;
+		compiledAnimation.AddChannel(0, 0, DCore::AttributeKeyframeType::Float, numberOfTracks);
+		for (size_t trackIndex(0); trackIndex < numberOfTracks; trackIndex++)
+		{
+			for (size_t keyframeIndex(0); keyframeIndex < numberOfKeyframes; keyframeIndex++)
+			{
+				const float time(keyframeIndex / DCore::Animation::sampleRate);
+				attributeAnimations[trackIndex].AddKeyframe(keyframeType(time, std::sin(time + trackIndex)));
+			}
+			compiledAnimation.AddTrack(attributeAnimations[trackIndex].GetKeyframes());
+		}
+		const DCore::CompiledAnimation::Channel& channel(compiledAnimation.GetChannels().front());
+		std::vector<float> entityTimes(numberOfEntities);
+		std::vector<DCore::AnimationCursors> entityCursors(numberOfEntities);
+		const auto resetEntities
+		(
+			[&]() -> void
+			{
+				for (size_t entityIndex(0); entityIndex < numberOfEntities; entityIndex++)
+				{
+					entityTimes[entityIndex] = std::fmod(entityIndex * 0.37f, duration);
+					entityCursors[entityIndex].Reset();
+				}
+			}
+		);
+		const auto tick
+		(
+			[&](auto sampleEntity) -> void
+			{
+				resetEntities();
+				for (size_t tickIndex(0); tickIndex < numberOfTicks; tickIndex++)
+				{
+					for (size_t entityIndex(0); entityIndex < numberOfEntities; entityIndex++)
+					{
+						float& time(entityTimes[entityIndex]);
+						sampleEntity(entityIndex, time);
+						time += deltaTime;
+						if (time >= duration)
+						{
+							time = 0.0f;
+							entityCursors[entityIndex].Reset();
+						}
+					}
+				}
+			}
+		);
+		const size_t numberOfOperations(numberOfEntities * numberOfTicks * numberOfTracks);
+		char name[128];
+		std::printf("%zu entities, %zu tracks of %zu keyframes\n", numberOfEntities, numberOfTracks, numberOfKeyframes);
+		// How sampling worked before: a linear scan from the first keyframe.
+		std::snprintf(name, sizeof(name), "  linear scan");
+		Run
+		(
+			name, numberOfRuns, numberOfOperations,
+			[&]() -> void
+			{
+				float sum(0.0f);
+				tick
+				(
+					[&](size_t, float time) -> void
+					{
+						for (const attributeAnimationType& attributeAnimation : attributeAnimations)
+						{
+							const std::vector<keyframeType>& keyframes(attributeAnimation.GetKeyframes());
+							size_t index(0);
+							while (index < keyframes.size() && keyframes[index].GetTime() <= time)
+							{
+								index++;
+							}
+							sum += keyframes[index == 0 ? 0 : index - 1].GetValue();
+						}
+					}
+				);
+				Consume(sum);
+			}
+		);
+		std::snprintf(name, sizeof(name), "  AttributeAnimation::Sample (binary search)");
+		Run
+		(
+			name, numberOfRuns, numberOfOperations,
+			[&]() -> void
+			{
+				float sum(0.0f);
+				tick
+				(
+					[&](size_t, float time) -> void
+					{
+						for (const attributeAnimationType& attributeAnimation : attributeAnimations)
+						{
+							sum += attributeAnimation.Sample(time);
+						}
+					}
+				);
+				Consume(sum);
+			}
+		);
+		std::snprintf(name, sizeof(name), "  CompiledAnimation::SampleChannel without cursors");
+		Run
+		(
+			name, numberOfRuns, numberOfOperations,
+			[&]() -> void
+			{
+				float sum(0.0f);
+				float values[numberOfTracks];
+				tick
+				(
+					[&](size_t, float time) -> void
+					{
+						compiledAnimation.SampleChannel(channel, time, nullptr, values);
+						sum += values[0] + values[1] + values[2];
+					}
+				);
+				Consume(sum);
+			}
+		);
+		std::snprintf(name, sizeof(name), "  CompiledAnimation::SampleChannel with cursors");
+		Run
+		(
+			name, numberOfRuns, numberOfOperations,
+			[&]() -> void
+			{
+				float sum(0.0f);
+				float values[numberOfTracks];
+				tick
+				(
+					[&](size_t entityIndex, float time) -> void
+					{
+						compiledAnimation.SampleChannel(channel, time, &entityCursors[entityIndex], values);
+						sum += values[0] + values[1] + values[2];
+					}
+				);
+				Consume(sum);
+			}
+		);
+	}
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+
+
+// Microbenchmarks of the runtime hot paths, built with MAKE_BENCHMARK. Every benchmark prints the time per
+// operation of its fastest run, so results are comparable between machines only relative to each other.
+namespace DBenchmark
+{
+
+// Runs function numberOfRuns times. function does numberOfOperations operations per run.
+template <class Func>
+void Run(const char* name, size_t numberOfRuns, size_t numberOfOperations, Func function)
+{
+	using clockType = std::chrono::steady_clock;
+	double bestNanoseconds(std::numeric_limits<double>::max());
+	for (size_t run(0); run < numberOfRuns; run++)
+	{
+		const clockType::time_point begin(clockType::now());
+		function();
+		const clockType::time_point end(clockType::now());
+		bestNanoseconds = (std::min)(bestNanoseconds, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+	}
+	std::printf("%-56s %12.2f ns/op %12.3f ms/run\n", name, bestNanoseconds / numberOfOperations, bestNanoseconds / 1.0e6);
+}
+
+// Keeps the results of the measured code alive, so it is not optimized away.
+template <class T>
+void Consume(const T& value)
+{
+	static volatile T sink;
+	sink = value;
+}
+
+void RunAnimationBenchmarks();
+void RunUUIDBenchmarks();
+// Requires the editor sources, see CMakeLists.txt.
+void RunSceneBenchmarks(const char* projectAssetsDirectory, const char* editorAssetsDirectory);
+
+}
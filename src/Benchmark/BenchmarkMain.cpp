@@ -0,0 +1,36 @@
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+
+
+// Usage: DommusBenchmark [animation | uuid | scene <project assets directory> <editor assets directory>]
+// Without arguments every benchmark that needs no arguments is run.
+int main(int argc, char** argv)
+{
+	const auto isSelected
+	(
+		[&](const char* name) -> bool
+		{
+			return argc < 2 || std::strcmp(argv[1], name) == 0;
+		}
+	);
+	if (isSelected("animation"))
+	{
+		std::cout << "Animation sampling" << std::endl;
+		DBenchmark::RunAnimationBenchmarks();
+	}
+	if (isSelected("uuid"))
+	{
+		std::cout << "UUID lookup" << std::endl;
+		DBenchmark::RunUUIDBenchmarks();
+	}
+	if (argc == 4 && std::strcmp(argv[1], "scene") == 0)
+	{
+		std::cout << "Scene load" << std::endl;
+		DBenchmark::RunSceneBenchmarks(argv[2], argv[3]);
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,202 @@
+#include "Benchmark.h"
+
+#include "ProgramContext.h"
+#include "SceneSerialization.h"
+
+#include "DommusCore.h"
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+
+namespace DBenchmark
+{
+
+static const char* s_scenesFileName = "scene/scenes.dscenes";
+static const char* s_entitiesKey = "Entities:";
+
+// The scene file with its entities copied numberOfCopies times. The entity UUIDs of each copy, and the references to
+// them, end with the index of the copy, so every copy is a new group of entities with the same hierarchy.
+static bool MakeScaledScene(const std::filesystem::path& scenePath, size_t numberOfCopies, std::string& outScene, size_t& outNumberOfEntities)
+{
+	std::ifstream istream(scenePath);
+	if (!istream)
+	{
+		return false;
+	}
+	std::stringstream sceneStream;
+	sceneStream << istream.rdbuf();
+	const std::string scene(sceneStream.str());
+	const size_t entitiesBegin(scene.find(s_entitiesKey));
+	if (entitiesBegin == std::string::npos)
+	{
+		return false;
+	}
+	const std::string header(scene.substr(0, entitiesBegin + std::strlen(s_entitiesKey)));
+	const std::string entities(scene.substr(header.size()));
+	std::vector<std::string> entityUUIDs;
+	YAML::Node entitiesNode(YAML::Load(scene)["Entities"]);
+	for (const YAML::Node& entityNode : entitiesNode)
+	{
+		entityUUIDs.push_back(entityNode["UUID Component"]["UUID"].as<std::string>());
+	}
+	outScene = header;
+	for (size_t copyIndex(0); copyIndex < numberOfCopies; copyIndex++)
+	{
+		std::string copy(entities);
+		char suffix[16];
+		std::snprintf(suffix, sizeof(suffix), "%08zx", copyIndex);
+		for (const std::string& uuid : entityUUIDs)
+		{
+			const std::string copyUUID(uuid.substr(0, uuid.size() - 8) + suffix);
+			for (size_t position(copy.find(uuid)); position != std::string::npos; position = copy.find(uuid, position))
+			{
+				copy.replace(position, uuid.size(), copyUUID);
+				position += copyUUID.size();
+			}
+		}
+		outScene.append(copy);
+		if (outScene.back() != '\n')
+		{
+			outScene.push_back('\n');
+		}
+	}
+	outNumberOfEntities = entityUUIDs.size() * numberOfCopies;
+	return true;
+}
+
+static DCore::SceneRef LoadEmptyScene(const std::string& sceneName)
+{
+	DCore::UUIDType uuid;
+	DCore::UUIDGenerator::Get().GenerateUUID(uuid);
+	return DCore::AssetManager::Get().LoadScene(uuid, DCore::Scene(sceneName));
+}
+
+static void UnloadScene(DCore::SceneRef scene)
+{
+	DCore::UUIDType uuid;
+	scene.GetUUID(uuid);
+	DCore::AssetManager::Get().UnloadScene(uuid);
+}
+
+// Loads the scenes of the project, scaled up, from their YAML source and from their cooked file. The assets of the
+// scenes are loaded before measuring, so only the scene load is measured.
+void RunSceneBenchmarks(const char* projectAssetsDirectory, const char* editorAssetsDirectory)
+{
+	constexpr size_t numberOfRuns{5};
+	DEditor::ProgramContext::Get().SetProjectAssetsDirectoryPath(projectAssetsDirectory);
+	DEditor::ProgramContext::Get().SetEditorAssetsDirectoryPath(editorAssetsDirectory);
+	const std::filesystem::path projectAssetsPath(DEditor::ProgramContext::Get().GetProjectAssetsDirectoryPath());
+	const std::filesystem::path outputPath(std::filesystem::temp_directory_path() / "DommusBenchmark");
+	std::filesystem::create_directories(outputPath);
+	YAML::Node scenesNode;
+	try
+	{
+		scenesNode = YAML::LoadFile((projectAssetsPath / s_scenesFileName).string());
+	}
+	catch (const std::exception& e)
+	{
+		std::printf("Fail to read the scenes of the project: %s\n", e.what());
+		return;
+	}
+	for (YAML::const_iterator it(scenesNode.begin()); it != scenesNode.end(); it++)
+	{
+		const std::string sceneName(it->second["Name"].as<std::string>());
+		std::string relativeScenePath(it->second["Path"].as<std::string>());
+		// Scenes created on Windows are saved with its separator.
+		std::replace(relativeScenePath.begin(), relativeScenePath.end(), '\\', '/');
+		for (const size_t numberOfCopies : {1, 16, 128})
+		{
+			std::string scaledScene;
+			size_t numberOfEntities(0);
+			if (!MakeScaledScene(projectAssetsPath / relativeScenePath, numberOfCopies, scaledScene, numberOfEntities) || numberOfEntities == 0)
+			{
+				std::printf("Fail to read scene %s\n", sceneName.c_str());
+				break;
+			}
+			const std::string fileName(sceneName + "x" + std::to_string(numberOfCopies));
+			const std::filesystem::path scenePath(outputPath / (fileName + ".dscene"));
+			std::filesystem::path cookedScenePath(scenePath);
+			cookedScenePath.replace_extension(DCore::CookedScene::fileExtension);
+			{
+				std::ofstream ostream(scenePath, std::ios_base::out | std::ios_base::trunc);
+				ostream << scaledScene;
+			}
+			// Stays loaded while the scene is measured, so the assets it refers are not loaded again by every run.
+			DCore::SceneRef sourceScene(LoadEmptyScene(sceneName));
+			const DCore::ReturnError error(DEditor::SceneSerialization::Get().DeserializeScene(scenePath, sourceScene));
+			if (!error.Ok)
+			{
+				std::printf("Fail to load scene %s: %s\n", sceneName.c_str(), error.Message.Data());
+				UnloadScene(sourceScene);
+				break;
+			}
+			bool isCooked(false);
+			{
+				DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SceneAssetManager*>(&DCore::AssetManager::Get()));
+				const DCore::ReturnError cookError(DEditor::SceneSerialization::Get().CookScene(cookedScenePath, sourceScene));
+				isCooked = cookError.Ok;
+				if (!isCooked)
+				{
+					std::printf("Fail to cook scene %s: %s\n", sceneName.c_str(), cookError.Message.Data());
+				}
+			}
+			if (!isCooked)
+			{
+				UnloadScene(sourceScene);
+				break;
+			}
+			std::printf("Scene %s, %zu entities\n", sceneName.c_str(), numberOfEntities);
+			std::vector<DCore::SceneRef> loadedScenes;
+			loadedScenes.reserve(numberOfRuns);
+			const auto measureLoad
+			(
+				[&](const char* name, auto loadScene) -> void
+				{
+					Run
+					(
+						name, numberOfRuns, numberOfEntities,
+						[&]() -> void
+						{
+							loadedScenes.push_back(LoadEmptyScene(sceneName));
+							Consume(loadScene(loadedScenes.back()).Ok);
+						}
+					);
+					// After the runs, so the unload is not measured.
+					for (DCore::SceneRef scene : loadedScenes)
+					{
+						UnloadScene(scene);
+					}
+					loadedScenes.clear();
+				}
+			);
+			measureLoad
+			(
+				"  YAML",
+				[&](DCore::SceneRef scene) -> DCore::ReturnError
+				{
+					return DEditor::SceneSerialization::Get().DeserializeScene(scenePath, scene);
+				}
+			);
+			measureLoad
+			(
+				"  cooked",
+				[&](DCore::SceneRef scene) -> DCore::ReturnError
+				{
+					return DEditor::SceneSerialization::Get().DeserializeCookedScene(cookedScenePath, scene);
+				}
+			);
+			UnloadScene(sourceScene);
+		}
+	}
+	std::filesystem::remove_all(outputPath);
+}
+
+}
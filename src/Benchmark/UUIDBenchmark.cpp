@@ -0,0 +1,135 @@
+#include "Benchmark.h"
+
+#include "DommusCore.h"
+
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+
+namespace DBenchmark
+{
+
+// How UUIDs were hashed before: a bitset built byte by byte, hashed by the standard library.
+struct BitsetUUIDHash
+{
+	using bitsType = std::bitset<DCore::UUIDType::sizeBytes * CHAR_BIT>;
+
+	size_t operator()(const DCore::UUIDType& uuid) const noexcept
+	{
+		bitsType bits;
+		for (size_t i(0); i < DCore::UUIDType::sizeBytes; i++)
+		{
+			const uint64_t half(i < 8 ? uuid.GetHigh() : uuid.GetLow());
+			bitsType temp((half >> ((7 - i % 8) * CHAR_BIT)) & 0xff);
+			temp <<= i * CHAR_BIT;
+			bits |= temp;
+		}
+		return std::hash<bitsType>{}(bits);
+	}
+};
+
+// Lookups of the UUIDs of loaded assets, half of them of assets that are not loaded.
+void RunUUIDBenchmarks()
+{
+	using valueType = uint32_t;
+	constexpr size_t numberOfRuns{5};
+	constexpr size_t numberOfLookups{1 << 20};
+	std::vector<DCore::UUIDType> lookups(numberOfLookups);
+	for (DCore::UUIDType& uuid : lookups)
+	{
+		DCore::UUIDGenerator::Get().GenerateUUID(uuid);
+	}
+	Run
+	(
+		"UUID hash, bitset", numberOfRuns, numberOfLookups,
+		[&]() -> void
+		{
+			size_t sum(0);
+			for (const DCore::UUIDType& uuid : lookups)
+			{
+				sum += BitsetUUIDHash{}(uuid);
+			}
+			Consume(sum);
+		}
+	);
+	Run
+	(
+		"UUID hash, UUIDType::Hash", numberOfRuns, numberOfLookups,
+		[&]() -> void
+		{
+			size_t sum(0);
+			for (const DCore::UUIDType& uuid : lookups)
+			{
+				sum += uuid.Hash();
+			}
+			Consume(sum);
+		}
+	);
+	for (const size_t numberOfKeys : {64, 4096, 262144})
+	{
+		std::unordered_map<DCore::UUIDType, valueType, BitsetUUIDHash> bitsetMap;
+		std::unordered_map<DCore::UUIDType, valueType> unorderedMap;
+		DCore::FlatHashMap<DCore::UUIDType, valueType> flatHashMap;
+		std::vector<DCore::UUIDType> keys(numberOfKeys);
+		for (size_t i(0); i < numberOfKeys; i++)
+		{
+			DCore::UUIDGenerator::Get().GenerateUUID(keys[i]);
+			bitsetMap.emplace(keys[i], static_cast<valueType>(i));
+			unorderedMap.emplace(keys[i], static_cast<valueType>(i));
+			flatHashMap.Insert(keys[i], static_cast<valueType>(i));
+		}
+		for (size_t i(0); i < numberOfLookups; i += 2)
+		{
+			lookups[i] = keys[(i * 7919) % numberOfKeys];
+		}
+		std::printf("%zu keys\n", numberOfKeys);
+		Run
+		(
+			"  std::unordered_map, bitset hash", numberOfRuns, numberOfLookups,
+			[&]() -> void
+			{
+				valueType sum(0);
+				for (const DCore::UUIDType& uuid : lookups)
+				{
+					const auto it(bitsetMap.find(uuid));
+					sum += it == bitsetMap.end() ? 0 : it->second;
+				}
+				Consume(sum);
+			}
+		);
+		Run
+		(
+			"  std::unordered_map, UUIDType::Hash", numberOfRuns, numberOfLookups,
+			[&]() -> void
+			{
+				valueType sum(0);
+				for (const DCore::UUIDType& uuid : lookups)
+				{
+					const auto it(unorderedMap.find(uuid));
+					sum += it == unorderedMap.end() ? 0 : it->second;
+				}
+				Consume(sum);
+			}
+		);
+		Run
+		(
+			"  FlatHashMap", numberOfRuns, numberOfLookups,
+			[&]() -> void
+			{
+				valueType sum(0);
+				for (const DCore::UUIDType& uuid : lookups)
+				{
+					const valueType* value(flatHashMap.Find(uuid));
+					sum += value == nullptr ? 0 : *value;
+				}
+				Consume(sum);
+			}
+		);
+	}
+}
+
+}
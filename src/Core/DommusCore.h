@@ -3,6 +3,7 @@
 // Animation
 #include "Animation.h"
 #include "AnimationStateMachine.h"
+#include "AnimationStateMachineInstance.h"
 #include "AnimationSimulator.h"
 //
 
@@ -24,10 +25,13 @@
 // Builtin Component
 #include "AnimationStateMachineComponent.h"
 #include "BoxColliderComponent.h"
+#include "CapsuleColliderComponent.h"
 #include "ChildComponent.h"
 #include "ChildrenComponent.h"
+#include "CircleColliderComponent.h"
 #include "NameComponent.h"
 #include "PerspectiveCameraComponent.h"
+#include "PolygonColliderComponent.h"
 #include "RootComponent.h"
 #include "SpriteComponent.h"
 #include "TransformComponent.h"
@@ -43,9 +47,11 @@
 // Data Structure
 #include "FixedString.h"
 #include "ReciclingVector.h"
+#include "ScratchArena.h"
 #include "SparseSet.h"
 #include "Vector.h"
 #include "CVector.h"
+#include "FlatHashMap.h"
 // 
 
 // ECS
@@ -86,6 +92,7 @@
 
 // Profiling
 #include "Timer.h"
+#include "ProfilingStats.h"
 //
 
 // Reference
@@ -100,11 +107,14 @@
 //
 
 // Runtime
+#include "AsyncSceneLoader.h"
 #include "Runtime.h"
 #include "SceneLoader.h"
+#include "ScenePreload.h"
 //
 
 // Scene
+#include "Prefab.h"
 #include "Scene.h"
 //
 
@@ -114,10 +124,22 @@
 //
 
 // Serialization
+#include "AssetPack.h"
 #include "ComponentForm.h"
+#include "CookedAnimation.h"
+#include "CookedAnimationStateMachine.h"
+#include "CookedScene.h"
+#include "CookedSpriteMaterial.h"
+#include "CookedTexture2D.h"
+#include "MappedFile.h"
 #include "SerializationTypes.h"
 //
 
+// Thread
+#include "InFlightLoadTable.h"
+#include "WorkerPool.h"
+//
+
 // UUID
 #include "UUID.h"
 //
@@ -31,6 +31,34 @@ ComponentAnimations& ComponentAnimations::operator=(ComponentAnimations&& other)
 }
 // End ComponentAnimations
 
+// CompiledAnimation
+CompiledAnimation::CompiledAnimation(channelContainerType&& channels, trackContainerType&& tracks, keyframeTimeContainerType&& keyframeTimes, keyframeValueContainerType&& keyframeValues)
+	:
+	m_channels(std::move(channels)),
+	m_tracks(std::move(tracks)),
+	m_keyframeTimes(std::move(keyframeTimes)),
+	m_keyframeValues(std::move(keyframeValues))
+{
+	DASSERT_E(m_keyframeTimes.size() == m_keyframeValues.size());
+}
+
+void CompiledAnimation::Clear()
+{
+	m_channels.clear();
+	m_tracks.clear();
+	m_keyframeTimes.clear();
+	m_keyframeValues.clear();
+}
+
+void CompiledAnimation::AddChannel(ComponentIdType componentId, AttributeIdType attributeId, AttributeKeyframeType keyframeType, size_t numberOfTracks)
+{
+	DASSERT_E(keyframeType == AttributeKeyframeType::Integer || keyframeType == AttributeKeyframeType::Float);
+	DASSERT_E(numberOfTracks <= maxNumberOfTracksPerChannel);
+	DASSERT_E(m_channels.empty() || m_channels.back().FirstTrack + m_channels.back().NumberOfTracks == m_tracks.size());
+	m_channels.push_back({componentId, attributeId, keyframeType, static_cast<uint32_t>(m_tracks.size()), static_cast<uint32_t>(numberOfTracks)});
+}
+// End CompiledAnimation
+
 // Animation
 Animation::Animation(const stringType& name, float duration)
 	:
@@ -38,13 +66,21 @@ Animation::Animation(const stringType& name, float duration)
 	m_duration(duration)
 {}
 
+Animation::Animation(const stringType& name, float duration, CompiledAnimation&& compiledAnimation)
+	:
+	m_name(name),
+	m_duration(duration),
+	m_compiledAnimation(std::move(compiledAnimation))
+{}
+
 Animation::Animation(Animation&& other) noexcept
 	:
 	m_name(std::move(other.m_name)),
 	m_duration(other.m_duration),
 	m_componentAnimations(std::move(other.m_componentAnimations)),
 	m_componentIndexes(std::move(other.m_componentIndexes)),
-	m_metachannels(std::move(other.m_metachannels))
+	m_metachannels(std::move(other.m_metachannels)),
+	m_compiledAnimation(std::move(other.m_compiledAnimation))
 {}
 
 void Animation::MakeAnimation(ComponentIdType componentIndex, AttributeIdType attributeIndex)
@@ -71,6 +107,40 @@ void Animation::MakeAnimation(ComponentIdType componentIndex, AttributeIdType at
 	m_componentAnimations[componentIndex].MakeAttributeAnimation<float>(attributeIndex, attribute.GetNumberOfAttributeComponents());
 }
 
+void Animation::Compile()
+{
+	if (m_componentIndexes.GetDenseRef().empty())
+	{
+		return;
+	}
+	m_compiledAnimation.Clear();
+	for (ComponentIdType componentId : m_componentIndexes.GetDenseRef())
+	{
+		const ComponentForm& componentForm(ComponentForms::Get()[componentId]);
+		const ComponentAnimations& componentAnimations(m_componentAnimations[componentId]);
+		componentAnimations.IterateThroughAttributes
+		(
+			[&](AttributeIdType attributeId) -> bool
+			{
+				const SerializedAttribute& attribute(componentForm.SerializedAttributes[attributeId]);
+				const AttributeKeyframeType keyframeType(attribute.GetKeyframeType());
+				const size_t numberOfAttributeComponents(attribute.GetNumberOfAttributeComponents());
+				m_compiledAnimation.AddChannel(componentId, attributeId, keyframeType, numberOfAttributeComponents);
+				for (size_t attributeComponentId(0); attributeComponentId < numberOfAttributeComponents; attributeComponentId++)
+				{
+					if (keyframeType == AttributeKeyframeType::Integer)
+					{
+						m_compiledAnimation.AddTrack(componentAnimations.GetAttributeAnimations<int>(attributeId).GetAnimation(attributeComponentId).GetKeyframes());
+						continue;
+					}
+					m_compiledAnimation.AddTrack(componentAnimations.GetAttributeAnimations<float>(attributeId).GetAnimation(attributeComponentId).GetKeyframes());
+				}
+				return false;
+			}
+		);
+	}
+}
+
 Animation::metachannelContainerType::Ref Animation::MakeMetachannel()
 {
 	return m_metachannels.PushBack({});
@@ -88,6 +158,7 @@ Animation& Animation::operator=(Animation&& other) noexcept
 	m_componentAnimations = std::move(other.m_componentAnimations);
 	m_componentIndexes = std::move(other.m_componentIndexes);
 	m_metachannels = std::move(other.m_metachannels);
+	m_compiledAnimation = std::move(other.m_compiledAnimation);
 	return *this;
 }
 // End Animation
@@ -112,7 +183,12 @@ AnimationRef::AnimationRef(const AnimationRef& other)
 
 bool AnimationRef::IsValid() const
 {
-	return m_lockData != nullptr && m_ref.IsValid();
+	if (m_lockData == nullptr)
+	{
+		return false;
+	}
+	ReadWriteLockGuard guard(LockType::ReadLock, *m_lockData);
+	return m_ref.IsValid();
 }
 
 AnimationRef::stringType AnimationRef::GetName() const
@@ -149,6 +225,7 @@ void AnimationRef::Unload()
 AnimationRef& AnimationRef::operator=(Animation&& animation) noexcept
 {
 	DASSERT_E(IsValid());
+	animation.Compile();
 	ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
 	m_ref->GetAsset() = std::move(animation);
 	return *this;
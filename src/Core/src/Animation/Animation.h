@@ -9,6 +9,8 @@
 #include "SerializationTypes.h"
 #include "ComponentForm.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <type_traits>
 #include <vector>
 #include <string>
@@ -58,15 +60,6 @@ private:
 	valueType m_value;
 };
 
-template <class KeyframeValueType>
-struct KeyframeComparator
-{
-	bool operator()(const Keyframe<KeyframeValueType>& a, const Keyframe<KeyframeValueType>& b) const
-	{
-		return a.GetTime() < b.GetTime();
-	}
-};
-
 // E.g., pode ser a animação da componente x do attributo "posição" do componente Transform.
 // E.g., can be the animation of the component x of attribute "position" of component Transform.
 template <class KeyframeValueType>
@@ -89,47 +82,21 @@ public:
 	{}
 	~AttributeAnimation() = default;
 public:
+	// Inserted after the keyframes with the same or earlier time, so keyframes added in time order are appended
+	// without sorting the animation again.
 	void AddKeyframe(const keyframeType& keyframe)
 	{
-		m_keyframes.push_back(keyframe);
-		std::sort(m_keyframes.begin(), m_keyframes.end(), KeyframeComparator<keyframeValueType>{});
+		m_keyframes.insert(m_keyframes.begin() + FindNextKeyframeIndex(keyframe.GetTime(), 0, m_keyframes.size()), keyframe);
 	}
 
 	keyframeValueType Sample(float sampleTime) const
 	{
-		if constexpr (std::is_same_v<int, KeyframeValueType>)
-		{
-			for (size_t index(0); index < m_keyframes.size(); index++)
-			{
-				if (m_keyframes[index].GetTime() == sampleTime)
-				{
-					return m_keyframes[index].GetValue();
-				}
-				if (m_keyframes[index].GetTime() > sampleTime)
-				{
-					return m_keyframes[index - 1].GetValue();
-				}
-			}
-			return m_keyframes[m_keyframes.size() - 1].GetValue();
-		}
-		else
-		{
-			for (size_t index(0); index < m_keyframes.size(); index++)
-			{
-				if (m_keyframes[index].GetTime() == sampleTime)
-				{
-					return m_keyframes[index].GetValue();
-				}
-				if (m_keyframes[index].GetTime() > sampleTime)
-				{
-					const keyframeType& firstKeyframe(m_keyframes[index - 1]);
-					const keyframeType& secondKeyframe(m_keyframes[index]);
-					float ratio((sampleTime - firstKeyframe.GetTime())/(secondKeyframe.GetTime() - firstKeyframe.GetTime()));
-					return firstKeyframe.GetValue() + ratio * (secondKeyframe.GetValue() - firstKeyframe.GetValue());
-				}
-			}
-			return m_keyframes[m_keyframes.size() - 1].GetValue();
-		}
+		return SampleBefore(FindNextKeyframeIndex(sampleTime, 0, m_keyframes.size()), sampleTime);
+	}
+
+	const keyframeContainerType& GetKeyframes() const
+	{
+		return m_keyframes;
 	}
 public:
 	AttributeAnimation& operator=(const AttributeAnimation& other)
@@ -145,6 +112,46 @@ public:
 	}
 private:
 	keyframeContainerType m_keyframes;
+private:
+	// Index of the first keyframe in [begin, end) with time after sampleTime, or end if there is none.
+	size_t FindNextKeyframeIndex(float sampleTime, size_t begin, size_t end) const
+	{
+		return std::upper_bound
+		(
+			m_keyframes.begin() + begin,
+			m_keyframes.begin() + end,
+			sampleTime,
+			[](float time, const keyframeType& keyframe) -> bool
+			{
+				return time < keyframe.GetTime();
+			}
+		) - m_keyframes.begin();
+	}
+
+	// Samples between the keyframe before nextKeyframeIndex and the one at it, clamping to the first and last keyframes.
+	keyframeValueType SampleBefore(size_t nextKeyframeIndex, float sampleTime) const
+	{
+		DASSERT_E(!m_keyframes.empty());
+		if (nextKeyframeIndex == 0)
+		{
+			return m_keyframes[0].GetValue();
+		}
+		if (nextKeyframeIndex == m_keyframes.size())
+		{
+			return m_keyframes[nextKeyframeIndex - 1].GetValue();
+		}
+		const keyframeType& firstKeyframe(m_keyframes[nextKeyframeIndex - 1]);
+		if constexpr (std::is_same_v<int, KeyframeValueType>)
+		{
+			return firstKeyframe.GetValue();
+		}
+		else
+		{
+			const keyframeType& secondKeyframe(m_keyframes[nextKeyframeIndex]);
+			float ratio((sampleTime - firstKeyframe.GetTime())/(secondKeyframe.GetTime() - firstKeyframe.GetTime()));
+			return firstKeyframe.GetValue() + ratio * (secondKeyframe.GetValue() - firstKeyframe.GetValue());
+		}
+	}
 };
 
 // Attributos podem possuir diversos componenetes (e.g., o attributo posição do componente Transform possui 3 componentes: x, y e z).
@@ -188,6 +195,12 @@ public:
 		DASSERT_E(attributeComponentIndex < m_animations.size());
 		return m_animations[attributeComponentIndex].Sample(sampleTime);
 	}
+
+	const AttributeAnimation<keyframeValueType>& GetAnimation(size_t attributeComponentIndex) const
+	{
+		DASSERT_E(attributeComponentIndex < m_animations.size());
+		return m_animations[attributeComponentIndex];
+	}
 public:
 	AttributeAnimations& operator=(const AttributeAnimations& other)
 	{
@@ -284,6 +297,33 @@ public:
 		}
 	}
 
+	template <class KeyframeValueType>
+	const AttributeAnimations<KeyframeValueType>& GetAttributeAnimations(AttributeIdType attributeIndex) const
+	{
+		static_assert(std::is_same_v<int, KeyframeValueType> || std::is_same_v<float, KeyframeValueType>, "Invalid keyframe value type.");
+		DASSERT_E(m_attributeIndexes.Exists(attributeIndex));
+		if constexpr (std::is_same_v<int, KeyframeValueType>)
+		{
+			return m_integerAnimations[attributeIndex];
+		}
+		else
+		{
+			return m_floatAnimations[attributeIndex];
+		}
+	}
+
+	template <class Function>
+	void IterateThroughAttributes(Function func) const
+	{
+		for (AttributeIdType attributeId : m_attributeIndexes.GetDenseRef())
+		{
+			if (std::invoke(func, attributeId))
+			{
+				return;
+			}
+		}
+	}
+
 	template <class Function>
 	void IterateThroughAttributes(Function func)
 	{
@@ -348,6 +388,213 @@ private:
 	float m_time;
 };
 
+// Keyframe search positions of one playing instance of an animation, one per track of its CompiledAnimation.
+class AnimationCursors
+{
+public:
+	using cursorContainerType = std::vector<size_t>;
+public:
+	AnimationCursors() = default;
+	AnimationCursors(const AnimationCursors&) = default;
+	AnimationCursors(AnimationCursors&&) noexcept = default;
+	~AnimationCursors() = default;
+public:
+	AnimationCursors& operator=(const AnimationCursors&) = default;
+	AnimationCursors& operator=(AnimationCursors&&) noexcept = default;
+public:
+	size_t& operator[](size_t trackIndex)
+	{
+		if (trackIndex >= m_cursors.size())
+		{
+			m_cursors.resize(trackIndex + 1, 0);
+		}
+		return m_cursors[trackIndex];
+	}
+
+	void Reset()
+	{
+		std::fill(m_cursors.begin(), m_cursors.end(), 0);
+	}
+private:
+	cursorContainerType m_cursors;
+};
+
+// Flat form of an Animation, built when the animation is loaded. The keyframe times and values of all the
+// attribute components are stored in two contiguous arrays and playback is a linear pass over the channel table,
+// without the nested containers and component form lookups of Animation.
+class CompiledAnimation
+{
+public:
+	static constexpr size_t maxNumberOfTracksPerChannel{128};
+public:
+	union KeyframeValue
+	{
+		float Float;
+		int Integer;
+	};
+
+	// The keyframes of one attribute component.
+	struct Track
+	{
+		uint32_t FirstKeyframe;
+		uint32_t NumberOfKeyframes;
+	};
+
+	// One animated attribute. The channels of the same component are contiguous.
+	struct Channel
+	{
+		ComponentIdType ComponentId;
+		AttributeIdType AttributeId;
+		AttributeKeyframeType KeyframeType;
+		uint32_t FirstTrack;
+		uint32_t NumberOfTracks;
+	};
+public:
+	using channelContainerType = std::vector<Channel>;
+	using trackContainerType = std::vector<Track>;
+	using keyframeTimeContainerType = std::vector<float>;
+	using keyframeValueContainerType = std::vector<KeyframeValue>;
+public:
+	CompiledAnimation() = default;
+	// From the tables of a cooked animation. The tracks of each channel and the keyframes of each track must be
+	// in range, and the keyframe times of each track sorted.
+	CompiledAnimation(channelContainerType&&, trackContainerType&&, keyframeTimeContainerType&&, keyframeValueContainerType&&);
+	CompiledAnimation(CompiledAnimation&&) noexcept = default;
+	~CompiledAnimation() = default;
+public:
+	CompiledAnimation& operator=(CompiledAnimation&&) noexcept = default;
+public:
+	void Clear();
+	void AddChannel(ComponentIdType, AttributeIdType, AttributeKeyframeType, size_t numberOfTracks);
+	// Adds a track to the last channel. The keyframes must be sorted by time.
+	template <class KeyframeValueType>
+	void AddTrack(const std::vector<Keyframe<KeyframeValueType>>& keyframes)
+	{
+		DASSERT_E(!m_channels.empty());
+		DASSERT_E(m_channels.back().FirstTrack + m_channels.back().NumberOfTracks > m_tracks.size());
+		m_tracks.push_back({static_cast<uint32_t>(m_keyframeTimes.size()), static_cast<uint32_t>(keyframes.size())});
+		for (const Keyframe<KeyframeValueType>& keyframe : keyframes)
+		{
+			KeyframeValue value;
+			if constexpr (std::is_same_v<int, KeyframeValueType>)
+			{
+				value.Integer = keyframe.GetValue();
+			}
+			else
+			{
+				value.Float = keyframe.GetValue();
+			}
+			m_keyframeTimes.push_back(keyframe.GetTime());
+			m_keyframeValues.push_back(value);
+		}
+	}
+public:
+	const channelContainerType& GetChannels() const
+	{
+		return m_channels;
+	}
+
+	size_t GetNumberOfTracks() const
+	{
+		return m_tracks.size();
+	}
+
+	const trackContainerType& GetTracks() const
+	{
+		return m_tracks;
+	}
+
+	const keyframeTimeContainerType& GetKeyframeTimes() const
+	{
+		return m_keyframeTimes;
+	}
+
+	const keyframeValueContainerType& GetKeyframeValues() const
+	{
+		return m_keyframeValues;
+	}
+
+	// Without cursors every track is sampled with a binary search. With them, the search starts from the
+	// keyframe of the previous sample, so forward playback ends it in a few steps.
+	template <class ValueType>
+	void SampleChannel(const Channel& channel, float sampleTime, AnimationCursors* cursors, ValueType* out) const
+	{
+		static_assert(std::is_same_v<int, ValueType> || std::is_same_v<float, ValueType>, "Invalid keyframe value type.");
+		for (uint32_t i(0); i < channel.NumberOfTracks; i++)
+		{
+			const size_t trackIndex(channel.FirstTrack + i);
+			const Track& track(m_tracks[trackIndex]);
+			size_t nextKeyframeIndex;
+			if (cursors == nullptr)
+			{
+				nextKeyframeIndex = FindNextKeyframeIndex(track, sampleTime, 0);
+			}
+			else
+			{
+				size_t& cursor((*cursors)[trackIndex]);
+				cursor = FindNextKeyframeIndex(track, sampleTime, cursor);
+				nextKeyframeIndex = cursor;
+			}
+			out[i] = SampleBefore<ValueType>(track, nextKeyframeIndex, sampleTime);
+		}
+	}
+private:
+	channelContainerType m_channels;
+	trackContainerType m_tracks;
+	keyframeTimeContainerType m_keyframeTimes;
+	keyframeValueContainerType m_keyframeValues;
+private:
+	// Index, relative to the track, of the first keyframe with time after sampleTime, or the number of keyframes if there is none.
+	size_t FindNextKeyframeIndex(const Track& track, float sampleTime, size_t cursor) const
+	{
+		constexpr size_t maxForwardSteps{4};
+		const float* times(m_keyframeTimes.data() + track.FirstKeyframe);
+		const size_t numberOfKeyframes(track.NumberOfKeyframes);
+		if (cursor > numberOfKeyframes || (cursor > 0 && times[cursor - 1] > sampleTime))
+		{
+			cursor = 0;
+		}
+		else
+		{
+			for (size_t step(0); step < maxForwardSteps; step++)
+			{
+				if (cursor == numberOfKeyframes || times[cursor] > sampleTime)
+				{
+					return cursor;
+				}
+				cursor++;
+			}
+		}
+		return std::upper_bound(times + cursor, times + numberOfKeyframes, sampleTime) - times;
+	}
+
+	// A track without keyframes (e.g. an attribute component never keyed in the editor) samples to the default value.
+	template <class ValueType>
+	ValueType SampleBefore(const Track& track, size_t nextKeyframeIndex, float sampleTime) const
+	{
+		if (track.NumberOfKeyframes == 0)
+		{
+			return ValueType();
+		}
+		const float* times(m_keyframeTimes.data() + track.FirstKeyframe);
+		const KeyframeValue* values(m_keyframeValues.data() + track.FirstKeyframe);
+		const size_t keyframeIndex(nextKeyframeIndex == 0 ? 0 : nextKeyframeIndex - 1);
+		if constexpr (std::is_same_v<int, ValueType>)
+		{
+			return values[keyframeIndex].Integer;
+		}
+		else
+		{
+			if (nextKeyframeIndex == 0 || nextKeyframeIndex == track.NumberOfKeyframes)
+			{
+				return values[keyframeIndex].Float;
+			}
+			const float ratio((sampleTime - times[keyframeIndex])/(times[nextKeyframeIndex] - times[keyframeIndex]));
+			return values[keyframeIndex].Float + ratio * (values[nextKeyframeIndex].Float - values[keyframeIndex].Float);
+		}
+	}
+};
+
 class Animation
 {
 public:
@@ -359,10 +606,15 @@ public:
 	static constexpr float sampleRate{30.0f};
 public:
 	Animation(const stringType& name, float duration);
+	// Already compiled, as loaded from a cooked animation. It has no keyframes besides the compiled ones.
+	Animation(const stringType& name, float duration, CompiledAnimation&&);
 	Animation(Animation&&) noexcept;
 	~Animation() = default;
 public:
 	void MakeAnimation(ComponentIdType componentIndex, AttributeIdType attributeIndex);
+	// Must be called after the last keyframe is added, before the animation is played. Keeps the compiled animation
+	// of an animation without keyframes, as the ones made from a compiled animation.
+	void Compile();
 	metachannelContainerType::Ref MakeMetachannel();
 	void RemoveMetachannelAtIndex(size_t index);
 public:
@@ -382,6 +634,11 @@ public:
 	{
 		return m_duration;
 	}
+
+	const CompiledAnimation& GetCompiledAnimation() const
+	{
+		return m_compiledAnimation;
+	}
 public:
 	template <class KeyframeValueType>
 	void AddKeyframe(ComponentIdType componentIndex, AttributeIdType attributeIndex, size_t attributeComponentIndex, const Keyframe<KeyframeValueType>& keyframe)
@@ -446,6 +703,18 @@ public:
 		);
 	}
 
+	template <class Function>
+	void IterateOnMetachannels(Function func) const
+	{
+		m_metachannels.Iterate
+		(
+			[&](metachannelContainerType::ConstRef metachannel) -> bool
+			{
+				return std::invoke(func, metachannel);
+			}
+		);
+	}
+
 	template <class Function>
 	void TryGetMetachannelsIds(float initialTime, float finalTime, Function func) const
 	{
@@ -472,6 +741,7 @@ private:
 	componentAnimationsContainerType m_componentAnimations;
 	componentIndexContainerType m_componentIndexes;
 	metachannelContainerType m_metachannels;
+	CompiledAnimation m_compiledAnimation;
 };
 
 using InternalAnimationRefType = typename AssetContainerType<Animation>::Ref;
@@ -509,6 +779,12 @@ public:
 		return m_ref->GetAsset().Sample<KeyframeValueType>(componentIndex, attributeIndex, attributeComponentIndex, sampleTime);
 	}
 
+	const CompiledAnimation& GetCompiledAnimation() const
+	{
+		DASSERT_E(IsValid());
+		return m_ref->GetAsset().GetCompiledAnimation();
+	}
+
 	template <class Function>
 	void IterateThroughComponents(Function func)
 	{
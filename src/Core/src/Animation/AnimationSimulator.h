@@ -19,58 +19,76 @@ public:
 public:
 	template <class Func>
 	static void Simulate(EntityRef entity, AnimationRef animation, float currentSampleTime, float nextSampleTime, Func metachannelsCallback)
+	{
+		Internal_Simulate<false>(entity, animation, nullptr, currentSampleTime, nextSampleTime, metachannelsCallback);
+	}
+
+	// Used for playback, where the sample time of an instance only moves forward until the animation loops.
+	// The cursors are indexed by the tracks of the animation's CompiledAnimation.
+	// The attributes are written straight into the components, so the caller must hold the write lock of the
+	// entity's scene. This lets the entities of a scene be simulated in parallel by threads that take no lock.
+	template <class Func>
+	static void Simulate(EntityRef entity, AnimationRef animation, AnimationCursors& cursors, float currentSampleTime, float nextSampleTime, Func metachannelsCallback)
+	{
+		Internal_Simulate<true>(entity, animation, &cursors, currentSampleTime, nextSampleTime, metachannelsCallback);
+	}
+private:
+	AnimationSimulator() = default;	
+private:
+	template <bool IsSceneLocked, class Func>
+	static void Internal_Simulate(EntityRef entity, AnimationRef animation, AnimationCursors* cursors, float currentSampleTime, float nextSampleTime, Func metachannelsCallback)
 	{
 		if (!animation.IsValid() || !entity.IsValid())
 		{
 			return;
 		}
-		animation.IterateThroughComponents(
-			[&](ComponentIdType componentId) -> bool
+		const CompiledAnimation& compiledAnimation(animation.GetCompiledAnimation());
+		const CompiledAnimation::channelContainerType& channels(compiledAnimation.GetChannels());
+		int integerValues[CompiledAnimation::maxNumberOfTracksPerChannel];
+		float floatValues[CompiledAnimation::maxNumberOfTracksPerChannel];
+		size_t channelIndex(0);
+		while (channelIndex < channels.size())
+		{
+			const ComponentIdType componentId(channels[channelIndex].ComponentId);
+			size_t endChannelIndex(channelIndex + 1);
+			while (endChannelIndex < channels.size() && channels[endChannelIndex].ComponentId == componentId)
+			{
+				endChannelIndex++;
+			}
+			ComponentRef<Component> component(entity.GetComponent(componentId));
+			if (!component.IsValid())
 			{
-				ComponentRef<Component> component(entity.GetComponent(componentId));
-				const ComponentForm& componentForm(ComponentForms::Get()[componentId]);
-				if (!component.IsValid())
+				channelIndex = endChannelIndex;
+				continue;
+			}
+			Component* rawComponent(IsSceneLocked ? component.GetRawComponent() : nullptr);
+			const auto changeAttribute
+			(
+				[&](AttributeIdType attributeId, void* newValue, AttributeType typeHint) -> void
 				{
-					return false;
-				}
-				animation.IterateThroughAttributes
-				(
-					componentId, 
-					[&](AttributeIdType attributeId) -> bool
+					if constexpr (IsSceneLocked)
 					{
-						const SerializedAttribute& attribute(componentForm.SerializedAttributes[attributeId]);
-						int integerValues[128];
-						float floatValues[128];
-						for (size_t attributeComponentId(0); attributeComponentId < attribute.GetNumberOfAttributeComponents(); attributeComponentId++)
-						{
-							switch (attribute.GetKeyframeType())
-							{
-							case AttributeKeyframeType::Integer:
-							{
-								integerValues[attributeComponentId] = animation.Sample<int>(componentId, attributeId, attributeComponentId, currentSampleTime);
-								break;
-							}
-							case AttributeKeyframeType::Float:
-							{
-								floatValues[attributeComponentId] = animation.Sample<float>(componentId, attributeId, attributeComponentId, currentSampleTime);
-								break;
-							}
-							default:
-								DASSERT_E(false);
-								break;
-							}
-						}
-						if (attribute.GetKeyframeType() == AttributeKeyframeType::Integer)
-						{
-							component.OnAttributeChange(attributeId, integerValues, AttributeType::Integer);
-							return false;
-						}
-						component.OnAttributeChange(attributeId, floatValues, AttributeType::Float);
-						return false;
+						rawComponent->OnAttributeChange(attributeId, newValue, typeHint);
 					}
-				);
-				return false;
-			});
+					else
+					{
+						component.OnAttributeChange(attributeId, newValue, typeHint);
+					}
+				}
+			);
+			for (; channelIndex < endChannelIndex; channelIndex++)
+			{
+				const CompiledAnimation::Channel& channel(channels[channelIndex]);
+				if (channel.KeyframeType == AttributeKeyframeType::Integer)
+				{
+					compiledAnimation.SampleChannel(channel, currentSampleTime, cursors, integerValues);
+					changeAttribute(channel.AttributeId, integerValues, AttributeType::Integer);
+					continue;
+				}
+				compiledAnimation.SampleChannel(channel, currentSampleTime, cursors, floatValues);
+				changeAttribute(channel.AttributeId, floatValues, AttributeType::Float);
+			}
+		}
 		animation.TryGetMetachannelsIds(
 			currentSampleTime, nextSampleTime,
 			[&](size_t metachannelId) -> void
@@ -78,8 +96,6 @@ public:
 				std::invoke(metachannelsCallback, entity, metachannelId);
 			});
 	}
-private:
-	AnimationSimulator() = default;	
 };
 
 }
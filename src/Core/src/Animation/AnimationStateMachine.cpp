@@ -11,25 +11,128 @@
 namespace DCore
 {
 
+// CompiledTransitionTable
+void CompiledTransitionTable::Clear()
+{
+	m_conditions.clear();
+	m_transitions.clear();
+	m_states.clear();
+}
+
+void CompiledTransitionTable::AddState(size_t stateIndex)
+{
+	DASSERT_E(stateIndex >= m_states.size());
+	m_states.resize(stateIndex + 1, {m_transitions.size(), 0});
+}
+
+void CompiledTransitionTable::AddTransition(size_t toStateIndex)
+{
+	DASSERT_E(!m_states.empty());
+	m_transitions.push_back({toStateIndex, m_conditions.size(), 0});
+	m_states.back().NumberOfTransitions++;
+}
+
+void CompiledTransitionTable::AddCondition(const ConditionEntry& condition)
+{
+	DASSERT_E(!m_transitions.empty());
+	m_conditions.push_back(condition);
+	m_transitions.back().NumberOfConditions++;
+}
+
+bool CompiledTransitionTable::TryMakeTransition(size_t stateIndex, parameterValueContainerType& parameterValues, size_t& outToStateIndex) const
+{
+	if (stateIndex >= m_states.size())
+	{
+		return false;
+	}
+	const StateEntry& state(m_states[stateIndex]);
+	for (size_t transitionIndex(state.FirstTransition); transitionIndex < state.FirstTransition + state.NumberOfTransitions; transitionIndex++)
+	{
+		const TransitionEntry& transition(m_transitions[transitionIndex]);
+		const size_t endConditionIndex(transition.FirstCondition + transition.NumberOfConditions);
+		size_t conditionIndex(transition.FirstCondition);
+		while (conditionIndex < endConditionIndex && IsConditionTrue(m_conditions[conditionIndex], parameterValues))
+		{
+			conditionIndex++;
+		}
+		if (conditionIndex < endConditionIndex)
+		{
+			continue;
+		}
+		for (conditionIndex = transition.FirstCondition; conditionIndex < endConditionIndex; conditionIndex++)
+		{
+			const ConditionEntry& condition(m_conditions[conditionIndex]);
+			if (condition.Type == ParameterType::Trigger)
+			{
+				parameterValues[condition.ValueIndex].Logic = false;
+			}
+		}
+		outToStateIndex = transition.ToStateIndex;
+		return true;
+	}
+	return false;
+}
+
+bool CompiledTransitionTable::IsConditionTrue(const ConditionEntry& condition, const parameterValueContainerType& parameterValues)
+{
+	// The instance may have been set up before parameters were added in the editor.
+	if (condition.ValueIndex >= parameterValues.size())
+	{
+		return false;
+	}
+	const ParameterValue& parameterValue(parameterValues[condition.ValueIndex]);
+	switch (condition.Type)
+	{
+	case ParameterType::Integer:
+		switch (condition.NumericCondition)
+		{
+		case NumericConditionType::Smaller:
+			return parameterValue.Integer < condition.Value.Integer;
+		case NumericConditionType::Equals:
+			return parameterValue.Integer == condition.Value.Integer;
+		case NumericConditionType::Bigger:
+			return parameterValue.Integer > condition.Value.Integer;
+		}
+		return false;
+	case ParameterType::Float:
+		switch (condition.NumericCondition)
+		{
+		case NumericConditionType::Smaller:
+			return parameterValue.Float < condition.Value.Float;
+		case NumericConditionType::Equals:
+			return parameterValue.Float == condition.Value.Float;
+		case NumericConditionType::Bigger:
+			return parameterValue.Float > condition.Value.Float;
+		}
+		return false;
+	case ParameterType::Logic:
+		return parameterValue.Logic == condition.Value.Logic;
+	case ParameterType::Trigger:
+		return parameterValue.Logic;
+	}
+	return false;
+}
+// End CompiledTransitionTable
+
 // AnimationStateMachine
 AnimationStateMachine::AnimationStateMachine(const UUIDType& uuid)
 	:
 	m_uuid(uuid),
-	m_currentStateIndex(0),
 	m_initialStateIndex(0),
-	m_currentTime(0.0f)
+	m_parameterOffsets{}
 {}
 
 AnimationStateMachine::AnimationStateMachine(const AnimationStateMachine& other)
 	:
 	m_uuid(other.m_uuid),
-	m_currentStateIndex(other.m_currentStateIndex),
 	m_initialStateIndex(other.m_initialStateIndex),
 	m_integerParameters(other.m_integerParameters),
 	m_floatParameters(other.m_floatParameters),
 	m_logicParameters(other.m_logicParameters),
 	m_triggerParameters(other.m_triggerParameters),
-	m_currentTime(other.m_currentTime)
+	m_compiledTransitions(other.m_compiledTransitions),
+	m_initialParameterValues(other.m_initialParameterValues),
+	m_parameterOffsets(other.m_parameterOffsets)
 #ifdef EDITOR
 	, m_name(other.m_name)
 #endif
@@ -47,13 +150,14 @@ AnimationStateMachine::AnimationStateMachine(const AnimationStateMachine& other)
 AnimationStateMachine::AnimationStateMachine(AnimationStateMachine&& other) noexcept
 	:
 	m_uuid(other.m_uuid),
-	m_currentStateIndex(other.m_currentStateIndex),
 	m_initialStateIndex(other.m_initialStateIndex),
 	m_integerParameters(std::move(other.m_integerParameters)),
 	m_floatParameters(std::move(other.m_floatParameters)),
 	m_logicParameters(std::move(other.m_logicParameters)),
 	m_triggerParameters(std::move(other.m_triggerParameters)),
-	m_currentTime(other.m_currentTime)
+	m_compiledTransitions(std::move(other.m_compiledTransitions)),
+	m_initialParameterValues(std::move(other.m_initialParameterValues)),
+	m_parameterOffsets(other.m_parameterOffsets)
 #ifdef EDITOR
 	, m_name(std::move(other.m_name))
 #endif
@@ -312,28 +416,102 @@ void AnimationStateMachine::DeleteCondition(size_t fromStateIndex, size_t transi
 	transition->DeleteCondition(conditionIndex);
 }
 
-void AnimationStateMachine::AttachTo(EntityRef entity)
+void AnimationStateMachine::Compile()
 {
+	m_initialParameterValues.clear();
+	const auto addParameterValues
+	(
+		[&](ParameterType parameterType, const auto& parameterContainer, auto getValue) -> void
+		{
+			const size_t offset(m_initialParameterValues.size());
+			m_parameterOffsets[static_cast<size_t>(parameterType)] = offset;
+			parameterContainer.Iterate
+			(
+				[&](auto parameter) -> bool
+				{
+					const size_t valueIndex(offset + parameter.GetIndex());
+					if (valueIndex >= m_initialParameterValues.size())
+					{
+						m_initialParameterValues.resize(valueIndex + 1, ParameterValue{0});
+					}
+					getValue(m_initialParameterValues[valueIndex], *parameter.Data());
+					return false;
+				}
+			);
+		}
+	);
+	addParameterValues(ParameterType::Integer, m_integerParameters, [](ParameterValue& value, const Parameter<int>& parameter) { value.Integer = parameter.GetValue(); });
+	addParameterValues(ParameterType::Float, m_floatParameters, [](ParameterValue& value, const Parameter<float>& parameter) { value.Float = parameter.GetValue(); });
+	addParameterValues(ParameterType::Logic, m_logicParameters, [](ParameterValue& value, const Parameter<LogicParameter>& parameter) { value.Logic = parameter.GetValue().Value; });
+	addParameterValues(ParameterType::Trigger, m_triggerParameters, [](ParameterValue& value, const Parameter<TriggerParameter>& parameter) { value.Logic = parameter.GetValueWithoutReset().Value; });
+	m_parameterOffsets[numberOfParameterTypes] = m_initialParameterValues.size();
+	m_compiledTransitions.Clear();
 	m_states.Iterate
 	(
-		[&](stateRefType state) -> bool
+		[&](stateConstRefType state) -> bool
 		{
-			state->SetEntity(entity);
+			m_compiledTransitions.AddState(state.GetIndex());
+			state->IterateOnTransitions
+			(
+				[&](transitionConstRefType transition) -> bool
+				{
+					m_compiledTransitions.AddTransition(transition->GetToStateIndex());
+					transition->IterateOnConditions
+					(
+						[&](conditionConstRefType condition) -> bool
+						{
+							CompiledTransitionTable::ConditionEntry conditionEntry;
+							conditionEntry.ValueIndex = m_parameterOffsets[static_cast<size_t>(condition->GetParameterType())] + condition->GetParameterIndex();
+							conditionEntry.Type = condition->GetParameterType();
+							conditionEntry.NumericCondition = condition->GetNumericCondition();
+							conditionEntry.Value.Integer = 0;
+							switch (conditionEntry.Type)
+							{
+							case ParameterType::Integer:
+								conditionEntry.Value.Integer = condition->GetValue<ParameterType::Integer>();
+								break;
+							case ParameterType::Float:
+								conditionEntry.Value.Float = condition->GetValue<ParameterType::Float>();
+								break;
+							case ParameterType::Logic:
+								conditionEntry.Value.Logic = condition->GetValue<ParameterType::Logic>().Value;
+								break;
+							case ParameterType::Trigger:
+								break;
+							}
+							m_compiledTransitions.AddCondition(conditionEntry);
+							return false;
+						}
+					);
+					return false;
+				}
+			);
 			return false;
 		}
 	);
 }
 
+void AnimationStateMachine::SetupInstance(AnimationStateMachineInstance& instance) const
+{
+	instance.m_currentStateIndex = m_initialStateIndex;
+	instance.m_currentTime = 0.0f;
+	instance.m_cursors.Reset();
+	instance.m_parameterValues = m_initialParameterValues;
+	instance.m_parameterOffsets = m_parameterOffsets;
+	instance.m_parameterGeneration = instance.m_evaluatedParameterGeneration + 1;
+}
+
 AnimationStateMachine& AnimationStateMachine::operator=(AnimationStateMachine&& other) noexcept
 {
 	m_uuid = other.m_uuid;
-	m_currentStateIndex = other.m_currentStateIndex;
 	m_initialStateIndex = other.m_initialStateIndex;
 	m_integerParameters = std::move(other.m_integerParameters);
 	m_floatParameters = std::move(other.m_floatParameters);
 	m_logicParameters = std::move(other.m_logicParameters);
 	m_triggerParameters = std::move(other.m_triggerParameters);
-	m_currentTime = other.m_currentTime;
+	m_compiledTransitions = std::move(other.m_compiledTransitions);
+	m_initialParameterValues = std::move(other.m_initialParameterValues);
+	m_parameterOffsets = other.m_parameterOffsets;
 	other.m_states.Iterate
 	(
 		[&](stateRefType state) -> bool
@@ -374,14 +552,19 @@ AnimationStateMachineRef::AnimationStateMachineRef(const AnimationStateMachineRe
 
 bool AnimationStateMachineRef::IsValid()
 {
-	return m_lockData != nullptr && m_ref.IsValid();
+	if (m_lockData == nullptr)
+	{
+		return false;
+	}
+	ReadWriteLockGuard guard(LockType::ReadLock, *m_lockData);
+	return m_ref.IsValid();
 }
 
 void AnimationStateMachineRef::Unload()
 {
 	if (IsValid())
 	{
-		AssetManager::Get().RemoveAnimationStateMachine(*this);
+		AssetManager::Get().UnloadAnimationStateMachine(m_ref->GetUUID());
 	}
 }
 
@@ -391,11 +574,10 @@ UUIDType AnimationStateMachineRef::GetUUID()
 	return m_ref->GetAsset().GetUUID();
 }
 
-void AnimationStateMachineRef::AttachTo(EntityRef entity)
+void AnimationStateMachineRef::SetupInstance(AnimationStateMachineInstance& instance)
 {
 	DASSERT_E(IsValid());
-	ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
-	m_ref->GetAsset().AttachTo(entity);
+	m_ref->GetAsset().SetupInstance(instance);
 }
 
 #ifdef EDITOR
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Parameter.h"
+#include "AnimationStateMachineInstance.h"
 #include "ReciclingVector.h"
 #include "State.h"
 #include "AttributeRef.h"
@@ -15,6 +16,64 @@
 namespace DCore
 {
 
+// Flat form of the transitions of an AnimationStateMachine, built by AnimationStateMachine::Compile. The conditions
+// of all the transitions are stored contiguously and reference the parameters by their position in the flat value
+// array of an AnimationStateMachineInstance, so evaluating a state is a linear pass without the nested containers.
+class CompiledTransitionTable
+{
+public:
+	struct ConditionEntry
+	{
+		size_t ValueIndex;
+		ParameterType Type;
+		NumericConditionType NumericCondition;
+		ParameterValue Value;
+	};
+
+	struct TransitionEntry
+	{
+		size_t ToStateIndex;
+		size_t FirstCondition;
+		size_t NumberOfConditions;
+	};
+
+	// Indexed by state index. Removed states have no transitions.
+	struct StateEntry
+	{
+		size_t FirstTransition;
+		size_t NumberOfTransitions;
+	};
+public:
+	using conditionContainerType = std::vector<ConditionEntry>;
+	using transitionContainerType = std::vector<TransitionEntry>;
+	using stateContainerType = std::vector<StateEntry>;
+	using parameterValueContainerType = AnimationStateMachineInstance::parameterValueContainerType;
+public:
+	CompiledTransitionTable() = default;
+	CompiledTransitionTable(const CompiledTransitionTable&) = default;
+	CompiledTransitionTable(CompiledTransitionTable&&) noexcept = default;
+	~CompiledTransitionTable() = default;
+public:
+	CompiledTransitionTable& operator=(const CompiledTransitionTable&) = default;
+	CompiledTransitionTable& operator=(CompiledTransitionTable&&) noexcept = default;
+public:
+	void Clear();
+	// States must be added in increasing index order, each followed by its transitions and their conditions.
+	void AddState(size_t stateIndex);
+	void AddTransition(size_t toStateIndex);
+	void AddCondition(const ConditionEntry&);
+	// Finds the first transition of the state whose conditions are all true and resets the triggers it uses.
+	bool TryMakeTransition(size_t stateIndex, parameterValueContainerType& parameterValues, size_t& outToStateIndex) const;
+private:
+	conditionContainerType m_conditions;
+	transitionContainerType m_transitions;
+	stateContainerType m_states;
+private:
+	static bool IsConditionTrue(const ConditionEntry&, const parameterValueContainerType&);
+};
+
+// Graph of states, transitions, conditions and animations, loaded once and shared by every entity that
+// uses it. The parameters hold the values an AnimationStateMachineInstance starts with.
 class AnimationStateMachine
 {
 public:
@@ -83,7 +142,11 @@ public:
 	void SetConditionParameter(size_t fromStateIndex, size_t transitionIndex, size_t conditionIndex, ParameterType, size_t parameterIndex);
 	void SetNumericCondition(size_t fromStateIndex, size_t transitionIndex, size_t conditionIndex, NumericConditionType);
 	void DeleteCondition(size_t fromStateIndex, size_t transitionIndex, size_t conditionIndex);
-	void AttachTo(EntityRef entity);
+	// Builds the transition table and the parameter layout used by the instances. Must be called again after
+	// the graph or the parameters are edited, before setting up instances.
+	void Compile();
+	// Starts the instance at the initial state, with the values of the parameters.
+	void SetupInstance(AnimationStateMachineInstance&) const;
 public:
 	AnimationStateMachine& operator=(AnimationStateMachine&&) noexcept;
 public:
@@ -106,11 +169,6 @@ public:
 	{
 		m_initialStateIndex = index;
 	}
-
-	void Setup()
-	{
-		m_currentStateIndex = m_initialStateIndex;
-	}
 #ifdef EDITOR
 	const stringType& GetName() const
 	{
@@ -496,48 +554,50 @@ public:
 	}
 
 	template <class Func>
-	void Tick(float deltaTime, Func metachannelsCallback)
+	void Tick(AnimationStateMachineInstance& instance, EntityRef entity, float deltaTime, Func metachannelsCallback) const
 	{
-		if (m_states.Empty())
+		// Transitions only depend on the parameters, so they are only evaluated after a parameter changed. When one
+		// is made, the transitions of the new state are evaluated in the same pass. A trigger stays set until a
+		// transition that uses it is made.
+		if (instance.m_evaluatedParameterGeneration != instance.m_parameterGeneration)
 		{
-			return;
-		}
-		stateRefType state(m_states.GetRefFromIndex(m_currentStateIndex));
-		constexpr size_t maxNumberOfTransitionAttempts(10);
-		size_t currentNumberOfTransitionsAttempts(0);
-		while (true)
-		{
-			if (state->TryMakeTransition(m_currentStateIndex))
+			constexpr size_t maxNumberOfTransitions(10);
+			size_t numberOfTransitions(0);
+			while (numberOfTransitions < maxNumberOfTransitions &&
+				m_compiledTransitions.TryMakeTransition(instance.m_currentStateIndex, instance.m_parameterValues, instance.m_currentStateIndex))
 			{
-				m_currentTime = 0.0f;
-				state = m_states.GetRefFromIndex(m_currentStateIndex);
-			}
-			currentNumberOfTransitionsAttempts++;
-			if (currentNumberOfTransitionsAttempts >= maxNumberOfTransitionAttempts)
-			{
-				break;
+				instance.m_currentTime = 0.0f;
+				instance.m_cursors.Reset();
+				numberOfTransitions++;
 			}
+			instance.m_evaluatedParameterGeneration = instance.m_parameterGeneration;
+		}
+		stateConstRefType state(m_states.GetRefFromIndex(instance.m_currentStateIndex));
+		if (!state.IsValid())
+		{
+			return;
 		}
 		if (state->GetAnimation().IsValid())
 		{
-			state->Tick(m_currentTime, m_currentTime + deltaTime, metachannelsCallback);
-			m_currentTime += deltaTime;
-			if (m_currentTime >= state->GetAnimation().GetDuration())
+			state->Tick(entity, instance.m_cursors, instance.m_currentTime, instance.m_currentTime + deltaTime, metachannelsCallback);
+			instance.m_currentTime += deltaTime;
+			if (instance.m_currentTime >= state->GetAnimation().GetDuration())
 			{
-				m_currentTime = 0.0f;
+				instance.m_currentTime = 0.0f;
 			}
 		}
 	}
 private:
 	UUIDType m_uuid;
 	stateContainerType m_states;
-	size_t m_currentStateIndex;
 	size_t m_initialStateIndex;
 	integerParameterContainerType m_integerParameters;
 	floatParameterContainerType m_floatParameters;
 	logicParameterContainerType m_logicParameters;
 	triggerParameterContainerType m_triggerParameters;
-	float m_currentTime;
+	CompiledTransitionTable m_compiledTransitions;
+	AnimationStateMachineInstance::parameterValueContainerType m_initialParameterValues;
+	AnimationStateMachineInstance::parameterOffsetContainerType m_parameterOffsets;
 #ifdef EDITOR
 	stringType m_name;
 #endif
@@ -619,7 +679,7 @@ public:
 	bool IsValid();
 	void Unload();
 	UUIDType GetUUID();
-	void AttachTo(EntityRef);
+	void SetupInstance(AnimationStateMachineInstance&);
 #ifdef EDITOR
 	stringType GetName();
 	void SetName(const stringType& name);
@@ -631,18 +691,12 @@ public:
 	{
 		return m_ref;
 	}
-
-	void Setup()
-	{
-		DASSERT_E(IsValid());
-		m_ref->GetAsset().Setup();
-	}
 public:
 	template <class Func>
-	void Tick(float deltaTime, Func metachannelsCallback)
+	void Tick(AnimationStateMachineInstance& instance, EntityRef entity, float deltaTime, Func metachannelsCallback)
 	{
 		DASSERT_E(IsValid());
-		m_ref->GetAsset().Tick(deltaTime, metachannelsCallback);
+		m_ref->GetAsset().Tick(instance, entity, deltaTime, metachannelsCallback);
 	}
 
 	template <ParameterType ParameterT>
@@ -654,16 +708,6 @@ public:
 		}
 		return m_ref->GetAsset().TryGetParameterIndexWithName<ParameterT>(name, out);
 	}
-
-	template <ParameterType ParameterT, class ParameterValueType>
-	void SetParameterValue(size_t parameterIndex, ParameterValueType value)
-	{
-		if (!IsValid())
-		{
-			return;
-		}
-		m_ref->GetAsset().SetParameterValue<ParameterT>(parameterIndex, value);
-	}
 private:
 	InternalAnimationStateMachineRefType m_ref;
 	LockData* m_lockData;
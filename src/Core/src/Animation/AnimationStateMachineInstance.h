@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Parameter.h"
+#include "Animation.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+// Playback state of an entity's animation state machine. The graph (states, transitions, conditions and
+// animations) lives in the AnimationStateMachine, which is shared by every entity that uses it and is set up
+// and ticked with an instance.
+class AnimationStateMachineInstance
+{
+	friend class AnimationStateMachine;
+public:
+	using parameterValueContainerType = std::vector<ParameterValue>;
+	using parameterOffsetContainerType = std::array<size_t, numberOfParameterTypes + 1>;
+public:
+	AnimationStateMachineInstance()
+		:
+		m_currentStateIndex(0),
+		m_currentTime(0.0f),
+		m_parameterOffsets{},
+		m_parameterGeneration(0),
+		m_evaluatedParameterGeneration(0)
+	{}
+	AnimationStateMachineInstance(const AnimationStateMachineInstance&) = default;
+	AnimationStateMachineInstance(AnimationStateMachineInstance&&) noexcept = default;
+	~AnimationStateMachineInstance() = default;
+public:
+	AnimationStateMachineInstance& operator=(const AnimationStateMachineInstance&) = default;
+	AnimationStateMachineInstance& operator=(AnimationStateMachineInstance&&) noexcept = default;
+public:
+	size_t GetCurrentStateIndex() const
+	{
+		return m_currentStateIndex;
+	}
+
+	float GetCurrentTime() const
+	{
+		return m_currentTime;
+	}
+
+	// Returns nullptr if the parameter did not exist when the instance was set up.
+	ParameterValue* TryGetParameterValue(ParameterType parameterType, size_t parameterIndex)
+	{
+		const size_t typeIndex(static_cast<size_t>(parameterType));
+		const size_t valueIndex(m_parameterOffsets[typeIndex] + parameterIndex);
+		if (valueIndex >= m_parameterOffsets[typeIndex + 1])
+		{
+			return nullptr;
+		}
+		return &m_parameterValues[valueIndex];
+	}
+
+	const ParameterValue* TryGetParameterValue(ParameterType parameterType, size_t parameterIndex) const
+	{
+		return const_cast<AnimationStateMachineInstance*>(this)->TryGetParameterValue(parameterType, parameterIndex);
+	}
+public:
+	template <ParameterType ParameterT, class ParameterValueType>
+	void SetParameterValue(size_t parameterIndex, ParameterValueType value)
+	{
+		static_assert
+		(
+			(ParameterT == ParameterType::Integer && std::is_same_v<ParameterValueType, int>) ||
+			(ParameterT == ParameterType::Float && std::is_same_v<ParameterValueType, float>) ||
+			(ParameterT == ParameterType::Logic && std::is_same_v<ParameterValueType, LogicParameter>) ||
+			(ParameterT == ParameterType::Trigger && std::is_same_v<ParameterValueType, TriggerParameter>),
+			"Parameter type and parameter value don't match."
+		);
+		ParameterValue* parameterValue(TryGetParameterValue(ParameterT, parameterIndex));
+		if (parameterValue == nullptr)
+		{
+			return;
+		}
+		m_parameterGeneration++;
+		if constexpr (ParameterT == ParameterType::Integer)
+		{
+			parameterValue->Integer = value;
+		}
+		else if constexpr (ParameterT == ParameterType::Float)
+		{
+			parameterValue->Float = value;
+		}
+		else
+		{
+			parameterValue->Logic = value.Value;
+		}
+	}
+private:
+	size_t m_currentStateIndex;
+	float m_currentTime;
+	AnimationCursors m_cursors;
+	// The values of each parameter type are stored contiguously, indexed by the parameter indexes of the
+	// AnimationStateMachine. m_parameterOffsets[type] is where the values of a type start.
+	parameterValueContainerType m_parameterValues;
+	parameterOffsetContainerType m_parameterOffsets;
+	// Bumped when a parameter is set, so the transitions are only evaluated when they could have changed.
+	size_t m_parameterGeneration;
+	size_t m_evaluatedParameterGeneration;
+};
+
+}
@@ -93,56 +93,4 @@ NumericConditionType Condition::GetNumericCondition(const stringType& name)
 	return NumericConditionType::Smaller;
 }
 
-bool Condition::IsTrue()
-{
-	switch (m_parameterType)
-	{
-	case ParameterType::Integer:
-	{
-		integerParameterConstRefType parameter(GetParameter<ParameterType::Integer>());
-		switch (m_numericCondition)
-		{
-		case NumericConditionType::Smaller:
-			return parameter->GetValue() < m_integerValue;
-		case NumericConditionType::Equals:
-			return parameter->GetValue() == m_integerValue;
-		case NumericConditionType::Bigger:
-			return parameter->GetValue() > m_integerValue;
-		default:
-			DASSERT_E(false);
-			break;
-		}
-		return false;
-	}
-	case ParameterType::Float:
-	{
-		floatParameterConstRefType parameter(GetParameter<ParameterType::Float>());
-		switch (m_numericCondition)
-		{
-		case NumericConditionType::Smaller:
-			return parameter->GetValue() < m_floatValue;
-		case NumericConditionType::Equals:
-			return parameter->GetValue() == m_floatValue;
-		case NumericConditionType::Bigger:
-			return parameter->GetValue() > m_floatValue;
-		default:
-			DASSERT_E(false);
-			break;
-		}
-		return false;
-	}
-	case ParameterType::Logic:
-	{
-		logicParameterConstRefType parameter(GetParameter<ParameterType::Logic>());
-		return parameter->GetValue().Value == m_logicValue.Value;
-	}
-	case ParameterType::Trigger:
-	{
-		triggerParameterRefType parameter(GetParameter<ParameterType::Trigger>());
-		return parameter->GetValue().Value;
-	}
-	}
-	return false;
-}
-
 }
@@ -38,8 +38,6 @@ public:
 public:
 	static stringType GetNumericConditionTypeName(NumericConditionType);
 	static NumericConditionType GetNumericCondition(const stringType&);
-public:
-	bool IsTrue();
 public:
 	ParameterType GetParameterType() const
 	{
@@ -28,6 +28,16 @@ enum class ParameterType
 	Trigger
 };
 
+static constexpr size_t numberOfParameterTypes{4};
+
+// Value of a parameter in an AnimationStateMachineInstance. Trigger parameters use Logic.
+union ParameterValue
+{
+	int Integer;
+	float Float;
+	bool Logic;
+};
+
 namespace ParameterUtils
 {
 	using stringType = std::string;
@@ -19,8 +19,7 @@ State::State(
 	triggerParameterContainerType& triggerParameters)
 	:
 	m_name(other.m_name),
-	m_toStateIndexes(other.m_toStateIndexes),
-	m_entity(other.m_entity)
+	m_toStateIndexes(other.m_toStateIndexes)
 {
 	if (other.m_animation.IsValid())
 	{
@@ -45,8 +44,7 @@ State::State(
 	:
 	m_name(std::move(other.m_name)),
 	m_toStateIndexes(std::move(other.m_toStateIndexes)),
-	m_animation(other.m_animation),
-	m_entity(other.m_entity)
+	m_animation(other.m_animation)
 {
 	other.m_animation.Invalidate();
 	other.m_transitions.IterateConstRef
@@ -64,8 +62,7 @@ State::State(State&& other) noexcept
 	m_name(std::move(other.m_name)),
 	m_transitions(std::move(other.m_transitions)),
 	m_toStateIndexes(std::move(other.m_toStateIndexes)),
-	m_animation(other.m_animation),
-	m_entity(other.m_entity)
+	m_animation(other.m_animation)
 {
 	other.m_animation.Invalidate();
 }
@@ -115,23 +112,4 @@ void State::DeleteAllTransitionsThatGoToStateAtIndex(size_t stateIndex)
 	);
 }
 
-bool State::TryMakeTransition(size_t& outToStateIndex)
-{
-	bool result(false);
-	m_transitions.Iterate
-	(
-		[&](transitionRefType transition) -> bool
-		{
-			if (transition->ToExecute())
-			{
-				outToStateIndex = transition->GetToStateIndex();
-				result = true;
-				return true;
-			}
-			return false;
-		}
-	);
-	return result;
-}
-
 }
@@ -40,7 +40,6 @@ public:
 	transitionConstRefType TryGetTransitionAtIndex(size_t index) const;
 	void DeleteTransitionAtIndex(size_t transitionIndex);
 	void DeleteAllTransitionsThatGoToStateAtIndex(size_t);
-	bool TryMakeTransition(size_t& outToStateIndex);
 public:
 	const stringType& GetName() const
 	{
@@ -71,11 +70,6 @@ public:
 	{
 		return m_transitions.GetRefFromIndex(transitionIndex);
 	}
-
-	void SetEntity(EntityRef entity)
-	{
-		m_entity = entity;
-	}
 public:
 	template <class Func>
 	void IterateOnTransitions(Func function)
@@ -90,16 +84,15 @@ public:
 	}
 	
 	template <class Func>
-	void Tick(float currentSampleTime, float nextSampleTime, Func metachannelsCallback)
+	void Tick(EntityRef entity, AnimationCursors& cursors, float currentSampleTime, float nextSampleTime, Func metachannelsCallback) const
 	{
-		AnimationSimulator::Simulate(m_entity, m_animation, currentSampleTime, nextSampleTime, metachannelsCallback);
+		AnimationSimulator::Simulate(entity, m_animation, cursors, currentSampleTime, nextSampleTime, metachannelsCallback);
 	}
 private:
 	stringType m_name;
 	transitionContainerType m_transitions;
 	toStateIndexesType m_toStateIndexes;
 	AnimationRef m_animation;
-	EntityRef m_entity;
 };
 
 }
@@ -51,24 +51,6 @@ conditionRefType Transition::CreateCondition(
 	return m_conditions.PushBack(conditionParameter, parameterIndex, integerParameters, floatParameters, logicParameters, triggerParameters);
 }
 
-bool Transition::ToExecute()
-{
-	bool toExecute(true);
-	m_conditions.Iterate
-	(
-		[&](conditionRefType condition) -> bool
-		{
-			if (!condition->IsTrue())
-			{
-				toExecute = false;
-				return true;
-			}
-			return false;
-		}
-	);
-	return toExecute;
-}
-
 void Transition::DeleteCondition(size_t conditionIndex)
 {
 	m_conditions.RemoveElementAtIndex(conditionIndex);
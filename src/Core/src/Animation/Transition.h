@@ -30,7 +30,6 @@ public:
 			floatParameterContainerType& floatParameters,
 			logicParameterContainerType& logicParameters,
 			triggerParameterContainerType& triggerParameters);
-	bool ToExecute();
 	void DeleteCondition(size_t conditionIndex);
 public:
 	Transition& operator=(Transition&& other) noexcept;
@@ -9,57 +9,82 @@ namespace DCore
 
 AnimationAssetManager::~AnimationAssetManager()
 {
+	m_unloadedAnimations.clear();
 	m_animations.Clear();
-	m_loadedAnimations.clear();
+	m_loadedAnimations.Clear();
 }
 
 bool AnimationAssetManager::IsAnimationLoaded(const UUIDType& uuid)
 {
-	return m_loadedAnimations.find(uuid) != m_loadedAnimations.end();
+	return m_loadedAnimations.Contains(uuid);
 }
 
 AnimationRef AnimationAssetManager::LoadAnimation(const UUIDType& uuid, Animation&& animation)
 {
+	animation.Compile();
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);	
-	DASSERT_E(m_loadedAnimations.find(uuid) == m_loadedAnimations.end());
+	DASSERT_E(!m_loadedAnimations.Contains(uuid));
 	InternalAnimationRefType internalRef(m_animations.PushBack(uuid, std::move(animation)));
-	m_loadedAnimations.insert({uuid, internalRef});
+	m_loadedAnimations.Insert(uuid, internalRef);
 	return AnimationRef(internalRef, m_lockData);
 }
 
 AnimationRef AnimationAssetManager::GetAnimation(const UUIDType& uuid)
 {
-	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);	
-	DASSERT_E(m_loadedAnimations.find(uuid) != m_loadedAnimations.end());
-	InternalAnimationRefType internalRef(m_loadedAnimations.find(uuid)->second);
+	ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);	
+	DASSERT_E(m_loadedAnimations.Contains(uuid));
+	InternalAnimationRefType internalRef(*m_loadedAnimations.Find(uuid));
 	internalRef->AddReferenceCount();
 	return AnimationRef(internalRef, m_lockData);
 }
 
+bool AnimationAssetManager::ReloadAnimation(const UUIDType& uuid, Animation&& animation)
+{
+	animation.Compile();
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	auto* loadedRef(m_loadedAnimations.Find(uuid));
+	if (loadedRef == nullptr)
+	{
+		return false;
+	}
+	// The cursors of the instances playing it are reset by the search, if out of the new tracks.
+	(*loadedRef)->GetAsset() = std::move(animation);
+	return true;
+}
+
 void AnimationAssetManager::UnloadAnimation(const UUIDType& uuid, bool removeAllReferences)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	auto it(m_loadedAnimations.find(uuid));
-	if (it == m_loadedAnimations.end())
+	auto* loadedRef(m_loadedAnimations.Find(uuid));
+	if (loadedRef == nullptr)
 	{
 		return;
 	}
-	InternalAnimationRefType internalRef(it->second);
-	if (internalRef->m_referenceCount == 1 || removeAllReferences)
+	InternalAnimationRefType internalRef(*loadedRef);
+	if (!removeAllReferences && internalRef->SubReferenceCount() != 0)
 	{
-		m_loadedAnimations.erase(uuid);
-		m_animations.Remove(internalRef);
 		return;
 	}
-	internalRef->SubReferenceCount();
+	m_loadedAnimations.Remove(uuid);
+	m_unloadedAnimations.push_back(internalRef);
+}
+
+void AnimationAssetManager::DestroyUnloadedAnimations()
+{
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	for (InternalAnimationRefType& internalRef : m_unloadedAnimations)
+	{
+		m_animations.Remove(internalRef);
+	}
+	m_unloadedAnimations.clear();
 }
 
 void AnimationAssetManager::RenameAnimation(const UUIDType& uuid, const stringType& newName)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	auto it(m_loadedAnimations.find(uuid));
-	DASSERT_E(it != m_loadedAnimations.end());
-	it->second->GetAsset().SetName(newName);
+	auto* loadedRef(m_loadedAnimations.Find(uuid));
+	DASSERT_E(loadedRef != nullptr);
+	(*loadedRef)->GetAsset().SetName(newName);
 }
 
 }
@@ -2,11 +2,12 @@
 
 #include "AssetManagerTypes.h"
 #include "UUID.h"
+#include "FlatHashMap.h"
 #include "Animation.h"
 
 #include <thread>
 #include <unordered_set>
-#include <unordered_map>
+#include <vector>
 #include <string>
 
 
@@ -19,7 +20,8 @@ class AnimationAssetManager
 	friend class ReadWriteLockGuard;
 public:
 	using animationContainerType = AssetContainerType<Animation>;
-	using loadedAnimationsRefType = std::unordered_map<UUIDType, InternalAnimationRefType>;
+	using loadedAnimationsRefType = FlatHashMap<UUIDType, InternalAnimationRefType>;
+	using unloadedAnimationContainerType = std::vector<InternalAnimationRefType>;
 	using stringType = std::string;
 public:
 	virtual ~AnimationAssetManager();
@@ -27,13 +29,19 @@ public:
 	bool IsAnimationLoaded(const UUIDType&);
 	[[nodiscard]] AnimationRef LoadAnimation(const UUIDType&, Animation&&);
 	[[nodiscard]] AnimationRef GetAnimation(const UUIDType&);
+	// Replaces the loaded animation in place, so its refs play the new one. False if the animation is not loaded.
+	bool ReloadAnimation(const UUIDType&, Animation&&);
+	// The animation is destroyed by DestroyUnloadedAnimations, so its refs stay valid until then.
 	void UnloadAnimation(const UUIDType&, bool removeAllReferences = false);
+	// To be called where no ref to an unloaded animation is in use, as between frames.
+	void DestroyUnloadedAnimations();
 	void RenameAnimation(const UUIDType&, const stringType& newName);
 protected:
 	AnimationAssetManager() = default;
 private:
 	animationContainerType m_animations;	
 	loadedAnimationsRefType m_loadedAnimations;
+	unloadedAnimationContainerType m_unloadedAnimations;
 	LockData m_lockData;
 private:
 	LockData& GetLockData()
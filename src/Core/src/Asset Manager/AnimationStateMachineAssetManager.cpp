@@ -1,4 +1,5 @@
 #include "AnimationStateMachineAssetManager.h"
+#include "DCoreAssert.h"
 
 
 
@@ -7,35 +8,60 @@ namespace DCore
 
 AnimationStateMachineAssetManager::~AnimationStateMachineAssetManager()
 {
+	m_unloadedAnimationStateMachines.clear();
 	m_animationStateMachines.Clear();
+	m_loadedAnimationStateMachines.Clear();
 }
 
-AnimationStateMachineRef AnimationStateMachineAssetManager::AddAnimationStateMachine(AnimationStateMachine&& animationStateMachine)
+bool AnimationStateMachineAssetManager::IsAnimationStateMachineLoaded(const UUIDType& uuid)
 {
+	return m_loadedAnimationStateMachines.Contains(uuid);
+}
+
+AnimationStateMachineRef AnimationStateMachineAssetManager::LoadAnimationStateMachine(const UUIDType& uuid, AnimationStateMachine&& animationStateMachine)
+{
+	animationStateMachine.Compile();
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	return AnimationStateMachineRef(m_animationStateMachines.PushBack(animationStateMachine.GetUUID(), std::move(animationStateMachine)), m_lockData);
+	DASSERT_E(!m_loadedAnimationStateMachines.Contains(uuid));
+	InternalAnimationStateMachineRefType internalRef(m_animationStateMachines.PushBack(uuid, std::move(animationStateMachine)));
+	m_loadedAnimationStateMachines.Insert(uuid, internalRef);
+	return AnimationStateMachineRef(internalRef, m_lockData);
+}
+
+AnimationStateMachineRef AnimationStateMachineAssetManager::GetAnimationStateMachine(const UUIDType& uuid)
+{
+	ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);
+	DASSERT_E(m_loadedAnimationStateMachines.Contains(uuid));
+	InternalAnimationStateMachineRefType internalRef(*m_loadedAnimationStateMachines.Find(uuid));
+	internalRef->AddReferenceCount();
+	return AnimationStateMachineRef(internalRef, m_lockData);
 }
 
-void AnimationStateMachineAssetManager::RemoveAnimationStateMachine(AnimationStateMachineRef ref)
+void AnimationStateMachineAssetManager::UnloadAnimationStateMachine(const UUIDType& uuid, bool removeAllReferences)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	m_animationStateMachines.Remove(ref.GetInternalRef());
+	auto* loadedRef(m_loadedAnimationStateMachines.Find(uuid));
+	if (loadedRef == nullptr)
+	{
+		return;
+	}
+	InternalAnimationStateMachineRefType internalRef(*loadedRef);
+	if (!removeAllReferences && internalRef->SubReferenceCount() != 0)
+	{
+		return;
+	}
+	m_loadedAnimationStateMachines.Remove(uuid);
+	m_unloadedAnimationStateMachines.push_back(internalRef);
 }
 
-void AnimationStateMachineAssetManager::RemoveAllAnimationStateMachineInstancesWithUUID(const UUIDType& uuid)
+void AnimationStateMachineAssetManager::DestroyUnloadedAnimationStateMachines()
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	m_animationStateMachines.Iterate
-	(
-		[&](animationStateMachineContainerType::ConstRef animationStateMachine) -> bool
-		{
-			if (animationStateMachine->GetUUID() == uuid)
-			{
-				m_animationStateMachines.Remove(animationStateMachine);
-			}
-			return false;
-		}
-	);
+	for (InternalAnimationStateMachineRefType& internalRef : m_unloadedAnimationStateMachines)
+	{
+		m_animationStateMachines.Remove(internalRef);
+	}
+	m_unloadedAnimationStateMachines.clear();
 }
 
 }
@@ -3,25 +3,38 @@
 #include "ReciclingVector.h"
 #include "AnimationStateMachine.h"
 #include "ReadWriteLockGuard.h"
+#include "UUID.h"
+#include "FlatHashMap.h"
+
+#include <vector>
 
 
 
 namespace DCore
 {
 
+// Each animation state machine is loaded once and shared, reference counted, by all the entities that use it.
+// The per entity playback state is kept in an AnimationStateMachineInstance.
 class AnimationStateMachineAssetManager
 {
 	friend class ReadWriteLockGuard;
 public:
 	using animationStateMachineContainerType = AssetContainerType<AnimationStateMachine>;
+	using loadedAnimationStateMachinesRefType = FlatHashMap<UUIDType, InternalAnimationStateMachineRefType>;
+	using unloadedAnimationStateMachineContainerType = std::vector<InternalAnimationStateMachineRefType>;
 public:
 	AnimationStateMachineAssetManager(const AnimationStateMachineAssetManager&) = delete;
 	AnimationStateMachineAssetManager(AnimationStateMachineAssetManager&&) = delete;
 	~AnimationStateMachineAssetManager();
 public:
-	AnimationStateMachineRef AddAnimationStateMachine(AnimationStateMachine&&);
-	void RemoveAnimationStateMachine(AnimationStateMachineRef);
-	void RemoveAllAnimationStateMachineInstancesWithUUID(const UUIDType&);
+	bool IsAnimationStateMachineLoaded(const UUIDType&);
+	[[nodiscard]] AnimationStateMachineRef LoadAnimationStateMachine(const UUIDType&, AnimationStateMachine&&);
+	[[nodiscard]] AnimationStateMachineRef GetAnimationStateMachine(const UUIDType&);
+	// The animation state machine is destroyed by DestroyUnloadedAnimationStateMachines, so its refs stay valid until
+	// then.
+	void UnloadAnimationStateMachine(const UUIDType&, bool removeAllReferences = false);
+	// To be called where no ref to an unloaded animation state machine is in use, as between frames.
+	void DestroyUnloadedAnimationStateMachines();
 public:
 	template <class Func>
 	void IterateOnAnimationStateMachines(Func function)
@@ -38,6 +51,8 @@ protected:
 	AnimationStateMachineAssetManager() = default;
 private:
 	animationStateMachineContainerType m_animationStateMachines;
+	loadedAnimationStateMachinesRefType m_loadedAnimationStateMachines;
+	unloadedAnimationStateMachineContainerType m_unloadedAnimationStateMachines;
 	LockData m_lockData;
 private:
 	LockData& GetLockData()
@@ -3,14 +3,16 @@
 #include "UUID.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <mutex>
 
 
 
 namespace DCore
 {
 
+// The reference count is atomic, so references are taken and released under the read lock of the manager of the
+// asset. Only loading and unloading, which change the containers, take the write lock.
 template <class AssetType>
 class Asset
 {
@@ -36,14 +38,14 @@ public:
 		:
 		m_asset(other.m_asset),
 		m_uuid(other.m_uuid),
-		m_referenceCount(other.m_referenceCount)
+		m_referenceCount(other.GetReferenceCount())
 	{}
 
 	Asset(Asset&& other) noexcept
 		:
 		m_asset(std::move(other.m_asset)),
 		m_uuid(other.m_uuid),
-		m_referenceCount(other.m_referenceCount)
+		m_referenceCount(other.GetReferenceCount())
 	{}
 
 	~Asset() = default;
@@ -65,78 +67,68 @@ public:
 
 	void AddReferenceCount()
 	{
-		m_referenceCount++;
+		m_referenceCount.fetch_add(1, std::memory_order_relaxed);
 	}
 
-	void SubReferenceCount()
+	// Returns the count left.
+	size_t SubReferenceCount()
 	{
-		m_referenceCount--;
+		return m_referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
 	}
 
 	size_t GetReferenceCount() const
 	{
-		return m_referenceCount;
+		return m_referenceCount.load(std::memory_order_acquire);
 	}
 public:
 	Asset& operator=(Asset&& other) noexcept
 	{
 		m_asset = std::move(other.m_asset);
 		m_uuid = other.m_uuid;
-		m_referenceCount = other.m_referenceCount;
+		m_referenceCount.store(other.GetReferenceCount(), std::memory_order_relaxed);
 		return *this;
 	}
 private:
 	AssetType m_asset;
 	UUIDType m_uuid;
-	size_t m_referenceCount;
+	std::atomic<size_t> m_referenceCount;
 };
 
+// The validity of a ref is the version of its slot. The slots are moved when an asset is loaded and released by
+// AssetManager::DestroyUnloadedAssets, both under the write lock of the manager, so a ref is checked and used under its
+// read lock. The refs of each asset type (Texture2DRef, ...) take it to check their validity.
 template <class RefType, class RefIdType>
 class AssetRef
 {
 public:
-	AssetRef(RefType ref, std::recursive_mutex& mutex)
+	AssetRef(RefType ref)
 		:
-		m_ref(ref),
-		m_mutex(mutex)
+		m_ref(ref)
 	{}
 	AssetRef(const AssetRef& other)
 		:
-		m_ref(other.m_ref),
-		m_mutex(other.m_mutex)
+		m_ref(other.m_ref)
 	{}
 	AssetRef(AssetRef&& other)
 		:
-		m_ref(other.m_ref),
-		m_mutex(other.m_mutex)
+		m_ref(other.m_ref)
 	{}
 	~AssetRef() = default;
 public:
-	bool IsValid()
+	bool IsValid() const
 	{
-		std::lock_guard<std::recursive_mutex> guard(m_mutex);
 		return m_ref.IsValid();
 	}
 	
-	RefIdType GetId()
+	RefIdType GetId() const
 	{
 		return m_ref.GetId();
 	}
 
-	void Lock()
-	{
-		m_mutex.lock();
-	}
-
 	RefType& GetInternalRef()
 	{
 		return m_ref;
 	}
-
-	void Unlock()
-	{
-		m_mutex.unlock();
-	}
 public:
 	RefType& operator->()
 	{
@@ -149,32 +141,12 @@ public:
 		return *this;
 	}
 
-	bool operator==(const AssetRef& other)
+	bool operator==(const AssetRef& other) const
 	{
 		return m_ref == other.m_ref;
 	}
 private:
 	RefType m_ref;
-	std::recursive_mutex& m_mutex;
-};
-
-template <class AssetRef>
-class AssetRefGuard
-{
-public:
-	AssetRefGuard(AssetRef assetRef)
-		:
-		m_assetRef(assetRef)
-	{
-		m_assetRef.Lock();
-	}
-
-	~AssetRefGuard()
-	{
-		m_assetRef.Unlock();
-	}
-private:
-	AssetRef m_assetRef;
 };
 
 }
@@ -1,10 +1,85 @@
 #include "AssetManager.h"
+#include "ComponentForm.h"
 
 
 
 namespace DCore
 {
 
+void AssetManager::DestroyUnloadedAssets()
+{
+	// The sprite materials first, as unloading them unloads their textures.
+	DestroyUnloadedSpriteMaterials();
+	DestroyUnloadedTextures2D();
+	DestroyUnloadedAnimationStateMachines();
+	DestroyUnloadedAnimations();
+	DestroyUnloadedPhysicsMaterials();
+}
 
+bool AssetManager::AcquireAssetAttribute(AttributeType attributeType, void* attribute)
+{
+	switch (attributeType)
+	{
+	case AttributeType::SpriteMaterial:
+	{
+		SpriteMaterialRef& spriteMaterial(*static_cast<SpriteMaterialRef*>(attribute));
+		if (spriteMaterial.IsValid())
+		{
+			spriteMaterial = GetSpriteMaterial(spriteMaterial.GetUUID());
+		}
+		return true;
+	}
+	case AttributeType::Animation:
+	{
+		AnimationRef& animation(*static_cast<AnimationRef*>(attribute));
+		if (animation.IsValid())
+		{
+			animation = GetAnimation(animation.GetUUID());
+		}
+		return true;
+	}
+	case AttributeType::AnimationStateMachine:
+	{
+		AnimationStateMachineRef& animationStateMachine(*static_cast<AnimationStateMachineRef*>(attribute));
+		if (animationStateMachine.IsValid())
+		{
+			animationStateMachine = GetAnimationStateMachine(animationStateMachine.GetUUID());
+		}
+		return true;
+	}
+	case AttributeType::PhysicsMaterial:
+	{
+		PhysicsMaterialRef& physicsMaterial(*static_cast<PhysicsMaterialRef*>(attribute));
+		if (physicsMaterial.IsValid())
+		{
+			physicsMaterial = GetPhysicsMaterial(physicsMaterial.GetUUID());
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+bool AssetManager::ReleaseAssetAttribute(AttributeType attributeType, void* attribute)
+{
+	switch (attributeType)
+	{
+	case AttributeType::SpriteMaterial:
+		static_cast<SpriteMaterialRef*>(attribute)->Unload();
+		return true;
+	case AttributeType::Animation:
+		static_cast<AnimationRef*>(attribute)->Unload();
+		return true;
+	case AttributeType::AnimationStateMachine:
+		static_cast<AnimationStateMachineRef*>(attribute)->Unload();
+		return true;
+	case AttributeType::PhysicsMaterial:
+		static_cast<PhysicsMaterialRef*>(attribute)->Unload();
+		return true;
+	default:
+		return false;
+	}
+}
 
 }
@@ -12,6 +12,8 @@
 namespace DCore
 {
 
+enum class AttributeType;
+
 class AssetManager
 	:
 	public SceneAssetManager,
@@ -30,6 +32,18 @@ public:
 		static AssetManager assetManager;
 		return assetManager;
 	}
+public:
+	// Destroys the assets unloaded since the last call. To be called once per frame by the thread of the main GL
+	// context, before the frame uses any asset. It takes the write lock of each asset manager, so it waits for the
+	// threads using assets of the manager, as the game loop and the loaders, which must hold its read lock meanwhile.
+	// Must not be called with any asset manager lock held.
+	void DestroyUnloadedAssets();
+	// Takes a new reference to the asset of an asset attribute (of a component or of its constructor arguments) and
+	// writes it over the attribute, for the attributes copied byte by byte. Returns false if the attribute is not
+	// an asset reference.
+	bool AcquireAssetAttribute(AttributeType, void* attribute);
+	// Releases the reference held by an asset attribute. Returns false if the attribute is not an asset reference.
+	bool ReleaseAssetAttribute(AttributeType, void* attribute);
 private:
 	AssetManager() = default;
 };	
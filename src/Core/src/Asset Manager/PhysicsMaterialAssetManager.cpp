@@ -9,29 +9,30 @@ namespace DCore
 
 PhysicsMaterialAssetManager::~PhysicsMaterialAssetManager()
 {
+	m_unloadedPhysicsMaterials.clear();
 	m_physicsMaterials.Clear();
-	m_loadedPhysicsMaterials.clear();
+	m_loadedPhysicsMaterials.Clear();
 }
 
 bool PhysicsMaterialAssetManager::IsPhysicsMaterialLoaded(const UUIDType& uuid)
 {
-	return m_loadedPhysicsMaterials.find(uuid) != m_loadedPhysicsMaterials.end();
+	return m_loadedPhysicsMaterials.Contains(uuid);
 }
 
 PhysicsMaterialRef PhysicsMaterialAssetManager::LoadPhysicsMaterial(const UUIDType& uuid, PhysicsMaterial&& physicsMaterial)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	DASSERT_E(m_loadedPhysicsMaterials.find(uuid) == m_loadedPhysicsMaterials.end());
+	DASSERT_E(!m_loadedPhysicsMaterials.Contains(uuid));
 	InternalPhysicsMaterialRefType internalRef(m_physicsMaterials.PushBack(uuid, std::move(physicsMaterial)));
-	m_loadedPhysicsMaterials.insert({uuid, internalRef});
+	m_loadedPhysicsMaterials.Insert(uuid, internalRef);
 	return PhysicsMaterialRef(internalRef, m_lockData);
 }
 
 PhysicsMaterialRef PhysicsMaterialAssetManager::GetPhysicsMaterial(const UUIDType& uuid)
 {
-	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	DASSERT_E(m_loadedPhysicsMaterials.find(uuid) != m_loadedPhysicsMaterials.end());
-	InternalPhysicsMaterialRefType internalRef(m_loadedPhysicsMaterials.find(uuid)->second);
+	ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);
+	DASSERT_E(m_loadedPhysicsMaterials.Contains(uuid));
+	InternalPhysicsMaterialRefType internalRef(*m_loadedPhysicsMaterials.Find(uuid));
 	internalRef->AddReferenceCount();
 	return PhysicsMaterialRef(internalRef, m_lockData);
 }
@@ -39,19 +40,28 @@ PhysicsMaterialRef PhysicsMaterialAssetManager::GetPhysicsMaterial(const UUIDTyp
 void PhysicsMaterialAssetManager::UnloadPhysicsMaterial(const UUIDType& uuid, bool removeAllReferences)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	auto it(m_loadedPhysicsMaterials.find(uuid));
-	if (it == m_loadedPhysicsMaterials.end())
+	auto* loadedRef(m_loadedPhysicsMaterials.Find(uuid));
+	if (loadedRef == nullptr)
 	{
 		return;
 	}
-	InternalPhysicsMaterialRefType internalRef(it->second);
-	if (internalRef->GetReferenceCount() == 1 || removeAllReferences)
+	InternalPhysicsMaterialRefType internalRef(*loadedRef);
+	if (!removeAllReferences && internalRef->SubReferenceCount() != 0)
 	{
-		m_loadedPhysicsMaterials.erase(uuid);
-		m_physicsMaterials.Remove(internalRef);
 		return;
 	}
-	internalRef->SubReferenceCount();
+	m_loadedPhysicsMaterials.Remove(uuid);
+	m_unloadedPhysicsMaterials.push_back(internalRef);
+}
+
+void PhysicsMaterialAssetManager::DestroyUnloadedPhysicsMaterials()
+{
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	for (InternalPhysicsMaterialRefType& internalRef : m_unloadedPhysicsMaterials)
+	{
+		m_physicsMaterials.Remove(internalRef);
+	}
+	m_unloadedPhysicsMaterials.clear();
 }
 
 }
@@ -3,10 +3,11 @@
 #include "AssetManagerTypes.h"
 #include "PhysicsMaterial.h"
 #include "UUID.h"
+#include "FlatHashMap.h"
 #include "ReadWriteLockGuard.h"
 
-#include <unordered_map>
 #include <string>
+#include <vector>
 
 
 
@@ -18,7 +19,8 @@ class PhysicsMaterialAssetManager
 	friend class ReadWriteLockGuard;
 public:
 	using physicsMaterialContainerType = AssetContainerType<PhysicsMaterial>;	
-	using loadedPhysicsMaterialsRefType = std::unordered_map<UUIDType, InternalPhysicsMaterialRefType>;
+	using loadedPhysicsMaterialsRefType = FlatHashMap<UUIDType, InternalPhysicsMaterialRefType>;
+	using unloadedPhysicsMaterialContainerType = std::vector<InternalPhysicsMaterialRefType>;
 public:
 	PhysicsMaterialAssetManager(const PhysicsMaterialAssetManager&) = delete;
 	PhysicsMaterialAssetManager(PhysicsMaterialAssetManager&&) = delete;
@@ -28,12 +30,16 @@ public:
 	bool IsPhysicsMaterialLoaded(const UUIDType&);
 	[[nodiscard]] PhysicsMaterialRef LoadPhysicsMaterial(const UUIDType&, PhysicsMaterial&&);
 	[[nodiscard]] PhysicsMaterialRef GetPhysicsMaterial(const UUIDType&);
+	// The physics material is destroyed by DestroyUnloadedPhysicsMaterials, so its refs stay valid until then.
 	void UnloadPhysicsMaterial(const UUIDType&, bool removeAllReferences = false);
+	// To be called where no ref to an unloaded physics material is in use, as between frames.
+	void DestroyUnloadedPhysicsMaterials();
 protected:
 	PhysicsMaterialAssetManager() = default;
 private:
 	physicsMaterialContainerType m_physicsMaterials;
 	loadedPhysicsMaterialsRefType m_loadedPhysicsMaterials;
+	unloadedPhysicsMaterialContainerType m_unloadedPhysicsMaterials;
 	LockData m_lockData;
 private:
 	LockData& GetLockData()
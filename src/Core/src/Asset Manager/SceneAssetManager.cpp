@@ -13,21 +13,21 @@ SceneAssetManager::SceneAssetManager()
 SceneAssetManager::~SceneAssetManager()
 {
 	m_scenes.Clear();
-	m_loadedScenes.clear();
+	m_loadedScenes.Clear();
 }
 
 bool SceneAssetManager::IsSceneLoaded(const UUIDType& uuid)
 {
-	return m_loadedScenes.find(uuid) != m_loadedScenes.end();
+	return m_loadedScenes.Contains(uuid);
 }
 
 SceneRef SceneAssetManager::LoadScene(const UUIDType& uuid, Scene&& scene)
 {
 	DASSERT_E(m_scenes.Size() <= maximumNumberOfLoadedScenes);
-	DASSERT_E(m_loadedScenes.find(uuid) == m_loadedScenes.end());
+	DASSERT_E(!m_loadedScenes.Contains(uuid));
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
 	InternalSceneRefType internalRef(m_scenes.PushBack(uuid, std::move(scene)));
-	m_loadedScenes.insert({uuid, internalRef});
+	m_loadedScenes.Insert(uuid, internalRef);
 	return SceneRef(internalRef, m_lockData);
 }
 
@@ -46,31 +46,35 @@ void SceneAssetManager::ClearScenes()
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
 	m_scenes.Clear();
-	m_loadedScenes.clear();
+	m_loadedScenes.Clear();
 }
 
-void SceneAssetManager::GetScenesInfo(sceneContainerType& outScenes, std::unordered_map<UUIDType, InternalSceneRefType>& outLoadedScenes)
+void SceneAssetManager::GetScenesInfo(sceneContainerType& outScenes, loadedSceneContainerType& outLoadedScenes)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
 	outScenes = std::move(m_scenes);
 	outLoadedScenes = std::move(m_loadedScenes);
 	m_scenes.Clear();
 	m_scenes.Reserve(maximumNumberOfLoadedScenes);
-	m_loadedScenes.clear();
+	m_loadedScenes.Clear();
 }
 
-void SceneAssetManager::SetScenesInfo(sceneContainerType&& scenes, std::unordered_map<UUIDType, InternalSceneRefType>&& loadedScenes)
+void SceneAssetManager::SetScenesInfo(sceneContainerType&& scenes, loadedSceneContainerType&& loadedScenes)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
 	std::vector<UUIDType> scenesToUnload;
-	scenesToUnload.reserve(loadedScenes.size());
-	for (auto& pair : m_loadedScenes)
-	{
-		if (loadedScenes.find(pair.first) == loadedScenes.end())
+	scenesToUnload.reserve(m_loadedScenes.Size());
+	m_loadedScenes.Iterate
+	(
+		[&](const UUIDType& uuid, InternalSceneRefType) -> bool
 		{
-			scenesToUnload.push_back(pair.first);
+			if (!loadedScenes.Contains(uuid))
+			{
+				scenesToUnload.push_back(uuid);
+			}
+			return false;
 		}
-	}
+	);
 	for (const UUIDType& uuid : scenesToUnload)
 	{
 		UnloadSceneNoBlock(uuid);
@@ -79,28 +83,44 @@ void SceneAssetManager::SetScenesInfo(sceneContainerType&& scenes, std::unordere
 	m_loadedScenes = std::move(loadedScenes);
 }
 
+SceneRef SceneAssetManager::LoadSceneCopy(const UUIDType& uuid, sceneContainerType& scenes, const loadedSceneContainerType& loadedScenes)
+{
+	auto* loadedRef(loadedScenes.Find(uuid));
+	if (loadedRef == nullptr)
+	{
+		return SceneRef();
+	}
+	// The refs of loadedScenes still refer to the container the scenes were taken from.
+	const InternalSceneRefType sourceRef(*loadedRef, scenes);
+	DASSERT_E(sourceRef.IsValid());
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	SceneRef scene(LoadScene(uuid, Scene(sourceRef->GetAsset().GetName())));
+	scene.CopyEntitiesFrom(SceneRef(sourceRef, m_lockData));
+	return scene;
+}
+
 void SceneAssetManager::RenameScene(const UUIDType& uuid, const stringType& name)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	auto it(m_loadedScenes.find(uuid));
-	DASSERT_E(it != m_loadedScenes.end());
-	it->second->GetAsset().SetName(name);
+	auto* loadedRef(m_loadedScenes.Find(uuid));
+	DASSERT_E(loadedRef != nullptr);
+	(*loadedRef)->GetAsset().SetName(name);
 }
 
 void SceneAssetManager::UnloadSceneNoBlock(const UUIDType& uuid)
 {
-	auto it(m_loadedScenes.find(uuid));
-	if (it == m_loadedScenes.end())
+	auto* loadedRef(m_loadedScenes.Find(uuid));
+	if (loadedRef == nullptr)
 	{
 		return;
 	}
-	if (it->second->GetReferenceCount() == 1)
+	if ((*loadedRef)->GetReferenceCount() == 1)
 	{
-		m_scenes.Remove(it->second);
-		m_loadedScenes.erase(uuid);
+		m_scenes.Remove(*loadedRef);
+		m_loadedScenes.Remove(uuid);
 		return;
 	}
-	it->second->SubReferenceCount();
+	(*loadedRef)->SubReferenceCount();
 }
 
 }
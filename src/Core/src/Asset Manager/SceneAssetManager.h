@@ -1,13 +1,13 @@
 #pragma once
 
 #include "UUID.h"
+#include "FlatHashMap.h"
 #include "Scene.h"
 #include "ReadWriteLockGuard.h"
 #include "AssetManagerTypes.h"
 
 #include <string>
 #include <thread>
-#include <unordered_map>
 #include <unordered_set>
 #include <mutex>
 
@@ -22,7 +22,7 @@ class SceneAssetManager
 	friend class ReadWriteLockGuard;
 public:
 	using sceneContainerType = AssetContainerType<Scene, SceneIdType, SceneVersionType>;
-	using loadedSceneContainerType = std::unordered_map<UUIDType, InternalSceneRefType>;
+	using loadedSceneContainerType = FlatHashMap<UUIDType, InternalSceneRefType>;
 	using stringType = std::string;
 public:
 	static constexpr size_t maximumNumberOfLoadedScenes{64};
@@ -34,8 +34,11 @@ public:
 	void UnloadScene(const UUIDType&);
 	SceneRef GetSceneRefFromSceneRefId(SceneIdType);	// Does not increase the reference count to the referenced scene.
 	void ClearScenes();
-	void GetScenesInfo(sceneContainerType& outScenes, std::unordered_map<UUIDType, InternalSceneRefType>& outLoadedScenes);
-	void SetScenesInfo(sceneContainerType&&, std::unordered_map<UUIDType, InternalSceneRefType>&&);
+	void GetScenesInfo(sceneContainerType& outScenes, loadedSceneContainerType& outLoadedScenes);
+	void SetScenesInfo(sceneContainerType&&, loadedSceneContainerType&&);
+	// Loads a copy of a scene taken out by GetScenesInfo, without reading it again from its file. The copy is a new
+	// scene: changing it doesn't change the one taken out. Returns an invalid ref if the scene is not in loadedScenes.
+	[[nodiscard]] SceneRef LoadSceneCopy(const UUIDType&, sceneContainerType& scenes, const loadedSceneContainerType& loadedScenes);
 	void RenameScene(const UUIDType& uuid, const stringType&);
 public:
 	template <class Func>
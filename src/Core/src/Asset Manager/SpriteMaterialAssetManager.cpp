@@ -10,33 +10,35 @@ namespace DCore
 
 SpriteMaterialAssetManager::~SpriteMaterialAssetManager()
 {
+	m_unloadedSpriteMaterials.clear();
 	m_spriteMaterials.Clear();
-	m_loadedSpriteMaterials.clear();
+	m_loadedSpriteMaterials.Clear();
 }
 
 bool SpriteMaterialAssetManager::IsSpriteMaterialLoaded(const UUIDType& uuid)
 {
-	return m_loadedSpriteMaterials.find(uuid) != m_loadedSpriteMaterials.end();
+	return m_loadedSpriteMaterials.Contains(uuid);
 }
 
 SpriteMaterialRef SpriteMaterialAssetManager::LoadSpriteMaterial(const UUIDType& uuid, SpriteMaterial&& spriteMaterial)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	if (m_loadedSpriteMaterials.find(uuid) != m_loadedSpriteMaterials.end())
+	if (m_loadedSpriteMaterials.Contains(uuid))
 	{
 		return GetSpriteMaterial(uuid);
 	}
 	InternalSpriteMaterialRefType internalRef(m_spriteMaterials.PushBack(uuid, std::move(spriteMaterial)));
-	m_loadedSpriteMaterials.insert({uuid, internalRef});
+	m_loadedSpriteMaterials.Insert(uuid, internalRef);
 	return SpriteMaterialRef(internalRef, m_lockData);
 }
 
 SpriteMaterialRef SpriteMaterialAssetManager::GetSpriteMaterial(const UUIDType& uuid)
 {
-	ReadWriteLockGuard spriteMaterialGuard(LockType::WriteLock, m_lockData);
-	DASSERT_E(m_loadedSpriteMaterials.find(uuid) != m_loadedSpriteMaterials.end());
-	InternalSpriteMaterialRefType internalRef(m_loadedSpriteMaterials.find(uuid)->second);
-	ReadWriteLockGuard textureGuard(LockType::WriteLock, *static_cast<Texture2DAssetManager*>(&AssetManager::Get()));
+	// The reference counts are atomic, so the read locks are enough.
+	ReadWriteLockGuard spriteMaterialGuard(LockType::ReadLock, m_lockData);
+	DASSERT_E(m_loadedSpriteMaterials.Contains(uuid));
+	InternalSpriteMaterialRefType internalRef(*m_loadedSpriteMaterials.Find(uuid));
+	ReadWriteLockGuard textureGuard(LockType::ReadLock, *static_cast<Texture2DAssetManager*>(&AssetManager::Get()));
 	internalRef->AddReferenceCount();
 	if (internalRef->GetAsset().GetDiffuseMapRef().IsValid())
 	{
@@ -53,31 +55,61 @@ SpriteMaterialRef SpriteMaterialAssetManager::GetSpriteMaterial(const UUIDType&
 	return SpriteMaterialRef(internalRef, m_lockData);
 }
 
+bool SpriteMaterialAssetManager::ReloadSpriteMaterial(const UUIDType& uuid, SpriteMaterial&& spriteMaterial)
+{
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	auto* loadedRef(m_loadedSpriteMaterials.Find(uuid));
+	SpriteMaterial releasedSpriteMaterial(std::move(spriteMaterial));
+	if (loadedRef != nullptr)
+	{
+		std::swap(releasedSpriteMaterial, (*loadedRef)->GetAsset());
+	}
+	constexpr uint8_t numberOfTextures(3);
+	Texture2DRef textures[numberOfTextures]{
+		releasedSpriteMaterial.GetDiffuseMapRef(), 
+		releasedSpriteMaterial.GetAmbientMapRef(), 
+		releasedSpriteMaterial.GetSpecularMapRef()};  
+	for (uint8_t i(0); i < numberOfTextures; i++)
+	{
+		textures[i].Unload();
+	}
+	return loadedRef != nullptr;
+}
+
 void SpriteMaterialAssetManager::UnloadSpriteMaterial(const UUIDType& uuid, bool removeAllReferences)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	auto it(m_loadedSpriteMaterials.find(uuid));
-	if (it == m_loadedSpriteMaterials.end())
+	auto* loadedRef(m_loadedSpriteMaterials.Find(uuid));
+	if (loadedRef == nullptr)
 	{
 		return;
 	}
-	InternalSpriteMaterialRefType internalRef(it->second);
-	if (internalRef->m_referenceCount == 1 || removeAllReferences)
+	InternalSpriteMaterialRefType internalRef(*loadedRef);
+	if (!removeAllReferences && internalRef->SubReferenceCount() != 0)
 	{
-		m_loadedSpriteMaterials.erase(uuid);
-		constexpr uint8_t numberOfTextures(3);
-		Texture2DRef textures[numberOfTextures]{
-			internalRef->GetAsset().GetDiffuseMapRef(), 
-			internalRef->GetAsset().GetAmbientMapRef(), 
-			internalRef->GetAsset().GetSpecularMapRef()};  
-		for (uint8_t i(0); i < numberOfTextures; i++)
-		{
-			textures[i].Unload();
-		}
-		m_spriteMaterials.Remove(internalRef);
 		return;
 	}
-	internalRef->SubReferenceCount();
+	m_loadedSpriteMaterials.Remove(uuid);
+	constexpr uint8_t numberOfTextures(3);
+	Texture2DRef textures[numberOfTextures]{
+		internalRef->GetAsset().GetDiffuseMapRef(), 
+		internalRef->GetAsset().GetAmbientMapRef(), 
+		internalRef->GetAsset().GetSpecularMapRef()};  
+	for (uint8_t i(0); i < numberOfTextures; i++)
+	{
+		textures[i].Unload();
+	}
+	m_unloadedSpriteMaterials.push_back(internalRef);
+}
+
+void SpriteMaterialAssetManager::DestroyUnloadedSpriteMaterials()
+{
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	for (InternalSpriteMaterialRefType& internalRef : m_unloadedSpriteMaterials)
+	{
+		m_spriteMaterials.Remove(internalRef);
+	}
+	m_unloadedSpriteMaterials.clear();
 }
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UUID.h"
+#include "FlatHashMap.h"
 #include "SpriteMaterial.h"
 #include "ReadWriteLockGuard.h"
 #include "AssetManagerTypes.h"
@@ -8,6 +9,7 @@
 #include <thread>
 #include <unordered_set>
 #include <mutex>
+#include <vector>
 
 
 
@@ -19,19 +21,27 @@ class SpriteMaterialAssetManager
 	friend class ReadWriteLockGuard;
 public:
 	using spriteMaterialContainerType = AssetContainerType<SpriteMaterial>;
-	using loadedSpriteMaterialContainerType = std::unordered_map<UUIDType, InternalSpriteMaterialRefType>;
+	using loadedSpriteMaterialContainerType = FlatHashMap<UUIDType, InternalSpriteMaterialRefType>;
+	using unloadedSpriteMaterialContainerType = std::vector<InternalSpriteMaterialRefType>;
 public:
 	virtual ~SpriteMaterialAssetManager();
 public:	
 	bool IsSpriteMaterialLoaded(const UUIDType&);
 	[[nodiscard]] SpriteMaterialRef LoadSpriteMaterial(const UUIDType&, SpriteMaterial&&);
 	[[nodiscard]] SpriteMaterialRef GetSpriteMaterial(const UUIDType&);
+	// Replaces the loaded sprite material in place, so its refs draw with the new one. The maps of the previous one
+	// are released as when it is unloaded. False, releasing the maps of the new one, if it is not loaded.
+	bool ReloadSpriteMaterial(const UUIDType&, SpriteMaterial&&);
+	// The sprite material is destroyed by DestroyUnloadedSpriteMaterials, so its refs stay valid until then.
 	void UnloadSpriteMaterial(const UUIDType&, bool removeAllReferences = false);
+	// To be called where no ref to an unloaded sprite material is in use, as between frames.
+	void DestroyUnloadedSpriteMaterials();
 protected:
 	SpriteMaterialAssetManager() = default;
 private:
 	spriteMaterialContainerType m_spriteMaterials;
 	loadedSpriteMaterialContainerType m_loadedSpriteMaterials;
+	unloadedSpriteMaterialContainerType m_unloadedSpriteMaterials;
 	LockData m_lockData;
 private:
 	LockData& GetLockData()
@@ -1,70 +1,323 @@
 #include "Texture2DAssetManager.h"
+#include "CookedTexture2D.h"
 #include "Graphics.h"
 #include "RendererTypes.h"
 #include "Timer.h"
 
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
 
 
 namespace DCore 
 {
 
+Texture2DAssetManager::Texture2DAssetManager()
+	:
+	m_residentTexture2DBytes(0),
+	m_residencyBudget(defaultResidencyBudget),
+	m_residentBytesCounter(ProfilingStats::Get().GetCounter("Assets/Texture 2D/Resident Bytes")),
+	m_cacheHitsCounter(ProfilingStats::Get().GetCounter("Assets/Texture 2D/Cache Hits")),
+	m_cacheMissesCounter(ProfilingStats::Get().GetCounter("Assets/Texture 2D/Cache Misses")),
+	m_evictionsCounter(ProfilingStats::Get().GetCounter("Assets/Texture 2D/Evictions"))
+{}
+
 Texture2DAssetManager::~Texture2DAssetManager()
 {
+	for (PendingUpload& pendingUpload : m_pendingUploads)
+	{
+		FreePendingUpload(pendingUpload);
+	}
+	m_pendingUploads.clear();
+	m_unloadedTextures2D.clear();
+	m_cachedTextures2D.clear();
+	m_cachedTexture2DIterators.Clear();
 	m_textures.Clear();
-	m_loadedTextures2D.clear();
+	m_loadedTextures2D.Clear();
 }
 
 bool Texture2DAssetManager::IsTexture2DLoaded(const UUIDType& uuid)
 {
-	return m_loadedTextures2D.find(uuid) != m_loadedTextures2D.end();
+	return m_loadedTextures2D.Contains(uuid);
 }
 
 Texture2DRef Texture2DAssetManager::LoadTexture2D(const UUIDType& uuid, unsigned char* binary, const DVec2& sizes, int numberChannels, Texture2DMetadata metadata)
 {
-	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	DASSERT_E(m_loadedTextures2D.find(uuid) == m_loadedTextures2D.end());
+	// The GL texture doesn't depend on the registry, so it is created before taking the lock.
 	Texture2D texture2D(GenerateTexture2D(binary, sizes, numberChannels, metadata));
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	DASSERT_E(!m_loadedTextures2D.Contains(uuid));
+	AddResidentTexture2D(sizes, numberChannels);
 	InternalTexture2DRefType internalRef(m_textures.PushBack(uuid, std::move(texture2D)));
-	m_loadedTextures2D.insert({uuid, internalRef});
+	m_loadedTextures2D.Insert(uuid, internalRef);
+	return Texture2DRef(internalRef, m_lockData);
+}
+
+Texture2DRef Texture2DAssetManager::LoadTexture2DDeferred(const UUIDType& uuid, unsigned char* binary, const DVec2& sizes, int numberChannels, Texture2DMetadata metadata, binaryDeleterType binaryDeleter)
+{
+	DASSERT_E(binary != nullptr && binaryDeleter != nullptr);
+	InternalTexture2DRefType internalRef;
+	{
+		ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+		DASSERT_E(!m_loadedTextures2D.Contains(uuid));
+		AddResidentTexture2D(sizes, numberChannels);
+		internalRef = m_textures.PushBack(uuid, Texture2D(0, sizes, numberChannels, metadata));
+		m_loadedTextures2D.Insert(uuid, internalRef);
+	}
+	{
+		lockGuardType guard(m_pendingUploadsMutex);
+		m_pendingUploads.push_back({internalRef, binary, binaryDeleter, nullptr, 0, MappedFile()});
+	}
 	return Texture2DRef(internalRef, m_lockData);
 }
 
+Texture2DRef Texture2DAssetManager::LoadTexture2DDeferred(const UUIDType& uuid, MappedFile&& cookedTexture2D, Texture2DMetadata metadata)
+{
+	DASSERT_E(cookedTexture2D.IsOpen());
+	// The mapping doesn't move with the file, so its data can be queued with it.
+	const char* data(cookedTexture2D.GetData());
+	const size_t size(cookedTexture2D.GetSize());
+	return LoadCookedTexture2DDeferred(uuid, data, size, std::move(cookedTexture2D), metadata);
+}
+
+Texture2DRef Texture2DAssetManager::LoadTexture2DDeferred(const UUIDType& uuid, const char* cookedTexture2D, size_t cookedTexture2DSize, Texture2DMetadata metadata)
+{
+	return LoadCookedTexture2DDeferred(uuid, cookedTexture2D, cookedTexture2DSize, MappedFile(), metadata);
+}
+
+bool Texture2DAssetManager::IsCookedTexture2DValid(const char* cookedTexture2D, size_t cookedTexture2DSize)
+{
+	if (cookedTexture2D == nullptr || cookedTexture2DSize < sizeof(CookedTexture2D::Header) ||
+		reinterpret_cast<uintptr_t>(cookedTexture2D) % alignof(CookedTexture2D::Header) != 0)
+	{
+		return false;
+	}
+	const CookedTexture2D::Header& header(*reinterpret_cast<const CookedTexture2D::Header*>(cookedTexture2D));
+	if (header.Magic != CookedTexture2D::magic || header.Version != CookedTexture2D::version ||
+		header.NumberOfChannels == 0 || header.NumberOfChannels > 4 ||
+		header.NumberOfMipLevels == 0 || header.NumberOfMipLevels > CookedTexture2D::maximumNumberOfMipLevels ||
+		cookedTexture2DSize < sizeof(CookedTexture2D::Header) + header.NumberOfMipLevels * sizeof(CookedTexture2D::MipLevelEntry))
+	{
+		return false;
+	}
+	const CookedTexture2D::MipLevelEntry* mipLevelEntries(reinterpret_cast<const CookedTexture2D::MipLevelEntry*>(cookedTexture2D + sizeof(CookedTexture2D::Header)));
+	for (uint32_t level(0); level < header.NumberOfMipLevels; level++)
+	{
+		const CookedTexture2D::MipLevelEntry& mipLevelEntry(mipLevelEntries[level]);
+		if (mipLevelEntry.Size != static_cast<uint64_t>(mipLevelEntry.Width) * mipLevelEntry.Height * header.NumberOfChannels ||
+			mipLevelEntry.Offset > cookedTexture2DSize || mipLevelEntry.Size > cookedTexture2DSize - mipLevelEntry.Offset)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 Texture2D Texture2DAssetManager::LoadRawTexture2D(unsigned char* binary, const DVec2& size, int numberChannels, Texture2DMetadata metadata)
 {
 	return GenerateTexture2D(binary, size, numberChannels, metadata);
 }
 
+bool Texture2DAssetManager::ReloadTexture2D(const UUIDType& uuid, MappedFile&& cookedTexture2D)
+{
+	DASSERT_E(cookedTexture2D.IsOpen() && IsCookedTexture2DValid(cookedTexture2D.GetData(), cookedTexture2D.GetSize()));
+	InternalTexture2DRefType internalRef;
+	{
+		ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);
+		const InternalTexture2DRefType* loadedRef(m_loadedTextures2D.Find(uuid));
+		if (loadedRef == nullptr)
+		{
+			return false;
+		}
+		internalRef = *loadedRef;
+	}
+	const char* data(cookedTexture2D.GetData());
+	const size_t size(cookedTexture2D.GetSize());
+	lockGuardType guard(m_pendingUploadsMutex);
+	m_pendingUploads.push_back({internalRef, nullptr, nullptr, data, size, std::move(cookedTexture2D)});
+	return true;
+}
+
 Texture2DRef Texture2DAssetManager::GetTexture2DRef(const UUIDType& uuid)
 {
-	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	DASSERT_E(m_loadedTextures2D.find(uuid) != m_loadedTextures2D.end());
-	InternalTexture2DRefType internalRef(m_loadedTextures2D.find(uuid)->second);
-	internalRef->AddReferenceCount();
+	ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);
+	DASSERT_E(m_loadedTextures2D.Contains(uuid));
+	InternalTexture2DRefType internalRef(*m_loadedTextures2D.Find(uuid));
+	{
+		// References are only released under the write lock, so a texture with none is cached until it is taken out
+		// here.
+		lockGuardType cacheGuard(m_cachedTextures2DMutex);
+		if (internalRef->GetReferenceCount() == 0)
+		{
+			cachedTexture2DIteratorContainerType::valueType* cachedIterator(m_cachedTexture2DIterators.Find(uuid));
+			DASSERT_E(cachedIterator != nullptr);
+			m_cachedTextures2D.erase(*cachedIterator);
+			m_cachedTexture2DIterators.Remove(uuid);
+			m_cacheHitsCounter.fetch_add(1, std::memory_order_relaxed);
+		}
+		internalRef->AddReferenceCount();
+	}
 	return Texture2DRef(internalRef, m_lockData);
 }
 
 void Texture2DAssetManager::UnloadTexture2D(const UUIDType& uuid, bool removeAllReferences)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
-	auto it(m_loadedTextures2D.find(uuid));
-	if (it == m_loadedTextures2D.end())
+	auto* loadedRef(m_loadedTextures2D.Find(uuid));
+	if (loadedRef == nullptr)
 	{
 		return;
 	}
-	InternalTexture2DRefType internalRef(it->second);
-	if (internalRef->m_referenceCount == 1 || removeAllReferences)
+	InternalTexture2DRefType internalRef(*loadedRef);
+	if (!removeAllReferences)
 	{
-		m_loadedTextures2D.erase(uuid);
-		m_textures.Remove(internalRef);
+		// A cached texture has no reference to release.
+		if (internalRef->GetReferenceCount() == 0 || internalRef->SubReferenceCount() != 0)
+		{
+			return;
+		}
+		m_cachedTextures2D.push_back(uuid);
+		m_cachedTexture2DIterators.Insert(uuid, std::prev(m_cachedTextures2D.end()));
+		EvictCachedTextures2D();
 		return;
 	}
-	internalRef->SubReferenceCount();
+	cachedTexture2DIteratorContainerType::valueType* cachedIterator(m_cachedTexture2DIterators.Find(uuid));
+	if (cachedIterator != nullptr)
+	{
+		m_cachedTextures2D.erase(*cachedIterator);
+		m_cachedTexture2DIterators.Remove(uuid);
+	}
+	RemoveResidentTexture2D(uuid, internalRef);
+}
+
+void Texture2DAssetManager::SetTexture2DResidencyBudget(size_t bytes)
+{
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	m_residencyBudget = bytes;
+	EvictCachedTextures2D();
+}
+
+size_t Texture2DAssetManager::GetTexture2DResidencyBudget()
+{
+	ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);
+	return m_residencyBudget;
+}
+
+void Texture2DAssetManager::DestroyUnloadedTextures2D()
+{
+	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+	for (InternalTexture2DRefType& internalRef : m_unloadedTextures2D)
+	{
+		{
+			// The slot only destroys the texture when it is reused, maybe by another thread, so the GL texture is
+			// deleted here.
+			Texture2D texture2D(std::move(internalRef->GetAsset()));
+		}
+		m_textures.Remove(internalRef);
+	}
+	m_unloadedTextures2D.clear();
+}
+
+void Texture2DAssetManager::UploadPendingTextures2D(uint64_t budgetMicroseconds)
+{
+	using clockType = std::chrono::steady_clock;
+	const clockType::time_point deadline(clockType::now() + std::chrono::microseconds(budgetMicroseconds));
+	do
+	{
+		PendingUpload pendingUpload;
+		{
+			lockGuardType guard(m_pendingUploadsMutex);
+			if (m_pendingUploads.empty())
+			{
+				return;
+			}
+			pendingUpload = std::move(m_pendingUploads.front());
+			m_pendingUploads.pop_front();
+		}
+		DVec2 sizes;
+		int numberChannels(0);
+		Texture2DMetadata metadata;
+		{
+			ReadWriteLockGuard guard(LockType::ReadLock, m_lockData);
+			// The texture may have been unloaded while it waited.
+			if (!pendingUpload.Ref.IsValid())
+			{
+				FreePendingUpload(pendingUpload);
+				continue;
+			}
+			const Texture2D& texture2D(pendingUpload.Ref->GetAsset());
+			sizes = texture2D.GetDimensions();
+			numberChannels = texture2D.GetNumberOfChannels();
+			metadata = texture2D.GetMetadata();
+		}
+		Texture2D uploadedTexture2D
+		(
+			pendingUpload.CookedBinary != nullptr ?
+			GenerateCookedTexture2D(pendingUpload.CookedBinary, pendingUpload.CookedBinarySize, metadata) :
+			GenerateTexture2D(pendingUpload.Binary, sizes, numberChannels, metadata)
+		);
+		FreePendingUpload(pendingUpload);
+		ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+		if (pendingUpload.Ref.IsValid())
+		{
+			// The filter may have been changed during the upload.
+			if (pendingUpload.Ref->GetAsset().GetFilter() != metadata.GetFilterMethod())
+			{
+				uploadedTexture2D.SetFilter(pendingUpload.Ref->GetAsset().GetFilter());
+			}
+			// A reloaded texture replaces an uploaded one, maybe of another size.
+			const InternalTexture2DRefType* loadedRef(m_loadedTextures2D.Find(pendingUpload.Ref->GetUUID()));
+			if (loadedRef != nullptr && *loadedRef == pendingUpload.Ref)
+			{
+				m_residentTexture2DBytes -= GetTexture2DMemorySize(sizes, numberChannels);
+				m_residentTexture2DBytes += GetTexture2DMemorySize(uploadedTexture2D.GetDimensions(), uploadedTexture2D.GetNumberOfChannels());
+				m_residentBytesCounter.store(static_cast<int64_t>(m_residentTexture2DBytes), std::memory_order_relaxed);
+			}
+			Texture2D previousTexture2D(std::move(pendingUpload.Ref->GetAsset()));
+			pendingUpload.Ref->GetAsset() = std::move(uploadedTexture2D);
+		}
+	} while (clockType::now() < deadline);
+}
+
+size_t Texture2DAssetManager::GetNumberOfPendingTextures2D()
+{
+	lockGuardType guard(m_pendingUploadsMutex);
+	return m_pendingUploads.size();
+}
+
+Texture2DRef Texture2DAssetManager::LoadCookedTexture2DDeferred(const UUIDType& uuid, const char* cookedTexture2D, size_t cookedTexture2DSize, MappedFile&& cookedFile, Texture2DMetadata metadata)
+{
+	DASSERT_E(IsCookedTexture2DValid(cookedTexture2D, cookedTexture2DSize));
+	const CookedTexture2D::Header& header(*reinterpret_cast<const CookedTexture2D::Header*>(cookedTexture2D));
+	const DVec2 sizes(header.Width, header.Height);
+	const int numberChannels(static_cast<int>(header.NumberOfChannels));
+	InternalTexture2DRefType internalRef;
+	{
+		ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
+		DASSERT_E(!m_loadedTextures2D.Contains(uuid));
+		AddResidentTexture2D(sizes, numberChannels);
+		internalRef = m_textures.PushBack(uuid, Texture2D(0, sizes, numberChannels, metadata));
+		m_loadedTextures2D.Insert(uuid, internalRef);
+	}
+	{
+		lockGuardType guard(m_pendingUploadsMutex);
+		m_pendingUploads.push_back({internalRef, nullptr, nullptr, cookedTexture2D, cookedTexture2DSize, std::move(cookedFile)});
+	}
+	return Texture2DRef(internalRef, m_lockData);
 }
 
 Texture2D Texture2DAssetManager::GenerateTexture2D(unsigned char* binary, const DVec2& sizes, int numberChannels, Texture2DMetadata metadata)
+{
+	const MipLevel mipLevel{binary, sizes};
+	return GenerateTexture2D(&mipLevel, 1, numberChannels, metadata);
+}
+
+Texture2D Texture2DAssetManager::GenerateTexture2D(const MipLevel* mipLevels, size_t numberOfMipLevels, int numberChannels, Texture2DMetadata metadata)
 {
 	//Timer<std::chrono::milliseconds> timer("Load texture");
 	//std::cout << "Sizes: " << sizes.x << ", " << sizes.y << std::endl;
+	DASSERT_E(numberOfMipLevels > 0);
 	unsigned int id(0);
 	glGenTextures(1, &id); CHECK_GL_ERROR;
 	glBindTexture(GL_TEXTURE_2D, id); CHECK_GL_ERROR;
@@ -86,27 +339,107 @@ Texture2D Texture2DAssetManager::GenerateTexture2D(unsigned char* binary, const
 		break;
 	}
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); CHECK_GL_ERROR;
+	GLenum format(GL_RGBA);
 	switch (numberChannels)
 	{
 	case 1:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, sizes.x, sizes.y, 0, GL_RED, GL_UNSIGNED_BYTE, binary); CHECK_GL_ERROR;
+		format = GL_RED;
 		break;
 	case 2:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG, sizes.x, sizes.y, 0, GL_RG, GL_UNSIGNED_BYTE, binary); CHECK_GL_ERROR;
+		format = GL_RG;
 		break;
 	case 3:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, sizes.x, sizes.y, 0, GL_RGB, GL_UNSIGNED_BYTE, binary); CHECK_GL_ERROR;
+		format = GL_RGB;
 		break;
 	case 4:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, sizes.x, sizes.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, binary); CHECK_GL_ERROR;
+		format = GL_RGBA;
 		break;
 	default:
 		assert(false);
 		break;
 	}
-	glGenerateMipmap(GL_TEXTURE_2D); CHECK_GL_ERROR;
+	// The rows of the smaller levels are not 4 bytes aligned.
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1); CHECK_GL_ERROR;
+	for (size_t level(0); level < numberOfMipLevels; level++)
+	{
+		const MipLevel& mipLevel(mipLevels[level]);
+		glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format, mipLevel.Sizes.x, mipLevel.Sizes.y, 0, format, GL_UNSIGNED_BYTE, mipLevel.Binary); CHECK_GL_ERROR;
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4); CHECK_GL_ERROR;
+	if (numberOfMipLevels == 1)
+	{
+		glGenerateMipmap(GL_TEXTURE_2D); CHECK_GL_ERROR;
+	}
+	else
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(numberOfMipLevels - 1)); CHECK_GL_ERROR;
+	}
 	//glFinish(); CHECK_GL_ERROR;
-	return Texture2D(id, sizes, numberChannels, metadata);
+	return Texture2D(id, mipLevels[0].Sizes, numberChannels, metadata);
+}
+
+Texture2D Texture2DAssetManager::GenerateCookedTexture2D(const char* cookedTexture2D, size_t cookedTexture2DSize, Texture2DMetadata metadata)
+{
+	const unsigned char* data(reinterpret_cast<const unsigned char*>(cookedTexture2D));
+	const CookedTexture2D::Header& header(*reinterpret_cast<const CookedTexture2D::Header*>(data));
+	DASSERT_E(header.NumberOfMipLevels > 0 && header.NumberOfMipLevels <= CookedTexture2D::maximumNumberOfMipLevels);
+	const CookedTexture2D::MipLevelEntry* mipLevelEntries(reinterpret_cast<const CookedTexture2D::MipLevelEntry*>(data + sizeof(CookedTexture2D::Header)));
+	MipLevel mipLevels[CookedTexture2D::maximumNumberOfMipLevels];
+	for (uint32_t level(0); level < header.NumberOfMipLevels; level++)
+	{
+		const CookedTexture2D::MipLevelEntry& mipLevelEntry(mipLevelEntries[level]);
+		DASSERT_E(mipLevelEntry.Offset + mipLevelEntry.Size <= cookedTexture2DSize);
+		mipLevels[level] = {data + mipLevelEntry.Offset, DVec2(mipLevelEntry.Width, mipLevelEntry.Height)};
+	}
+	return GenerateTexture2D(mipLevels, header.NumberOfMipLevels, static_cast<int>(header.NumberOfChannels), metadata);
+}
+
+void Texture2DAssetManager::AddResidentTexture2D(const DVec2& sizes, int numberChannels)
+{
+	m_residentTexture2DBytes += GetTexture2DMemorySize(sizes, numberChannels);
+	m_residentBytesCounter.store(static_cast<int64_t>(m_residentTexture2DBytes), std::memory_order_relaxed);
+	// Every texture loaded is one found neither loaded nor cached.
+	m_cacheMissesCounter.fetch_add(1, std::memory_order_relaxed);
+	EvictCachedTextures2D();
+}
+
+void Texture2DAssetManager::RemoveResidentTexture2D(const UUIDType& uuid, InternalTexture2DRefType internalRef)
+{
+	const Texture2D& texture2D(internalRef->GetAsset());
+	m_residentTexture2DBytes -= GetTexture2DMemorySize(texture2D.GetDimensions(), texture2D.GetNumberOfChannels());
+	m_residentBytesCounter.store(static_cast<int64_t>(m_residentTexture2DBytes), std::memory_order_relaxed);
+	m_loadedTextures2D.Remove(uuid);
+	m_unloadedTextures2D.push_back(internalRef);
+}
+
+void Texture2DAssetManager::EvictCachedTextures2D()
+{
+	while (m_residentTexture2DBytes > m_residencyBudget && !m_cachedTextures2D.empty())
+	{
+		const UUIDType uuid(m_cachedTextures2D.front());
+		m_cachedTextures2D.pop_front();
+		m_cachedTexture2DIterators.Remove(uuid);
+		RemoveResidentTexture2D(uuid, *m_loadedTextures2D.Find(uuid));
+		m_evictionsCounter.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+size_t Texture2DAssetManager::GetTexture2DMemorySize(const DVec2& sizes, int numberChannels)
+{
+	// The mip levels take a third of the full size level.
+	const size_t fullSize(static_cast<size_t>(sizes.x) * static_cast<size_t>(sizes.y) * static_cast<size_t>(numberChannels));
+	return fullSize + fullSize / 3;
+}
+
+void Texture2DAssetManager::FreePendingUpload(PendingUpload& pendingUpload)
+{
+	if (pendingUpload.Binary != nullptr)
+	{
+		pendingUpload.BinaryDeleter(pendingUpload.Binary);
+		pendingUpload.Binary = nullptr;
+	}
+	pendingUpload.CookedBinary = nullptr;
+	pendingUpload.CookedFile.Close();
 }
 
 }
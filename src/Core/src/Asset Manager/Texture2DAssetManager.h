@@ -3,11 +3,18 @@
 #include "AssetManagerTypes.h"
 #include "ReadWriteLockGuard.h"
 #include "UUID.h"
+#include "FlatHashMap.h"
+#include "MappedFile.h"
+#include "ProfilingStats.h"
 #include "Texture2D.h"
 
+#include <cstdint>
+#include <deque>
+#include <list>
 #include <unordered_set>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 
 
@@ -19,23 +26,114 @@ class Texture2DAssetManager
 	friend class ReadWriteLockGuard;
 public:
 	using texture2DContainerType = AssetContainerType<Texture2D>;
-	using loadedTexture2DContainerType = std::unordered_map<UUIDType, InternalTexture2DRefType>;
+	using loadedTexture2DContainerType = FlatHashMap<UUIDType, InternalTexture2DRefType>;
+	using unloadedTexture2DContainerType = std::vector<InternalTexture2DRefType>;
+	using binaryDeleterType = void(*)(void*);
+	using counterType = ProfilingStats::counterType;
+public:
+	// Microseconds.
+	static constexpr uint64_t defaultUploadBudget{2000};
+	// Bytes.
+	static constexpr size_t defaultResidencyBudget{size_t(256) << 20};
 public:
 	virtual ~Texture2DAssetManager();
 public:
 	bool IsTexture2DLoaded(const UUIDType&);
 	[[nodiscard]] Texture2DRef LoadTexture2D(const UUIDType& uuid, unsigned char* binary, const DVec2& size, int numberChannels, Texture2DMetadata metadata = Texture2DMetadata());
+	// Registers the texture without creating its GL texture, which is queued to be created by UploadPendingTextures2D.
+	// Until then the id of the texture is 0. binary is freed with binaryDeleter after the upload.
+	[[nodiscard]] Texture2DRef LoadTexture2DDeferred(const UUIDType& uuid, unsigned char* binary, const DVec2& size, int numberChannels, Texture2DMetadata metadata, binaryDeleterType binaryDeleter);
+	// Same as above, from a cooked texture (see CookedTexture2D.h), whose mip levels are uploaded as they are. The
+	// file is kept mapped until the upload.
+	[[nodiscard]] Texture2DRef LoadTexture2DDeferred(const UUIDType& uuid, MappedFile&& cookedTexture2D, Texture2DMetadata metadata);
+	// Same as above, from a cooked texture in memory that must stay valid until the upload, as the payloads of an
+	// open asset pack.
+	[[nodiscard]] Texture2DRef LoadTexture2DDeferred(const UUIDType& uuid, const char* cookedTexture2D, size_t cookedTexture2DSize, Texture2DMetadata metadata);
+	// If a cooked texture is well formed, with its mip level table and pixels inside it. The cooked textures loaded
+	// must be.
+	static bool IsCookedTexture2DValid(const char* cookedTexture2D, size_t cookedTexture2DSize);
 	[[nodiscard]] Texture2D LoadRawTexture2D(unsigned char* binary, const DVec2& size, int numberChannels, Texture2DMetadata metadata = Texture2DMetadata());
+	// Replaces the loaded texture in place with a cooked one, keeping its refs and metadata. The previous GL texture
+	// is drawn until the new one is created by UploadPendingTextures2D. False if the texture is not loaded.
+	bool ReloadTexture2D(const UUIDType& uuid, MappedFile&& cookedTexture2D);
+	// A texture with no references left is still loaded while it is cached, in which case the ref returned is a cache
+	// hit.
 	[[nodiscard]] Texture2DRef GetTexture2DRef(const UUIDType&);
+	// A texture whose last reference is released is cached, to be evicted, least recently released first, when the
+	// resident textures take more than the residency budget. With removeAllReferences it is unloaded right away.
+	// Either way the texture is destroyed by DestroyUnloadedTextures2D, so its refs stay valid until then.
 	void UnloadTexture2D(const UUIDType&, bool removeAllReferences = false);
+	// Evicts the cached textures right away if the resident ones take more than the new budget. 0 disables the cache.
+	void SetTexture2DResidencyBudget(size_t bytes);
+	size_t GetTexture2DResidencyBudget();
+	// To be called by the thread of the main GL context, where no ref to an unloaded texture is in use, as between
+	// frames.
+	void DestroyUnloadedTextures2D();
+	// To be called once per frame by the thread of the main GL context. Creates the GL textures of the textures
+	// loaded deferred, and generates the mipmaps of the ones not cooked, until the budget is spent, at least one
+	// texture per call.
+	void UploadPendingTextures2D(uint64_t budgetMicroseconds = defaultUploadBudget);
+	size_t GetNumberOfPendingTextures2D();
 protected:
-	Texture2DAssetManager() = default;
+	Texture2DAssetManager();
+private:
+	// Either Binary or CookedBinary holds the pixels. CookedFile is open if the cooked texture is mapped only for
+	// the upload.
+	struct PendingUpload
+	{
+		InternalTexture2DRefType Ref;
+		unsigned char* Binary;
+		binaryDeleterType BinaryDeleter;
+		const char* CookedBinary;
+		size_t CookedBinarySize;
+		MappedFile CookedFile;
+	};
+
+	struct MipLevel
+	{
+		const unsigned char* Binary;
+		DVec2 Sizes;
+	};
+private:
+	using pendingUploadContainerType = std::deque<PendingUpload>;
+	// Least recently released first.
+	using cachedTexture2DContainerType = std::list<UUIDType>;
+	using cachedTexture2DIteratorContainerType = FlatHashMap<UUIDType, cachedTexture2DContainerType::iterator>;
+	using mutexType = std::mutex;
+	using lockGuardType = std::lock_guard<mutexType>;
 private:
 	texture2DContainerType m_textures;
 	loadedTexture2DContainerType m_loadedTextures2D;
+	unloadedTexture2DContainerType m_unloadedTextures2D;
 	LockData m_lockData;
+	pendingUploadContainerType m_pendingUploads;
+	mutexType m_pendingUploadsMutex;
+	// Changed under the write lock, or under the read lock with the cache mutex, as by GetTexture2DRef.
+	cachedTexture2DContainerType m_cachedTextures2D;
+	cachedTexture2DIteratorContainerType m_cachedTexture2DIterators;
+	mutexType m_cachedTextures2DMutex;
+	// Changed under the write lock. The textures pending destruction are not counted as resident.
+	size_t m_residentTexture2DBytes;
+	size_t m_residencyBudget;
+	counterType& m_residentBytesCounter;
+	counterType& m_cacheHitsCounter;
+	counterType& m_cacheMissesCounter;
+	counterType& m_evictionsCounter;
 private:
 	Texture2D GenerateTexture2D(unsigned char* binary, const DVec2& size, int numberChannels, Texture2DMetadata metadata = Texture2DMetadata());
+	// The mipmaps are generated if there is only one level.
+	Texture2D GenerateTexture2D(const MipLevel* mipLevels, size_t numberOfMipLevels, int numberChannels, Texture2DMetadata metadata);
+	Texture2D GenerateCookedTexture2D(const char* cookedTexture2D, size_t cookedTexture2DSize, Texture2DMetadata metadata);
+	Texture2DRef LoadCookedTexture2DDeferred(const UUIDType& uuid, const char* cookedTexture2D, size_t cookedTexture2DSize, MappedFile&& cookedFile, Texture2DMetadata metadata);
+	void FreePendingUpload(PendingUpload&);
+	// To be called under the write lock.
+	void AddResidentTexture2D(const DVec2& sizes, int numberChannels);
+	// Unloads the texture, to be destroyed by DestroyUnloadedTextures2D.
+	void RemoveResidentTexture2D(const UUIDType&, InternalTexture2DRefType);
+	void EvictCachedTextures2D();
+private:
+	// Including the mip levels.
+	static size_t GetTexture2DMemorySize(const DVec2& sizes, int numberChannels);
 private:
 	LockData& GetLockData()
 	{
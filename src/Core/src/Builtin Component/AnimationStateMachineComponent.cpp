@@ -11,13 +11,19 @@ namespace DCore
 
 AnimationStateMachineComponent::AnimationStateMachineComponent(const ConstructorArgs<AnimationStateMachineComponent>& args)
 	:
-	m_animationStateMachine(args.AnimationStateMachine)
-{}
+	m_animationStateMachine(args.AnimationStateMachine),
+	m_areAnimationEventListenersSetup(false)
+{
+	Setup();
+}
 
 AnimationStateMachineComponent::AnimationStateMachineComponent(DAnimationStateMachine animationStateMachine)
 	:
-	m_animationStateMachine(animationStateMachine)
-{}
+	m_animationStateMachine(animationStateMachine),
+	m_areAnimationEventListenersSetup(false)
+{
+	Setup();
+}
 
 AnimationStateMachineComponent::~AnimationStateMachineComponent()
 {
@@ -26,32 +32,59 @@ AnimationStateMachineComponent::~AnimationStateMachineComponent()
 
 void AnimationStateMachineComponent::Setup()
 {
-	m_animationStateMachine.Setup();
+	if (m_animationStateMachine.IsValid())
+	{
+		m_animationStateMachine.SetupInstance(m_instance);
+	}
 }
 
-void AnimationStateMachineComponent::Tick(float deltaTime)
+void AnimationStateMachineComponent::SetupAnimationEventListeners(EntityRef entity)
 {
-	if (m_animationStateMachine.IsValid())
+	DASSERT_E(entity.IsValid());
+	m_animationEventListenerIds.clear();
+	const ComponentForms::scriptComponentIdContainerType& scriptComponentIds(ComponentForms::Get().GetAnimationEventScriptComponentIds());
+	for (ComponentIdType componentId : scriptComponentIds)
+	{
+		if (entity.HaveComponents(&componentId, 1))
+		{
+			m_animationEventListenerIds.push_back(componentId);
+		}
+	}
+	m_areAnimationEventListenersSetup = true;
+}
+
+void AnimationStateMachineComponent::DispatchAnimationEvent(EntityRef entity, size_t metachannelId)
+{
+	if (!entity.IsValid())
+	{
+		return;
+	}
+	// A listener removed from the entity.
+	if (!m_areAnimationEventListenersSetup || !entity.HaveComponents(m_animationEventListenerIds.data(), m_animationEventListenerIds.size()))
+	{
+		SetupAnimationEventListeners(entity);
+	}
+	if (m_animationEventListenerIds.empty())
+	{
+		return;
+	}
+	// Copied, since a listener can change the components of the entity, what would also move this component.
+	const scriptComponentIdContainerType listenerIds(m_animationEventListenerIds);
+	Registry& registry(entity.GetSceneRef().GetInternalSceneRef()->GetAsset().GetRegistry());
+	for (ComponentIdType listenerId : listenerIds)
 	{
-		m_animationStateMachine.Tick(
-			deltaTime, 
-			[&](EntityRef entity, size_t metachannelId)
+		if (!entity.IsValid() || !registry.HaveComponents(entity.GetEntity(), &listenerId, 1))
+		{
+			continue;
+		}
+		registry.GetComponents
+		(
+			entity.GetEntity(), &listenerId, 1,
+			[&](ComponentIdType, void* componentAddress) -> void
 			{
-				const ComponentForms::scriptComponentIdContainerType& scriptComponentIds(ComponentForms::Get().GetScriptComponentIds());
-				for (ComponentIdType componentId : scriptComponentIds)
-				{
-					if (!entity.HaveComponents(&componentId, 1))
-					{
-						continue;
-					}
-					entity.GetComponents(
-						&componentId, 1,
-						[&](ComponentRef<Component> component) -> void
-						{
-							static_cast<ScriptComponent*>(component.GetRawComponent())->OnAnimationEvent(metachannelId);
-						});
-				}
-			});
+				static_cast<ScriptComponent*>(componentAddress)->OnAnimationEvent(metachannelId);
+			}
+		);
 	}
 }
 
@@ -72,6 +105,7 @@ void AnimationStateMachineComponent::OnAttributeChange(AttributeIdType attribute
 	{
 	case a_animationStateMachine:
 		m_animationStateMachine = *static_cast<DAnimationStateMachine*>(newValue);
+		Setup();
 		return;
 	default:
 		DASSERT_E(false);
@@ -10,6 +10,7 @@
 #include "ReadWriteLockGuard.h"
 
 #include <string>
+#include <vector>
 
 
 
@@ -28,6 +29,7 @@ class AnimationStateMachineComponent : public Component
 {
 public:
 	using stringType = std::string;
+	using scriptComponentIdContainerType = std::vector<ComponentIdType>;
 public:
 	static constexpr AttributeIdType a_animationStateMachine{0};
 public:
@@ -39,13 +41,30 @@ public:
 	virtual void OnAttributeChange(AttributeIdType, void* newValue, AttributeType typeHint) override;
 public:
 	void Setup();
-	void Tick(float deltaTime);
+	// Finds the script components of the entity that handle animation events, so they are not searched for
+	// every event. Done on the first event if not called before, and again after components are added to the
+	// entity (see InvalidateAnimationEventListeners).
+	void SetupAnimationEventListeners(EntityRef);
+	// Calls OnAnimationEvent on the script components found by SetupAnimationEventListeners.
+	void DispatchAnimationEvent(EntityRef, size_t metachannelId);
 public:
-	void AttachToEntity(EntityRef entity)
+	// Samples the current animation into the components of the entity, so the write lock of the entity's scene
+	// must be held. Entities can be ticked in parallel since only their own components are written. The events
+	// fired by the animation are passed to metachannelsCallback, to be dispatched with DispatchAnimationEvent.
+	template <class Func>
+	void Tick(EntityRef entity, float deltaTime, Func metachannelsCallback)
 	{
-		m_animationStateMachine.AttachTo(entity);
+		if (m_animationStateMachine.IsValid())
+		{
+			m_animationStateMachine.Tick(m_instance, entity, deltaTime, metachannelsCallback);
+		}
 	}
-public:
+
+	void InvalidateAnimationEventListeners()
+	{
+		m_areAnimationEventListenersSetup = false;
+	}
+
 	template <ParameterType ParameterT>
 	bool TryGetParameterIndexWithName(const stringType& name, size_t& out)
 	{
@@ -55,10 +74,14 @@ public:
 	template <ParameterType ParameterT, class ParameterValueType>
 	void SetParameterValue(size_t parameterIndex, ParameterValueType value)
 	{
-		m_animationStateMachine.SetParameterValue<ParameterT>(parameterIndex, value);
+		m_instance.SetParameterValue<ParameterT>(parameterIndex, value);
 	}
 private:
 	DAnimationStateMachine m_animationStateMachine;
+	AnimationStateMachineInstance m_instance;
+	// Component ids rather than pointers, since the components move when the registry changes.
+	scriptComponentIdContainerType m_animationEventListenerIds;
+	bool m_areAnimationEventListenersSetup;
 };
 
 class AnimationStateMachineComponentFormGenerator : public ComponentFormGenerator
@@ -85,7 +108,12 @@ private:
 				{
 					static_cast<AnimationStateMachineComponent*>(componentAddress)->~AnimationStateMachineComponent();
 				},
-				&m_defaultArgs
+				&m_defaultArgs,
+				false,
+				[](void* address, const void* other) -> void
+				{
+					new (address) AnimationStateMachineComponent(*static_cast<const AnimationStateMachineComponent*>(other));
+				}
 			}
 		)
 	{}
@@ -126,25 +154,38 @@ public:
 		DASSERT_E(registry.HaveComponents<AnimationStateMachineComponent>(m_entity));
 		AnimationStateMachineComponent& component(registry.GetComponents<AnimationStateMachineComponent>(m_entity));
 		component.Setup();
+		component.SetupAnimationEventListeners(EntityRef(m_entity, SceneRef(m_internalSceneRef, *m_lockData)));
 	}
 
 	void Tick(float deltaTime)
 	{
 		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
 		Registry& registry(m_internalSceneRef->GetAsset().GetRegistry());
 		DASSERT_E(registry.HaveComponents<AnimationStateMachineComponent>(m_entity));
 		AnimationStateMachineComponent& component(registry.GetComponents<AnimationStateMachineComponent>(m_entity));
-		component.Tick(deltaTime);
+		component.Tick(
+			EntityRef(m_entity, SceneRef(m_internalSceneRef, *m_lockData)),
+			deltaTime,
+			[&](EntityRef entity, size_t metachannelId) -> void
+			{
+				component.DispatchAnimationEvent(entity, metachannelId);
+			});
 	}
-	
-	void AttachToEntity(EntityRef entity)
+
+	void DispatchAnimationEvent(size_t metachannelId)
 	{
 		DASSERT_E(IsValid());
-		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
 		Registry& registry(m_internalSceneRef->GetAsset().GetRegistry());
-		DASSERT_E(registry.HaveComponents<AnimationStateMachineComponent>(m_entity));
 		AnimationStateMachineComponent& component(registry.GetComponents<AnimationStateMachineComponent>(m_entity));
-		component.AttachToEntity(entity);
+		component.DispatchAnimationEvent(EntityRef(m_entity, SceneRef(m_internalSceneRef, *m_lockData)), metachannelId);
+	}
+
+	AnimationStateMachineComponent* GetRawComponent()
+	{
+		DASSERT_E(IsValid());
+		Registry& registry(m_internalSceneRef->GetAsset().GetRegistry());
+		return &registry.GetComponents<AnimationStateMachineComponent>(m_entity);
 	}
 public:
 	template <ParameterType ParameterT>
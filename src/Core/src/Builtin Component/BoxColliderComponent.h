@@ -36,6 +36,7 @@ struct BoxColliderComponentDirtyType
 	static constexpr uint64_t SelfPhysicsLayer			= static_cast<uint64_t>(1) << 9;
 	static constexpr uint64_t ColliderWithPhysicsLayer	= static_cast<uint64_t>(1) << 10;
 	static constexpr uint64_t LinearVelocity			= static_cast<uint64_t>(1) << 11;
+	static constexpr uint64_t Shape						= Offset | Size;
 
 } BoxColliderComponentDirtyType;
 
@@ -0,0 +1,685 @@
+#pragma once
+
+#include "AssetManagerTypes.h"
+#include "Component.h"
+#include "ComponentForm.h"
+#include "TemplateUtils.h"
+#include "SerializationTypes.h"
+#include "ComponentId.h"
+#include "ComponentRef.h"
+#include "ReadWriteLockGuard.h"
+#include "DCoreAssert.h"
+#include "Scene.h"
+#include "Asset.h"
+#include "PhysicsMaterial.h"
+#include "PhysicsAPI.h"
+
+#include "box2d/box2d.h"
+
+
+
+namespace DCore
+{
+
+// The bits shared by all the colliders have the same values as in BoxColliderComponentDirtyType.
+typedef 
+struct CapsuleColliderComponentDirtyType
+{
+	static constexpr uint64_t BodyType					= static_cast<uint64_t>(1) << 0;
+	static constexpr uint64_t Enabled					= static_cast<uint64_t>(1) << 1;
+	static constexpr uint64_t Sensor					= static_cast<uint64_t>(1) << 2;
+	static constexpr uint64_t GravityScale				= static_cast<uint64_t>(1) << 3;
+	static constexpr uint64_t FixedRotation				= static_cast<uint64_t>(1) << 4;
+	static constexpr uint64_t UseCCD					= static_cast<uint64_t>(1) << 5;
+	static constexpr uint64_t Offset					= static_cast<uint64_t>(1) << 6;
+	static constexpr uint64_t PhysicsMaterial			= static_cast<uint64_t>(1) << 8;
+	static constexpr uint64_t SelfPhysicsLayer			= static_cast<uint64_t>(1) << 9;
+	static constexpr uint64_t ColliderWithPhysicsLayer	= static_cast<uint64_t>(1) << 10;
+	static constexpr uint64_t LinearVelocity			= static_cast<uint64_t>(1) << 11;
+	static constexpr uint64_t Radius					= static_cast<uint64_t>(1) << 12;
+	static constexpr uint64_t Height					= static_cast<uint64_t>(1) << 13;
+	static constexpr uint64_t Shape						= Offset | Radius | Height;
+
+} CapsuleColliderComponentDirtyType;
+
+using CapsuleColliderDirtyT = uint64_t;
+
+class CapsuleColliderComponent;
+
+#pragma pack(push, 1)
+template <>
+struct ConstructorArgs<CapsuleColliderComponent>
+{
+	ConstructorArgs()
+		:
+		BodyType(DBodyType::Static),
+		Enabled(true),
+		IsSensor(false),
+		GravityScale(1.0),
+		FixedRotation(false),
+		UseCCD(false),
+		Radius(0.5f),
+		Height(2.0f),
+		SelfPhysicsLayer(DPhysicsLayer::Unspecified),
+		CollideWithPhysicsLayers(DPhysicsLayer::Unspecified),
+		DrawCollider(false)
+	{}
+
+	ConstructorArgs(
+		DBodyType bodyType,
+		DLogic enabled,
+		DLogic isSensor,
+		DFloat gravityScale,
+		DLogic fixedRotation,
+		DLogic useCCD,
+		const DVec2& offset,
+		DFloat radius,
+		DFloat height,
+		PhysicsMaterialRef physicsMaterial,
+		DPhysicsLayer selfPhysicsLayer,
+		DPhysicsLayer collideWithPhysicsLayers)
+		:
+		BodyType(bodyType),
+		Enabled(enabled),
+		IsSensor(isSensor),
+		GravityScale(gravityScale),
+		FixedRotation(fixedRotation),
+		UseCCD(useCCD),
+		Offset(offset),
+		Radius(radius),
+		Height(height),
+		PhysicsMaterial(physicsMaterial),
+		SelfPhysicsLayer(selfPhysicsLayer),
+		CollideWithPhysicsLayers(collideWithPhysicsLayers),
+		DrawCollider(false)
+	{}
+	
+	DBodyType BodyType;
+	DLogic Enabled;
+	DLogic IsSensor;
+	DFloat GravityScale;
+	DLogic FixedRotation;
+	DLogic UseCCD;
+	DVec2 Offset;
+	DFloat Radius;
+	DFloat Height;
+	PhysicsMaterialRef PhysicsMaterial;
+	DPhysicsLayer SelfPhysicsLayer;
+	DPhysicsLayer CollideWithPhysicsLayers;
+	DLogic DrawCollider;
+};
+#pragma pack(pop)
+
+class CapsuleColliderComponent : public Component
+{
+public:
+	static constexpr AttributeIdType a_bodyType{0};
+	static constexpr AttributeIdType a_enabled{1};
+	static constexpr AttributeIdType a_isSensor{2};
+	static constexpr AttributeIdType a_gravityScale{3};
+	static constexpr AttributeIdType a_fixedRotation{4};
+	static constexpr AttributeIdType a_useCCD{5};
+	static constexpr AttributeIdType a_offset{6};
+	static constexpr AttributeIdType a_radius{7};
+	static constexpr AttributeIdType a_height{8};
+	static constexpr AttributeIdType a_physicsMaterial{9};
+	static constexpr AttributeIdType a_selfPhysicsLayer{10};
+	static constexpr AttributeIdType a_collideWithPhysicsLayers{11};
+	static constexpr AttributeIdType a_drawCollider{12};
+public:
+	CapsuleColliderComponent(const ConstructorArgs<CapsuleColliderComponent>&);
+	~CapsuleColliderComponent();
+public:
+	virtual void* GetAttributePtr(AttributeIdType);
+	virtual void OnAttributeChange(AttributeIdType, void* newValue, AttributeType typeHint);
+public:
+	DBodyType GetBodyType() const
+	{
+		return m_bodyType;
+	}
+
+	void SetBodyType(DBodyType value)
+	{
+		m_bodyType = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::BodyType;
+	}
+
+	DLogic IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	void SetEnabled(DLogic value)
+	{
+		m_enabled = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::Enabled;
+	}
+
+	DLogic IsSensor() const
+	{
+		return m_isSensor;
+	}
+
+	void SetIsSensor(DLogic value)
+	{
+		m_isSensor = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::Sensor;
+	}
+
+	DFloat GetGravityScale() const
+	{
+		return m_gravityScale;
+	}
+
+	void SetGravityScale(DFloat value)
+	{
+		m_gravityScale = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::GravityScale;
+	}
+
+	bool IsRotationFixed() const
+	{
+		return m_fixedRotation;
+	}
+
+	void SetFixedRotation(DLogic value)
+	{
+		m_fixedRotation = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::FixedRotation;
+	}
+
+	DLogic IsUsingCCD() const
+	{
+		return m_useCCD;
+	}
+
+	void SetUseCCD(DLogic value)
+	{
+		m_useCCD = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::UseCCD;
+	}
+
+	const DVec2& GetOffset() const
+	{
+		return m_offset;
+	}
+
+	void SetOffset(const DVec2& value)
+	{
+		m_offset = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::Offset;
+	}
+
+	DFloat GetRadius() const
+	{
+		return m_radius;
+	}
+
+	void SetRadius(DFloat value)
+	{
+		m_radius = (std::max)(0.0f, value);
+		m_dirtyType |= CapsuleColliderComponentDirtyType::Radius;
+	}
+
+	// Total height of the capsule, including the caps.
+	DFloat GetHeight() const
+	{
+		return m_height;
+	}
+
+	void SetHeight(DFloat value)
+	{
+		m_height = (std::max)(0.0f, value);
+		m_dirtyType |= CapsuleColliderComponentDirtyType::Height;
+	}
+
+	PhysicsMaterialRef GetPhysicsMaterial() const
+	{
+		return m_physicsMaterial;
+	}
+
+	void SetPhysicsMaterial(PhysicsMaterialRef value)
+	{
+		m_physicsMaterial = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::PhysicsMaterial;
+	}
+
+	DPhysicsLayer GetSelfPhysicsLayer() const
+	{
+		return m_selfPhysicsLayer;
+	}
+
+	void SetSelfPhysicsLayer(DPhysicsLayer value)
+	{
+		m_selfPhysicsLayer = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::SelfPhysicsLayer;
+	}
+
+	DPhysicsLayer GetCollideWithPhysicsLayers() const
+	{
+		return m_collideWithPhysicsLayer;
+	}
+
+	void SetColliderWithPhysicsLayers(DPhysicsLayer value)
+	{
+		m_collideWithPhysicsLayer = value;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::ColliderWithPhysicsLayer;
+	}
+
+	DLogic HaveToDrawCollider() const
+	{
+		return m_drawCollider;
+	}
+
+	void SetDrawCollider(DLogic value)
+	{
+		m_drawCollider = value;
+	}
+
+	DBodyId GetBodyId() const
+	{
+		return m_bodyId;
+	}
+
+	void SetBodyId(b2BodyId value)
+	{
+		m_bodyId = value;
+	}
+
+	DShapeId GetShapeId() const
+	{
+		return m_shapeId;
+	}
+
+	void SetShapeId(DShapeId shapeId)
+	{
+		m_shapeId = shapeId;
+	}
+
+	void SetLinearVelocity(const DVec2& velocity)
+	{
+		m_linearVelocity = velocity;
+		m_dirtyType |= CapsuleColliderComponentDirtyType::LinearVelocity;
+	}
+
+	const DVec2& GetLinearVelocity() const
+	{
+		return m_linearVelocity;
+	}
+
+	CapsuleColliderDirtyT GetDirtyType() const
+	{
+		return m_dirtyType;
+	}
+
+	void Clean()
+	{
+		m_dirtyType = 0;
+	}
+private:
+	DBodyType m_bodyType;
+	DLogic m_enabled;
+	DLogic m_isSensor;
+	DFloat m_gravityScale;
+	DLogic m_fixedRotation;
+	DLogic m_useCCD;
+	DVec2 m_offset;
+	DFloat m_radius;
+	DFloat m_height;
+	PhysicsMaterialRef m_physicsMaterial;
+	DPhysicsLayer m_selfPhysicsLayer;
+	DPhysicsLayer m_collideWithPhysicsLayer;
+	DLogic m_drawCollider;
+	DBodyId m_bodyId;
+	DShapeId m_shapeId;
+	DVec2 m_linearVelocity;
+ 	CapsuleColliderDirtyT m_dirtyType;
+};
+
+class CapsuleColliderComponentFormGenerator : public ComponentFormGenerator
+{
+public:
+	~CapsuleColliderComponentFormGenerator() = default;
+private:
+	CapsuleColliderComponentFormGenerator()
+		:
+		ComponentFormGenerator
+		(
+			{
+				ComponentId::GetId<CapsuleColliderComponent>(),
+				"Capsule Collider Component",
+				false,
+				sizeof(CapsuleColliderComponent),
+				sizeof(ConstructorArgs<CapsuleColliderComponent>),
+				{{AttributeName("Type"), AttributeType::PhysicsBodyType, CapsuleColliderComponent::a_bodyType},
+				{AttributeName("Enabled"), AttributeType::Logic, CapsuleColliderComponent::a_enabled},
+				{AttributeName("Is Sensor"), AttributeType::Logic, CapsuleColliderComponent::a_isSensor},
+				{AttributeName("Gravity Scale"), AttributeType::Float, CapsuleColliderComponent::a_gravityScale},
+				{AttributeName("Fixed Rotation"), AttributeType::Logic, CapsuleColliderComponent::a_fixedRotation},
+				{AttributeName("Use CCD"), AttributeType::Logic, CapsuleColliderComponent::a_useCCD},
+				{AttributeName("Offset#X#Y"), AttributeType::Vector2, CapsuleColliderComponent::a_offset},
+				{AttributeName("Radius"), AttributeType::Float, CapsuleColliderComponent::a_radius},
+				{AttributeName("Height"), AttributeType::Float, CapsuleColliderComponent::a_height},
+				{AttributeName("Physics Material"), AttributeType::PhysicsMaterial, CapsuleColliderComponent::a_physicsMaterial},
+				{AttributeName("Self Physics Layer"), AttributeType::PhysicsLayer, CapsuleColliderComponent::a_selfPhysicsLayer},
+				{AttributeName("Collide With Physics Layer"), AttributeType::PhysicsLayers, CapsuleColliderComponent::a_collideWithPhysicsLayers},
+				{AttributeName("Draw Debug Collider"), AttributeType::Logic, CapsuleColliderComponent::a_drawCollider}},
+				[](void* address, const void* args) -> void
+				{
+					new (address) CapsuleColliderComponent(*static_cast<const ConstructorArgs<CapsuleColliderComponent>*>(args));
+				},
+				[](void* componentAddess) -> void
+				{
+					static_cast<CapsuleColliderComponent*>(componentAddess)->~CapsuleColliderComponent();
+				},
+				&m_defaultArgs
+			}
+		)
+	{}
+private:
+	ConstructorArgs<CapsuleColliderComponent> m_defaultArgs;
+private:
+	static CapsuleColliderComponentFormGenerator s_generator;
+};
+
+template <>
+class ComponentRef<CapsuleColliderComponent>
+{
+public:
+	ComponentRef()
+		:
+		m_lockData(nullptr)
+	{}
+	ComponentRef(Entity entity, InternalSceneRefType internalSceneRef, LockData& lockData)
+		:
+		m_entity(entity),
+		m_internalSceneRef(internalSceneRef),
+		m_lockData(&lockData)
+	{}
+	~ComponentRef() = default;
+public:
+	bool IsValid() const
+	{
+		if (m_lockData == nullptr)
+		{
+			return false;
+		}
+		return m_internalSceneRef.IsValid() && m_internalSceneRef->GetAsset().GetRegistry().HaveComponents<CapsuleColliderComponent>(m_entity);
+	}
+
+	void GetAttributePtr(AttributeIdType attributeId, void* out, size_t attributeSize)
+	{
+		DASSERT_E(IsValid());
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		std::memcpy(out, capsuleColliderComponent.GetAttributePtr(attributeId), attributeSize);
+	}
+
+	void OnAttributeChange(AttributeIdType attributeId, void* newValue, AttributeType typeHint)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.OnAttributeChange(attributeId, newValue, typeHint);
+	}
+	
+	DBodyType GetBodyType() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetBodyType();
+	}
+
+	void SetBodyType(DBodyType value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetBodyType(value);
+	}
+
+	DLogic IsEnabled() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.IsEnabled();
+	}
+	
+	void SetEnabled(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetEnabled(value);
+	}
+
+	DLogic IsSensor() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.IsSensor();
+	}
+ 
+	void SetIsSensor(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetIsSensor(value);
+	}
+
+	DFloat GetGravityScale() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetGravityScale();
+	}
+
+	void SetGravityScale(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetGravityScale(value);
+	}
+
+	DLogic IsRotationFixed() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.IsRotationFixed();
+	}
+
+	void SetFixedRotation(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetFixedRotation(value);
+	}
+
+	DLogic IsUsingCCD() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.IsUsingCCD();
+	}
+
+	void SetUseCCD(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetUseCCD(value);
+	}
+
+	DVec2 GetOffset() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetOffset();
+	}
+
+	void SetOffset(const DVec2& value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetOffset(value);
+	}
+
+	DFloat GetRadius() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetRadius();
+	}
+
+	void SetRadius(DFloat value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetRadius(value);
+	}
+
+	DFloat GetHeight() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetHeight();
+	}
+
+	void SetHeight(DFloat value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetHeight(value);
+	}
+
+	PhysicsMaterialRef GetPhysicsMaterial() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetPhysicsMaterial();
+	}
+
+	void SetPhysicsMaterial(PhysicsMaterialRef value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetPhysicsMaterial(value);
+	}
+
+	DPhysicsLayer GetSelfPhysicsLayer() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetSelfPhysicsLayer();
+	}
+
+	void SetSelfPhysicsLayer(DPhysicsLayer value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetSelfPhysicsLayer(value);
+	}
+
+	DPhysicsLayer GetCollideWithPhysicsLayers() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetCollideWithPhysicsLayers();
+	}
+
+	void SetColliderWithPhysicsLayers(DPhysicsLayer value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetColliderWithPhysicsLayers(value);
+	}
+
+	DLogic HaveToDrawCollider() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.HaveToDrawCollider();
+	}
+
+	void SetDrawCollider(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetDrawCollider(value);
+	}
+
+	DBodyId GetBodyId() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetBodyId();
+	}
+
+	void SetBodyId(DBodyId value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetBodyId(value);
+	}
+
+	DShapeId GetShapeId() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetShapeId();
+	}
+
+	void SetShapeId(DShapeId value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetShapeId(value);
+	}
+
+	CapsuleColliderDirtyT GetDirtyType() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetDirtyType();	
+	}
+
+	DVec2 GetLinearVelocity() const
+	{
+		DASSERT_E(IsValid());
+		const CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		return capsuleColliderComponent.GetLinearVelocity();	
+	}
+
+	void SetLinearVelocity(const DVec2& velocity)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.SetLinearVelocity(velocity);
+	}
+
+	void Clean()
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CapsuleColliderComponent& capsuleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CapsuleColliderComponent>(m_entity));
+		capsuleColliderComponent.Clean();	
+	}
+private:
+	Entity m_entity;
+	InternalSceneRefType m_internalSceneRef;
+	LockData* m_lockData;
+};
+
+}
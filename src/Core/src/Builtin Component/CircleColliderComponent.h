@@ -0,0 +1,650 @@
+#pragma once
+
+#include "AssetManagerTypes.h"
+#include "Component.h"
+#include "ComponentForm.h"
+#include "TemplateUtils.h"
+#include "SerializationTypes.h"
+#include "ComponentId.h"
+#include "ComponentRef.h"
+#include "ReadWriteLockGuard.h"
+#include "DCoreAssert.h"
+#include "Scene.h"
+#include "Asset.h"
+#include "PhysicsMaterial.h"
+#include "PhysicsAPI.h"
+
+#include "box2d/box2d.h"
+
+
+
+namespace DCore
+{
+
+// The bits shared by all the colliders have the same values as in BoxColliderComponentDirtyType.
+typedef 
+struct CircleColliderComponentDirtyType
+{
+	static constexpr uint64_t BodyType					= static_cast<uint64_t>(1) << 0;
+	static constexpr uint64_t Enabled					= static_cast<uint64_t>(1) << 1;
+	static constexpr uint64_t Sensor					= static_cast<uint64_t>(1) << 2;
+	static constexpr uint64_t GravityScale				= static_cast<uint64_t>(1) << 3;
+	static constexpr uint64_t FixedRotation				= static_cast<uint64_t>(1) << 4;
+	static constexpr uint64_t UseCCD					= static_cast<uint64_t>(1) << 5;
+	static constexpr uint64_t Offset					= static_cast<uint64_t>(1) << 6;
+	static constexpr uint64_t PhysicsMaterial			= static_cast<uint64_t>(1) << 8;
+	static constexpr uint64_t SelfPhysicsLayer			= static_cast<uint64_t>(1) << 9;
+	static constexpr uint64_t ColliderWithPhysicsLayer	= static_cast<uint64_t>(1) << 10;
+	static constexpr uint64_t LinearVelocity			= static_cast<uint64_t>(1) << 11;
+	static constexpr uint64_t Radius					= static_cast<uint64_t>(1) << 12;
+	static constexpr uint64_t Shape						= Offset | Radius;
+
+} CircleColliderComponentDirtyType;
+
+using CircleColliderDirtyT = uint64_t;
+
+class CircleColliderComponent;
+
+#pragma pack(push, 1)
+template <>
+struct ConstructorArgs<CircleColliderComponent>
+{
+	ConstructorArgs()
+		:
+		BodyType(DBodyType::Static),
+		Enabled(true),
+		IsSensor(false),
+		GravityScale(1.0),
+		FixedRotation(false),
+		UseCCD(false),
+		Radius(0.5f),
+		SelfPhysicsLayer(DPhysicsLayer::Unspecified),
+		CollideWithPhysicsLayers(DPhysicsLayer::Unspecified),
+		DrawCollider(false)
+	{}
+
+	ConstructorArgs(
+		DBodyType bodyType,
+		DLogic enabled,
+		DLogic isSensor,
+		DFloat gravityScale,
+		DLogic fixedRotation,
+		DLogic useCCD,
+		const DVec2& offset,
+		DFloat radius,
+		PhysicsMaterialRef physicsMaterial,
+		DPhysicsLayer selfPhysicsLayer,
+		DPhysicsLayer collideWithPhysicsLayers)
+		:
+		BodyType(bodyType),
+		Enabled(enabled),
+		IsSensor(isSensor),
+		GravityScale(gravityScale),
+		FixedRotation(fixedRotation),
+		UseCCD(useCCD),
+		Offset(offset),
+		Radius(radius),
+		PhysicsMaterial(physicsMaterial),
+		SelfPhysicsLayer(selfPhysicsLayer),
+		CollideWithPhysicsLayers(collideWithPhysicsLayers),
+		DrawCollider(false)
+	{}
+	
+	DBodyType BodyType;
+	DLogic Enabled;
+	DLogic IsSensor;
+	DFloat GravityScale;
+	DLogic FixedRotation;
+	DLogic UseCCD;
+	DVec2 Offset;
+	DFloat Radius;
+	PhysicsMaterialRef PhysicsMaterial;
+	DPhysicsLayer SelfPhysicsLayer;
+	DPhysicsLayer CollideWithPhysicsLayers;
+	DLogic DrawCollider;
+};
+#pragma pack(pop)
+
+class CircleColliderComponent : public Component
+{
+public:
+	static constexpr AttributeIdType a_bodyType{0};
+	static constexpr AttributeIdType a_enabled{1};
+	static constexpr AttributeIdType a_isSensor{2};
+	static constexpr AttributeIdType a_gravityScale{3};
+	static constexpr AttributeIdType a_fixedRotation{4};
+	static constexpr AttributeIdType a_useCCD{5};
+	static constexpr AttributeIdType a_offset{6};
+	static constexpr AttributeIdType a_radius{7};
+	static constexpr AttributeIdType a_physicsMaterial{8};
+	static constexpr AttributeIdType a_selfPhysicsLayer{9};
+	static constexpr AttributeIdType a_collideWithPhysicsLayers{10};
+	static constexpr AttributeIdType a_drawCollider{11};
+public:
+	CircleColliderComponent(const ConstructorArgs<CircleColliderComponent>&);
+	~CircleColliderComponent();
+public:
+	virtual void* GetAttributePtr(AttributeIdType);
+	virtual void OnAttributeChange(AttributeIdType, void* newValue, AttributeType typeHint);
+public:
+	DBodyType GetBodyType() const
+	{
+		return m_bodyType;
+	}
+
+	void SetBodyType(DBodyType value)
+	{
+		m_bodyType = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::BodyType;
+	}
+
+	DLogic IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	void SetEnabled(DLogic value)
+	{
+		m_enabled = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::Enabled;
+	}
+
+	DLogic IsSensor() const
+	{
+		return m_isSensor;
+	}
+
+	void SetIsSensor(DLogic value)
+	{
+		m_isSensor = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::Sensor;
+	}
+
+	DFloat GetGravityScale() const
+	{
+		return m_gravityScale;
+	}
+
+	void SetGravityScale(DFloat value)
+	{
+		m_gravityScale = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::GravityScale;
+	}
+
+	bool IsRotationFixed() const
+	{
+		return m_fixedRotation;
+	}
+
+	void SetFixedRotation(DLogic value)
+	{
+		m_fixedRotation = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::FixedRotation;
+	}
+
+	DLogic IsUsingCCD() const
+	{
+		return m_useCCD;
+	}
+
+	void SetUseCCD(DLogic value)
+	{
+		m_useCCD = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::UseCCD;
+	}
+
+	const DVec2& GetOffset() const
+	{
+		return m_offset;
+	}
+
+	void SetOffset(const DVec2& value)
+	{
+		m_offset = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::Offset;
+	}
+
+	DFloat GetRadius() const
+	{
+		return m_radius;
+	}
+
+	void SetRadius(DFloat value)
+	{
+		m_radius = (std::max)(0.0f, value);
+		m_dirtyType |= CircleColliderComponentDirtyType::Radius;
+	}
+
+	PhysicsMaterialRef GetPhysicsMaterial() const
+	{
+		return m_physicsMaterial;
+	}
+
+	void SetPhysicsMaterial(PhysicsMaterialRef value)
+	{
+		m_physicsMaterial = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::PhysicsMaterial;
+	}
+
+	DPhysicsLayer GetSelfPhysicsLayer() const
+	{
+		return m_selfPhysicsLayer;
+	}
+
+	void SetSelfPhysicsLayer(DPhysicsLayer value)
+	{
+		m_selfPhysicsLayer = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::SelfPhysicsLayer;
+	}
+
+	DPhysicsLayer GetCollideWithPhysicsLayers() const
+	{
+		return m_collideWithPhysicsLayer;
+	}
+
+	void SetColliderWithPhysicsLayers(DPhysicsLayer value)
+	{
+		m_collideWithPhysicsLayer = value;
+		m_dirtyType |= CircleColliderComponentDirtyType::ColliderWithPhysicsLayer;
+	}
+
+	DLogic HaveToDrawCollider() const
+	{
+		return m_drawCollider;
+	}
+
+	void SetDrawCollider(DLogic value)
+	{
+		m_drawCollider = value;
+	}
+
+	DBodyId GetBodyId() const
+	{
+		return m_bodyId;
+	}
+
+	void SetBodyId(b2BodyId value)
+	{
+		m_bodyId = value;
+	}
+
+	DShapeId GetShapeId() const
+	{
+		return m_shapeId;
+	}
+
+	void SetShapeId(DShapeId shapeId)
+	{
+		m_shapeId = shapeId;
+	}
+
+	void SetLinearVelocity(const DVec2& velocity)
+	{
+		m_linearVelocity = velocity;
+		m_dirtyType |= CircleColliderComponentDirtyType::LinearVelocity;
+	}
+
+	const DVec2& GetLinearVelocity() const
+	{
+		return m_linearVelocity;
+	}
+
+	CircleColliderDirtyT GetDirtyType() const
+	{
+		return m_dirtyType;
+	}
+
+	void Clean()
+	{
+		m_dirtyType = 0;
+	}
+private:
+	DBodyType m_bodyType;
+	DLogic m_enabled;
+	DLogic m_isSensor;
+	DFloat m_gravityScale;
+	DLogic m_fixedRotation;
+	DLogic m_useCCD;
+	DVec2 m_offset;
+	DFloat m_radius;
+	PhysicsMaterialRef m_physicsMaterial;
+	DPhysicsLayer m_selfPhysicsLayer;
+	DPhysicsLayer m_collideWithPhysicsLayer;
+	DLogic m_drawCollider;
+	DBodyId m_bodyId;
+	DShapeId m_shapeId;
+	DVec2 m_linearVelocity;
+ 	CircleColliderDirtyT m_dirtyType;
+};
+
+class CircleColliderComponentFormGenerator : public ComponentFormGenerator
+{
+public:
+	~CircleColliderComponentFormGenerator() = default;
+private:
+	CircleColliderComponentFormGenerator()
+		:
+		ComponentFormGenerator
+		(
+			{
+				ComponentId::GetId<CircleColliderComponent>(),
+				"Circle Collider Component",
+				false,
+				sizeof(CircleColliderComponent),
+				sizeof(ConstructorArgs<CircleColliderComponent>),
+				{{AttributeName("Type"), AttributeType::PhysicsBodyType, CircleColliderComponent::a_bodyType},
+				{AttributeName("Enabled"), AttributeType::Logic, CircleColliderComponent::a_enabled},
+				{AttributeName("Is Sensor"), AttributeType::Logic, CircleColliderComponent::a_isSensor},
+				{AttributeName("Gravity Scale"), AttributeType::Float, CircleColliderComponent::a_gravityScale},
+				{AttributeName("Fixed Rotation"), AttributeType::Logic, CircleColliderComponent::a_fixedRotation},
+				{AttributeName("Use CCD"), AttributeType::Logic, CircleColliderComponent::a_useCCD},
+				{AttributeName("Offset#X#Y"), AttributeType::Vector2, CircleColliderComponent::a_offset},
+				{AttributeName("Radius"), AttributeType::Float, CircleColliderComponent::a_radius},
+				{AttributeName("Physics Material"), AttributeType::PhysicsMaterial, CircleColliderComponent::a_physicsMaterial},
+				{AttributeName("Self Physics Layer"), AttributeType::PhysicsLayer, CircleColliderComponent::a_selfPhysicsLayer},
+				{AttributeName("Collide With Physics Layer"), AttributeType::PhysicsLayers, CircleColliderComponent::a_collideWithPhysicsLayers},
+				{AttributeName("Draw Debug Collider"), AttributeType::Logic, CircleColliderComponent::a_drawCollider}},
+				[](void* address, const void* args) -> void
+				{
+					new (address) CircleColliderComponent(*static_cast<const ConstructorArgs<CircleColliderComponent>*>(args));
+				},
+				[](void* componentAddess) -> void
+				{
+					static_cast<CircleColliderComponent*>(componentAddess)->~CircleColliderComponent();
+				},
+				&m_defaultArgs
+			}
+		)
+	{}
+private:
+	ConstructorArgs<CircleColliderComponent> m_defaultArgs;
+private:
+	static CircleColliderComponentFormGenerator s_generator;
+};
+
+template <>
+class ComponentRef<CircleColliderComponent>
+{
+public:
+	ComponentRef()
+		:
+		m_lockData(nullptr)
+	{}
+	ComponentRef(Entity entity, InternalSceneRefType internalSceneRef, LockData& lockData)
+		:
+		m_entity(entity),
+		m_internalSceneRef(internalSceneRef),
+		m_lockData(&lockData)
+	{}
+	~ComponentRef() = default;
+public:
+	bool IsValid() const
+	{
+		if (m_lockData == nullptr)
+		{
+			return false;
+		}
+		return m_internalSceneRef.IsValid() && m_internalSceneRef->GetAsset().GetRegistry().HaveComponents<CircleColliderComponent>(m_entity);
+	}
+
+	void GetAttributePtr(AttributeIdType attributeId, void* out, size_t attributeSize)
+	{
+		DASSERT_E(IsValid());
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		std::memcpy(out, circleColliderComponent.GetAttributePtr(attributeId), attributeSize);
+	}
+
+	void OnAttributeChange(AttributeIdType attributeId, void* newValue, AttributeType typeHint)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.OnAttributeChange(attributeId, newValue, typeHint);
+	}
+	
+	DBodyType GetBodyType() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetBodyType();
+	}
+
+	void SetBodyType(DBodyType value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetBodyType(value);
+	}
+
+	DLogic IsEnabled() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.IsEnabled();
+	}
+	
+	void SetEnabled(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetEnabled(value);
+	}
+
+	DLogic IsSensor() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.IsSensor();
+	}
+ 
+	void SetIsSensor(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetIsSensor(value);
+	}
+
+	DFloat GetGravityScale() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetGravityScale();
+	}
+
+	void SetGravityScale(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetGravityScale(value);
+	}
+
+	DLogic IsRotationFixed() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.IsRotationFixed();
+	}
+
+	void SetFixedRotation(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetFixedRotation(value);
+	}
+
+	DLogic IsUsingCCD() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.IsUsingCCD();
+	}
+
+	void SetUseCCD(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetUseCCD(value);
+	}
+
+	DVec2 GetOffset() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetOffset();
+	}
+
+	void SetOffset(const DVec2& value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetOffset(value);
+	}
+
+	DFloat GetRadius() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetRadius();
+	}
+
+	void SetRadius(DFloat value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetRadius(value);
+	}
+
+	PhysicsMaterialRef GetPhysicsMaterial() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetPhysicsMaterial();
+	}
+
+	void SetPhysicsMaterial(PhysicsMaterialRef value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetPhysicsMaterial(value);
+	}
+
+	DPhysicsLayer GetSelfPhysicsLayer() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetSelfPhysicsLayer();
+	}
+
+	void SetSelfPhysicsLayer(DPhysicsLayer value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetSelfPhysicsLayer(value);
+	}
+
+	DPhysicsLayer GetCollideWithPhysicsLayers() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetCollideWithPhysicsLayers();
+	}
+
+	void SetColliderWithPhysicsLayers(DPhysicsLayer value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetColliderWithPhysicsLayers(value);
+	}
+
+	DLogic HaveToDrawCollider() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.HaveToDrawCollider();
+	}
+
+	void SetDrawCollider(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetDrawCollider(value);
+	}
+
+	DBodyId GetBodyId() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetBodyId();
+	}
+
+	void SetBodyId(DBodyId value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetBodyId(value);
+	}
+
+	DShapeId GetShapeId() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetShapeId();
+	}
+
+	void SetShapeId(DShapeId value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetShapeId(value);
+	}
+
+	CircleColliderDirtyT GetDirtyType() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetDirtyType();	
+	}
+
+	DVec2 GetLinearVelocity() const
+	{
+		DASSERT_E(IsValid());
+		const CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		return circleColliderComponent.GetLinearVelocity();	
+	}
+
+	void SetLinearVelocity(const DVec2& velocity)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.SetLinearVelocity(velocity);
+	}
+
+	void Clean()
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		CircleColliderComponent& circleColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<CircleColliderComponent>(m_entity));
+		circleColliderComponent.Clean();	
+	}
+private:
+	Entity m_entity;
+	InternalSceneRefType m_internalSceneRef;
+	LockData* m_lockData;
+};
+
+}
@@ -0,0 +1,710 @@
+#pragma once
+
+#include "AssetManagerTypes.h"
+#include "Component.h"
+#include "ComponentForm.h"
+#include "TemplateUtils.h"
+#include "SerializationTypes.h"
+#include "ComponentId.h"
+#include "ComponentRef.h"
+#include "ReadWriteLockGuard.h"
+#include "DCoreAssert.h"
+#include "Scene.h"
+#include "Asset.h"
+#include "PhysicsMaterial.h"
+#include "PhysicsAPI.h"
+
+#include "box2d/box2d.h"
+#include "box2d/collision.h"
+
+
+
+namespace DCore
+{
+
+// The bits shared by all the colliders have the same values as in BoxColliderComponentDirtyType.
+typedef 
+struct PolygonColliderComponentDirtyType
+{
+	static constexpr uint64_t BodyType					= static_cast<uint64_t>(1) << 0;
+	static constexpr uint64_t Enabled					= static_cast<uint64_t>(1) << 1;
+	static constexpr uint64_t Sensor					= static_cast<uint64_t>(1) << 2;
+	static constexpr uint64_t GravityScale				= static_cast<uint64_t>(1) << 3;
+	static constexpr uint64_t FixedRotation				= static_cast<uint64_t>(1) << 4;
+	static constexpr uint64_t UseCCD					= static_cast<uint64_t>(1) << 5;
+	static constexpr uint64_t Offset					= static_cast<uint64_t>(1) << 6;
+	static constexpr uint64_t PhysicsMaterial			= static_cast<uint64_t>(1) << 8;
+	static constexpr uint64_t SelfPhysicsLayer			= static_cast<uint64_t>(1) << 9;
+	static constexpr uint64_t ColliderWithPhysicsLayer	= static_cast<uint64_t>(1) << 10;
+	static constexpr uint64_t LinearVelocity			= static_cast<uint64_t>(1) << 11;
+	static constexpr uint64_t Vertices					= static_cast<uint64_t>(1) << 12;
+	static constexpr uint64_t Shape						= Offset | Vertices;
+
+} PolygonColliderComponentDirtyType;
+
+using PolygonColliderDirtyT = uint64_t;
+
+constexpr size_t maxPolygonColliderVertices{b2_maxPolygonVertices};
+
+class PolygonColliderComponent;
+
+#pragma pack(push, 1)
+template <>
+struct ConstructorArgs<PolygonColliderComponent>
+{
+	ConstructorArgs()
+		:
+		BodyType(DBodyType::Static),
+		Enabled(true),
+		IsSensor(false),
+		GravityScale(1.0),
+		FixedRotation(false),
+		UseCCD(false),
+		VertexCount(4),
+		Vertices{{-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f}},
+		SelfPhysicsLayer(DPhysicsLayer::Unspecified),
+		CollideWithPhysicsLayers(DPhysicsLayer::Unspecified),
+		DrawCollider(false)
+	{}
+
+	ConstructorArgs(
+		DBodyType bodyType,
+		DLogic enabled,
+		DLogic isSensor,
+		DFloat gravityScale,
+		DLogic fixedRotation,
+		DLogic useCCD,
+		const DVec2& offset,
+		DUInt vertexCount,
+		const DVec2* vertices,
+		PhysicsMaterialRef physicsMaterial,
+		DPhysicsLayer selfPhysicsLayer,
+		DPhysicsLayer collideWithPhysicsLayers)
+		:
+		BodyType(bodyType),
+		Enabled(enabled),
+		IsSensor(isSensor),
+		GravityScale(gravityScale),
+		FixedRotation(fixedRotation),
+		UseCCD(useCCD),
+		Offset(offset),
+		VertexCount(vertexCount),
+		PhysicsMaterial(physicsMaterial),
+		SelfPhysicsLayer(selfPhysicsLayer),
+		CollideWithPhysicsLayers(collideWithPhysicsLayers),
+		DrawCollider(false)
+	{
+		std::memcpy(Vertices, vertices, maxPolygonColliderVertices * sizeof(DVec2));
+	}
+	
+	DBodyType BodyType;
+	DLogic Enabled;
+	DLogic IsSensor;
+	DFloat GravityScale;
+	DLogic FixedRotation;
+	DLogic UseCCD;
+	DVec2 Offset;
+	DUInt VertexCount;
+	DVec2 Vertices[maxPolygonColliderVertices];
+	PhysicsMaterialRef PhysicsMaterial;
+	DPhysicsLayer SelfPhysicsLayer;
+	DPhysicsLayer CollideWithPhysicsLayers;
+	DLogic DrawCollider;
+};
+#pragma pack(pop)
+
+class PolygonColliderComponent : public Component
+{
+public:
+	static constexpr AttributeIdType a_bodyType{0};
+	static constexpr AttributeIdType a_enabled{1};
+	static constexpr AttributeIdType a_isSensor{2};
+	static constexpr AttributeIdType a_gravityScale{3};
+	static constexpr AttributeIdType a_fixedRotation{4};
+	static constexpr AttributeIdType a_useCCD{5};
+	static constexpr AttributeIdType a_offset{6};
+	static constexpr AttributeIdType a_vertexCount{7};
+	static constexpr AttributeIdType a_firstVertex{8};
+	static constexpr AttributeIdType a_physicsMaterial{16};
+	static constexpr AttributeIdType a_selfPhysicsLayer{17};
+	static constexpr AttributeIdType a_collideWithPhysicsLayers{18};
+	static constexpr AttributeIdType a_drawCollider{19};
+public:
+	PolygonColliderComponent(const ConstructorArgs<PolygonColliderComponent>&);
+	~PolygonColliderComponent();
+public:
+	virtual void* GetAttributePtr(AttributeIdType);
+	virtual void OnAttributeChange(AttributeIdType, void* newValue, AttributeType typeHint);
+public:
+	DBodyType GetBodyType() const
+	{
+		return m_bodyType;
+	}
+
+	void SetBodyType(DBodyType value)
+	{
+		m_bodyType = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::BodyType;
+	}
+
+	DLogic IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	void SetEnabled(DLogic value)
+	{
+		m_enabled = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::Enabled;
+	}
+
+	DLogic IsSensor() const
+	{
+		return m_isSensor;
+	}
+
+	void SetIsSensor(DLogic value)
+	{
+		m_isSensor = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::Sensor;
+	}
+
+	DFloat GetGravityScale() const
+	{
+		return m_gravityScale;
+	}
+
+	void SetGravityScale(DFloat value)
+	{
+		m_gravityScale = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::GravityScale;
+	}
+
+	bool IsRotationFixed() const
+	{
+		return m_fixedRotation;
+	}
+
+	void SetFixedRotation(DLogic value)
+	{
+		m_fixedRotation = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::FixedRotation;
+	}
+
+	DLogic IsUsingCCD() const
+	{
+		return m_useCCD;
+	}
+
+	void SetUseCCD(DLogic value)
+	{
+		m_useCCD = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::UseCCD;
+	}
+
+	const DVec2& GetOffset() const
+	{
+		return m_offset;
+	}
+
+	void SetOffset(const DVec2& value)
+	{
+		m_offset = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::Offset;
+	}
+
+	DUInt GetVertexCount() const
+	{
+		return m_vertexCount;
+	}
+
+	void SetVertexCount(DUInt value)
+	{
+		m_vertexCount = (std::min)((std::max)(value, static_cast<DUInt>(3)), static_cast<DUInt>(maxPolygonColliderVertices));
+		m_dirtyType |= PolygonColliderComponentDirtyType::Vertices;
+	}
+
+	const DVec2* GetVertices() const
+	{
+		return m_vertices;
+	}
+
+	const DVec2& GetVertex(size_t index) const
+	{
+		DASSERT_E(index < maxPolygonColliderVertices);
+		return m_vertices[index];
+	}
+
+	void SetVertex(size_t index, const DVec2& value)
+	{
+		DASSERT_E(index < maxPolygonColliderVertices);
+		m_vertices[index] = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::Vertices;
+	}
+
+	PhysicsMaterialRef GetPhysicsMaterial() const
+	{
+		return m_physicsMaterial;
+	}
+
+	void SetPhysicsMaterial(PhysicsMaterialRef value)
+	{
+		m_physicsMaterial = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::PhysicsMaterial;
+	}
+
+	DPhysicsLayer GetSelfPhysicsLayer() const
+	{
+		return m_selfPhysicsLayer;
+	}
+
+	void SetSelfPhysicsLayer(DPhysicsLayer value)
+	{
+		m_selfPhysicsLayer = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::SelfPhysicsLayer;
+	}
+
+	DPhysicsLayer GetCollideWithPhysicsLayers() const
+	{
+		return m_collideWithPhysicsLayer;
+	}
+
+	void SetColliderWithPhysicsLayers(DPhysicsLayer value)
+	{
+		m_collideWithPhysicsLayer = value;
+		m_dirtyType |= PolygonColliderComponentDirtyType::ColliderWithPhysicsLayer;
+	}
+
+	DLogic HaveToDrawCollider() const
+	{
+		return m_drawCollider;
+	}
+
+	void SetDrawCollider(DLogic value)
+	{
+		m_drawCollider = value;
+	}
+
+	DBodyId GetBodyId() const
+	{
+		return m_bodyId;
+	}
+
+	void SetBodyId(b2BodyId value)
+	{
+		m_bodyId = value;
+	}
+
+	DShapeId GetShapeId() const
+	{
+		return m_shapeId;
+	}
+
+	void SetShapeId(DShapeId shapeId)
+	{
+		m_shapeId = shapeId;
+	}
+
+	void SetLinearVelocity(const DVec2& velocity)
+	{
+		m_linearVelocity = velocity;
+		m_dirtyType |= PolygonColliderComponentDirtyType::LinearVelocity;
+	}
+
+	const DVec2& GetLinearVelocity() const
+	{
+		return m_linearVelocity;
+	}
+
+	PolygonColliderDirtyT GetDirtyType() const
+	{
+		return m_dirtyType;
+	}
+
+	void Clean()
+	{
+		m_dirtyType = 0;
+	}
+private:
+	DBodyType m_bodyType;
+	DLogic m_enabled;
+	DLogic m_isSensor;
+	DFloat m_gravityScale;
+	DLogic m_fixedRotation;
+	DLogic m_useCCD;
+	DVec2 m_offset;
+	DUInt m_vertexCount;
+	DVec2 m_vertices[maxPolygonColliderVertices];
+	PhysicsMaterialRef m_physicsMaterial;
+	DPhysicsLayer m_selfPhysicsLayer;
+	DPhysicsLayer m_collideWithPhysicsLayer;
+	DLogic m_drawCollider;
+	DBodyId m_bodyId;
+	DShapeId m_shapeId;
+	DVec2 m_linearVelocity;
+ 	PolygonColliderDirtyT m_dirtyType;
+};
+
+class PolygonColliderComponentFormGenerator : public ComponentFormGenerator
+{
+public:
+	~PolygonColliderComponentFormGenerator() = default;
+private:
+	PolygonColliderComponentFormGenerator()
+		:
+		ComponentFormGenerator
+		(
+			{
+				ComponentId::GetId<PolygonColliderComponent>(),
+				"Polygon Collider Component",
+				false,
+				sizeof(PolygonColliderComponent),
+				sizeof(ConstructorArgs<PolygonColliderComponent>),
+				{{AttributeName("Type"), AttributeType::PhysicsBodyType, PolygonColliderComponent::a_bodyType},
+				{AttributeName("Enabled"), AttributeType::Logic, PolygonColliderComponent::a_enabled},
+				{AttributeName("Is Sensor"), AttributeType::Logic, PolygonColliderComponent::a_isSensor},
+				{AttributeName("Gravity Scale"), AttributeType::Float, PolygonColliderComponent::a_gravityScale},
+				{AttributeName("Fixed Rotation"), AttributeType::Logic, PolygonColliderComponent::a_fixedRotation},
+				{AttributeName("Use CCD"), AttributeType::Logic, PolygonColliderComponent::a_useCCD},
+				{AttributeName("Offset#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_offset},
+				{AttributeName("Vertex Count"), AttributeType::UInteger, PolygonColliderComponent::a_vertexCount},
+				{AttributeName("Vertex 1#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 0},
+				{AttributeName("Vertex 2#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 1},
+				{AttributeName("Vertex 3#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 2},
+				{AttributeName("Vertex 4#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 3},
+				{AttributeName("Vertex 5#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 4},
+				{AttributeName("Vertex 6#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 5},
+				{AttributeName("Vertex 7#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 6},
+				{AttributeName("Vertex 8#X#Y"), AttributeType::Vector2, PolygonColliderComponent::a_firstVertex + 7},
+				{AttributeName("Physics Material"), AttributeType::PhysicsMaterial, PolygonColliderComponent::a_physicsMaterial},
+				{AttributeName("Self Physics Layer"), AttributeType::PhysicsLayer, PolygonColliderComponent::a_selfPhysicsLayer},
+				{AttributeName("Collide With Physics Layer"), AttributeType::PhysicsLayers, PolygonColliderComponent::a_collideWithPhysicsLayers},
+				{AttributeName("Draw Debug Collider"), AttributeType::Logic, PolygonColliderComponent::a_drawCollider}},
+				[](void* address, const void* args) -> void
+				{
+					new (address) PolygonColliderComponent(*static_cast<const ConstructorArgs<PolygonColliderComponent>*>(args));
+				},
+				[](void* componentAddess) -> void
+				{
+					static_cast<PolygonColliderComponent*>(componentAddess)->~PolygonColliderComponent();
+				},
+				&m_defaultArgs
+			}
+		)
+	{}
+private:
+	ConstructorArgs<PolygonColliderComponent> m_defaultArgs;
+private:
+	static PolygonColliderComponentFormGenerator s_generator;
+};
+
+template <>
+class ComponentRef<PolygonColliderComponent>
+{
+public:
+	ComponentRef()
+		:
+		m_lockData(nullptr)
+	{}
+	ComponentRef(Entity entity, InternalSceneRefType internalSceneRef, LockData& lockData)
+		:
+		m_entity(entity),
+		m_internalSceneRef(internalSceneRef),
+		m_lockData(&lockData)
+	{}
+	~ComponentRef() = default;
+public:
+	bool IsValid() const
+	{
+		if (m_lockData == nullptr)
+		{
+			return false;
+		}
+		return m_internalSceneRef.IsValid() && m_internalSceneRef->GetAsset().GetRegistry().HaveComponents<PolygonColliderComponent>(m_entity);
+	}
+
+	void GetAttributePtr(AttributeIdType attributeId, void* out, size_t attributeSize)
+	{
+		DASSERT_E(IsValid());
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		std::memcpy(out, polygonColliderComponent.GetAttributePtr(attributeId), attributeSize);
+	}
+
+	void OnAttributeChange(AttributeIdType attributeId, void* newValue, AttributeType typeHint)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.OnAttributeChange(attributeId, newValue, typeHint);
+	}
+	
+	DBodyType GetBodyType() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetBodyType();
+	}
+
+	void SetBodyType(DBodyType value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetBodyType(value);
+	}
+
+	DLogic IsEnabled() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.IsEnabled();
+	}
+	
+	void SetEnabled(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetEnabled(value);
+	}
+
+	DLogic IsSensor() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.IsSensor();
+	}
+ 
+	void SetIsSensor(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetIsSensor(value);
+	}
+
+	DFloat GetGravityScale() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetGravityScale();
+	}
+
+	void SetGravityScale(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetGravityScale(value);
+	}
+
+	DLogic IsRotationFixed() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.IsRotationFixed();
+	}
+
+	void SetFixedRotation(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetFixedRotation(value);
+	}
+
+	DLogic IsUsingCCD() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.IsUsingCCD();
+	}
+
+	void SetUseCCD(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetUseCCD(value);
+	}
+
+	DVec2 GetOffset() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetOffset();
+	}
+
+	void SetOffset(const DVec2& value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetOffset(value);
+	}
+
+	DUInt GetVertexCount() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetVertexCount();
+	}
+
+	void SetVertexCount(DUInt value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetVertexCount(value);
+	}
+
+	DVec2 GetVertex(size_t index) const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetVertex(index);
+	}
+
+	void SetVertex(size_t index, const DVec2& value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetVertex(index, value);
+	}
+
+	// Copies the vertices to out, that must have space for maxPolygonColliderVertices elements. Returns the vertex count.
+	size_t GetVertices(DVec2* out) const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		std::memcpy(out, polygonColliderComponent.GetVertices(), maxPolygonColliderVertices * sizeof(DVec2));
+		return polygonColliderComponent.GetVertexCount();
+	}
+
+	PhysicsMaterialRef GetPhysicsMaterial() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetPhysicsMaterial();
+	}
+
+	void SetPhysicsMaterial(PhysicsMaterialRef value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetPhysicsMaterial(value);
+	}
+
+	DPhysicsLayer GetSelfPhysicsLayer() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetSelfPhysicsLayer();
+	}
+
+	void SetSelfPhysicsLayer(DPhysicsLayer value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetSelfPhysicsLayer(value);
+	}
+
+	DPhysicsLayer GetCollideWithPhysicsLayers() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetCollideWithPhysicsLayers();
+	}
+
+	void SetColliderWithPhysicsLayers(DPhysicsLayer value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetColliderWithPhysicsLayers(value);
+	}
+
+	DLogic HaveToDrawCollider() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.HaveToDrawCollider();
+	}
+
+	void SetDrawCollider(DLogic value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetDrawCollider(value);
+	}
+
+	DBodyId GetBodyId() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetBodyId();
+	}
+
+	void SetBodyId(DBodyId value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetBodyId(value);
+	}
+
+	DShapeId GetShapeId() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetShapeId();
+	}
+
+	void SetShapeId(DShapeId value)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetShapeId(value);
+	}
+
+	PolygonColliderDirtyT GetDirtyType() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetDirtyType();	
+	}
+
+	DVec2 GetLinearVelocity() const
+	{
+		DASSERT_E(IsValid());
+		const PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		return polygonColliderComponent.GetLinearVelocity();	
+	}
+
+	void SetLinearVelocity(const DVec2& velocity)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.SetLinearVelocity(velocity);
+	}
+
+	void Clean()
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		PolygonColliderComponent& polygonColliderComponent(m_internalSceneRef->GetAsset().GetRegistry().GetComponents<PolygonColliderComponent>(m_entity));
+		polygonColliderComponent.Clean();	
+	}
+private:
+	Entity m_entity;
+	InternalSceneRefType m_internalSceneRef;
+	LockData* m_lockData;
+};
+
+}
@@ -34,7 +34,7 @@ public:
 		m_data = new char[m_capacity * m_chunkSize];
 		if (m_occupation > 0)
 		{
-			std::memcpy(m_data, other.m_data, m_occupation * sizeof(m_chunkSize));
+			std::memcpy(m_data, other.m_data, m_occupation * m_chunkSize);
 		}
 	}
 
@@ -68,6 +68,15 @@ public:
 		return m_data + m_occupation++ * m_chunkSize;
 	}
 
+	void Reserve(size_t capacity)
+	{
+		if (capacity <= m_capacity)
+		{
+			return;
+		}
+		Reallocate(capacity);
+	}
+
 	void EraseAtIndex(size_t index)
 	{
 		DASSERT_E(index < m_occupation);
@@ -132,7 +141,12 @@ private:
 		{
 			return;
 		}
-		m_capacity *= 2;
+		Reallocate(m_capacity * 2);
+	}
+
+	void Reallocate(size_t capacity)
+	{
+		m_capacity = capacity;
 		char* newData(new char[m_capacity * m_chunkSize]);
 		if (m_occupation > 0)
 		{
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "DCoreAssert.h"
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+// Open addressing hash map with linear probing. Removals shift the following keys of the probe back, so there are no
+// tombstones and a lookup stops at the first empty slot. Every slot has a control byte holding seven bits of the
+// hash of its key, so the keys are only compared when those bits match.
+// The slot of a key is taken from the low bits of its hash, so the hash must be well mixed in all of them.
+// Pointers to values are invalidated by insertions and removals.
+template <class KeyType, class ValueType, class HashType = std::hash<KeyType>>
+class FlatHashMap
+{
+public:
+	using keyType = KeyType;
+	using valueType = ValueType;
+	using hashType = HashType;
+private:
+	struct Slot
+	{
+		keyType Key;
+		valueType Value;
+	};
+private:
+	using slotContainerType = std::vector<Slot>;
+	using controlContainerType = std::vector<uint8_t>;
+private:
+	static constexpr size_t minimumCapacity{16};
+	static constexpr size_t notFound{SIZE_MAX};
+	static constexpr uint8_t emptyControl{0};
+	static constexpr uint8_t occupiedBit{0x80};
+public:
+	FlatHashMap()
+		:
+		m_size(0)
+	{}
+	FlatHashMap(const FlatHashMap&) = default;
+	FlatHashMap(FlatHashMap&& other) noexcept
+		:
+		m_slots(std::move(other.m_slots)),
+		m_controls(std::move(other.m_controls)),
+		m_size(other.m_size)
+	{
+		other.m_slots.clear();
+		other.m_controls.clear();
+		other.m_size = 0;
+	}
+	~FlatHashMap() = default;
+public:
+	FlatHashMap& operator=(const FlatHashMap&) = default;
+
+	FlatHashMap& operator=(FlatHashMap&& other) noexcept
+	{
+		m_slots = std::move(other.m_slots);
+		m_controls = std::move(other.m_controls);
+		m_size = other.m_size;
+		other.m_slots.clear();
+		other.m_controls.clear();
+		other.m_size = 0;
+		return *this;
+	}
+public:
+	// Returns false, without changing the value, if the key is already in the map.
+	bool Insert(const keyType& key, valueType value)
+	{
+		if (FindIndex(key) != notFound)
+		{
+			return false;
+		}
+		if ((m_size + 1) * 8 > m_controls.size() * 7)
+		{
+			Rehash(m_controls.empty() ? minimumCapacity : m_controls.size() * 2);
+		}
+		InsertNew(key, std::move(value));
+		m_size++;
+		return true;
+	}
+
+	bool Remove(const keyType& key)
+	{
+		size_t index(FindIndex(key));
+		if (index == notFound)
+		{
+			return false;
+		}
+		const size_t mask(m_controls.size() - 1);
+		for (size_t next((index + 1) & mask); m_controls[next] != emptyControl; next = (next + 1) & mask)
+		{
+			const size_t home(hashType{}(m_slots[next].Key) & mask);
+			// Keys whose probe doesn't pass by the hole stay where they are.
+			if (((next - home) & mask) < ((next - index) & mask))
+			{
+				continue;
+			}
+			m_slots[index] = std::move(m_slots[next]);
+			m_controls[index] = m_controls[next];
+			index = next;
+		}
+		m_slots[index] = Slot();
+		m_controls[index] = emptyControl;
+		m_size--;
+		return true;
+	}
+
+	valueType* Find(const keyType& key)
+	{
+		const size_t index(FindIndex(key));
+		return index == notFound ? nullptr : &m_slots[index].Value;
+	}
+
+	const valueType* Find(const keyType& key) const
+	{
+		const size_t index(FindIndex(key));
+		return index == notFound ? nullptr : &m_slots[index].Value;
+	}
+
+	bool Contains(const keyType& key) const
+	{
+		return FindIndex(key) != notFound;
+	}
+
+	// Keeps the capacity.
+	void Clear()
+	{
+		for (size_t i(0); i < m_controls.size(); i++)
+		{
+			if (m_controls[i] != emptyControl)
+			{
+				m_slots[i] = Slot();
+				m_controls[i] = emptyControl;
+			}
+		}
+		m_size = 0;
+	}
+
+	void Reserve(size_t numberOfKeys)
+	{
+		size_t capacity(minimumCapacity);
+		while (numberOfKeys * 8 > capacity * 7)
+		{
+			capacity *= 2;
+		}
+		if (capacity > m_controls.size())
+		{
+			Rehash(capacity);
+		}
+	}
+
+	size_t Size() const
+	{
+		return m_size;
+	}
+
+	// func(const keyType&, valueType&) -> bool returns true to stop the iteration. The map must not be changed
+	// during the iteration.
+	template <class Func>
+	void Iterate(Func func)
+	{
+		for (size_t i(0); i < m_controls.size(); i++)
+		{
+			if (m_controls[i] == emptyControl)
+			{
+				continue;
+			}
+			bool toStop(std::invoke(func, static_cast<const keyType&>(m_slots[i].Key), m_slots[i].Value));
+			if (toStop)
+			{
+				return;
+			}
+		}
+	}
+
+	template <class Func>
+	void Iterate(Func func) const
+	{
+		for (size_t i(0); i < m_controls.size(); i++)
+		{
+			if (m_controls[i] == emptyControl)
+			{
+				continue;
+			}
+			bool toStop(std::invoke(func, m_slots[i].Key, m_slots[i].Value));
+			if (toStop)
+			{
+				return;
+			}
+		}
+	}
+private:
+	slotContainerType m_slots;
+	controlContainerType m_controls;
+	size_t m_size;
+private:
+	static uint8_t GetControl(size_t hash)
+	{
+		return static_cast<uint8_t>(hash >> (sizeof(size_t) * CHAR_BIT - 7)) | occupiedBit;
+	}
+private:
+	size_t FindIndex(const keyType& key) const
+	{
+		if (m_size == 0)
+		{
+			return notFound;
+		}
+		const size_t hash(hashType{}(key));
+		const uint8_t control(GetControl(hash));
+		const size_t mask(m_controls.size() - 1);
+		// The map is never full, so the probe always reaches an empty slot.
+		for (size_t index(hash & mask); ; index = (index + 1) & mask)
+		{
+			if (m_controls[index] == emptyControl)
+			{
+				return notFound;
+			}
+			if (m_controls[index] == control && m_slots[index].Key == key)
+			{
+				return index;
+			}
+		}
+	}
+
+	void InsertNew(const keyType& key, valueType&& value)
+	{
+		const size_t hash(hashType{}(key));
+		const size_t mask(m_controls.size() - 1);
+		size_t index(hash & mask);
+		while (m_controls[index] != emptyControl)
+		{
+			index = (index + 1) & mask;
+		}
+		m_slots[index].Key = key;
+		m_slots[index].Value = std::move(value);
+		m_controls[index] = GetControl(hash);
+	}
+
+	void Rehash(size_t capacity)
+	{
+		DASSERT_E((capacity & (capacity - 1)) == 0 && m_size * 8 <= capacity * 7);
+		slotContainerType slots(std::move(m_slots));
+		controlContainerType controls(std::move(m_controls));
+		m_slots.clear();
+		m_slots.resize(capacity);
+		m_controls.clear();
+		m_controls.resize(capacity, emptyControl);
+		for (size_t i(0); i < controls.size(); i++)
+		{
+			if (controls[i] != emptyControl)
+			{
+				InsertNew(slots[i].Key, std::move(slots[i].Value));
+			}
+		}
+	}
+};
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "DCoreAssert.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+// Bump allocator for short lived memory, e.g. the buffers of a scene load. Everything allocated is released at once
+// by Reset, which keeps the memory to be reused by the next allocations. Destructors are never called.
+class ScratchArena
+{
+public:
+	static constexpr size_t defaultBlockSize{64 * 1024};
+private:
+	struct Block
+	{
+		std::unique_ptr<char[]> Data;
+		size_t Size;
+	};
+public:
+	using blockContainerType = std::vector<Block>;
+public:
+	ScratchArena(size_t blockSize = defaultBlockSize)
+		:
+		m_blockSize(blockSize),
+		m_offset(0)
+	{
+		DASSERT_E(m_blockSize > 0);
+	}
+	ScratchArena(const ScratchArena&) = delete;
+	ScratchArena(ScratchArena&&) noexcept = default;
+	~ScratchArena() = default;
+public:
+	ScratchArena& operator=(const ScratchArena&) = delete;
+	ScratchArena& operator=(ScratchArena&&) noexcept = default;
+public:
+	// alignment must be a power of two no greater than alignof(std::max_align_t).
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+	{
+		DASSERT_E(alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= alignof(std::max_align_t));
+		size_t offset((m_offset + alignment - 1) & ~(alignment - 1));
+		if (m_blocks.empty() || offset + size > m_blocks.back().Size)
+		{
+			const size_t blockSize(size > m_blockSize ? size : m_blockSize);
+			m_blocks.push_back({std::make_unique<char[]>(blockSize), blockSize});
+			offset = 0;
+		}
+		m_offset = offset + size;
+		return m_blocks.back().Data.get() + offset;
+	}
+
+	template <class T>
+	T* Allocate(size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	// Memory given before must not be used anymore. If it took more than one block, the blocks are merged, so the
+	// same allocations fit in one block next time.
+	void Reset()
+	{
+		m_offset = 0;
+		if (m_blocks.size() <= 1)
+		{
+			return;
+		}
+		size_t totalSize(0);
+		for (const Block& block : m_blocks)
+		{
+			totalSize += block.Size;
+		}
+		m_blocks.clear();
+		m_blocks.push_back({std::make_unique<char[]>(totalSize), totalSize});
+	}
+private:
+	size_t m_blockSize;
+	size_t m_offset;
+	blockContainerType m_blocks;
+};
+
+}
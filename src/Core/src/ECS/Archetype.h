@@ -117,6 +117,17 @@ public:
 		return m_components.GetSparseRef().data();
 	}
 public:
+	// Makes room for numberOfEntities more entities, so adding them doesn't grow the pools one by one.
+	void Reserve(size_t numberOfEntities)
+	{
+		const size_t capacity(m_entities.size() + numberOfEntities);
+		m_entities.reserve(capacity);
+		for (ComponentPool& componentPool : m_componentPools)
+		{
+			componentPool.Reserve(capacity);
+		}
+	}
+
 	template <class Func>
 	void AddEntityComponents(Entity entity, const ComponentIdType* componentIds, size_t numberOfComponents, Func function)
 	{
@@ -286,6 +297,35 @@ public:
 		}
 	}
 
+	// After a copy of the archetype of another registry, makes its entities refer to the entities of this one.
+	template <class EntityContainer>
+	void SetEntityContainer(const EntityContainer& entities)
+	{
+		for (Entity& entity : m_entities)
+		{
+			entity = Entity(entity, entities);
+		}
+	}
+
+	// other must be a copy of this archetype. function is called for each component pool with the component id and size,
+	// the entities, the addresses of the first component of the pool in this archetype and in other, and the number of
+	// components. The components of a pool are contiguous and in the order of the entities.
+	template <class Func>
+	void IterateOnComponentPools(const Archetype& other, Func function)
+	{
+		DASSERT_E(m_componentPools.size() == other.m_componentPools.size());
+		for (size_t poolIndex(0); poolIndex < m_componentPools.size(); poolIndex++)
+		{
+			std::invoke
+			(
+				function,
+				m_components[poolIndex], m_componentSizes[poolIndex], m_entities.data(),
+				m_componentPools[poolIndex].GetComponentAtIndex(0), static_cast<const void*>(other.m_componentPools[poolIndex].GetComponentAtIndex(0)),
+				m_entities.size()
+			);
+		}
+	}
+
 	template <class Func>
 	void AddEntityFromArchetypeWithLessComponents(Entity entity, Archetype& other, const ComponentIdType* componentIds, size_t numberOfComponents, Func function)
 	{
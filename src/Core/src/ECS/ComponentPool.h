@@ -40,6 +40,11 @@ public:
 		m_components.PushBack(component);
 	}
 
+	void Reserve(size_t numberOfComponents)
+	{
+		m_components.Reserve(numberOfComponents);
+	}
+
 	void RemoveComponent(size_t index)
 	{
 		m_components.EraseAtIndex(index);
@@ -61,6 +61,26 @@ public:
 		}
 		return entity;
 	}
+
+	// Makes this registry a copy of other, with the same entities. The components are copied byte by byte, a pool at a
+	// time, then function is called for every pool as function(componentId, componentSize, const Entity* entities,
+	// void* components, const void* otherComponents, size_t numberOfComponents), to construct again the components
+	// that can't be copied so. The components this registry had are not destroyed.
+	template <class Func>
+	void CopyFrom(const Registry& other, Func function)
+	{
+		m_entities = entityContainerType(other.m_entities);
+		m_archetypes = archetypeContainerType(other.m_archetypes);
+		m_archetypes.Iterate
+		(
+			[&](archetypeContainerType::Ref archetype) -> bool
+			{
+				archetype->SetEntityContainer(m_entities);
+				archetype->IterateOnComponentPools(other.m_archetypes[archetype.GetIndex()], function);
+				return false;
+			}
+		);
+	}
 public:
 	template <class Func>
 	Entity CreateEntity(const ComponentIdType* componentIds, const size_t* componentSizes, size_t numberOfComponents, Func function)
@@ -82,6 +102,33 @@ public:
 		return entityContainerType::ConstRef(entity.GetId(), entity.GetVersion(), *entity.GetReciclingVector());
 	}
 
+	// Creates numberOfEntities entities with the same components in their archetype at once. function is called with
+	// the index of the entity in [0, numberOfEntities), the component id and the address where the component must be
+	// constructed, for every component of every entity, in the order of the entities.
+	template <class Func>
+	void CreateEntities(const ComponentIdType* componentIds, const size_t* componentSizes, size_t numberOfComponents, size_t numberOfEntities, Entity* outEntities, Func function)
+	{
+		archetypeContainerType::Ref archetype;
+		if (!TryGetArchetypeWithComponentsExactly(componentIds, numberOfComponents, archetype))
+		{
+			archetype = m_archetypes.PushBack(componentIds, componentSizes, numberOfComponents);
+		}
+		archetype->Reserve(numberOfEntities);
+		for (size_t entityIndex(0); entityIndex < numberOfEntities; entityIndex++)
+		{
+			entityContainerType::Ref entity(m_entities.PushBack(archetype.GetIndex()));
+			archetype->AddEntityComponents
+			(
+				entity, componentIds, numberOfComponents,
+				[&](ComponentIdType componentId, void* componentAddress) -> void
+				{
+					std::invoke(function, entityIndex, componentId, componentAddress);
+				}
+			);
+			outEntities[entityIndex] = entityContainerType::ConstRef(entity.GetId(), entity.GetVersion(), *entity.GetReciclingVector());
+		}
+	}
+
 	template <class Component, class ...Components, class TupleArg, class ...TupleArgs>
 	Entity CreateEntity(TupleArg&& tupleArg, TupleArgs&&... tupleArgs)
 	{
@@ -17,6 +17,21 @@ bool ScriptComponent::OverlapBox(float boxRotation, const DVec2& boxSizes, const
 	return m_runtime->OverlapBox(boxRotation, boxSizes, origin, selfPhysicsLayer, onlyCollideWithLayers, result, entitiesSize);
 }
 
+void ScriptComponent::BatchQuery(const queryRequestType* requests, size_t numberOfRequests, queryResultType* results)
+{
+	m_runtime->BatchQuery(requests, numberOfRequests, results);
+}
+
+void ScriptComponent::EnableBodyPooling(size_t maximumBodiesPerArchetype)
+{
+	m_runtime->EnableBodyPooling(maximumBodiesPerArchetype);
+}
+
+void ScriptComponent::DisableBodyPooling()
+{
+	m_runtime->DisableBodyPooling();
+}
+
 void ScriptComponent::DrawDebugBox(const DVec2& translation, float rotation, const DVec2& sizes, const DVec4& color)
 {
 	if (m_runtime == nullptr)
@@ -10,12 +10,18 @@
 #include "Component.h"
 #include "EntityRef.h"
 #include "PhysicsAPI.h"
+#include "BodyPool.h"
 #include "TransformComponent.h"
 #include "NameComponent.h"
 #include "UUIDComponent.h"
 #include "BoxColliderComponent.h"
+#include "CircleColliderComponent.h"
+#include "CapsuleColliderComponent.h"
+#include "PolygonColliderComponent.h"
 #include "AssetManager.h"
+#include "Prefab.h"
 
+#include <type_traits>
 #include <utility>
 
 
@@ -32,6 +38,8 @@ class ScriptComponent : public Component
 public:
 	using rayCastResultType = Physics::RayCastResult;
 	using overlapResultType = Physics::OverlapResult;
+	using queryRequestType = Physics::QueryRequest;
+	using queryResultType = Physics::QueryResult;
 	using componentRefConstructorArgsType =	std::tuple<Entity, InternalSceneRefType, ComponentIdType, LockData*>;
 public:
 	virtual ~ScriptComponent() = default;
@@ -39,6 +47,11 @@ public:
 	// Physics
 	bool CastBox(float boxRotation, const DVec2& boxSizes, const DVec2& origin, const DVec2& direction, float maxDistance = FLT_MAX, uint64_t onlyCollideWithLayers = COLLIDE_WITH_ALL_MASK, rayCastResultType* out = nullptr);
 	bool OverlapBox(float boxRotation, const DVec2& boxSizes, const DVec2& origin, uint64_t selfPhysicsLayer = UNDEFINED_PHYSICS_LAYER_MASK, uint64_t onlyCollideWithLayers = COLLIDE_WITH_ALL_MASK, overlapResultType* result = nullptr, size_t entitiesSize = 0);
+	// Runs many casts and overlaps at once. Prefer it to many CastBox/OverlapBox calls in the same update.
+	void BatchQuery(const queryRequestType* requests, size_t numberOfRequests, queryResultType* results);
+	// Reuses the bodies of destroyed entities. Worth it when many entities with equal colliders are created and destroyed.
+	void EnableBodyPooling(size_t maximumBodiesPerArchetype = Physics::BodyPool::defaultMaximumBodiesPerArchetype);
+	void DisableBodyPooling();
 	// Debug rendering
 	void DrawDebugBox(const DVec2& translation, float rotation, const DVec2& sizes, const DVec4& color);
 public:
@@ -122,6 +135,19 @@ public:
 		return entityRef;
 	}
 
+	// Spawns the hierarchy of the prefab in the scene of the script. Cheaper than building it with CreateEntity.
+	EntityRef InstantiatePrefab(const Prefab& prefab, EntityRef parent = EntityRef())
+	{
+		DASSERT_E(m_entityRef.IsValid());
+		return prefab.Instantiate(m_entityRef.GetSceneRef(), *m_runtime, parent);
+	}
+
+	void InstantiatePrefab(const Prefab& prefab, size_t numberOfInstances, EntityRef* outRoots, EntityRef parent = EntityRef())
+	{
+		DASSERT_E(m_entityRef.IsValid());
+		prefab.Instantiate(m_entityRef.GetSceneRef(), *m_runtime, numberOfInstances, outRoots, parent);
+	}
+
 	template <class Func>
 	void IterateOnEntitiesWithComponents(const ComponentIdType* componentIds, size_t numberOfComponents, Func function)
 	{
@@ -172,7 +198,10 @@ private:
 				}
 			);
 		}
-		if (componentId == ComponentId::GetId<BoxColliderComponent>())
+		if (componentId == ComponentId::GetId<BoxColliderComponent>() ||
+			componentId == ComponentId::GetId<CircleColliderComponent>() ||
+			componentId == ComponentId::GetId<CapsuleColliderComponent>() ||
+			componentId == ComponentId::GetId<PolygonColliderComponent>())
 		{
 			SetupEntityPhysics(entity, *m_runtime);
 		}
@@ -186,6 +215,13 @@ private:
 	}
 };
 
+// To be passed to the ScriptComponentFormGenerator, so the script is only called for animation events if it handles them.
+template <class ScriptComponentT>
+constexpr bool OverridesOnAnimationEvent()
+{
+	return !std::is_same_v<decltype(&ScriptComponentT::OnAnimationEvent), void (ScriptComponent::*)(size_t)>;
+}
+
 template <>
 class ComponentRef<ScriptComponent>
 {
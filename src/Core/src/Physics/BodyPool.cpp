@@ -0,0 +1,153 @@
+#include "BodyPool.h"
+#include "DCoreAssert.h"
+
+#include <functional>
+
+
+
+namespace DCore::Physics
+{
+
+// BodyArchetype
+BodyArchetype::BodyArchetype(const ShapeDefinition& shape, const b2ShapeDef& shapeDef)
+	:
+	Shape(&shape),
+	CategoryBits(shapeDef.filter.categoryBits),
+	MaskBits(shapeDef.filter.maskBits),
+	Density(shapeDef.density),
+	Friction(shapeDef.friction),
+	Restitution(shapeDef.restitution),
+	IsSensor(shapeDef.isSensor)
+{}
+
+BodyArchetype::BodyArchetype(const ShapeDefinition& shape, b2ShapeId shapeId)
+	:
+	Shape(&shape),
+	Density(b2Shape_GetDensity(shapeId)),
+	Friction(b2Shape_GetFriction(shapeId)),
+	Restitution(b2Shape_GetRestitution(shapeId)),
+	IsSensor(b2Shape_IsSensor(shapeId))
+{
+	const b2Filter filter(b2Shape_GetFilter(shapeId));
+	CategoryBits = filter.categoryBits;
+	MaskBits = filter.maskBits;
+}
+
+bool BodyArchetype::operator==(const BodyArchetype& other) const
+{
+	return Shape == other.Shape &&
+		CategoryBits == other.CategoryBits &&
+		MaskBits == other.MaskBits &&
+		Density == other.Density &&
+		Friction == other.Friction &&
+		Restitution == other.Restitution &&
+		IsSensor == other.IsSensor;
+}
+
+size_t BodyPool::BodyArchetypeHash::operator()(const BodyArchetype& archetype) const
+{
+	size_t hash(std::hash<const ShapeDefinition*>()(archetype.Shape));
+	const auto combine
+	(
+		[&](size_t value) -> void
+		{
+			hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+		}
+	);
+	combine(std::hash<uint64_t>()(archetype.CategoryBits));
+	combine(std::hash<uint64_t>()(archetype.MaskBits));
+	combine(std::hash<float>()(archetype.Density));
+	combine(std::hash<float>()(archetype.Friction));
+	combine(std::hash<float>()(archetype.Restitution));
+	combine(archetype.IsSensor);
+	return hash;
+}
+// End BodyArchetype
+
+// BodyPool
+BodyPool::BodyPool()
+	:
+	m_enabled(false),
+	m_maximumBodiesPerArchetype(defaultMaximumBodiesPerArchetype),
+	m_acquireRequests(ProfilingStats::Get().GetCounter("Physics/Body Pool/Acquire Requests")),
+	m_reusedBodies(ProfilingStats::Get().GetCounter("Physics/Body Pool/Reused Bodies")),
+	m_releasedBodies(ProfilingStats::Get().GetCounter("Physics/Body Pool/Released Bodies")),
+	m_pooledBodies(ProfilingStats::Get().GetCounter("Physics/Body Pool/Pooled Bodies"))
+{}
+
+void BodyPool::Enable(size_t maximumBodiesPerArchetype)
+{
+	DASSERT_E(maximumBodiesPerArchetype > 0);
+	m_enabled = true;
+	m_maximumBodiesPerArchetype = maximumBodiesPerArchetype;
+}
+
+void BodyPool::Disable()
+{
+	m_enabled = false;
+}
+
+size_t BodyPool::GetArchetypeIndex(const BodyArchetype& archetype)
+{
+	archetypeIndexContainerType::iterator it(m_archetypeIndexes.find(archetype));
+	if (it != m_archetypeIndexes.end())
+	{
+		return it->second;
+	}
+	const size_t archetypeIndex(m_bodies.size());
+	m_bodies.emplace_back();
+	m_archetypeIndexes.emplace(archetype, archetypeIndex);
+	return archetypeIndex;
+}
+
+bool BodyPool::TryAcquire(size_t archetypeIndex, b2BodyId& out)
+{
+	DASSERT_E(archetypeIndex < m_bodies.size());
+	if (!m_enabled)
+	{
+		return false;
+	}
+	m_acquireRequests.fetch_add(1, std::memory_order_relaxed);
+	bodyContainerType& bodies(m_bodies[archetypeIndex]);
+	if (bodies.empty())
+	{
+		return false;
+	}
+	out = bodies.back();
+	bodies.pop_back();
+	m_reusedBodies.fetch_add(1, std::memory_order_relaxed);
+	m_pooledBodies.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+bool BodyPool::TryRelease(size_t archetypeIndex, b2BodyId bodyId)
+{
+	DASSERT_E(archetypeIndex < m_bodies.size());
+	DASSERT_E(!b2Body_IsEnabled(bodyId));
+	if (!m_enabled)
+	{
+		return false;
+	}
+	bodyContainerType& bodies(m_bodies[archetypeIndex]);
+	if (bodies.size() >= m_maximumBodiesPerArchetype)
+	{
+		return false;
+	}
+	bodies.push_back(bodyId);
+	m_releasedBodies.fetch_add(1, std::memory_order_relaxed);
+	m_pooledBodies.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void BodyPool::Clear()
+{
+	for (const bodyContainerType& bodies : m_bodies)
+	{
+		m_pooledBodies.fetch_sub(static_cast<int64_t>(bodies.size()), std::memory_order_relaxed);
+	}
+	m_archetypeIndexes.clear();
+	m_bodies.clear();
+}
+// End BodyPool
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "ShapeCache.h"
+#include "ProfilingStats.h"
+
+#include "box2d/box2d.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+
+namespace DCore::Physics
+{
+
+// What a pooled body must match to be reused without recreating its shape.
+// The shape is identified by its ShapeCache entry, so the cache must outlive the pool entries.
+struct BodyArchetype
+{
+	BodyArchetype(const ShapeDefinition&, const b2ShapeDef&);
+	BodyArchetype(const ShapeDefinition&, b2ShapeId);
+
+	const ShapeDefinition* Shape;
+	uint64_t CategoryBits;
+	uint64_t MaskBits;
+	float Density;
+	float Friction;
+	float Restitution;
+	bool IsSensor;
+
+	bool operator==(const BodyArchetype&) const;
+};
+
+// Keeps disabled bodies of destroyed entities, grouped by archetype, so entities spawned later
+// with the same collider (e.g. projectiles) only need to teleport and enable an existing body.
+// Disabled by default.
+class BodyPool
+{
+public:
+	static constexpr size_t invalidArchetypeIndex{SIZE_MAX};
+	static constexpr size_t defaultMaximumBodiesPerArchetype{256};
+private:
+	struct BodyArchetypeHash
+	{
+		size_t operator()(const BodyArchetype&) const;
+	};
+public:
+	using bodyContainerType = std::vector<b2BodyId>;
+	using archetypeBodiesContainerType = std::vector<bodyContainerType>;
+	using archetypeIndexContainerType = std::unordered_map<BodyArchetype, size_t, BodyArchetypeHash>;
+	using counterType = ProfilingStats::counterType;
+public:
+	BodyPool();
+	BodyPool(const BodyPool&) = delete;
+	BodyPool(BodyPool&&) = delete;
+	~BodyPool() = default;
+public:
+	void Enable(size_t maximumBodiesPerArchetype);
+	void Disable();
+	size_t GetArchetypeIndex(const BodyArchetype&);
+	bool TryAcquire(size_t archetypeIndex, b2BodyId& out);
+	// Returns false if the body was not pooled, in which case the caller must destroy it.
+	// The body must already be disabled.
+	bool TryRelease(size_t archetypeIndex, b2BodyId);
+	// Forgets the pooled bodies without destroying them. Use IterateOnPooledBodies before if they must be destroyed.
+	void Clear();
+public:
+	bool IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	template <class Func>
+	void IterateOnPooledBodies(Func function)
+	{
+		for (const bodyContainerType& bodies : m_bodies)
+		{
+			for (b2BodyId bodyId : bodies)
+			{
+				function(bodyId);
+			}
+		}
+	}
+private:
+	bool m_enabled;
+	size_t m_maximumBodiesPerArchetype;
+	archetypeIndexContainerType m_archetypeIndexes;
+	archetypeBodiesContainerType m_bodies;
+	counterType& m_acquireRequests;
+	counterType& m_reusedBodies;
+	counterType& m_releasedBodies;
+	counterType& m_pooledBodies;
+};
+
+}
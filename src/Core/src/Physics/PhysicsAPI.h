@@ -11,6 +11,7 @@
 #include <string>
 #include <type_traits>
 #include <tuple>
+#include <float.h>
 
 
 #define UNDEFINED_PHYSICS_LAYER_MASK B2_DEFAULT_CATEGORY_BITS
@@ -79,6 +80,71 @@ struct OverlapResult
 	EntityRef* Entities;
 };
 
+enum class QueryType : uint8_t
+{
+	CastBox,
+	OverlapBox,
+	RayCast
+};
+
+// A single request of a batched query. Use the Make*Request functions to fill it.
+struct QueryRequest
+{
+	QueryType Type;
+	float BoxRotation;
+	DVec2 BoxSizes;
+	DVec2 Origin;
+	DVec2 Direction;
+	float MaxDistance;
+	uint64_t SelfPhysicsLayer;
+	uint64_t OnlyCollideWithLayers;
+	// Overlap only. Caller owned, may be nullptr if only the overlap test is needed.
+	EntityRef* OverlapEntities;
+	size_t MaxOverlapEntities;
+};
+
+struct QueryResult
+{
+	// Casts only.
+	RayCastResult RayCast;
+	// Overlap only.
+	size_t NumberOfOverlapEntities;
+	bool Hit;
+};
+
+inline QueryRequest MakeCastBoxRequest(
+	float boxRotation,
+	const DVec2& boxSizes,
+	const DVec2& origin,
+	const DVec2& direction,
+	float maxDistance = FLT_MAX,
+	uint64_t onlyCollideWithLayers = COLLIDE_WITH_ALL_MASK)
+{
+	return {QueryType::CastBox, boxRotation, boxSizes, origin, direction, maxDistance, UNDEFINED_PHYSICS_LAYER_MASK, onlyCollideWithLayers, nullptr, 0};
+}
+
+inline QueryRequest MakeOverlapBoxRequest(
+	float boxRotation,
+	const DVec2& boxSizes,
+	const DVec2& origin,
+	uint64_t selfPhysicsLayer = UNDEFINED_PHYSICS_LAYER_MASK,
+	uint64_t onlyCollideWithLayers = COLLIDE_WITH_ALL_MASK,
+	EntityRef* overlapEntities = nullptr,
+	size_t maxOverlapEntities = 0)
+{
+	DASSERT_E(overlapEntities == nullptr || maxOverlapEntities > 0);
+	return {QueryType::OverlapBox, boxRotation, boxSizes, origin, {0.0f, 0.0f}, 0.0f, selfPhysicsLayer, onlyCollideWithLayers, overlapEntities, maxOverlapEntities};
+}
+
+inline QueryRequest MakeRayCastRequest(
+	const DVec2& origin,
+	const DVec2& direction,
+	float maxDistance,
+	uint64_t onlyCollideWithLayers = COLLIDE_WITH_ALL_MASK)
+{
+	return {QueryType::RayCast, 0.0f, {0.0f, 0.0f}, origin, direction, maxDistance, UNDEFINED_PHYSICS_LAYER_MASK, onlyCollideWithLayers, nullptr, 0};
+}
+
 // Internal
 inline uint64_t Internal_GetLayersMask(uint64_t& returnValue)
 {
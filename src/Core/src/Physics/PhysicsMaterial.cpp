@@ -2,6 +2,7 @@
 #include "Asset.h"
 #include "ReciclingVector.h"
 #include "AssetManager.h"
+#include "ReadWriteLockGuard.h"
 
 
 
@@ -62,7 +63,12 @@ PhysicsMaterialRef::PhysicsMaterialRef(PhysicsMaterialRef&& other) noexcept
 
 bool PhysicsMaterialRef::IsValid() const
 {
-	return m_lockData != nullptr && m_ref.IsValid();
+	if (m_lockData == nullptr)
+	{
+		return false;
+	}
+	ReadWriteLockGuard guard(LockType::ReadLock, *m_lockData);
+	return m_ref.IsValid();
 }
 
 void PhysicsMaterialRef::Invalidate()	
@@ -0,0 +1,195 @@
+#include "ShapeCache.h"
+#include "DCoreAssert.h"
+
+#include <cstddef>
+#include <cstring>
+
+
+
+namespace DCore::Physics
+{
+
+// ShapeKey
+ShapeCache::ShapeKey::ShapeKey(ShapeType type)
+{
+	// Zeroes the padding too, since keys are compared and hashed byte by byte.
+	std::memset(this, 0, sizeof(ShapeKey));
+	Type = type;
+}
+
+bool ShapeCache::ShapeKey::operator==(const ShapeKey& other) const
+{
+	return std::memcmp(this, &other, sizeof(ShapeKey)) == 0;
+}
+
+size_t ShapeCache::ShapeKeyHash::operator()(const ShapeKey& key) const
+{
+	// FNV-1a.
+	const unsigned char* bytes(reinterpret_cast<const unsigned char*>(&key));
+	const size_t numberOfBytes(offsetof(ShapeKey, Values) + key.NumberOfValues * sizeof(float));
+	uint64_t hash(14695981039346656037ull);
+	for (size_t i(0); i < numberOfBytes; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return static_cast<size_t>(hash);
+}
+// End ShapeKey
+
+// ShapeCache
+ShapeCache::ShapeCache()
+	:
+	m_maximumNumberOfShapes(defaultMaximumNumberOfShapes)
+{}
+
+b2ShapeId ShapeCache::CreateShape(b2BodyId bodyId, const b2ShapeDef& shapeDef, const ShapeDefinition& shapeDefinition)
+{
+	switch (shapeDefinition.Type)
+	{
+	case ShapeType::Polygon:
+		return b2CreatePolygonShape(bodyId, &shapeDef, &shapeDefinition.Polygon);
+	case ShapeType::Circle:
+		return b2CreateCircleShape(bodyId, &shapeDef, &shapeDefinition.Circle);
+	case ShapeType::Capsule:
+		return b2CreateCapsuleShape(bodyId, &shapeDef, &shapeDefinition.Capsule);
+	default:
+		DASSERT_E(false);
+		return b2_nullShapeId;
+	}
+}
+
+void ShapeCache::SetShape(b2ShapeId shapeId, const ShapeDefinition& shapeDefinition)
+{
+	switch (shapeDefinition.Type)
+	{
+	case ShapeType::Polygon:
+		b2Shape_SetPolygon(shapeId, &shapeDefinition.Polygon);
+		return;
+	case ShapeType::Circle:
+		b2Shape_SetCircle(shapeId, &shapeDefinition.Circle);
+		return;
+	case ShapeType::Capsule:
+		b2Shape_SetCapsule(shapeId, &shapeDefinition.Capsule);
+		return;
+	default:
+		DASSERT_E(false);
+		return;
+	}
+}
+
+const ShapeDefinition& ShapeCache::GetBox(const DVec2& halfSizes, const DVec2& center)
+{
+	// Boxes are built directly, without the hull computation of the generic polygons.
+	ShapeKey key(ShapeType::Polygon);
+	key.NumberOfValues = 4;
+	key.Values[0] = halfSizes.x;
+	key.Values[1] = halfSizes.y;
+	key.Values[2] = center.x;
+	key.Values[3] = center.y;
+	shapeDefinitionContainerType::iterator it(m_shapeDefinitions.find(key));
+	if (it != m_shapeDefinitions.end())
+	{
+		return it->second;
+	}
+	ShapeDefinition shapeDefinition;
+	shapeDefinition.Type = ShapeType::Polygon;
+	shapeDefinition.Polygon = b2MakeOffsetBox(halfSizes.x, halfSizes.y, {center.x, center.y}, b2Rot_identity);
+	return Insert(key, shapeDefinition);
+}
+
+const ShapeDefinition& ShapeCache::GetCircle(const DVec2& center, float radius)
+{
+	ShapeKey key(ShapeType::Circle);
+	key.NumberOfValues = 3;
+	key.Values[0] = center.x;
+	key.Values[1] = center.y;
+	key.Values[2] = radius;
+	shapeDefinitionContainerType::iterator it(m_shapeDefinitions.find(key));
+	if (it != m_shapeDefinitions.end())
+	{
+		return it->second;
+	}
+	ShapeDefinition shapeDefinition;
+	shapeDefinition.Type = ShapeType::Circle;
+	shapeDefinition.Circle = {{center.x, center.y}, radius};
+	return Insert(key, shapeDefinition);
+}
+
+const ShapeDefinition& ShapeCache::GetCapsule(const DVec2& center1, const DVec2& center2, float radius)
+{
+	ShapeKey key(ShapeType::Capsule);
+	key.NumberOfValues = 5;
+	key.Values[0] = center1.x;
+	key.Values[1] = center1.y;
+	key.Values[2] = center2.x;
+	key.Values[3] = center2.y;
+	key.Values[4] = radius;
+	shapeDefinitionContainerType::iterator it(m_shapeDefinitions.find(key));
+	if (it != m_shapeDefinitions.end())
+	{
+		return it->second;
+	}
+	ShapeDefinition shapeDefinition;
+	shapeDefinition.Type = ShapeType::Capsule;
+	shapeDefinition.Capsule = {{center1.x, center1.y}, {center2.x, center2.y}, radius};
+	return Insert(key, shapeDefinition);
+}
+
+const ShapeDefinition& ShapeCache::GetPolygon(const DVec2* vertices, size_t numberOfVertices)
+{
+	DASSERT_E(numberOfVertices <= b2_maxPolygonVertices);
+	// The marker value makes the number of values odd, so polygon keys never match box keys.
+	ShapeKey key(ShapeType::Polygon);
+	key.NumberOfValues = static_cast<uint32_t>(2 * numberOfVertices + 1);
+	for (size_t i(0); i < numberOfVertices; i++)
+	{
+		key.Values[2 * i] = vertices[i].x;
+		key.Values[2 * i + 1] = vertices[i].y;
+	}
+	key.Values[2 * numberOfVertices] = 1.0f;
+	shapeDefinitionContainerType::iterator it(m_shapeDefinitions.find(key));
+	if (it != m_shapeDefinitions.end())
+	{
+		return it->second;
+	}
+	b2Vec2 points[b2_maxPolygonVertices];
+	b2Vec2 center{0.0f, 0.0f};
+	for (size_t i(0); i < numberOfVertices; i++)
+	{
+		points[i] = {vertices[i].x, vertices[i].y};
+		center.x += vertices[i].x / numberOfVertices;
+		center.y += vertices[i].y / numberOfVertices;
+	}
+	ShapeDefinition shapeDefinition;
+	shapeDefinition.Type = ShapeType::Polygon;
+	const b2Hull hull(b2ComputeHull(points, static_cast<int32_t>(numberOfVertices)));
+	if (hull.count == 0)
+	{
+		shapeDefinition.Polygon = b2MakeOffsetBox(0.5f, 0.5f, center, b2Rot_identity);
+	}
+	else
+	{
+		shapeDefinition.Polygon = b2MakePolygon(&hull, 0.0f);
+	}
+	return Insert(key, shapeDefinition);
+}
+
+void ShapeCache::Clear()
+{
+	m_shapeDefinitions.clear();
+}
+
+const ShapeDefinition& ShapeCache::Insert(const ShapeKey& key, const ShapeDefinition& shapeDefinition)
+{
+	// Entries are never evicted, since the body pool identifies shapes by their address.
+	if (m_shapeDefinitions.size() >= m_maximumNumberOfShapes)
+	{
+		m_uncachedShapeDefinition = shapeDefinition;
+		return m_uncachedShapeDefinition;
+	}
+	return m_shapeDefinitions.emplace(key, shapeDefinition).first->second;
+}
+// End ShapeCache
+
+}
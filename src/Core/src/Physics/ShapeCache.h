@@ -0,0 +1,101 @@
+#pragma once
+
+#include "SerializationTypes.h"
+
+#include "box2d/box2d.h"
+#include "box2d/collision.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+
+
+namespace DCore::Physics
+{
+
+enum class ShapeType : uint8_t
+{
+	Polygon,
+	Circle,
+	Capsule
+};
+
+struct ShapeDefinition
+{
+	ShapeType Type;
+	union
+	{
+		b2Polygon Polygon;
+		b2Circle Circle;
+		b2Capsule Capsule;
+	};
+};
+
+// Caches the geometry of the collider shapes already scaled and offset, so bodies with identical
+// colliders (e.g. many spawned projectiles) reuse the same precomputed shape.
+// Once the cache holds its maximum number of shapes new shapes are built without being cached.
+class ShapeCache
+{
+public:
+	static constexpr size_t maxNumberOfValues{2 * b2_maxPolygonVertices + 2};
+	static constexpr size_t defaultMaximumNumberOfShapes{4096};
+private:
+	struct ShapeKey
+	{
+		ShapeKey(ShapeType type);
+
+		ShapeType Type;
+		uint32_t NumberOfValues;
+		float Values[maxNumberOfValues];
+
+		bool operator==(const ShapeKey&) const;
+	};
+
+	struct ShapeKeyHash
+	{
+		size_t operator()(const ShapeKey&) const;
+	};
+public:
+	using shapeDefinitionContainerType = std::unordered_map<ShapeKey, ShapeDefinition, ShapeKeyHash>;
+public:
+	ShapeCache();
+	ShapeCache(const ShapeCache&) = delete;
+	ShapeCache(ShapeCache&&) = delete;
+	~ShapeCache() = default;
+public:
+	static b2ShapeId CreateShape(b2BodyId, const b2ShapeDef&, const ShapeDefinition&);
+	static void SetShape(b2ShapeId, const ShapeDefinition&);
+public:
+	// The returned references are valid until Clear is called, or, for the shapes not cached (see IsCached),
+	// until the next shape is requested.
+	const ShapeDefinition& GetBox(const DVec2& halfSizes, const DVec2& center);
+	const ShapeDefinition& GetCircle(const DVec2& center, float radius);
+	const ShapeDefinition& GetCapsule(const DVec2& center1, const DVec2& center2, float radius);
+	// If the vertices do not form a valid convex hull a box with halfSizes of 0.5 in the center of the vertices is used.
+	const ShapeDefinition& GetPolygon(const DVec2* vertices, size_t numberOfVertices);
+	void Clear();
+public:
+	size_t GetSize() const
+	{
+		return m_shapeDefinitions.size();
+	}
+
+	bool IsCached(const ShapeDefinition& shapeDefinition) const
+	{
+		return &shapeDefinition != &m_uncachedShapeDefinition;
+	}
+
+	void SetMaximumNumberOfShapes(size_t maximumNumberOfShapes)
+	{
+		m_maximumNumberOfShapes = maximumNumberOfShapes;
+	}
+private:
+	size_t m_maximumNumberOfShapes;
+	shapeDefinitionContainerType m_shapeDefinitions;
+	ShapeDefinition m_uncachedShapeDefinition;
+private:
+	const ShapeDefinition& Insert(const ShapeKey&, const ShapeDefinition&);
+};
+
+}
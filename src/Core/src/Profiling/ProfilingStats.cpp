@@ -0,0 +1,28 @@
+#include "ProfilingStats.h"
+
+
+
+namespace DCore
+{
+
+ProfilingStats::counterType& ProfilingStats::GetCounter(const stringType& name)
+{
+	lockGuardType guard(m_mutex);
+	std::unique_ptr<counterType>& counter(m_counters[name]);
+	if (counter == nullptr)
+	{
+		counter = std::make_unique<counterType>(0);
+	}
+	return *counter;
+}
+
+void ProfilingStats::ResetCounters()
+{
+	lockGuardType guard(m_mutex);
+	for (counterContainerType::value_type& counter : m_counters)
+	{
+		counter.second->store(0, std::memory_order_relaxed);
+	}
+}
+
+}
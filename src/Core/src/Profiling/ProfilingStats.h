@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+
+namespace DCore
+{
+
+// Named counters that systems update while running, so their behaviour (e.g. pool reuse, cache hits)
+// can be inspected without a debugger. Counters are never removed, so the returned references can be cached.
+class ProfilingStats
+{
+public:
+	using counterType = std::atomic<int64_t>;
+	using stringType = std::string;
+	using counterContainerType = std::map<stringType, std::unique_ptr<counterType>>;
+	using mutexType = std::mutex;
+	using lockGuardType = std::lock_guard<mutexType>;
+public:
+	ProfilingStats(const ProfilingStats&) = delete;
+	ProfilingStats(ProfilingStats&&) = delete;
+	~ProfilingStats() = default;
+public:
+	static ProfilingStats& Get()
+	{
+		static ProfilingStats instance;
+		return instance;
+	}
+public:
+	// Creates the counter, starting at zero, if it does not exist.
+	counterType& GetCounter(const stringType& name);
+	void ResetCounters();
+public:
+	// Iterates in name order. Return true from the function to stop the iteration.
+	template <class Func>
+	void IterateOnCounters(Func function)
+	{
+		lockGuardType guard(m_mutex);
+		for (const counterContainerType::value_type& counter : m_counters)
+		{
+			if (function(counter.first, counter.second->load(std::memory_order_relaxed)))
+			{
+				return;
+			}
+		}
+	}
+private:
+	ProfilingStats() = default;
+private:
+	counterContainerType m_counters;
+	mutexType m_mutex;
+};
+
+}
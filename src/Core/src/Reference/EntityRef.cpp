@@ -16,6 +16,7 @@
 #include "UUIDComponent.h"
 #include "DCoreAssert.h"
 #include "TransformComponent.h"
+#include "AnimationStateMachineComponent.h"
 
 
 
@@ -422,6 +423,15 @@ void EntityRef::RemoveParentTransformationsFrom(DMat4& model) const
 	model = parentInverseTransformations * model;
 }
 
+void EntityRef::InvalidateAnimationEventListeners()
+{
+	Registry& registry(m_internalSceneRef->GetAsset().GetRegistry());
+	if (registry.HaveComponents<AnimationStateMachineComponent>(m_entity))
+	{
+		registry.GetComponents<AnimationStateMachineComponent>(m_entity).InvalidateAnimationEventListeners();
+	}
+}
+
 EntityRef EntityRef::Duplicate()
 {
 	DASSERT_E(IsValid());
@@ -509,17 +519,13 @@ EntityRef EntityRef::Duplicate(EntityRef entityToDuplicate, EntityRef parent)
 							[&](const UUIDType& uuid) -> AnimationRef {return AssetManager::Get().GetAnimation(uuid); });
 						break;
 					case AttributeType::AnimationStateMachine:
-					{
-						AnimationStateMachineRef asmRef(*static_cast<AnimationStateMachineRef*>(attributePtr));
-						if (!asmRef.IsValid())
-						{
-							break;
-						}
-						AnimationStateMachine duplicatedAsm(asmRef.GetInternalRef()->GetAsset());
-						AnimationStateMachineRef duplicatedAsmRef(AssetManager::Get().AddAnimationStateMachine(std::move(duplicatedAsm)));
-						duplicatedComponent->OnAttributeChange(attributeId, &duplicatedAsmRef, attributeType);
+						DuplicateAssetAndAssignItToComponent(
+							attributeId,
+							*static_cast<AnimationStateMachineRef*>(attributePtr),
+							attributeType,
+							duplicatedComponent,
+							[&](const UUIDType& uuid) -> AnimationStateMachineRef {return AssetManager::Get().GetAnimationStateMachine(uuid); });
 						break;
-					}
 					case AttributeType::PhysicsMaterial:
 						DuplicateAssetAndAssignItToComponent(
 							attributeId,
@@ -121,6 +121,7 @@ public:
 				std::invoke(function, componentId, componentAddress);
 			}
 		);
+		InvalidateAnimationEventListeners();
 	}
 
 	template <class Component, class ...Components, class TupleArg, class ...TupleArgs>
@@ -129,6 +130,7 @@ public:
 		DASSERT_E(IsValid());
 		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
 		m_internalSceneRef->GetAsset().GetRegistry().AddComponents<Component, Components...>(m_entity, std::forward<TupleArg>(arg), std::forward<TupleArgs>(args)...);
+		InvalidateAnimationEventListeners();
 	}
 	
 	template <class Component, class ...Components>
@@ -256,6 +258,10 @@ private:
 	LockData* m_lockData;
 private:
 	static EntityRef Duplicate(EntityRef entityToDuplicate, EntityRef parent);
+private:
+	// The added components may handle animation events, so the listeners cached by the entity's animation state
+	// machine component must be searched for again.
+	void InvalidateAnimationEventListeners();
 private:
 	template <class AssetRefType, class GetRefFunc>
 	static void DuplicateAssetAndAssignItToComponent(
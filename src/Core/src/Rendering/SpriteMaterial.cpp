@@ -36,6 +36,23 @@ SpriteMaterial::SpriteMaterial(SpriteMaterial&& other) noexcept
 	other.m_specularMapRef.Invalidate();
 }
 
+SpriteMaterial& SpriteMaterial::operator=(SpriteMaterial&& other) noexcept
+{
+	m_type = other.m_type;
+	m_ambientMapRef = other.m_ambientMapRef;
+	m_diffuseMapRef = other.m_diffuseMapRef;
+	m_specularMapRef = other.m_specularMapRef;
+	m_glossiness = other.m_glossiness;
+	m_diffuseColor = other.m_diffuseColor;
+#ifdef EDITOR
+	m_name = std::move(other.m_name);
+#endif
+	other.m_diffuseMapRef.Invalidate();
+	other.m_ambientMapRef.Invalidate();
+	other.m_specularMapRef.Invalidate();
+	return *this;
+}
+
 SpriteMaterial::stringType SpriteMaterial::SpriteMaterialTypeToString(SpriteMaterialType type)
 {
 	switch (type)
@@ -93,7 +110,12 @@ SpriteMaterialRef::SpriteMaterialRef(SpriteMaterialRef&& other) noexcept
 
 bool SpriteMaterialRef::IsValid() const
 {
-	return m_lockData != nullptr && m_ref.IsValid();
+	if (m_lockData == nullptr)
+	{
+		return false;
+	}
+	ReadWriteLockGuard guard(LockType::ReadLock, *m_lockData);
+	return m_ref.IsValid();
 }
 
 UUIDType SpriteMaterialRef::GetUUID() const
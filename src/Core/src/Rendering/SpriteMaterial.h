@@ -27,6 +27,8 @@ public:
 	SpriteMaterial(SpriteMaterialType);
 	SpriteMaterial(SpriteMaterial&&) noexcept;
 	~SpriteMaterial() = default;
+public:
+	SpriteMaterial& operator=(SpriteMaterial&&) noexcept;
 public:
 	static stringType SpriteMaterialTypeToString(SpriteMaterialType);
 	static SpriteMaterialType StringToSpriteMaterialType(const stringType&);
@@ -104,6 +104,11 @@ Texture2D::~Texture2D()
 void Texture2D::SetFilter(Texture2DFilter filter)
 {
 	m_metadata.SetFilterMethod(filter);
+	if (!IsUploaded())
+	{
+		// The filter is set when it is uploaded.
+		return;
+	}
 	glBindTexture(GL_TEXTURE_2D, m_id);
 	switch (m_metadata.GetFilterMethod())
 	{
@@ -146,7 +151,12 @@ Texture2DRef::Texture2DRef(const Texture2DRef& other)
 
 bool Texture2DRef::IsValid() const
 {
-	return m_lockData != nullptr && m_ref.IsValid();
+	if (m_lockData == nullptr)
+	{
+		return false;
+	}
+	ReadWriteLockGuard guard(LockType::ReadLock, *m_lockData);
+	return m_ref.IsValid();
 }
 
 UUIDType Texture2DRef::GetUUID() const
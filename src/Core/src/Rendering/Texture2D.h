@@ -93,6 +93,17 @@ public:
 		return m_metadata.GetFilterMethod();
 	}
 
+	const Texture2DMetadata& GetMetadata() const
+	{
+		return m_metadata;
+	}
+
+	// Textures loaded deferred have no GL texture until they are uploaded.
+	bool IsUploaded() const
+	{
+		return m_id != 0;
+	}
+
 	Texture2D& operator=(Texture2D&& other) noexcept
 	{
 		m_id = other.m_id;
@@ -0,0 +1,257 @@
+#include "AsyncSceneLoader.h"
+#include "SceneLoader.h"
+#include "DCoreAssert.h"
+
+#include <algorithm>
+
+
+
+namespace DCore
+{
+
+AsyncSceneLoader::AsyncSceneLoader(GLFWwindow* mainContext)
+	:
+	m_nextRequestId(invalidRequestId + 1),
+	m_toStop(false)
+{
+	glfwWindowHint(GLFW_VISIBLE, false);
+	m_contexts.reserve(numberOfLoaders);
+	m_loaders.reserve(numberOfLoaders);
+	for (size_t i(0); i < numberOfLoaders; i++)
+	{
+		GLFWwindow* context(glfwCreateWindow(800, 600, "Offscreen window", nullptr, mainContext));
+		DASSERT_E(context != nullptr);
+		m_contexts.push_back(context);
+		m_loaders.emplace_back(&AsyncSceneLoader::LoaderLoop, this, context);
+	}
+}
+
+AsyncSceneLoader::~AsyncSceneLoader()
+{
+	{
+		lockGuardType guard(m_mutex);
+		m_toStop = true;
+		m_queuedRequests.clear();
+	}
+	m_requestConditionVariable.notify_all();
+	for (threadType& loader : m_loaders)
+	{
+		if (loader.joinable())
+		{
+			loader.join();
+		}
+	}
+	for (GLFWwindow* context : m_contexts)
+	{
+		glfwDestroyWindow(context);
+	}
+}
+
+AsyncSceneLoader::requestIdType AsyncSceneLoader::RequestLoad(const stringType& sceneName, LoadPriority priority)
+{
+	requestIdType requestId;
+	{
+		lockGuardType guard(m_mutex);
+		requestId = m_nextRequestId++;
+		m_queuedRequests.push_back({requestId, sceneName, priority, false});
+	}
+	m_requestConditionVariable.notify_one();
+	return requestId;
+}
+
+void AsyncSceneLoader::Cancel(requestIdType requestId)
+{
+	lockGuardType guard(m_mutex);
+	m_queuedRequests.erase
+	(
+		std::remove_if
+		(
+			m_queuedRequests.begin(), m_queuedRequests.end(),
+			[&](const Request& request) -> bool
+			{
+				return request.Id == requestId;
+			}
+		),
+		m_queuedRequests.end()
+	);
+	for (Request& request : m_requestsInProgress)
+	{
+		if (request.Id == requestId)
+		{
+			request.Canceled = true;
+		}
+	}
+	for (LoadedScene& loadedScene : m_loadedScenes)
+	{
+		if (loadedScene.RequestId == requestId)
+		{
+			loadedScene.Canceled = true;
+		}
+	}
+}
+
+void AsyncSceneLoader::CancelScene(const stringType& sceneName)
+{
+	lockGuardType guard(m_mutex);
+	m_queuedRequests.erase
+	(
+		std::remove_if
+		(
+			m_queuedRequests.begin(), m_queuedRequests.end(),
+			[&](const Request& request) -> bool
+			{
+				return request.SceneName == sceneName;
+			}
+		),
+		m_queuedRequests.end()
+	);
+	for (Request& request : m_requestsInProgress)
+	{
+		if (request.SceneName == sceneName)
+		{
+			request.Canceled = true;
+		}
+	}
+	for (LoadedScene& loadedScene : m_loadedScenes)
+	{
+		if (loadedScene.SceneName == sceneName)
+		{
+			loadedScene.Canceled = true;
+		}
+	}
+}
+
+void AsyncSceneLoader::CancelAll()
+{
+	lockGuardType guard(m_mutex);
+	m_queuedRequests.clear();
+	for (Request& request : m_requestsInProgress)
+	{
+		request.Canceled = true;
+	}
+	for (LoadedScene& loadedScene : m_loadedScenes)
+	{
+		loadedScene.Canceled = true;
+	}
+}
+
+bool AsyncSceneLoader::IsLoading(const stringType& sceneName) const
+{
+	lockGuardType guard(m_mutex);
+	const auto hasSceneName
+	(
+		[&](const auto& request) -> bool
+		{
+			return request.SceneName == sceneName && !request.Canceled;
+		}
+	);
+	return std::any_of(m_queuedRequests.begin(), m_queuedRequests.end(), hasSceneName) ||
+		std::any_of(m_requestsInProgress.begin(), m_requestsInProgress.end(), hasSceneName) ||
+		std::any_of(m_loadedScenes.begin(), m_loadedScenes.end(), hasSceneName);
+}
+
+bool AsyncSceneLoader::IsLoadInProgress(const stringType& sceneName) const
+{
+	lockGuardType guard(m_mutex);
+	const auto hasSceneName
+	(
+		[&](const auto& request) -> bool
+		{
+			return request.SceneName == sceneName;
+		}
+	);
+	return std::any_of(m_requestsInProgress.begin(), m_requestsInProgress.end(), hasSceneName) ||
+		std::any_of(m_loadedScenes.begin(), m_loadedScenes.end(), hasSceneName);
+}
+
+bool AsyncSceneLoader::TryTakeLoadedScene(LoadedScene& out)
+{
+	lockGuardType guard(m_mutex);
+	if (m_loadedScenes.empty())
+	{
+		return false;
+	}
+	out = std::move(m_loadedScenes.front());
+	m_loadedScenes.pop_front();
+	return true;
+}
+
+void AsyncSceneLoader::WaitForLoadsInProgress()
+{
+	uniqueLockType lock(m_mutex);
+	m_loadDoneConditionVariable.wait
+	(
+		lock,
+		[&]() -> bool
+		{
+			return m_requestsInProgress.empty();
+		}
+	);
+}
+
+void AsyncSceneLoader::LoaderLoop(GLFWwindow* context)
+{
+	glfwMakeContextCurrent(context);
+	while (true)
+	{
+		Request request;
+		{
+			uniqueLockType lock(m_mutex);
+			m_requestConditionVariable.wait
+			(
+				lock,
+				[&]() -> bool
+				{
+					return m_toStop || !m_queuedRequests.empty();
+				}
+			);
+			if (m_toStop)
+			{
+				break;
+			}
+			const size_t requestIndex(GetNextRequestIndex());
+			request = std::move(m_queuedRequests[requestIndex]);
+			m_queuedRequests.erase(m_queuedRequests.begin() + requestIndex);
+			m_requestsInProgress.push_back(request);
+		}
+		SceneRef scene(SceneLoader::Get().LoadScene(request.SceneName));
+		{
+			lockGuardType guard(m_mutex);
+			requestContainerType::iterator it
+			(
+				std::find_if
+				(
+					m_requestsInProgress.begin(), m_requestsInProgress.end(),
+					[&](const Request& requestInProgress) -> bool
+					{
+						return requestInProgress.Id == request.Id;
+					}
+				)
+			);
+			DASSERT_E(it != m_requestsInProgress.end());
+			m_loadedScenes.push_back({request.Id, std::move(request.SceneName), scene, it->Canceled});
+			m_requestsInProgress.erase(it);
+		}
+		m_loadDoneConditionVariable.notify_all();
+	}
+	glfwMakeContextCurrent(nullptr);
+}
+
+size_t AsyncSceneLoader::GetNextRequestIndex() const
+{
+	DASSERT_E(!m_queuedRequests.empty());
+	size_t nextRequestIndex(0);
+	for (size_t i(1); i < m_queuedRequests.size(); i++)
+	{
+		const Request& request(m_queuedRequests[i]);
+		const Request& nextRequest(m_queuedRequests[nextRequestIndex]);
+		if (request.Priority > nextRequest.Priority ||
+			(request.Priority == nextRequest.Priority && request.Id < nextRequest.Id))
+		{
+			nextRequestIndex = i;
+		}
+	}
+	return nextRequestIndex;
+}
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Scene.h"
+#include "Graphics.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+enum class LoadPriority
+{
+	Low,
+	Normal,
+	High
+};
+
+// Loads scenes with SceneLoader on a small fixed pool of threads. Requests are served by priority, then in the
+// order they were made. Each loader owns a hidden window with a GL context shared with the main one, for the GL
+// objects created while loading.
+// Must be created and destroyed in the main thread, as it creates windows.
+class AsyncSceneLoader
+{
+public:
+	static constexpr size_t numberOfLoaders{2};
+public:
+	using stringType = std::string;
+	using requestIdType = uint64_t;
+	using threadType = std::thread;
+	using threadContainerType = std::vector<threadType>;
+	using contextContainerType = std::vector<GLFWwindow*>;
+	using mutexType = std::mutex;
+	using uniqueLockType = std::unique_lock<mutexType>;
+	using lockGuardType = std::lock_guard<mutexType>;
+	using conditionVariableType = std::condition_variable;
+public:
+	static constexpr requestIdType invalidRequestId{0};
+public:
+	struct LoadedScene
+	{
+		requestIdType RequestId;
+		stringType SceneName;
+		SceneRef Scene;
+		// The request was canceled while the scene was being loaded. The scene must be unloaded.
+		bool Canceled;
+	};
+private:
+	struct Request
+	{
+		requestIdType Id;
+		stringType SceneName;
+		LoadPriority Priority;
+		bool Canceled;
+	};
+private:
+	using requestContainerType = std::vector<Request>;
+	using loadedSceneContainerType = std::deque<LoadedScene>;
+public:
+	AsyncSceneLoader(GLFWwindow* mainContext);
+	AsyncSceneLoader(const AsyncSceneLoader&) = delete;
+	AsyncSceneLoader(AsyncSceneLoader&&) = delete;
+	~AsyncSceneLoader();
+public:
+	requestIdType RequestLoad(const stringType& sceneName, LoadPriority = LoadPriority::Normal);
+	// A queued request is dropped. A scene being loaded is still loaded, then given back as canceled.
+	void Cancel(requestIdType);
+	void CancelScene(const stringType& sceneName);
+	void CancelAll();
+	// If the scene is queued, being loaded or loaded but not taken yet.
+	bool IsLoading(const stringType& sceneName) const;
+	// If the scene is being loaded or loaded but not taken yet, even if canceled. The scene of such a load is owned
+	// by the loader until it is taken.
+	bool IsLoadInProgress(const stringType& sceneName) const;
+	bool TryTakeLoadedScene(LoadedScene& out);
+	// Waits for the scenes being loaded. Queued requests are not waited for.
+	void WaitForLoadsInProgress();
+private:
+	threadContainerType m_loaders;
+	contextContainerType m_contexts;
+	requestContainerType m_queuedRequests;
+	requestContainerType m_requestsInProgress;
+	loadedSceneContainerType m_loadedScenes;
+	requestIdType m_nextRequestId;
+	mutable mutexType m_mutex;
+	conditionVariableType m_requestConditionVariable;
+	conditionVariableType m_loadDoneConditionVariable;
+	bool m_toStop;
+private:
+	void LoaderLoop(GLFWwindow* context);
+	// Requires m_mutex.
+	size_t GetNextRequestIndex() const;
+};
+
+}
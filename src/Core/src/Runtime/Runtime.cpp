@@ -13,14 +13,19 @@
 #include "Quad.h"
 #include "AnimationStateMachineComponent.h"
 #include "BoxColliderComponent.h"
+#include "CircleColliderComponent.h"
+#include "CapsuleColliderComponent.h"
+#include "PolygonColliderComponent.h"
 #include "PhysicsAPI.h"
 #include "ScriptComponent.h"
 #include "ChildrenComponent.h"
 #include "Sound.h"
 #include "SceneLoader.h"
+#include "WorkerPool.h"
 
 #include "box2d/types.h"
 
+#include <algorithm>
 
 
 namespace DCore
@@ -41,6 +46,109 @@ struct OverlapContext
 	bool Overlap;
 };
 
+static void SubmitDebugCollider(const DMat4& viewProjectionMatrix, Renderer& renderer, const EntityRef& entityRef, ComponentRef<TransformComponent> transform, const DVec2& offset, const DVec2& sizes)
+{
+	const DVec3 translation(transform.GetTranslation());
+	const DFloat rotation(transform.GetRotation());
+	const DVec2 scale(transform.GetScale());
+	const TransformComponent transformComponent({{translation.x, translation.y, 0.0f}, rotation, scale});
+	DMat4 mvp(viewProjectionMatrix);
+	if (entityRef.HaveParent())
+	{
+		mvp *= entityRef.GetWorldModelMatrix();
+	}
+	else
+	{
+		mvp *= transformComponent.GetModelMatrix();
+	}
+	Renderer::debugRectObjectRenderer::objectType object;
+	DebugRectVertex& vertex(object[0]);
+	vertex.MVP = mvp;
+	vertex.Offset = offset;
+	vertex.RectSizes = sizes;
+	vertex.Color = {0.0f, 1.0f, 0.0f, 1.0f};
+	renderer.SubmitDebugRectObject(object);
+}
+
+// The debug renderer only draws rects, so the colliders that are not boxes are drawn by their bounds.
+static void GetColliderDebugRect(const ComponentRef<BoxColliderComponent>& boxCollider, DVec2& offset, DVec2& sizes)
+{
+	offset = boxCollider.GetOffset();
+	sizes = boxCollider.GetSizes();
+}
+
+static void GetColliderDebugRect(const ComponentRef<CircleColliderComponent>& circleCollider, DVec2& offset, DVec2& sizes)
+{
+	const DFloat diameter(2.0f * circleCollider.GetRadius());
+	offset = circleCollider.GetOffset();
+	sizes = {diameter, diameter};
+}
+
+static void GetColliderDebugRect(const ComponentRef<CapsuleColliderComponent>& capsuleCollider, DVec2& offset, DVec2& sizes)
+{
+	const DFloat diameter(2.0f * capsuleCollider.GetRadius());
+	offset = capsuleCollider.GetOffset();
+	sizes = {diameter, (std::max)(diameter, capsuleCollider.GetHeight())};
+}
+
+static void GetColliderDebugRect(const ComponentRef<PolygonColliderComponent>& polygonCollider, DVec2& offset, DVec2& sizes)
+{
+	DVec2 vertices[maxPolygonColliderVertices];
+	const size_t vertexCount(polygonCollider.GetVertices(vertices));
+	DVec2 min(vertices[0]), max(vertices[0]);
+	for (size_t i(1); i < vertexCount; i++)
+	{
+		min = glm::min(min, vertices[i]);
+		max = glm::max(max, vertices[i]);
+	}
+	offset = polygonCollider.GetOffset() + (min + max) / 2.0f;
+	sizes = max - min;
+}
+
+template <class ColliderComponentT>
+static void SubmitDebugColliders(const DMat4& viewProjectionMatrix, Renderer& renderer, SceneRef sceneRef)
+{
+	sceneRef.Iterate<TransformComponent, ColliderComponentT>
+	(
+		[&](Entity entity, ComponentRef<TransformComponent> transform, ComponentRef<ColliderComponentT> collider) -> bool
+		{
+			if (!collider.HaveToDrawCollider())
+			{
+				return false;
+			}
+			DVec2 offset, sizes;
+			GetColliderDebugRect(collider, offset, sizes);
+			SubmitDebugCollider(viewProjectionMatrix, renderer, EntityRef(entity, sceneRef), transform, offset, sizes);
+			return false;
+		}
+	);
+}
+
+static bool TryGetColliderBodyId(EntityRef entity, DBodyId& bodyId)
+{
+	if (entity.HaveComponents<BoxColliderComponent>())
+	{
+		bodyId = entity.GetComponents<BoxColliderComponent>().GetBodyId();
+		return true;
+	}
+	if (entity.HaveComponents<CircleColliderComponent>())
+	{
+		bodyId = entity.GetComponents<CircleColliderComponent>().GetBodyId();
+		return true;
+	}
+	if (entity.HaveComponents<CapsuleColliderComponent>())
+	{
+		bodyId = entity.GetComponents<CapsuleColliderComponent>().GetBodyId();
+		return true;
+	}
+	if (entity.HaveComponents<PolygonColliderComponent>())
+	{
+		bodyId = entity.GetComponents<PolygonColliderComponent>().GetBodyId();
+		return true;
+	}
+	return false;
+}
+
 }
 
 static float RayCastCallback(b2ShapeId shapeId, b2Vec2 point, b2Vec2 normal, float fraction, void* context)
@@ -68,6 +176,63 @@ static bool OverlapCallback(b2ShapeId shapeId, void* context)
 	return overlapContext->EntitiesSize < overlapContext->MaxEntitiesSize;
 }
 
+static void ExecuteQuery(b2WorldId worldId, DCore::Runtime* runtime, const DCore::Physics::QueryRequest& request, DCore::Physics::QueryResult& result)
+{
+	using namespace DCore;
+	result.NumberOfOverlapEntities = 0;
+	b2QueryFilter filter(b2DefaultQueryFilter());
+	filter.maskBits = request.OnlyCollideWithLayers;
+	switch (request.Type)
+	{
+	case Physics::QueryType::CastBox:
+	case Physics::QueryType::RayCast:
+	{
+		RayCastContext rayCastContext;
+		rayCastContext.Runtime = runtime;
+		rayCastContext.Result.Hit = false;
+		const b2Vec2 translation({request.Direction.x * request.MaxDistance, request.Direction.y * request.MaxDistance});
+		if (request.Type == Physics::QueryType::RayCast)
+		{
+			b2World_CastRay(worldId, {request.Origin.x, request.Origin.y}, translation, filter, &RayCastCallback, &rayCastContext);
+		}
+		else
+		{
+			b2Polygon boxPolygon(b2MakeOffsetBox(request.BoxSizes.x/2.0f, request.BoxSizes.y/2.0f, {0.0f, 0.0f}, b2MakeRot(glm::radians(request.BoxRotation))));
+			b2Transform transform;
+			transform.p = {request.Origin.x, request.Origin.y};
+			transform.q = b2Rot_identity;
+			b2World_CastPolygon(worldId, &boxPolygon, transform, translation, filter, &RayCastCallback, &rayCastContext);
+		}
+		result.RayCast = rayCastContext.Result;
+		result.Hit = rayCastContext.Result.Hit;
+		return;
+	}
+	case Physics::QueryType::OverlapBox:
+	{
+		Physics::OverlapResult overlapResult;
+		overlapResult.Entities = request.OverlapEntities;
+		OverlapContext overlapContext;
+		overlapContext.Runtime = runtime;
+		overlapContext.Result = request.OverlapEntities != nullptr ? &overlapResult : nullptr;
+		overlapContext.MaxEntitiesSize = request.MaxOverlapEntities;
+		overlapContext.EntitiesSize = 0;
+		overlapContext.Overlap = false;
+		b2Polygon boxPolygon(b2MakeOffsetBox(request.BoxSizes.x/2.0f, request.BoxSizes.y/2.0f, {0.0f, 0.0f}, b2MakeRot(glm::radians(request.BoxRotation))));
+		b2Transform transform;
+		transform.p = {request.Origin.x, request.Origin.y};
+		transform.q = b2Rot_identity;
+		filter.categoryBits = request.SelfPhysicsLayer;
+		b2World_OverlapPolygon(worldId, &boxPolygon, transform, filter, &OverlapCallback, &overlapContext);
+		result.NumberOfOverlapEntities = overlapContext.EntitiesSize;
+		result.Hit = overlapContext.Overlap;
+		return;
+	}
+	default:
+		DASSERT_E(false);
+		return;
+	}
+}
+
 namespace DCore
 {
 
@@ -76,17 +241,12 @@ Runtime::Runtime(GLFWwindow* context)
 	m_toContinueSimulation(false),
 	m_currentState(RuntimeState::NotPlaying),
 	m_physicsWorldId(b2_nullWorldId),
-	m_nextAsyncContext(0)
+	m_sceneLoader(context),
+	m_sceneSetupBudget(defaultSceneSetupBudget)
 {
 	Input::Get().Start(context);
 	glfwWindowHint(GLFW_VISIBLE, false);
 	m_context = glfwCreateWindow(800, 600, "Offscreen window", nullptr, context);
-	for (size_t i(0); i < maximumNumberOfScenesLoadedAsync; i++)
-	{
-		AsyncSceneContext asyncSceneContext;
-		asyncSceneContext.Context = glfwCreateWindow(800, 600, "Offscreen window", nullptr, context);
-		m_asyncSceneContexts.PushBack(std::move(asyncSceneContext));
-	}
 	DASSERT_E(m_context != nullptr);
 }
 
@@ -97,13 +257,6 @@ Runtime::~Runtime()
 	{
 		DASSERT_E(m_gameLoopThread.joinable());
 		m_gameLoopThread.join();
-		for (AsyncSceneContext& context : m_asyncSceneContexts)
-		{
-			if (context.Context != nullptr)
-			{
-				glfwDestroyWindow(context.Context);
-			}
-		}
 	}
 	if (m_context != nullptr)
 	{
@@ -191,6 +344,8 @@ void Runtime::MakeRendererSubmitions(const DMat4& viewProjectionMatrix, Renderer
 						if (spriteComponent.GetSpriteMaterialRef().GetDiffuseMapRef().IsValid())
 						{
 							diffuseTextureId = spriteComponent.GetSpriteMaterialRef().GetDiffuseMapRef().GetId();
+							// Textures waiting for their upload have no id yet.
+							toUseDiffuseTexture = diffuseTextureId != 0;
 						}
 						else
 						{
@@ -220,40 +375,10 @@ void Runtime::MakeRendererSubmitions(const DMat4& viewProjectionMatrix, Renderer
 					return false;
 				}
 			);
-			sceneRef.Iterate<TransformComponent, BoxColliderComponent>
-			(
-				[&](Entity entity, ComponentRef<TransformComponent> transform, ComponentRef<BoxColliderComponent> boxCollider) -> bool
-				{
-					if (!boxCollider.HaveToDrawCollider())
-					{
-						return false;
-					}
-					const DVec3 translation(transform.GetTranslation());
-					const DVec2 sizes(boxCollider.GetSizes());
-					const DFloat rotation(transform.GetRotation());
-					const DVec2 scale(transform.GetScale());
-					const DVec2 offset(boxCollider.GetOffset());
-					const TransformComponent transformComponent({{translation.x, translation.y, 0.0f}, rotation, scale});
-					const EntityRef entityRef(entity, sceneRef);
-					DMat4 mvp(viewProjectionMatrix);
-					if (entityRef.HaveParent())
-					{
-						mvp *= entityRef.GetWorldModelMatrix();
-					}
-					else
-					{
-						mvp *= transformComponent.GetModelMatrix();
-					}
-					Renderer::debugRectObjectRenderer::objectType object;
-					DebugRectVertex& vertex(object[0]);
-					vertex.MVP = mvp;
-					vertex.Offset = offset;
-					vertex.RectSizes = sizes;
-					vertex.Color = {0.0f, 1.0f, 0.0f, 1.0f};
-					renderer.SubmitDebugRectObject(object);
-					return false;
-				}
-			);
+			SubmitDebugColliders<BoxColliderComponent>(viewProjectionMatrix, renderer, sceneRef);
+			SubmitDebugColliders<CircleColliderComponent>(viewProjectionMatrix, renderer, sceneRef);
+			SubmitDebugColliders<CapsuleColliderComponent>(viewProjectionMatrix, renderer, sceneRef);
+			SubmitDebugColliders<PolygonColliderComponent>(viewProjectionMatrix, renderer, sceneRef);
 			return false;
 		}
 	);
@@ -298,7 +423,6 @@ void Runtime::End()
 	}
 	m_currentState = RuntimeState::NotPlaying;
 	m_toContinueSimulation.store(false, std::memory_order_relaxed);
-	m_nextAsyncContext = 0;
 	DASSERT_E(m_gameLoopThread.joinable());
 	m_gameLoopThread.join();
 	Input::Get().RemoveRuntime(m_inputIndex);
@@ -448,6 +572,52 @@ bool Runtime::OverlapBox(float boxRotation, const DVec2& boxSizes, const DVec2&
 	return context.Overlap;
 }
 
+void Runtime::BatchQuery(const queryRequestType* requests, size_t numberOfRequests, queryResultType* results)
+{
+	DASSERT_E(numberOfRequests == 0 || (requests != nullptr && results != nullptr));
+	if (B2_IS_NULL(m_physicsWorldId))
+	{
+		for (size_t i(0); i < numberOfRequests; i++)
+		{
+			results[i].NumberOfOverlapEntities = 0;
+			results[i].RayCast.Hit = false;
+			results[i].Hit = false;
+		}
+		return;
+	}
+	const b2WorldId worldId(m_physicsWorldId);
+	WorkerPool::Get().ParallelFor
+	(
+		numberOfRequests, 
+		minimumQueriesPerBatch,
+		[&](size_t begin, size_t end) -> void
+		{
+			for (size_t i(begin); i < end; i++)
+			{
+				ExecuteQuery(worldId, this, requests[i], results[i]);
+			}
+		}
+	);
+}
+
+void Runtime::EnableBodyPooling(size_t maximumBodiesPerArchetype)
+{
+	ReadWriteLockGuard runtimeGuard(LockType::WriteLock, m_lockData);
+	m_bodyPool.Enable(maximumBodiesPerArchetype);
+}
+
+void Runtime::DisableBodyPooling()
+{
+	ReadWriteLockGuard runtimeGuard(LockType::WriteLock, m_lockData);
+	m_bodyPool.Disable();
+	if (B2_IS_NULL(m_physicsWorldId))
+	{
+		m_bodyPool.Clear();
+		return;
+	}
+	DestroyPooledBodies();
+}
+
 void Runtime::AddDrawDebugBoxCommand(const DrawDebugBoxCommand& command)
 {
 	ReadWriteLockGuard guard(LockType::WriteLock, m_lockData);
@@ -464,9 +634,14 @@ void Runtime::SetSceneToLoad(const stringType& sceneName)
 	m_namesOfScenesToLoad.push_back(sceneName);
 }
 
-void Runtime::SetSceneToLoadAsync(const stringType& sceneName)
+AsyncSceneLoader::requestIdType Runtime::SetSceneToLoadAsync(const stringType& sceneName, LoadPriority priority)
 {
-	m_namesOfScenesToLoadAsync.push_back(sceneName);
+	return m_sceneLoader.RequestLoad(sceneName, priority);
+}
+
+void Runtime::CancelSceneLoadAsync(AsyncSceneLoader::requestIdType requestId)
+{
+	m_sceneLoader.Cancel(requestId);
 }
 
 void Runtime::AddKeyEvent(KeyEvent event)
@@ -490,6 +665,67 @@ bool Runtime::KeyReleasedThisFrame(DKey key)
 	return m_keyStateBuffers.KeysReleasedThisFrame[KEY_TO_INT(key)];
 }
 
+void Runtime::SetSceneSetupBudget(uint64_t microseconds)
+{
+	m_sceneSetupBudget = microseconds;
+}
+
+bool Runtime::TryGetSceneLoadingProgress(const stringType& sceneName, float& outProgress) const
+{
+	constexpr size_t numberOfSceneSetupStages{4};
+	for (const SceneSetup& sceneSetup : m_sceneSetups)
+	{
+		if (sceneSetup.SceneName != sceneName)
+		{
+			continue;
+		}
+		const size_t numberOfSteps(numberOfSceneSetupStages * sceneSetup.Entities.size());
+		const size_t doneSteps(static_cast<size_t>(sceneSetup.Stage) * sceneSetup.Entities.size() + sceneSetup.NextEntityIndex);
+		outProgress = numberOfSteps == 0 ? 1.0f : static_cast<float>(doneSteps) / static_cast<float>(numberOfSteps);
+		return true;
+	}
+	if (m_sceneLoader.IsLoading(sceneName))
+	{
+		outProgress = 0.0f;
+		return true;
+	}
+	return false;
+}
+
+void Runtime::PreloadScene(const stringType& sceneName)
+{
+	for (const std::unique_ptr<ScenePreload>& scenePreload : m_scenePreloads)
+	{
+		if (scenePreload->GetSceneName() == sceneName)
+		{
+			return;
+		}
+	}
+	m_scenePreloads.push_back(std::make_unique<ScenePreload>(sceneName));
+	ScenePreload* scenePreload(m_scenePreloads.back().get());
+	WorkerPool::Get().Submit
+	(
+		[scenePreload]() -> void
+		{
+			SceneLoader::Get().PreloadScene(scenePreload->GetSceneName(), *scenePreload);
+			scenePreload->Complete();
+		}
+	);
+}
+
+bool Runtime::TryGetScenePreloadProgress(const stringType& sceneName, float& outProgress) const
+{
+	for (const std::unique_ptr<ScenePreload>& scenePreload : m_scenePreloads)
+	{
+		if (scenePreload->GetSceneName() == sceneName)
+		{
+			outProgress = scenePreload->GetProgress();
+			return true;
+		}
+	}
+	return false;
+}
+
 void Runtime::GameLoop()
 {
 	constexpr float physicsDeltaTime{1.0f/60.0f};
@@ -538,60 +774,65 @@ void Runtime::GameLoop()
 		animationAccumulatedDeltaTime += deltaTime;
 		for (const stringType& sceneName : m_namesOfScenesToUnload)
 		{
-			for (AsyncSceneContext& context : m_asyncSceneContexts)
+			// The loads of other scenes go on. A scene still being loaded is not unloaded here, as the loader
+			// is filling it: it is unloaded when it is handed back canceled.
+			m_sceneLoader.CancelScene(sceneName);
+			if (m_sceneLoader.IsLoadInProgress(sceneName))
 			{
-				if (context.LoadingThread.joinable())
-				{
-					context.LoadingThread.join();
-				}
+				continue;
 			}
-			m_nextAsyncContext = 0;
 			UnloadScene(sceneName);
 		}
 		if (!m_namesOfScenesToUnload.empty())
 		{
 			m_namesOfScenesToUnload.clear();
+			m_sceneSetups.erase
+			(
+				std::remove_if
+				(
+					m_sceneSetups.begin(), m_sceneSetups.end(),
+					[](const SceneSetup& sceneSetup) -> bool
+					{
+						return !sceneSetup.Scene.IsValid();
+					}
+				),
+				m_sceneSetups.end()
+			);
 		}
 		for (const stringType& sceneName : m_namesOfScenesToLoad)
 		{
 			SceneRef scene(SceneLoader::Get().LoadScene(sceneName));
 			SetupScene(scene);
+			ReleaseScenePreload(sceneName);
 		}
 		if (!m_namesOfScenesToLoad.empty())
 		{
 			m_namesOfScenesToLoad.clear();
 		}
-		for (const stringType& sceneName : m_namesOfScenesToLoadAsync)
-		{
-			if (m_nextAsyncContext >= maximumNumberOfScenesLoadedAsync)
-			{
-				m_nextAsyncContext = 0;
-			}
-			AsyncSceneContext& context(m_asyncSceneContexts[m_nextAsyncContext++]);
-			if (context.LoadingThread.joinable())
-			{
-				context.LoadingThread.join();
-			}
-			context.LoadingDone = false;
-			context.AtomicLoadingDone = false;
-			context.LoadingThread = std::thread(&Runtime::LoadSceneAsync, this, sceneName, &context);
-		}
-		if (!m_namesOfScenesToLoadAsync.empty())
-		{
-			m_namesOfScenesToLoadAsync.clear();
-		}
 	}
-	for (AsyncSceneContext& context : m_asyncSceneContexts)
+	m_sceneLoader.CancelAll();
+	m_sceneLoader.WaitForLoadsInProgress();
+	AsyncSceneLoader::LoadedScene loadedScene;
+	while (m_sceneLoader.TryTakeLoadedScene(loadedScene))
 	{
-		if (context.LoadingThread.joinable())
+		if (loadedScene.Scene.IsValid())
 		{
-			context.LoadingThread.join();
+			UnloadScene(loadedScene.Scene);
 		}
-		context.LoadingDone = true;
 	}
+	for (std::unique_ptr<ScenePreload>& scenePreload : m_scenePreloads)
+	{
+		// The job of the preload refers to it.
+		scenePreload->WaitForCompletion();
+		scenePreload->Release();
+	}
+	m_scenePreloads.clear();
+	m_sceneSetups.clear();
 	TerminateEntities();
 	b2DestroyWorld(m_physicsWorldId);
 	m_physicsWorldId = b2_nullWorldId;
+	m_bodyPool.Clear();
+	m_bodyPool.Disable();
 	Sound::Get().Update();
 }
 
@@ -600,59 +841,108 @@ void Runtime::SetupPhysics()
 	b2WorldDef worldDef(b2DefaultWorldDef());
 	m_physicsWorldId = b2CreateWorld(&worldDef);
 	m_userDatas.Clear();
+	m_shapeCache.Clear();
 	ReadWriteLockGuard runtimeGuard(LockType::WriteLock, m_lockData);
 	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
 	AssetManager::Get().IterateOnLoadedScenes
 	(
 		[&](SceneRef scene) -> bool
 		{
-			// TODO. Considerar outros componentes de colisores.
-			scene.Iterate<TransformComponent, BoxColliderComponent>
-			(
-				[&](Entity entity, ComponentRef<TransformComponent> transform, ComponentRef<BoxColliderComponent> boxCollider) -> bool
-				{
-					SetupEntityPhysics({entity, scene});
-					return false;
-				}
-			);
+			SetupCollidersPhysics<BoxColliderComponent>(scene);
+			SetupCollidersPhysics<CircleColliderComponent>(scene);
+			SetupCollidersPhysics<CapsuleColliderComponent>(scene);
+			SetupCollidersPhysics<PolygonColliderComponent>(scene);
 			return false;
 		}
 	);
 }
 
-void Runtime::SetupEntityPhysics(EntityRef entity)
+bool Runtime::SetupEntityPhysics(EntityRef entity, bool enableBody)
+{
+	if (entity.HaveComponents<BoxColliderComponent>())
+	{
+		SetupColliderPhysics(entity, entity.GetComponents<BoxColliderComponent>(), enableBody);
+		return true;
+	}
+	if (entity.HaveComponents<CircleColliderComponent>())
+	{
+		SetupColliderPhysics(entity, entity.GetComponents<CircleColliderComponent>(), enableBody);
+		return true;
+	}
+	if (entity.HaveComponents<CapsuleColliderComponent>())
+	{
+		SetupColliderPhysics(entity, entity.GetComponents<CapsuleColliderComponent>(), enableBody);
+		return true;
+	}
+	if (entity.HaveComponents<PolygonColliderComponent>())
+	{
+		SetupColliderPhysics(entity, entity.GetComponents<PolygonColliderComponent>(), enableBody);
+		return true;
+	}
+	return false;
+}
+
+void Runtime::EnableEntityBody(EntityRef entity)
+{
+	if (entity.HaveComponents<BoxColliderComponent>())
+	{
+		EnableColliderBody(entity.GetComponents<BoxColliderComponent>());
+		return;
+	}
+	if (entity.HaveComponents<CircleColliderComponent>())
+	{
+		EnableColliderBody(entity.GetComponents<CircleColliderComponent>());
+		return;
+	}
+	if (entity.HaveComponents<CapsuleColliderComponent>())
+	{
+		EnableColliderBody(entity.GetComponents<CapsuleColliderComponent>());
+		return;
+	}
+	if (entity.HaveComponents<PolygonColliderComponent>())
+	{
+		EnableColliderBody(entity.GetComponents<PolygonColliderComponent>());
+		return;
+	}
+}
+
+template <class ColliderComponentT>
+void Runtime::SetupCollidersPhysics(SceneRef scene)
+{
+	scene.Iterate<TransformComponent, ColliderComponentT>
+	(
+		[&](Entity entity, ComponentRef<TransformComponent> transform, ComponentRef<ColliderComponentT> collider) -> bool
+		{
+			SetupColliderPhysics<ColliderComponentT>({entity, scene}, collider);
+			return false;
+		}
+	);
+}
+
+template <class ColliderComponentT>
+void Runtime::SetupColliderPhysics(EntityRef entity, ComponentRef<ColliderComponentT> collider, bool enableBody)
 {
-	auto [transform, boxCollider] = entity.GetComponents<TransformComponent, BoxColliderComponent>();
 	b2BodyDef bodyDef(b2DefaultBodyDef());
 	const DMat4 modelMatrix(entity.GetWorldModelMatrix());
 	DVec2 translation, scale;
 	float rotation;
 	Math::Decompose(modelMatrix, translation, rotation, scale);
-	bodyDef.type = Physics::CoreBodyTypeToBox2dBodyType(boxCollider.GetBodyType());
+	bodyDef.type = Physics::CoreBodyTypeToBox2dBodyType(collider.GetBodyType());
 	bodyDef.position = {translation.x, translation.y};	
 	bodyDef.rotation = b2MakeRot(glm::radians(rotation));
-	bodyDef.isEnabled = boxCollider.IsEnabled();
+	bodyDef.isEnabled = enableBody && collider.IsEnabled();
 	bodyDef.enableSleep = false;
-	bodyDef.fixedRotation = boxCollider.IsRotationFixed();
-	bodyDef.gravityScale = boxCollider.GetGravityScale();
-	userDataContainerType::Ref userData(m_userDatas.PushBack(entity));
-	userData->Index = userData.GetIndex();
-	bodyDef.userData = reinterpret_cast<void*>(userData.GetId() - 1);
-	b2BodyId bodyId(b2CreateBody(m_physicsWorldId, &bodyDef));
-	boxCollider.SetBodyId(bodyId);
-	boxCollider.SetLinearVelocity({ 0.0f, 0.0f });
-	const DVec2 boxColliderSizes(boxCollider.GetSizes());
-	const DVec2 boxColliderOffset(boxCollider.GetOffset());
-	b2Polygon polygon(b2MakeOffsetBox(glm::abs(scale.x * boxColliderSizes.x/2.0f), glm::abs(scale.y * boxColliderSizes.y/2.0f), {scale.x * boxColliderOffset.x, scale.y * boxColliderOffset.y}, b2Rot_identity));
+	bodyDef.fixedRotation = collider.IsRotationFixed();
+	bodyDef.gravityScale = collider.GetGravityScale();
+	const Physics::ShapeDefinition& shapeDefinition(GetColliderShape(collider, scale));
 	b2ShapeDef shapeDef(b2DefaultShapeDef());
-	shapeDef.isSensor = boxCollider.IsSensor();
+	shapeDef.isSensor = collider.IsSensor();
 	shapeDef.enableContactEvents = true;
-	const Physics::PhysicsLayer selfPhysicsLayer(boxCollider.GetSelfPhysicsLayer());
-	const Physics::PhysicsLayer collideWithPhysicsPlayers(boxCollider.GetCollideWithPhysicsLayers());
+	const Physics::PhysicsLayer selfPhysicsLayer(collider.GetSelfPhysicsLayer());
+	const Physics::PhysicsLayer collideWithPhysicsPlayers(collider.GetCollideWithPhysicsLayers());
 	shapeDef.filter.categoryBits = selfPhysicsLayer == Physics::PhysicsLayer::Unspecified ? B2_DEFAULT_CATEGORY_BITS : static_cast<uint64_t>(selfPhysicsLayer);
 	shapeDef.filter.maskBits = collideWithPhysicsPlayers == Physics::PhysicsLayer::Unspecified ? B2_DEFAULT_MASK_BITS : static_cast<uint64_t>(collideWithPhysicsPlayers);
-	shapeDef.userData = bodyDef.userData;
-	const PhysicsMaterialRef physicsMaterial(boxCollider.GetPhysicsMaterial());
+	const PhysicsMaterialRef physicsMaterial(collider.GetPhysicsMaterial());
 	ReadWriteLockGuard guard(LockType::ReadLock, *static_cast<PhysicsMaterialAssetManager*>(&AssetManager::Get()));
 	if (physicsMaterial.IsValid())
 	{
@@ -660,7 +950,88 @@ void Runtime::SetupEntityPhysics(EntityRef entity)
 		shapeDef.friction = physicsMaterial.GetFriction();
 		shapeDef.restitution = physicsMaterial.GetRestitution();
 	}
-	boxCollider.SetShapeId(b2CreatePolygonShape(bodyId, &shapeDef, &polygon));
+	b2BodyId bodyId;
+	// Pooled bodies are grouped by the address of their cached shape, so bodies of uncached shapes are not pooled.
+	if (m_bodyPool.IsEnabled() && m_shapeCache.IsCached(shapeDefinition) &&
+		m_bodyPool.TryAcquire(m_bodyPool.GetArchetypeIndex({shapeDefinition, shapeDef}), bodyId))
+	{
+		// The shape and its user data are kept, only the body state is reset to what a new body would have.
+		UserData& userData(m_userDatas[reinterpret_cast<size_t>(b2Body_GetUserData(bodyId))]);
+		userData.Entity = entity;
+		userData.Shape = &shapeDefinition;
+		b2Body_SetType(bodyId, bodyDef.type);
+		b2Body_SetTransform(bodyId, bodyDef.position, bodyDef.rotation);
+		b2Body_SetFixedRotation(bodyId, bodyDef.fixedRotation);
+		b2Body_SetGravityScale(bodyId, bodyDef.gravityScale);
+		b2Body_SetBullet(bodyId, bodyDef.isBullet);
+		b2Body_Enable(bodyId);
+		b2Body_SetLinearVelocity(bodyId, b2Vec2_zero);
+		b2Body_SetAngularVelocity(bodyId, 0.0f);
+		if (!bodyDef.isEnabled)
+		{
+			b2Body_Disable(bodyId);
+		}
+		b2ShapeId shapeId;
+		b2Body_GetShapes(bodyId, &shapeId, 1);
+		collider.SetBodyId(bodyId);
+		collider.SetLinearVelocity({ 0.0f, 0.0f });
+		collider.SetShapeId(shapeId);
+		return;
+	}
+	userDataContainerType::Ref userData(m_userDatas.PushBack(entity));
+	userData->Index = userData.GetIndex();
+	userData->Shape = m_shapeCache.IsCached(shapeDefinition) ? &shapeDefinition : nullptr;
+	bodyDef.userData = reinterpret_cast<void*>(userData.GetId() - 1);
+	bodyId = b2CreateBody(m_physicsWorldId, &bodyDef);
+	collider.SetBodyId(bodyId);
+	collider.SetLinearVelocity({ 0.0f, 0.0f });
+	shapeDef.userData = bodyDef.userData;
+	collider.SetShapeId(Physics::ShapeCache::CreateShape(bodyId, shapeDef, shapeDefinition));
+}
+
+template <class ColliderComponentT>
+void Runtime::EnableColliderBody(ComponentRef<ColliderComponentT> collider)
+{
+	// A collider disabled by the scripts of its scene keeps its body disabled.
+	if (collider.IsEnabled())
+	{
+		b2Body_Enable(collider.GetBodyId());
+	}
+}
+
+const Physics::ShapeDefinition& Runtime::GetColliderShape(const ComponentRef<BoxColliderComponent>& boxCollider, const DVec2& scale)
+{
+	const DVec2 sizes(boxCollider.GetSizes());
+	const DVec2 offset(boxCollider.GetOffset());
+	return m_shapeCache.GetBox({glm::abs(scale.x * sizes.x/2.0f), glm::abs(scale.y * sizes.y/2.0f)}, scale * offset);
+}
+
+const Physics::ShapeDefinition& Runtime::GetColliderShape(const ComponentRef<CircleColliderComponent>& circleCollider, const DVec2& scale)
+{
+	const DFloat radius(circleCollider.GetRadius() * (std::max)(glm::abs(scale.x), glm::abs(scale.y)));
+	return m_shapeCache.GetCircle(scale * circleCollider.GetOffset(), radius);
+}
+
+const Physics::ShapeDefinition& Runtime::GetColliderShape(const ComponentRef<CapsuleColliderComponent>& capsuleCollider, const DVec2& scale)
+{
+	// Box2D does not accept capsules with coincident centers.
+	constexpr float minimumHalfSegment{0.01f};
+	const DFloat radius(capsuleCollider.GetRadius() * glm::abs(scale.x));
+	const DFloat halfSegment((std::max)(minimumHalfSegment, glm::abs(scale.y) * capsuleCollider.GetHeight()/2.0f - radius));
+	const DVec2 center(scale * capsuleCollider.GetOffset());
+	return m_shapeCache.GetCapsule({center.x, center.y - halfSegment}, {center.x, center.y + halfSegment}, radius);
+}
+
+const Physics::ShapeDefinition& Runtime::GetColliderShape(const ComponentRef<PolygonColliderComponent>& polygonCollider, const DVec2& scale)
+{
+	DVec2 vertices[maxPolygonColliderVertices];
+	const size_t vertexCount(polygonCollider.GetVertices(vertices));
+	const DVec2 offset(polygonCollider.GetOffset());
+	for (size_t i(0); i < vertexCount; i++)
+	{
+		vertices[i] = scale * (vertices[i] + offset);
+	}
+	return m_shapeCache.GetPolygon(vertices, vertexCount);
 }
 
 void Runtime::SetupKeyStateBuffers()
@@ -1044,20 +1415,16 @@ void Runtime::PhysicsUpdate(float physicsDeltaTime)
 
 void Runtime::UpdateEntityPhysics(EntityRef entityRef, ComponentRef<TransformComponent> transform)
 {
-	ComponentRef<BoxColliderComponent> boxCollider;
-	if (entityRef.HaveComponents<BoxColliderComponent>())
-	{
-		boxCollider = entityRef.GetComponents<BoxColliderComponent>();
-	}
+	DBodyId bodyId;
+	const bool haveCollider(TryGetColliderBodyId(entityRef, bodyId));
 	if (transform.IsDirty())
 	{
 		const DMat4 modelMatrix(entityRef.GetWorldModelMatrix());
 		DVec2 translation, scale;
 		DFloat rotation;
 		Math::Decompose(modelMatrix, translation, rotation, scale);
-		if (boxCollider.IsValid())
+		if (haveCollider)
 		{
-			b2BodyId bodyId(boxCollider.GetBodyId());
 			b2Body_SetTransform(bodyId, {translation.x, translation.y}, b2MakeRot(glm::radians(rotation + (scale.x < 0.0f && scale.y < 0.0f ? 180.0f : 0.0f))));
 		}
 		if (entityRef.HaveChildren())
@@ -1075,79 +1442,110 @@ void Runtime::UpdateEntityPhysics(EntityRef entityRef, ComponentRef<TransformCom
 		}
 		transform.SetIsDirty(false);
 	}
-	if (boxCollider.IsValid() && boxCollider.GetDirtyType() != 0)
+	if (!haveCollider)
 	{
-		const BoxColliderDirtyT dirtyType(boxCollider.GetDirtyType());
-		const b2BodyId bodyId(boxCollider.GetBodyId());
-		const b2ShapeId shapeId(boxCollider.GetShapeId());
-		if (dirtyType & BoxColliderComponentDirtyType::BodyType)
-		{
-			b2Body_SetType(bodyId, Physics::CoreBodyTypeToBox2dBodyType(boxCollider.GetBodyType()));
-		}
-		if (dirtyType & BoxColliderComponentDirtyType::Enabled)
-		{
-			if (boxCollider.IsEnabled())
-			{
-				b2Body_Enable(bodyId);
-			}
-			else
-			{
-				b2Body_Disable(bodyId);
-			}
-		}
-		if (dirtyType & BoxColliderComponentDirtyType::Sensor)
-		{
-			b2Shape_EnableSensorEvents(shapeId, boxCollider.IsSensor());
-		}
-		if (dirtyType & BoxColliderComponentDirtyType::GravityScale)
-		{
-			b2Body_SetGravityScale(bodyId, boxCollider.GetGravityScale());
-		}
-		if (dirtyType & BoxColliderComponentDirtyType::FixedRotation)
-		{
-			b2Body_SetFixedRotation(bodyId, boxCollider.IsRotationFixed());
-		}
-		if (dirtyType & BoxColliderComponentDirtyType::UseCCD)
-		{
-			b2Body_SetBullet(bodyId, boxCollider.IsUsingCCD());
-		}
-		if ((dirtyType & BoxColliderComponentDirtyType::Offset) || 
-				(dirtyType & BoxColliderComponentDirtyType::Size))
-		{
-			const DVec2 boxColliderSizes(boxCollider.GetSizes());
-			const DVec2 boxColliderOffset(boxCollider.GetOffset());
-			const DVec2 scale(transform.GetScale());
-			b2Polygon polygon(b2MakeOffsetBox(scale.x * boxColliderSizes.x/2.0f, scale.y * boxColliderSizes.y/2.0f, {boxColliderOffset.x, boxColliderOffset.y}, b2Rot_identity));
-			b2Shape_SetPolygon(shapeId, &polygon);
-		}
-		if (dirtyType & BoxColliderComponentDirtyType::PhysicsMaterial)
+		return;
+	}
+	if (entityRef.HaveComponents<BoxColliderComponent>())
+	{
+		UpdateColliderPhysics<BoxColliderComponent, BoxColliderComponentDirtyType>(entityRef, entityRef.GetComponents<BoxColliderComponent>());
+		return;
+	}
+	if (entityRef.HaveComponents<CircleColliderComponent>())
+	{
+		UpdateColliderPhysics<CircleColliderComponent, CircleColliderComponentDirtyType>(entityRef, entityRef.GetComponents<CircleColliderComponent>());
+		return;
+	}
+	if (entityRef.HaveComponents<CapsuleColliderComponent>())
+	{
+		UpdateColliderPhysics<CapsuleColliderComponent, CapsuleColliderComponentDirtyType>(entityRef, entityRef.GetComponents<CapsuleColliderComponent>());
+		return;
+	}
+	if (entityRef.HaveComponents<PolygonColliderComponent>())
+	{
+		UpdateColliderPhysics<PolygonColliderComponent, PolygonColliderComponentDirtyType>(entityRef, entityRef.GetComponents<PolygonColliderComponent>());
+		return;
+	}
+}
+
+template <class ColliderComponentT, class ColliderDirtyTypeT>
+void Runtime::UpdateColliderPhysics(EntityRef entityRef, ComponentRef<ColliderComponentT> collider)
+{
+	if (collider.GetDirtyType() == 0)
+	{
+		return;
+	}
+	const uint64_t dirtyType(collider.GetDirtyType());
+	const b2BodyId bodyId(collider.GetBodyId());
+	const b2ShapeId shapeId(collider.GetShapeId());
+	if (dirtyType & ColliderDirtyTypeT::BodyType)
+	{
+		b2Body_SetType(bodyId, Physics::CoreBodyTypeToBox2dBodyType(collider.GetBodyType()));
+	}
+	if (dirtyType & ColliderDirtyTypeT::Enabled)
+	{
+		if (collider.IsEnabled())
 		{
-			PhysicsMaterialRef physicsMaterial(boxCollider.GetPhysicsMaterial());
-			if (physicsMaterial.IsValid())
-			{
-				b2Shape_SetDensity(shapeId, physicsMaterial.GetDensity(), true);
-				b2Shape_SetFriction(shapeId, physicsMaterial.GetFriction());
-				b2Shape_SetRestitution(shapeId, physicsMaterial.GetRestitution());
-			}
+			b2Body_Enable(bodyId);
 		}
-		if ((dirtyType & BoxColliderComponentDirtyType::SelfPhysicsLayer) ||
-			(dirtyType & BoxColliderComponentDirtyType::ColliderWithPhysicsLayer))
+		else
 		{
-			b2Filter filter;
-			const DPhysicsLayer selfPhysicsLayer(boxCollider.GetSelfPhysicsLayer());
-			const DPhysicsLayer colliderWithPhysicsLayers(boxCollider.GetCollideWithPhysicsLayers());
-			filter.categoryBits = selfPhysicsLayer == Physics::PhysicsLayer::Unspecified ? B2_DEFAULT_CATEGORY_BITS : static_cast<uint64_t>(selfPhysicsLayer);
-			filter.maskBits = colliderWithPhysicsLayers == Physics::PhysicsLayer::Unspecified ? B2_DEFAULT_MASK_BITS : static_cast<uint64_t>(colliderWithPhysicsLayers);
-			b2Shape_SetFilter(shapeId, filter);
-			b2Body_SetType(bodyId, Physics::CoreBodyTypeToBox2dBodyType(boxCollider.GetBodyType()));
+			b2Body_Disable(bodyId);
 		}
-		if (dirtyType & BoxColliderComponentDirtyType::LinearVelocity)
+	}
+	if (dirtyType & ColliderDirtyTypeT::Sensor)
+	{
+		b2Shape_EnableSensorEvents(shapeId, collider.IsSensor());
+	}
+	if (dirtyType & ColliderDirtyTypeT::GravityScale)
+	{
+		b2Body_SetGravityScale(bodyId, collider.GetGravityScale());
+	}
+	if (dirtyType & ColliderDirtyTypeT::FixedRotation)
+	{
+		b2Body_SetFixedRotation(bodyId, collider.IsRotationFixed());
+	}
+	if (dirtyType & ColliderDirtyTypeT::UseCCD)
+	{
+		b2Body_SetBullet(bodyId, collider.IsUsingCCD());
+	}
+	if (dirtyType & ColliderDirtyTypeT::Shape)
+	{
+		DVec2 translation, scale;
+		DFloat rotation;
+		Math::Decompose(entityRef.GetWorldModelMatrix(), translation, rotation, scale);
+		const Physics::ShapeDefinition& shapeDefinition(GetColliderShape(collider, scale));
+		Physics::ShapeCache::SetShape(shapeId, shapeDefinition);
+		b2Body_ApplyMassFromShapes(bodyId);
+		m_userDatas[reinterpret_cast<size_t>(b2Body_GetUserData(bodyId))].Shape = m_shapeCache.IsCached(shapeDefinition) ? &shapeDefinition : nullptr;
+	}
+	if (dirtyType & ColliderDirtyTypeT::PhysicsMaterial)
+	{
+		PhysicsMaterialRef physicsMaterial(collider.GetPhysicsMaterial());
+		if (physicsMaterial.IsValid())
 		{
-			const DVec2 linearVelocity(boxCollider.GetLinearVelocity());
-			b2Body_SetLinearVelocity(boxCollider.GetBodyId(), {linearVelocity.x, linearVelocity.y});						
+			b2Shape_SetDensity(shapeId, physicsMaterial.GetDensity(), true);
+			b2Shape_SetFriction(shapeId, physicsMaterial.GetFriction());
+			b2Shape_SetRestitution(shapeId, physicsMaterial.GetRestitution());
 		}
-		boxCollider.Clean();
 	}
+	if ((dirtyType & ColliderDirtyTypeT::SelfPhysicsLayer) ||
+		(dirtyType & ColliderDirtyTypeT::ColliderWithPhysicsLayer))
+	{
+		b2Filter filter;
+		const DPhysicsLayer selfPhysicsLayer(collider.GetSelfPhysicsLayer());
+		const DPhysicsLayer colliderWithPhysicsLayers(collider.GetCollideWithPhysicsLayers());
+		filter.categoryBits = selfPhysicsLayer == Physics::PhysicsLayer::Unspecified ? B2_DEFAULT_CATEGORY_BITS : static_cast<uint64_t>(selfPhysicsLayer);
+		filter.maskBits = colliderWithPhysicsLayers == Physics::PhysicsLayer::Unspecified ? B2_DEFAULT_MASK_BITS : static_cast<uint64_t>(colliderWithPhysicsLayers);
+		b2Shape_SetFilter(shapeId, filter);
+		b2Body_SetType(bodyId, Physics::CoreBodyTypeToBox2dBodyType(collider.GetBodyType()));
+	}
+	if (dirtyType & ColliderDirtyTypeT::LinearVelocity)
+	{
+		const DVec2 linearVelocity(collider.GetLinearVelocity());
+		b2Body_SetLinearVelocity(collider.GetBodyId(), {linearVelocity.x, linearVelocity.y});						
+	}
+	collider.Clean();
 }
 
 void Runtime::AnimationSetup()
@@ -1173,24 +1571,81 @@ void Runtime::AnimationSetup()
 
 void Runtime::AnimationUpdate(float deltaTime)
 {
-	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
-	ReadWriteLockGuard asmGuard(LockType::ReadLock, *static_cast<AnimationStateMachineAssetManager*>(&AssetManager::Get()));
-	ReadWriteLockGuard animationGuard(LockType::ReadLock, *static_cast<AnimationAssetManager*>(&AssetManager::Get()));
-	AssetManager::Get().IterateOnLoadedScenes(
-		[&](SceneRef scene) -> bool
-		{
-			if (!scene.IsLoaded())
+	m_animatedEntities.clear();
+	m_animationEventBatches.clear();
+	{
+		// Evaluate stage. The workers write the sampled attributes straight into the components without locking,
+		// what is safe because the scenes are locked for writing and every entity only writes its own components.
+		ReadWriteLockGuard sceneGuard(LockType::WriteLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
+		ReadWriteLockGuard asmGuard(LockType::ReadLock, *static_cast<AnimationStateMachineAssetManager*>(&AssetManager::Get()));
+		ReadWriteLockGuard animationGuard(LockType::ReadLock, *static_cast<AnimationAssetManager*>(&AssetManager::Get()));
+		AssetManager::Get().IterateOnLoadedScenes(
+			[&](SceneRef scene) -> bool
 			{
-				return false;
-			}
-			scene.Iterate<AnimationStateMachineComponent>(
-				[&](Entity entity, ComponentRef<AnimationStateMachineComponent> asmComponent) -> bool
+				if (!scene.IsLoaded())
 				{
-					asmComponent.Tick(deltaTime);
 					return false;
-				});
-			return false;
-		});
+				}
+				scene.Iterate<AnimationStateMachineComponent>(
+					[&](Entity entity, ComponentRef<AnimationStateMachineComponent> asmComponent) -> bool
+					{
+						m_animatedEntities.push_back({EntityRef(entity, scene), asmComponent.GetRawComponent()});
+						return false;
+					});
+				return false;
+			});
+		WorkerPool::Get().ParallelFor
+		(
+			m_animatedEntities.size(),
+			minimumAnimatedEntitiesPerBatch,
+			[&](size_t begin, size_t end) -> void
+			{
+				animationEventContainerType events;
+				for (size_t i(begin); i < end; i++)
+				{
+					AnimatedEntity& animatedEntity(m_animatedEntities[i]);
+					animatedEntity.Component->Tick(
+						animatedEntity.Entity,
+						deltaTime,
+						[&](EntityRef entity, size_t metachannelId) -> void
+						{
+							events.push_back({entity, metachannelId});
+						});
+				}
+				if (events.empty())
+				{
+					return;
+				}
+				lockGuardType guard(m_animationEventBatchesMutex);
+				m_animationEventBatches.push_back({begin, std::move(events)});
+			}
+		);
+	}
+	// Dispatch stage. The batches finish in any order, so they are sorted to queue the events in the order
+	// the entities were iterated.
+	std::sort
+	(
+		m_animationEventBatches.begin(), m_animationEventBatches.end(),
+		[](const AnimationEventBatch& left, const AnimationEventBatch& right) -> bool
+		{
+			return left.FirstAnimatedEntityIndex < right.FirstAnimatedEntityIndex;
+		}
+	);
+	m_animationEvents.clear();
+	for (const AnimationEventBatch& batch : m_animationEventBatches)
+	{
+		m_animationEvents.insert(m_animationEvents.end(), batch.Events.begin(), batch.Events.end());
+	}
+	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
+	for (AnimationEvent& event : m_animationEvents)
+	{
+		// The entity can be destroyed by a script called for a previous event.
+		if (!event.Entity.IsValid() || !event.Entity.HaveComponents<AnimationStateMachineComponent>())
+		{
+			continue;
+		}
+		event.Entity.GetComponents<AnimationStateMachineComponent>().DispatchAnimationEvent(event.MetachannelId);
+	}
 }
 
 void Runtime::UpdateInput()
@@ -1224,11 +1679,19 @@ void Runtime::DestroyEntityNoLock(EntityRef entity)
 {
 	if (entity.HaveComponents<BoxColliderComponent>())
 	{
-		ComponentRef<BoxColliderComponent> boxCollider(entity.GetComponents<BoxColliderComponent>());
-		DBodyId bodyId(boxCollider.GetBodyId());
-		UserData& userData(m_userDatas[reinterpret_cast<size_t>(b2Body_GetUserData(bodyId))]);
-		m_userDatas.RemoveElementAtIndex(userData.Index);
-		b2DestroyBody(bodyId);
+		DestroyColliderBody(entity.GetComponents<BoxColliderComponent>());
+	}
+	else if (entity.HaveComponents<CircleColliderComponent>())
+	{
+		DestroyColliderBody(entity.GetComponents<CircleColliderComponent>());
+	}
+	else if (entity.HaveComponents<CapsuleColliderComponent>())
+	{
+		DestroyColliderBody(entity.GetComponents<CapsuleColliderComponent>());
+	}
+	else if (entity.HaveComponents<PolygonColliderComponent>())
+	{
+		DestroyColliderBody(entity.GetComponents<PolygonColliderComponent>());
 	}
 	if (!entity.HaveChildren())
 	{
@@ -1244,6 +1707,49 @@ void Runtime::DestroyEntityNoLock(EntityRef entity)
 	);
 }
 
+template <class ColliderComponentT>
+void Runtime::DestroyColliderBody(ComponentRef<ColliderComponentT> collider)
+{
+	const b2BodyId bodyId(collider.GetBodyId());
+	// The entities of a scene unloaded while it was set up may have no body yet.
+	if (!b2Body_IsValid(bodyId))
+	{
+		return;
+	}
+	UserData& userData(m_userDatas[reinterpret_cast<size_t>(b2Body_GetUserData(bodyId))]);
+	// The archetype is made from the shape the body has, since the scale of the entity may have changed after the
+	// shape was set. Bodies of uncached shapes are not pooled.
+	if (m_bodyPool.IsEnabled() && userData.Shape != nullptr)
+	{
+		const Physics::BodyArchetype archetype(*userData.Shape, collider.GetShapeId());
+		b2Body_Disable(bodyId);
+		if (m_bodyPool.TryRelease(m_bodyPool.GetArchetypeIndex(archetype), bodyId))
+		{
+			userData.Entity = EntityRef();
+			userData.CollisionBeginScriptComponents.Clear();
+			userData.CollisionEndScriptComponents.Clear();
+			userData.OverlapBeginScriptComponents.Clear();
+			userData.OverlapEndScriptComponents.Clear();
+			return;
+		}
+	}
+	m_userDatas.RemoveElementAtIndex(userData.Index);
+	b2DestroyBody(bodyId);
+}
+
+void Runtime::DestroyPooledBodies()
+{
+	m_bodyPool.IterateOnPooledBodies
+	(
+		[&](b2BodyId bodyId) -> void
+		{
+			m_userDatas.RemoveElementAtIndex(m_userDatas[reinterpret_cast<size_t>(b2Body_GetUserData(bodyId))].Index);
+			b2DestroyBody(bodyId);
+		}
+	);
+	m_bodyPool.Clear();
+}
+
 void Runtime::TerminateEntities()
 {
 	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
@@ -1287,31 +1793,12 @@ void Runtime::UnloadScene(const stringType& sceneName)
 			{
 				return false;
 			}
-			scene.IterateOnEntities(
-				[&](Entity entity) -> bool
-				{
-					EntityRef entityRef(entity, scene);
-					DestroyEntityNoLock(entityRef);
-					entityRef.Destroy();
-					return false;
-				});
-			UUIDType uuid;
-			scene.GetUUID(uuid);
-			AssetManager::Get().UnloadScene(uuid);
+			UnloadScene(scene);
 			return true;
 		});
 }
 
-void Runtime::LoadSceneAsync(stringType sceneName, AsyncSceneContext* context)
-{
-	//Timer<std::chrono::milliseconds> timer("Scene Loading");
-	glfwMakeContextCurrent(context->Context);
-	context->LoadedScene = SceneLoader::Get().LoadScene(sceneName);
-	context->AtomicLoadingDone.store(true, std::memory_order_release);
-	glfwMakeContextCurrent(nullptr);
-}
-
-void Runtime::SetupScene(SceneRef scene)
+void Runtime::UnloadScene(SceneRef scene)
 {
 	ReadWriteLockGuard runtimeGuard(LockType::WriteLock, m_lockData);
 	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
@@ -1320,30 +1807,96 @@ void Runtime::SetupScene(SceneRef scene)
 	ReadWriteLockGuard physicsMaterialGuard(LockType::ReadLock, *static_cast<PhysicsMaterialAssetManager*>(&AssetManager::Get()));
 	ReadWriteLockGuard spriteMaterialGuard(LockType::ReadLock, *static_cast<SpriteMaterialAssetManager*>(&AssetManager::Get()));
 	ReadWriteLockGuard textureGuard(LockType::ReadLock, *static_cast<Texture2DAssetManager*>(&AssetManager::Get()));
-	const ComponentForms::scriptComponentIdContainerType& scriptComponentIds(ComponentForms::Get().GetScriptComponentIds());
-	scene.Iterate<AnimationStateMachineComponent>(
-		[&](Entity entity, ComponentRef<AnimationStateMachineComponent> asmComponent) -> bool
+	scene.IterateOnEntities(
+		[&](Entity entity) -> bool
 		{
-			asmComponent.Setup();
+			EntityRef entityRef(entity, scene);
+			DestroyEntityNoLock(entityRef);
+			entityRef.Destroy();
 			return false;
 		});
+	UUIDType uuid;
+	scene.GetUUID(uuid);
+	AssetManager::Get().UnloadScene(uuid);
+}
+
+void Runtime::SetupScene(SceneRef scene)
+{
+	SceneSetup sceneSetup(BeginSceneSetup(scene, stringType()));
+	SetupSceneUntil(sceneSetup, clockType::time_point::max());
+}
+
+Runtime::SceneSetup Runtime::BeginSceneSetup(SceneRef scene, const stringType& sceneName)
+{
+	SceneSetup sceneSetup;
+	sceneSetup.Scene = scene;
+	sceneSetup.SceneName = sceneName;
+	sceneSetup.Stage = SceneSetupStage::AnimationStateMachines;
+	sceneSetup.NextEntityIndex = 0;
+	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
 	scene.IterateOnEntities(
 		[&](Entity entity) -> bool
 		{
-			EntityRef entityRef(entity, scene);
-			if (entityRef.HaveComponents<BoxColliderComponent>())
+			sceneSetup.Entities.push_back(entity);
+			return false;
+		});
+	return sceneSetup;
+}
+
+bool Runtime::SetupSceneUntil(SceneSetup& sceneSetup, clockType::time_point deadline)
+{
+	ReadWriteLockGuard runtimeGuard(LockType::WriteLock, m_lockData);
+	ReadWriteLockGuard sceneGuard(LockType::ReadLock, *static_cast<SceneAssetManager*>(&AssetManager::Get()));
+	ReadWriteLockGuard asmGuard(LockType::ReadLock, *static_cast<AnimationStateMachineAssetManager*>(&AssetManager::Get()));
+	ReadWriteLockGuard animationGuard(LockType::ReadLock, *static_cast<AnimationAssetManager*>(&AssetManager::Get()));
+	ReadWriteLockGuard physicsMaterialGuard(LockType::ReadLock, *static_cast<PhysicsMaterialAssetManager*>(&AssetManager::Get()));
+	ReadWriteLockGuard spriteMaterialGuard(LockType::ReadLock, *static_cast<SpriteMaterialAssetManager*>(&AssetManager::Get()));
+	ReadWriteLockGuard textureGuard(LockType::ReadLock, *static_cast<Texture2DAssetManager*>(&AssetManager::Get()));
+	const ComponentForms::scriptComponentIdContainerType& scriptComponentIds(ComponentForms::Get().GetScriptComponentIds());
+	SceneRef scene(sceneSetup.Scene);
+	bool isFirstEntity(true);
+	while (true)
+	{
+		if (sceneSetup.NextEntityIndex >= sceneSetup.Entities.size())
+		{
+			if (sceneSetup.Stage == SceneSetupStage::Start)
 			{
-				SetupEntityPhysics(entityRef);
+				break;
 			}
+			sceneSetup.Stage = static_cast<SceneSetupStage>(static_cast<size_t>(sceneSetup.Stage) + 1);
+			sceneSetup.NextEntityIndex = 0;
+			continue;
+		}
+		if (!isFirstEntity && clockType::now() >= deadline)
+		{
 			return false;
-		});
-	scene.IterateOnEntities(
-		[&](Entity entity) -> bool
+		}
+		isFirstEntity = false;
+		// Entities can be destroyed by the scripts of the scene before their turn.
+		EntityRef entityRef(sceneSetup.Entities[sceneSetup.NextEntityIndex++], scene);
+		if (!entityRef.IsValid())
 		{
-			EntityRef entityRef(entity, scene);
+			continue;
+		}
+		switch (sceneSetup.Stage)
+		{
+		case SceneSetupStage::AnimationStateMachines:
+			if (entityRef.HaveComponents<AnimationStateMachineComponent>())
+			{
+				entityRef.GetComponents<AnimationStateMachineComponent>().Setup();
+			}
+			break;
+		case SceneSetupStage::Physics:
+			// Until the whole scene is set up, the bodies must not be simulated.
+			if (entityRef.HaveComponents<TransformComponent>() && SetupEntityPhysics(entityRef, false))
+			{
+				sceneSetup.EntitiesWithDisabledBody.push_back(entityRef);
+			}
+			break;
+		case SceneSetupStage::Awake:
 			for (ComponentIdType scriptComponentId : scriptComponentIds)
 			{
-				ComponentRef<ScriptComponent> scriptComponent(entity, scene.GetInternalSceneRef(), scriptComponentId, *entityRef.GetLockData());
+				ComponentRef<ScriptComponent> scriptComponent(entityRef.GetEntity(), scene.GetInternalSceneRef(), scriptComponentId, *entityRef.GetLockData());
 				if (!scriptComponent.IsValid())
 				{
 					continue;
@@ -1351,42 +1904,85 @@ void Runtime::SetupScene(SceneRef scene)
 				scriptComponent.SetRuntime(this);
 				scriptComponent.Awake();
 			}
-			return false;
-		});
-	scene.IterateOnEntities(
-		[&](Entity entity) -> bool
-		{
-			EntityRef entityRef(entity, scene);
+			break;
+		case SceneSetupStage::Start:
 			for (ComponentIdType scriptComponentId : scriptComponentIds)
 			{
-				ComponentRef<ScriptComponent> scriptComponent(entity, scene.GetInternalSceneRef(), scriptComponentId, *entityRef.GetLockData());
+				ComponentRef<ScriptComponent> scriptComponent(entityRef.GetEntity(), scene.GetInternalSceneRef(), scriptComponentId, *entityRef.GetLockData());
 				if (!scriptComponent.IsValid())
 				{
 					continue;
 				}
 				scriptComponent.Start();
 			}
-			return false;
-		});
+			break;
+		}
+	}
+	for (EntityRef entityRef : sceneSetup.EntitiesWithDisabledBody)
+	{
+		if (entityRef.IsValid())
+		{
+			EnableEntityBody(entityRef);
+		}
+	}
 	scene.LoadingCompleted();
+	return true;
 }
 
 void Runtime::SetupScenesLoadedAsync()
 {
-	for (AsyncSceneContext& context : m_asyncSceneContexts)
+	AsyncSceneLoader::LoadedScene loadedScene;
+	while (m_sceneLoader.TryTakeLoadedScene(loadedScene))
 	{
-		// Frequent atomic loads uses too much processor. Do it only if non-atomic LoadingDone is false.
-		if (context.LoadingDone)
+		if (!loadedScene.Scene.IsValid())
 		{
 			continue;
 		}
-		if (!context.AtomicLoadingDone.load(std::memory_order_acquire))
+		if (loadedScene.Canceled)
 		{
+			UnloadScene(loadedScene.Scene);
 			continue;
 		}
-		context.LoadingDone = true;
-		SetupScene(context.LoadedScene);
+		m_sceneSetups.push_back(BeginSceneSetup(loadedScene.Scene, loadedScene.SceneName));
+		ReleaseScenePreload(loadedScene.SceneName);
+	}
+	// The scenes are set up in the order they were loaded, sharing the budget of the frame.
+	const clockType::time_point deadline(clockType::now() + std::chrono::microseconds(m_sceneSetupBudget));
+	size_t numberOfScenesSetup(0);
+	for (SceneSetup& sceneSetup : m_sceneSetups)
+	{
+		if (!SetupSceneUntil(sceneSetup, deadline))
+		{
+			break;
+		}
+		numberOfScenesSetup++;
+		if (clockType::now() >= deadline)
+		{
+			break;
+		}
 	}
+	m_sceneSetups.erase(m_sceneSetups.begin(), m_sceneSetups.begin() + numberOfScenesSetup);
+}
+
+void Runtime::ReleaseScenePreload(const stringType& sceneName)
+{
+	m_scenePreloads.erase
+	(
+		std::remove_if
+		(
+			m_scenePreloads.begin(), m_scenePreloads.end(),
+			[&](std::unique_ptr<ScenePreload>& scenePreload) -> bool
+			{
+				if (scenePreload->GetSceneName() != sceneName || !scenePreload->IsCompleted())
+				{
+					return false;
+				}
+				scenePreload->Release();
+				return true;
+			}
+		),
+		m_scenePreloads.end()
+	);
 }
 
 }
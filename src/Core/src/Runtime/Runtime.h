@@ -8,11 +8,23 @@
 #include "Array.h"
 #include "PhysicsAPI.h"
 #include "Input.h"
+#include "ShapeCache.h"
+#include "BodyPool.h"
+#include "BoxColliderComponent.h"
+#include "CircleColliderComponent.h"
+#include "CapsuleColliderComponent.h"
+#include "PolygonColliderComponent.h"
+#include "AsyncSceneLoader.h"
+#include "ScenePreload.h"
 
 #include "box2d/types.h"
 #include "box2d/box2d.h"
 
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 #include <float.h>
@@ -24,13 +36,19 @@
 namespace DCore
 {
 
+class AnimationStateMachineComponent;
+
 class Runtime
 {
 public:
 	static constexpr size_t drawDebugBoxCommandsSize{1024};
+	static constexpr size_t minimumQueriesPerBatch{8};
+	static constexpr size_t minimumAnimatedEntitiesPerBatch{16};
 public:
 	using rayCastResultType = Physics::RayCastResult;
 	using overlapResultType = Physics::OverlapResult;
+	using queryRequestType = Physics::QueryRequest;
+	using queryResultType = Physics::QueryResult;
 	using atomicBoolType = std::atomic_bool;
 	using threadType = std::thread;
 	using userDataContainerType = ReciclingVector<UserData>;
@@ -39,10 +57,17 @@ public:
 	using sceneNameContainerType = std::vector<stringType>;
 	using keyEventContainerType = std::vector<KeyEvent>;
 public:
-	static constexpr size_t maximumNumberOfScenesLoadedAsync{64};
+	// Microseconds.
+	static constexpr uint64_t defaultSceneSetupBudget{2000};
 public:
 	template <class Key, class Value>
 	using unorderedMapType = std::unordered_map<Key, Value>;
+public:
+	struct AnimationEvent
+	{
+		EntityRef Entity;
+		size_t MetachannelId;
+	};
 public:
 	Runtime(GLFWwindow* mainContext);
 	Runtime(const Runtime&) = delete;
@@ -92,41 +117,98 @@ public:
 		uint64_t onlyCollideWithLayers = COLLIDE_WITH_ALL_MASK, 
 		overlapResultType* result = nullptr, 
 		size_t entitiesSize = 0);
+	// Runs all the requests in parallel. results must have numberOfRequests elements.
+	// The physics world must not be stepped while this runs, what is guaranteed when called from scripts.
+	void BatchQuery(const queryRequestType* requests, size_t numberOfRequests, queryResultType* results);
+	// When enabled, the bodies of destroyed entities are disabled and kept to be reused by new entities
+	// with the same collider shape, physics layers, sensor flag and physics material.
+	void EnableBodyPooling(size_t maximumBodiesPerArchetype = Physics::BodyPool::defaultMaximumBodiesPerArchetype);
+	// Destroys the pooled bodies.
+	void DisableBodyPooling();
 	// To be called only in scripts!
 	void AddDrawDebugBoxCommand(const DrawDebugBoxCommand&);
 	void SetSceneToUnload(const stringType& sceneName);
 	void SetSceneToLoad(const stringType& sceneName);
-	void SetSceneToLoadAsync(const stringType& sceneName);
+	// Loaded by the AsyncSceneLoader, then set up over the next frames.
+	AsyncSceneLoader::requestIdType SetSceneToLoadAsync(const stringType& sceneName, LoadPriority = LoadPriority::Normal);
+	// A scene that is already being set up is not canceled.
+	void CancelSceneLoadAsync(AsyncSceneLoader::requestIdType);
 	void AddKeyEvent(KeyEvent);
 	bool KeyPressed(DKey);
 	bool KeyPressedThisFrame(DKey);
 	bool KeyReleasedThisFrame(DKey);
+	// To be called only in scripts! Time that the setup of the scenes loaded asynchronously (animation state
+	// machines, physics, Awake and Start) may take per frame, in microseconds. Their entities are set up in
+	// batches across frames, at least one entity per frame.
+	void SetSceneSetupBudget(uint64_t microseconds);
+	// To be called only in scripts! Returns false if the scene is not being loaded asynchronously, what includes
+	// when its loading is completed. outProgress is 0 while the scene is loaded and goes to 1 while it is set up.
+	bool TryGetSceneLoadingProgress(const stringType& sceneName, float& outProgress) const;
+	// To be called only in scripts! Loads, in parallel on the workers, the assets the scene needs as listed by its
+	// cooked file, so loading it afterwards, as with SetSceneToLoadAsync, finds them loaded. They are kept loaded
+	// until the scene is loaded or the simulation stops.
+	void PreloadScene(const stringType& sceneName);
+	// To be called only in scripts! Returns false if the scene is not preloaded nor being preloaded. outProgress goes
+	// from 0 to 1, when all the assets are loaded.
+	bool TryGetScenePreloadProgress(const stringType& sceneName, float& outProgress) const;
 public:
 	const UserData& GetUserDataAtIndex(size_t index) const
 	{
 		return m_userDatas[index];
 	}
+
+	// Iterates on the events fired by the last animation update, in the order they were dispatched to the scripts.
+	// They are kept until the next animation update.
+	template <class Func>
+	void IterateOnAnimationEvents(Func function) const
+	{
+		for (const AnimationEvent& event : m_animationEvents)
+		{
+			std::invoke(function, event);
+		}
+	}
 private:
-	typedef
-	struct AsyncSceneContext
+	enum class SceneSetupStage
+	{
+		AnimationStateMachines,
+		Physics,
+		Awake,
+		Start
+	};
+
+	// Setup of a loaded scene, done stage by stage for all its entities, so it can be split across frames.
+	// The bodies of its colliders are disabled until its Start stage is done.
+	struct SceneSetup
 	{
-		AsyncSceneContext()
-			:
-			LoadingDone(true)
-		{}
+		SceneRef Scene;
+		stringType SceneName;
+		std::vector<Entity> Entities;
+		std::vector<EntityRef> EntitiesWithDisabledBody;
+		SceneSetupStage Stage;
+		size_t NextEntityIndex;
+	};
 
-		AsyncSceneContext(struct AsyncSceneContext&& other) noexcept
-			:
-			Context(other.Context),
-			LoadingThread(std::move(other.LoadingThread))
-		{}
+	struct AnimatedEntity
+	{
+		EntityRef Entity;
+		AnimationStateMachineComponent* Component;
+	};
 
-		GLFWwindow* Context;
-		std::thread LoadingThread;
-		bool LoadingDone;
-		atomicBoolType AtomicLoadingDone;
-		SceneRef LoadedScene;
-	} AsyncSceneContext;
+	// Events fired by a batch of the parallel animation update, in the order of its entities.
+	struct AnimationEventBatch
+	{
+		size_t FirstAnimatedEntityIndex;
+		std::vector<AnimationEvent> Events;
+	};
+private:
+	using animatedEntityContainerType = std::vector<AnimatedEntity>;
+	using animationEventContainerType = std::vector<AnimationEvent>;
+	using animationEventBatchContainerType = std::vector<AnimationEventBatch>;
+	using mutexType = std::mutex;
+	using lockGuardType = std::lock_guard<mutexType>;
+	using sceneSetupContainerType = std::vector<SceneSetup>;
+	using scenePreloadContainerType = std::vector<std::unique_ptr<ScenePreload>>;
+	using clockType = std::chrono::steady_clock;
 private:
 	atomicBoolType m_toContinueSimulation;
 	threadType m_gameLoopThread;
@@ -136,18 +218,42 @@ private:
 	userDataContainerType m_userDatas;
 	sceneNameContainerType m_namesOfScenesToUnload;
 	sceneNameContainerType m_namesOfScenesToLoad;
-	sceneNameContainerType m_namesOfScenesToLoadAsync;
 	drawDebugBoxCommandContainerType m_drawDebugBoxCommands;
 	GLFWwindow* m_context;
-	Array<AsyncSceneContext, maximumNumberOfScenesLoadedAsync> m_asyncSceneContexts;
-	size_t m_nextAsyncContext;
+	AsyncSceneLoader m_sceneLoader;
 	size_t m_inputIndex;
 	KeyStateBuffers m_keyStateBuffers;
 	keyEventContainerType m_keyEvents;
+	Physics::ShapeCache m_shapeCache;
+	Physics::BodyPool m_bodyPool;
+	animatedEntityContainerType m_animatedEntities;
+	animationEventBatchContainerType m_animationEventBatches;
+	animationEventContainerType m_animationEvents;
+	mutexType m_animationEventBatchesMutex;
+	sceneSetupContainerType m_sceneSetups;
+	scenePreloadContainerType m_scenePreloads;
+	uint64_t m_sceneSetupBudget;
 private:
 	void GameLoop();
 	void SetupPhysics();
-	void SetupEntityPhysics(EntityRef);
+	// Returns false if the entity has no collider.
+	bool SetupEntityPhysics(EntityRef, bool enableBody = true);
+	void EnableEntityBody(EntityRef);
+	template <class ColliderComponentT>
+	void SetupCollidersPhysics(SceneRef);
+	template <class ColliderComponentT>
+	void SetupColliderPhysics(EntityRef, ComponentRef<ColliderComponentT>, bool enableBody = true);
+	template <class ColliderComponentT>
+	void EnableColliderBody(ComponentRef<ColliderComponentT>);
+	template <class ColliderComponentT, class ColliderDirtyTypeT>
+	void UpdateColliderPhysics(EntityRef, ComponentRef<ColliderComponentT>);
+	template <class ColliderComponentT>
+	void DestroyColliderBody(ComponentRef<ColliderComponentT>);
+	void DestroyPooledBodies();
+	const Physics::ShapeDefinition& GetColliderShape(const ComponentRef<BoxColliderComponent>&, const DVec2& scale);
+	const Physics::ShapeDefinition& GetColliderShape(const ComponentRef<CircleColliderComponent>&, const DVec2& scale);
+	const Physics::ShapeDefinition& GetColliderShape(const ComponentRef<CapsuleColliderComponent>&, const DVec2& scale);
+	const Physics::ShapeDefinition& GetColliderShape(const ComponentRef<PolygonColliderComponent>&, const DVec2& scale);
 	void SetupKeyStateBuffers();
 	void AwakeScripts();
 	void StartScripts();
@@ -164,9 +270,14 @@ private:
 	void DestroyEntityNoLock(EntityRef);
 	void TerminateEntities();
 	void UnloadScene(const stringType& sceneName);
-	void LoadSceneAsync(stringType sceneName, AsyncSceneContext*);
+	void UnloadScene(SceneRef);
 	void SetupScene(SceneRef);
+	SceneSetup BeginSceneSetup(SceneRef, const stringType& sceneName);
+	// Returns true when the setup is done. At least one entity is set up before the deadline is checked.
+	bool SetupSceneUntil(SceneSetup&, clockType::time_point deadline);
 	void SetupScenesLoadedAsync();
+	// Once the scene holds its own references. A preload in progress is released when the simulation stops.
+	void ReleaseScenePreload(const stringType& sceneName);
 };
 
 }
@@ -12,4 +12,12 @@ SceneRef SceneLoader::LoadScene(const stringType& sceneName)
 	return m_loadSceneFunc(sceneName);
 }
 
+void SceneLoader::PreloadScene(const stringType& sceneName, ScenePreload& scenePreload)
+{
+	if (m_preloadSceneFunc)
+	{
+		m_preloadSceneFunc(sceneName, scenePreload);
+	}
+}
+
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Scene.h"
+#include "ScenePreload.h"
 
 #include <functional>
 #include <string>
@@ -15,6 +16,7 @@ class SceneLoader
 public:
 	using stringType = std::string;
 	using loadSceneFunctionType = std::function<SceneRef(const stringType&)>;
+	using preloadSceneFunctionType = std::function<void(const stringType&, ScenePreload&)>;
 public:
 	SceneLoader(const SceneLoader&) = delete;
 	SceneLoader(SceneLoader&&) = delete;
@@ -27,15 +29,24 @@ public:
 	}
 public:
 	SceneRef LoadScene(const stringType& sceneName);
+	// Loads the assets the scene needs into the preload, which is completed by the caller. Without a preload
+	// function nothing is preloaded.
+	void PreloadScene(const stringType& sceneName, ScenePreload&);
 public:
 	void SetLoadSceneFunc(loadSceneFunctionType&& loadSceneFunc)
 	{
 		m_loadSceneFunc = std::move(loadSceneFunc);
 	}
+
+	void SetPreloadSceneFunc(preloadSceneFunctionType&& preloadSceneFunc)
+	{
+		m_preloadSceneFunc = std::move(preloadSceneFunc);
+	}
 private:
 	SceneLoader() = default;
 private:
 	loadSceneFunctionType m_loadSceneFunc;
+	preloadSceneFunctionType m_preloadSceneFunc;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "ScenePreload.h"
+#include "DCoreAssert.h"
+
+
+
+namespace DCore
+{
+
+ScenePreload::ScenePreload(const stringType& sceneName)
+	:
+	m_sceneName(sceneName),
+	m_numberOfAssets(0),
+	m_numberOfLoadedAssets(0),
+	m_completed(false)
+{}
+
+void ScenePreload::SetNumberOfAssets(size_t numberOfAssets)
+{
+	m_numberOfAssets.store(numberOfAssets, std::memory_order_relaxed);
+}
+
+void ScenePreload::AddTexture2D(Texture2DRef texture2D)
+{
+	AddAsset(texture2D, m_textures2D);
+}
+
+void ScenePreload::AddSpriteMaterial(SpriteMaterialRef spriteMaterial)
+{
+	AddAsset(spriteMaterial, m_spriteMaterials);
+}
+
+void ScenePreload::AddAnimation(AnimationRef animation)
+{
+	AddAsset(animation, m_animations);
+}
+
+void ScenePreload::AddAnimationStateMachine(AnimationStateMachineRef animationStateMachine)
+{
+	AddAsset(animationStateMachine, m_animationStateMachines);
+}
+
+void ScenePreload::AddPhysicsMaterial(PhysicsMaterialRef physicsMaterial)
+{
+	AddAsset(physicsMaterial, m_physicsMaterials);
+}
+
+void ScenePreload::Complete()
+{
+	{
+		lockGuardType guard(m_mutex);
+		m_completed.store(true, std::memory_order_release);
+	}
+	m_completedConditionVariable.notify_all();
+}
+
+void ScenePreload::WaitForCompletion()
+{
+	uniqueLockType lock(m_mutex);
+	m_completedConditionVariable.wait
+	(
+		lock,
+		[&]() -> bool
+		{
+			return m_completed.load(std::memory_order_acquire);
+		}
+	);
+}
+
+void ScenePreload::Release()
+{
+	DASSERT_E(IsCompleted());
+	// The sprite materials before their maps, and the animation state machines before their animations.
+	for (SpriteMaterialRef& spriteMaterial : m_spriteMaterials)
+	{
+		spriteMaterial.Unload();
+	}
+	for (Texture2DRef& texture2D : m_textures2D)
+	{
+		texture2D.Unload();
+	}
+	for (AnimationStateMachineRef& animationStateMachine : m_animationStateMachines)
+	{
+		animationStateMachine.Unload();
+	}
+	for (AnimationRef& animation : m_animations)
+	{
+		animation.Unload();
+	}
+	for (PhysicsMaterialRef& physicsMaterial : m_physicsMaterials)
+	{
+		physicsMaterial.Unload();
+	}
+	m_spriteMaterials.clear();
+	m_textures2D.clear();
+	m_animationStateMachines.clear();
+	m_animations.clear();
+	m_physicsMaterials.clear();
+}
+
+float ScenePreload::GetProgress() const
+{
+	if (IsCompleted())
+	{
+		return 1.0f;
+	}
+	const size_t numberOfAssets(m_numberOfAssets.load(std::memory_order_relaxed));
+	if (numberOfAssets == 0)
+	{
+		return 0.0f;
+	}
+	const size_t numberOfLoadedAssets(m_numberOfLoadedAssets.load(std::memory_order_relaxed));
+	// Reported below 1 until completed.
+	return 0.99f * static_cast<float>(numberOfLoadedAssets < numberOfAssets ? numberOfLoadedAssets : numberOfAssets) / static_cast<float>(numberOfAssets);
+}
+
+}
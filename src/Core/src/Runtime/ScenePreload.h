@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Animation.h"
+#include "AnimationStateMachine.h"
+#include "PhysicsMaterial.h"
+#include "SpriteMaterial.h"
+#include "Texture2D.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+// The assets preloaded for a scene (see Runtime::PreloadScene), kept loaded by the references taken on them until
+// released. Filled by the preload function of the SceneLoader, maybe from many threads at once.
+class ScenePreload
+{
+public:
+	using stringType = std::string;
+	using mutexType = std::mutex;
+	using lockGuardType = std::lock_guard<mutexType>;
+	using uniqueLockType = std::unique_lock<mutexType>;
+	using conditionVariableType = std::condition_variable;
+public:
+	ScenePreload(const stringType& sceneName);
+	ScenePreload(const ScenePreload&) = delete;
+	ScenePreload(ScenePreload&&) = delete;
+	~ScenePreload() = default;
+public:
+	// To be set before any asset is added. The invalid refs of the assets that fail to load are counted as loaded.
+	void SetNumberOfAssets(size_t);
+	void AddTexture2D(Texture2DRef);
+	void AddSpriteMaterial(SpriteMaterialRef);
+	void AddAnimation(AnimationRef);
+	void AddAnimationStateMachine(AnimationStateMachineRef);
+	void AddPhysicsMaterial(PhysicsMaterialRef);
+	void Complete();
+	void WaitForCompletion();
+	// Releases the references taken on the assets. To be called once completed.
+	void Release();
+	// From 0 to 1.
+	float GetProgress() const;
+public:
+	const stringType& GetSceneName() const
+	{
+		return m_sceneName;
+	}
+
+	bool IsCompleted() const
+	{
+		return m_completed.load(std::memory_order_acquire);
+	}
+private:
+	using texture2DContainerType = std::vector<Texture2DRef>;
+	using spriteMaterialContainerType = std::vector<SpriteMaterialRef>;
+	using animationContainerType = std::vector<AnimationRef>;
+	using animationStateMachineContainerType = std::vector<AnimationStateMachineRef>;
+	using physicsMaterialContainerType = std::vector<PhysicsMaterialRef>;
+private:
+	stringType m_sceneName;
+	std::atomic<size_t> m_numberOfAssets;
+	std::atomic<size_t> m_numberOfLoadedAssets;
+	std::atomic<bool> m_completed;
+	texture2DContainerType m_textures2D;
+	spriteMaterialContainerType m_spriteMaterials;
+	animationContainerType m_animations;
+	animationStateMachineContainerType m_animationStateMachines;
+	physicsMaterialContainerType m_physicsMaterials;
+	mutexType m_mutex;
+	conditionVariableType m_completedConditionVariable;
+private:
+	template <class RefType, class ContainerType>
+	void AddAsset(RefType ref, ContainerType& container)
+	{
+		if (ref.IsValid())
+		{
+			lockGuardType guard(m_mutex);
+			container.push_back(ref);
+		}
+		m_numberOfLoadedAssets.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+}
@@ -4,6 +4,7 @@
 #include "ScriptComponent.h"
 #include "ReciclingVector.h"
 #include "SparseSet.h"
+#include "ShapeCache.h"
 
 
 
@@ -19,6 +20,9 @@ struct UserData
 	EntityRef Entity;
 	size_t Index;
 	DCore::Runtime* Runtime;
+	// The cached shape the body has, so it is pooled with the archetype of its shape and not of its collider.
+	// nullptr if the shape was not cached.
+	const Physics::ShapeDefinition* Shape;
 	scriptComponentContainerType CollisionBeginScriptComponents;
 	scriptComponentContainerType CollisionEndScriptComponents;
 	scriptComponentContainerType OverlapBeginScriptComponents;
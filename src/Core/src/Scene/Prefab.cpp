@@ -0,0 +1,494 @@
+#include "Prefab.h"
+#include "DCoreAssert.h"
+#include "Runtime.h"
+#include "AssetManager.h"
+#include "Registry.h"
+#include "Component.h"
+#include "ComponentForm.h"
+#include "ComponentRef.h"
+#include "ReadWriteLockGuard.h"
+#include "ScriptComponent.h"
+#include "RootComponent.h"
+#include "ChildComponent.h"
+#include "ChildrenComponent.h"
+#include "TransformComponent.h"
+#include "AnimationStateMachineComponent.h"
+#include "BoxColliderComponent.h"
+#include "CircleColliderComponent.h"
+#include "CapsuleColliderComponent.h"
+#include "PolygonColliderComponent.h"
+#include "SoundEventInstance.h"
+#include "UUID.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+
+
+namespace DCore
+{
+
+Prefab::Prefab()
+	:
+	m_numberOfEntities(0),
+	m_rootIndex(0)
+{}
+
+Prefab::Prefab(const Prefab& other)
+	:
+	m_archetypes(other.m_archetypes),
+	m_componentIds(other.m_componentIds),
+	m_componentSizes(other.m_componentSizes),
+	m_componentArgumentsOffsets(other.m_componentArgumentsOffsets),
+	m_scriptComponentIds(other.m_scriptComponentIds),
+	m_arguments(other.m_arguments),
+	m_entityReferencePatches(other.m_entityReferencePatches),
+	m_uuidPatches(other.m_uuidPatches),
+	m_assetAttributes(other.m_assetAttributes),
+	m_numberOfEntities(other.m_numberOfEntities),
+	m_rootIndex(other.m_rootIndex)
+{
+	AcquireAssetAttributes();
+}
+
+Prefab::Prefab(Prefab&& other) noexcept
+	:
+	Prefab()
+{
+	*this = std::move(other);
+}
+
+Prefab::~Prefab()
+{
+	ReleaseAssetAttributes();
+}
+
+Prefab& Prefab::operator=(const Prefab& other)
+{
+	if (this != &other)
+	{
+		*this = Prefab(other);
+	}
+	return *this;
+}
+
+Prefab& Prefab::operator=(Prefab&& other) noexcept
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+	ReleaseAssetAttributes();
+	m_archetypes = std::move(other.m_archetypes);
+	m_componentIds = std::move(other.m_componentIds);
+	m_componentSizes = std::move(other.m_componentSizes);
+	m_componentArgumentsOffsets = std::move(other.m_componentArgumentsOffsets);
+	m_scriptComponentIds = std::move(other.m_scriptComponentIds);
+	m_arguments = std::move(other.m_arguments);
+	m_entityReferencePatches = std::move(other.m_entityReferencePatches);
+	m_uuidPatches = std::move(other.m_uuidPatches);
+	m_assetAttributes = std::move(other.m_assetAttributes);
+	m_numberOfEntities = other.m_numberOfEntities;
+	m_rootIndex = other.m_rootIndex;
+	// The references of the assets now belong to this prefab.
+	other.m_assetAttributes.clear();
+	other.m_numberOfEntities = 0;
+	return *this;
+}
+
+bool Prefab::Create(EntityRef root)
+{
+	*this = Prefab();
+	if (!root.IsValid())
+	{
+		return false;
+	}
+	const SceneRef scene(root.GetSceneRef());
+	std::vector<EntityRef> hierarchy({root});
+	for (size_t hierarchyIndex(0); hierarchyIndex < hierarchy.size(); hierarchyIndex++)
+	{
+		EntityRef entity(hierarchy[hierarchyIndex]);
+		if (!entity.HaveChildren())
+		{
+			continue;
+		}
+		entity.IterateOnChildren
+		(
+			[&](EntityRef child) -> bool
+			{
+				hierarchy.push_back(child);
+				return false;
+			}
+		);
+	}
+	// Group the entities by their components. The root is instantiated as a root, whatever it is in the scene.
+	std::map<componentIdContainerType, sizeContainerType> archetypes;
+	for (size_t hierarchyIndex(0); hierarchyIndex < hierarchy.size(); hierarchyIndex++)
+	{
+		EntityRef entity(hierarchy[hierarchyIndex]);
+		componentIdContainerType componentIds(entity.GetNumberOfComponents());
+		entity.GetComponentIds(componentIds.data());
+		if (hierarchyIndex == 0)
+		{
+			componentIds.erase(std::remove(componentIds.begin(), componentIds.end(), ComponentId::GetId<ChildComponent>()), componentIds.end());
+			if (std::find(componentIds.begin(), componentIds.end(), ComponentId::GetId<RootComponent>()) == componentIds.end())
+			{
+				componentIds.push_back(ComponentId::GetId<RootComponent>());
+			}
+		}
+		std::sort(componentIds.begin(), componentIds.end());
+		archetypes[componentIds].push_back(hierarchyIndex);
+	}
+	std::unordered_map<size_t, size_t> entityIndexes;
+	for (const auto& archetype : archetypes)
+	{
+		for (size_t hierarchyIndex : archetype.second)
+		{
+			entityIndexes.insert({hierarchy[hierarchyIndex].GetEntity().GetIndex(), m_numberOfEntities++});
+		}
+	}
+	m_rootIndex = entityIndexes[root.GetEntity().GetIndex()];
+	const auto alignArgumentsOffset
+	(
+		[](size_t offset) -> size_t
+		{
+			constexpr size_t alignment(alignof(std::max_align_t));
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	);
+	for (const auto& archetype : archetypes)
+	{
+		const componentIdContainerType& componentIds(archetype.first);
+		Archetype prefabArchetype;
+		prefabArchetype.FirstComponent = m_componentIds.size();
+		prefabArchetype.NumberOfComponents = componentIds.size();
+		prefabArchetype.FirstScriptComponent = m_scriptComponentIds.size();
+		prefabArchetype.NumberOfScriptComponents = 0;
+		prefabArchetype.FirstEntity = entityIndexes[hierarchy[archetype.second.front()].GetEntity().GetIndex()];
+		prefabArchetype.NumberOfEntities = archetype.second.size();
+		prefabArchetype.EntityArgumentsSize = 0;
+		prefabArchetype.HaveCollider = false;
+		prefabArchetype.HaveAnimationStateMachine = false;
+		bool haveTransform(false);
+		for (ComponentIdType componentId : componentIds)
+		{
+			const ComponentForm& componentForm(ComponentForms::Get()[componentId]);
+			m_componentIds.push_back(componentId);
+			m_componentSizes.push_back(componentForm.TotalSize);
+			m_componentArgumentsOffsets.push_back(prefabArchetype.EntityArgumentsSize);
+			prefabArchetype.EntityArgumentsSize += alignArgumentsOffset(componentForm.SerializedSize);
+			if (componentForm.IsScriptComponent)
+			{
+				m_scriptComponentIds.push_back(componentId);
+				prefabArchetype.NumberOfScriptComponents++;
+			}
+			haveTransform = haveTransform || componentId == ComponentId::GetId<TransformComponent>();
+			prefabArchetype.HaveAnimationStateMachine = prefabArchetype.HaveAnimationStateMachine || componentId == ComponentId::GetId<AnimationStateMachineComponent>();
+			prefabArchetype.HaveCollider = prefabArchetype.HaveCollider ||
+				componentId == ComponentId::GetId<BoxColliderComponent>() ||
+				componentId == ComponentId::GetId<CircleColliderComponent>() ||
+				componentId == ComponentId::GetId<CapsuleColliderComponent>() ||
+				componentId == ComponentId::GetId<PolygonColliderComponent>();
+		}
+		prefabArchetype.HaveCollider = prefabArchetype.HaveCollider && haveTransform;
+		prefabArchetype.ArgumentsOffset = m_arguments.size();
+		m_arguments.resize(m_arguments.size() + prefabArchetype.NumberOfEntities * prefabArchetype.EntityArgumentsSize, 0);
+		for (size_t archetypeEntityIndex(0); archetypeEntityIndex < prefabArchetype.NumberOfEntities; archetypeEntityIndex++)
+		{
+			EntityRef entity(hierarchy[archetype.second[archetypeEntityIndex]]);
+			const size_t entityIndex(prefabArchetype.FirstEntity + archetypeEntityIndex);
+			char* entityArguments(m_arguments.data() + prefabArchetype.ArgumentsOffset + archetypeEntityIndex * prefabArchetype.EntityArgumentsSize);
+			for (size_t componentIndex(0); componentIndex < componentIds.size(); componentIndex++)
+			{
+				const ComponentForm& componentForm(ComponentForms::Get()[componentIds[componentIndex]]);
+				if (componentForm.SerializedAttributes.empty())
+				{
+					continue;
+				}
+				ComponentRef<Component> component(entity.GetComponent(componentForm.Id));
+				char* componentArguments(entityArguments + m_componentArgumentsOffsets[prefabArchetype.FirstComponent + componentIndex]);
+				size_t argumentOffset(0);
+				for (const SerializedAttribute& attribute : componentForm.SerializedAttributes)
+				{
+					const AttributeIdType attributeId(attribute.GetAttributeId());
+					const size_t argumentSize(attribute.GetArgumentSizeBytes());
+					if (argumentSize == 0 || argumentOffset + argumentSize > componentForm.SerializedSize)
+					{
+						*this = Prefab();
+						return false;
+					}
+					char* argument(componentArguments + argumentOffset);
+					argumentOffset += argumentSize;
+					switch (attribute.GetAttributeType())
+					{
+					case AttributeType::EntityReference:
+					{
+						EntityRef referencedEntity;
+						component.GetAttributePtr(attributeId, &referencedEntity, sizeof(EntityRef));
+						if (referencedEntity.IsValid() && referencedEntity.GetSceneRef() == scene)
+						{
+							auto it(entityIndexes.find(referencedEntity.GetEntity().GetIndex()));
+							if (it != entityIndexes.end())
+							{
+								new (argument) EntityRef();
+								m_entityReferencePatches.push_back({entityIndex, componentForm.Id, attributeId, it->second});
+								break;
+							}
+						}
+						new (argument) EntityRef(referencedEntity);
+						break;
+					}
+					case AttributeType::UUID:
+						component.GetAttributePtr(attributeId, argument, argumentSize);
+						m_uuidPatches.push_back({entityIndex, componentForm.Id, attributeId, 0});
+						break;
+					case AttributeType::SoundEventInstance:
+					{
+						// Every instance must create its own event, so only the event path and bank are kept.
+						alignas(SoundEventInstance) char soundEventInstanceBytes[sizeof(SoundEventInstance)];
+						component.GetAttributePtr(attributeId, soundEventInstanceBytes, sizeof(SoundEventInstance));
+						const SoundEventInstance& soundEventInstance(*reinterpret_cast<const SoundEventInstance*>(soundEventInstanceBytes));
+						SoundEventInstance* prefabSoundEventInstance(new (argument) SoundEventInstance(soundEventInstance.GetPath()));
+						prefabSoundEventInstance->Internal_SetBank(soundEventInstance.Internal_GetBank());
+						break;
+					}
+					case AttributeType::SpriteMaterial:
+					case AttributeType::Animation:
+					case AttributeType::AnimationStateMachine:
+					case AttributeType::PhysicsMaterial:
+						component.GetAttributePtr(attributeId, argument, argumentSize);
+						AssetManager::Get().AcquireAssetAttribute(attribute.GetAttributeType(), argument);
+						m_assetAttributes.push_back({entityIndex, componentForm.Id, attributeId, attribute.GetAttributeType(), static_cast<size_t>(argument - m_arguments.data())});
+						break;
+					default:
+						component.GetAttributePtr(attributeId, argument, argumentSize);
+						break;
+					}
+				}
+			}
+		}
+		m_archetypes.push_back(prefabArchetype);
+	}
+	return true;
+}
+
+void Prefab::Instantiate(SceneRef scene, Runtime& runtime, size_t numberOfInstances, EntityRef* outRoots, EntityRef parent) const
+{
+	DASSERT_E(IsValid() && scene.IsValid());
+	if (numberOfInstances == 0)
+	{
+		return;
+	}
+	// The entities of the i-th instance are in [i * m_numberOfEntities, (i + 1) * m_numberOfEntities), in the order of the prefab.
+	entityContainerType entities(numberOfInstances * m_numberOfEntities);
+	entityContainerType archetypeEntities;
+	for (const Archetype& archetype : m_archetypes)
+	{
+		const ComponentIdType* componentIds(m_componentIds.data() + archetype.FirstComponent);
+		const size_t* componentArgumentsOffsets(m_componentArgumentsOffsets.data() + archetype.FirstComponent);
+		const char* archetypeArguments(m_arguments.data() + archetype.ArgumentsOffset);
+		archetypeEntities.resize(numberOfInstances * archetype.NumberOfEntities);
+		scene.CreateEntities
+		(
+			componentIds, m_componentSizes.data() + archetype.FirstComponent, archetype.NumberOfComponents, archetypeEntities.size(), archetypeEntities.data(),
+			[&](size_t archetypeEntityIndex, ComponentIdType componentId, void* componentAddress) -> void
+			{
+				const size_t componentIndex(std::lower_bound(componentIds, componentIds + archetype.NumberOfComponents, componentId) - componentIds);
+				const char* componentArguments(archetypeArguments + (archetypeEntityIndex % archetype.NumberOfEntities) * archetype.EntityArgumentsSize + componentArgumentsOffsets[componentIndex]);
+				ComponentForms::Get()[componentId].PlacementNewConstructor(componentAddress, componentArguments);
+			}
+		);
+		for (size_t archetypeEntityIndex(0); archetypeEntityIndex < archetypeEntities.size(); archetypeEntityIndex++)
+		{
+			const size_t instanceIndex(archetypeEntityIndex / archetype.NumberOfEntities);
+			entities[instanceIndex * m_numberOfEntities + archetype.FirstEntity + archetypeEntityIndex % archetype.NumberOfEntities] = archetypeEntities[archetypeEntityIndex];
+		}
+	}
+	const auto iterateOnArchetypeEntities
+	(
+		[&](const Archetype& archetype, auto function) -> void
+		{
+			for (size_t instanceIndex(0); instanceIndex < numberOfInstances; instanceIndex++)
+			{
+				const Entity* archetypeInstanceEntities(entities.data() + instanceIndex * m_numberOfEntities + archetype.FirstEntity);
+				for (size_t archetypeEntityIndex(0); archetypeEntityIndex < archetype.NumberOfEntities; archetypeEntityIndex++)
+				{
+					function(EntityRef(archetypeInstanceEntities[archetypeEntityIndex], scene));
+				}
+			}
+		}
+	);
+	{
+		ReadWriteLockGuard guard(LockType::WriteLock, *scene.GetLockData());
+		Registry& registry(scene.GetInternalSceneRef()->GetAsset().GetRegistry());
+		for (size_t instanceIndex(0); instanceIndex < numberOfInstances; instanceIndex++)
+		{
+			const Entity* instanceEntities(entities.data() + instanceIndex * m_numberOfEntities);
+			for (const AttributePatch& patch : m_entityReferencePatches)
+			{
+				registry.GetComponents
+				(
+					instanceEntities[patch.EntityIndex], &patch.ComponentId, 1,
+					[&](ComponentIdType, void* componentAddress) -> void
+					{
+						void* attribute(static_cast<Component*>(componentAddress)->GetAttributePtr(patch.AttributeId));
+						DASSERT_E(attribute != nullptr);
+						*static_cast<EntityRef*>(attribute) = EntityRef(instanceEntities[patch.ReferencedEntityIndex], scene);
+					}
+				);
+			}
+			for (const AttributePatch& patch : m_uuidPatches)
+			{
+				registry.GetComponents
+				(
+					instanceEntities[patch.EntityIndex], &patch.ComponentId, 1,
+					[&](ComponentIdType, void* componentAddress) -> void
+					{
+						void* attribute(static_cast<Component*>(componentAddress)->GetAttributePtr(patch.AttributeId));
+						DASSERT_E(attribute != nullptr);
+						UUIDGenerator::Get().GenerateUUID(*static_cast<UUIDType*>(attribute));
+					}
+				);
+			}
+			// The components were constructed from the references of the prefab, so every instance takes its own.
+			for (const AssetAttribute& assetAttribute : m_assetAttributes)
+			{
+				registry.GetComponents
+				(
+					instanceEntities[assetAttribute.EntityIndex], &assetAttribute.ComponentId, 1,
+					[&](ComponentIdType, void* componentAddress) -> void
+					{
+						void* attribute(static_cast<Component*>(componentAddress)->GetAttributePtr(assetAttribute.AttributeId));
+						DASSERT_E(attribute != nullptr);
+						AssetManager::Get().AcquireAssetAttribute(assetAttribute.Type, attribute);
+					}
+				);
+			}
+		}
+		for (const Archetype& archetype : m_archetypes)
+		{
+			if (archetype.NumberOfScriptComponents == 0)
+			{
+				continue;
+			}
+			iterateOnArchetypeEntities
+			(
+				archetype,
+				[&](EntityRef entity) -> void
+				{
+					registry.GetComponents
+					(
+						entity.GetEntity(), m_scriptComponentIds.data() + archetype.FirstScriptComponent, archetype.NumberOfScriptComponents,
+						[&](ComponentIdType componentId, void* componentAddress) -> void
+						{
+							ScriptComponent* scriptComponent(static_cast<ScriptComponent*>(componentAddress));
+							scriptComponent->Setup(entity, componentId);
+							scriptComponent->SetRuntime(&runtime);
+						}
+					);
+				}
+			);
+		}
+	}
+	for (size_t instanceIndex(0); instanceIndex < numberOfInstances; instanceIndex++)
+	{
+		outRoots[instanceIndex] = EntityRef(entities[instanceIndex * m_numberOfEntities + m_rootIndex], scene);
+		if (parent.IsValid())
+		{
+			outRoots[instanceIndex].SetParent(parent);
+		}
+	}
+	// The same stages as the setup of a loaded scene, so the scripts of an instance see all of it set up.
+	for (const Archetype& archetype : m_archetypes)
+	{
+		if (!archetype.HaveAnimationStateMachine)
+		{
+			continue;
+		}
+		iterateOnArchetypeEntities
+		(
+			archetype,
+			[&](EntityRef entity) -> void
+			{
+				entity.GetComponents<AnimationStateMachineComponent>().Setup();
+			}
+		);
+	}
+	for (const Archetype& archetype : m_archetypes)
+	{
+		if (!archetype.HaveCollider)
+		{
+			continue;
+		}
+		iterateOnArchetypeEntities
+		(
+			archetype,
+			[&](EntityRef entity) -> void
+			{
+				Runtime::SetupEntityPhysics(entity, runtime);
+			}
+		);
+	}
+	for (const bool toStart : {false, true})
+	{
+		for (const Archetype& archetype : m_archetypes)
+		{
+			if (archetype.NumberOfScriptComponents == 0)
+			{
+				continue;
+			}
+			iterateOnArchetypeEntities
+			(
+				archetype,
+				[&](EntityRef entity) -> void
+				{
+					for (size_t i(0); i < archetype.NumberOfScriptComponents; i++)
+					{
+						ComponentRef<ScriptComponent> scriptComponent(entity.GetEntity(), scene.GetInternalSceneRef(), m_scriptComponentIds[archetype.FirstScriptComponent + i], *scene.GetLockData());
+						if (!scriptComponent.IsValid())
+						{
+							continue;
+						}
+						if (toStart)
+						{
+							scriptComponent.Start();
+						}
+						else
+						{
+							scriptComponent.Awake();
+						}
+					}
+				}
+			);
+		}
+	}
+}
+
+EntityRef Prefab::Instantiate(SceneRef scene, Runtime& runtime, EntityRef parent) const
+{
+	EntityRef root;
+	Instantiate(scene, runtime, 1, &root, parent);
+	return root;
+}
+
+void Prefab::AcquireAssetAttributes()
+{
+	for (const AssetAttribute& assetAttribute : m_assetAttributes)
+	{
+		AssetManager::Get().AcquireAssetAttribute(assetAttribute.Type, m_arguments.data() + assetAttribute.ArgumentOffset);
+	}
+}
+
+void Prefab::ReleaseAssetAttributes()
+{
+	for (const AssetAttribute& assetAttribute : m_assetAttributes)
+	{
+		AssetManager::Get().ReleaseAssetAttribute(assetAttribute.Type, m_arguments.data() + assetAttribute.ArgumentOffset);
+	}
+}
+
+}
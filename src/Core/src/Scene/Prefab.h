@@ -0,0 +1,119 @@
+#pragma once
+
+#include "ECSTypes.h"
+#include "ComponentForm.h"
+#include "SerializationTypes.h"
+#include "EntityRef.h"
+#include "Scene.h"
+
+#include <cstddef>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+class Runtime;
+
+// Template of an entity and its descendants, resolved once to be instantiated many times. The entities are grouped
+// by archetype and the constructor arguments of their components are kept as CreateEntities takes them, so an
+// instance costs the creation of its entities in batch, the construction of their components from the kept
+// arguments and the patch of the references between them.
+// The references to entities out of the hierarchy are kept as they are, and every instance gets new UUIDs.
+// The prefab holds a reference to every asset its components refer to, so they stay loaded while it exists.
+class Prefab
+{
+public:
+	using componentIdContainerType = std::vector<ComponentIdType>;
+	using sizeContainerType = std::vector<size_t>;
+	using argumentContainerType = std::vector<char>;
+	using entityContainerType = std::vector<Entity>;
+private:
+	struct Archetype
+	{
+		// In m_componentIds, m_componentSizes and m_componentArgumentsOffsets. The ids are sorted.
+		size_t FirstComponent;
+		size_t NumberOfComponents;
+		// In m_scriptComponentIds.
+		size_t FirstScriptComponent;
+		size_t NumberOfScriptComponents;
+		size_t FirstEntity;
+		size_t NumberOfEntities;
+		size_t ArgumentsOffset;
+		size_t EntityArgumentsSize;
+		bool HaveCollider;
+		bool HaveAnimationStateMachine;
+	};
+
+	// An attribute of a component that is set after the entities of an instance are created.
+	struct AttributePatch
+	{
+		size_t EntityIndex;
+		ComponentIdType ComponentId;
+		AttributeIdType AttributeId;
+		// The referenced entity, for entity references.
+		size_t ReferencedEntityIndex;
+	};
+
+	// An asset reference kept in the arguments, that every instance takes a reference of.
+	struct AssetAttribute
+	{
+		size_t EntityIndex;
+		ComponentIdType ComponentId;
+		AttributeIdType AttributeId;
+		AttributeType Type;
+		// In m_arguments.
+		size_t ArgumentOffset;
+	};
+private:
+	using archetypeContainerType = std::vector<Archetype>;
+	using attributePatchContainerType = std::vector<AttributePatch>;
+	using assetAttributeContainerType = std::vector<AssetAttribute>;
+public:
+	Prefab();
+	Prefab(const Prefab&);
+	Prefab(Prefab&&) noexcept;
+	~Prefab();
+public:
+	Prefab& operator=(const Prefab&);
+	Prefab& operator=(Prefab&&) noexcept;
+public:
+	// The scene of the root must be locked for reading, as well as the asset managers of its asset references.
+	bool Create(EntityRef root);
+
+	// Creates numberOfInstances instances of the prefab in the scene, all the entities with the same components at
+	// once, and writes their roots in outRoots. The instances are set up as the entities of a loaded scene: their
+	// animation state machines are set up, their colliders registered in the physics of the runtime and their
+	// scripts are awaken then started. The roots are made children of parent, if it is valid.
+	// To be called while the runtime is playing, as the script components do.
+	void Instantiate(SceneRef, Runtime&, size_t numberOfInstances, EntityRef* outRoots, EntityRef parent = EntityRef()) const;
+	EntityRef Instantiate(SceneRef, Runtime&, EntityRef parent = EntityRef()) const;
+public:
+	bool IsValid() const
+	{
+		return m_numberOfEntities > 0;
+	}
+
+	size_t GetNumberOfEntities() const
+	{
+		return m_numberOfEntities;
+	}
+private:
+	archetypeContainerType m_archetypes;
+	componentIdContainerType m_componentIds;
+	sizeContainerType m_componentSizes;
+	sizeContainerType m_componentArgumentsOffsets;
+	componentIdContainerType m_scriptComponentIds;
+	argumentContainerType m_arguments;
+	attributePatchContainerType m_entityReferencePatches;
+	attributePatchContainerType m_uuidPatches;
+	assetAttributeContainerType m_assetAttributes;
+	size_t m_numberOfEntities;
+	size_t m_rootIndex;
+private:
+	void AcquireAssetAttributes();
+	void ReleaseAssetAttributes();
+};
+
+}
@@ -14,6 +14,13 @@
 #include "ChildComponent.h"
 #include "ChildrenComponent.h"
 #include "ComponentRefSpecialization.h"
+#include "ScriptComponent.h"
+#include "SoundEventInstance.h"
+#include "AssetManager.h"
+
+#include <cstring>
+#include <new>
+#include <vector>
 
 
 
@@ -162,6 +169,120 @@ void SceneRef::GetName(DString& outName) const
 	DASSERT_E(IsValid());
 	outName = m_ref->GetAsset().GetName().Data();
 }
+
+void SceneRef::CopyEntitiesFrom(SceneRef source)
+{
+	DASSERT_E(IsValid() && source.IsValid());
+	ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+	Registry& registry(m_ref->GetAsset().GetRegistry());
+	const SceneIdType sourceId(source.GetInternalSceneRefId());
+	const SceneVersionType sourceVersion(source.GetInternalSceneRefVersion());
+	std::vector<char> arguments;
+	std::vector<AttributeIdType> entityReferenceAttributeIds;
+	std::vector<const SerializedAttribute*> assetAttributes;
+	registry.CopyFrom
+	(
+		source.m_ref->GetAsset().GetRegistry(),
+		[&](ComponentIdType componentId, size_t componentSize, const Entity* entities, void* components, const void* sourceComponents, size_t numberOfComponents) -> void
+		{
+			const ComponentForm& componentForm(ComponentForms::Get()[componentId]);
+			const auto getComponent
+			(
+				[&](size_t componentIndex) -> Component*
+				{
+					return reinterpret_cast<Component*>(static_cast<char*>(components) + componentIndex * componentSize);
+				}
+			);
+			// GetAttributePtr is not const, but the components of source are only read.
+			const auto getSourceComponent
+			(
+				[&](size_t componentIndex) -> Component*
+				{
+					return reinterpret_cast<Component*>(const_cast<char*>(static_cast<const char*>(sourceComponents)) + componentIndex * componentSize);
+				}
+			);
+			if (componentForm.CopyConstructor)
+			{
+				for (size_t componentIndex(0); componentIndex < numberOfComponents; componentIndex++)
+				{
+					componentForm.CopyConstructor(getComponent(componentIndex), getSourceComponent(componentIndex));
+				}
+			}
+			else if (componentForm.IsScriptComponent)
+			{
+				// The scripts can own memory and have no copy constructor in their form, so they are constructed again
+				// from their attributes.
+				arguments.resize(componentForm.SerializedSize);
+				for (size_t componentIndex(0); componentIndex < numberOfComponents; componentIndex++)
+				{
+					Component* sourceComponent(getSourceComponent(componentIndex));
+					size_t argumentOffset(0);
+					for (const SerializedAttribute& attribute : componentForm.SerializedAttributes)
+					{
+						const size_t argumentSize(attribute.GetArgumentSizeBytes());
+						const void* sourceAttribute(sourceComponent->GetAttributePtr(attribute.GetAttributeId()));
+						DASSERT_E(argumentOffset + argumentSize <= arguments.size() && sourceAttribute != nullptr);
+						if (attribute.GetAttributeType() == AttributeType::SoundEventInstance)
+						{
+							const SoundEventInstance& sourceSoundEventInstance(*static_cast<const SoundEventInstance*>(sourceAttribute));
+							SoundEventInstance* soundEventInstance(new (&arguments[argumentOffset]) SoundEventInstance(sourceSoundEventInstance.GetPath()));
+							soundEventInstance->Internal_SetBank(sourceSoundEventInstance.Internal_GetBank());
+						}
+						else
+						{
+							std::memcpy(&arguments[argumentOffset], sourceAttribute, argumentSize);
+						}
+						argumentOffset += argumentSize;
+					}
+					componentForm.PlacementNewConstructor(getComponent(componentIndex), arguments.data());
+				}
+			}
+			entityReferenceAttributeIds.clear();
+			assetAttributes.clear();
+			for (const SerializedAttribute& attribute : componentForm.SerializedAttributes)
+			{
+				switch (attribute.GetAttributeType())
+				{
+				case AttributeType::EntityReference:
+					entityReferenceAttributeIds.push_back(attribute.GetAttributeId());
+					break;
+				case AttributeType::SpriteMaterial:
+				case AttributeType::Animation:
+				case AttributeType::AnimationStateMachine:
+				case AttributeType::PhysicsMaterial:
+					assetAttributes.push_back(&attribute);
+					break;
+				default:
+					break;
+				}
+			}
+			for (size_t componentIndex(0); componentIndex < numberOfComponents; componentIndex++)
+			{
+				Component* component(getComponent(componentIndex));
+				for (AttributeIdType attributeId : entityReferenceAttributeIds)
+				{
+					EntityRef& entityRef(*static_cast<EntityRef*>(component->GetAttributePtr(attributeId)));
+					const Entity entity(entityRef.GetEntity());
+					const InternalSceneRefType entityScene(entityRef.GetInternalSceneRef());
+					if (entity.GetId() == 0 || entityScene.GetId() != sourceId || entityScene.GetVersion() != sourceVersion)
+					{
+						continue;
+					}
+					entityRef = EntityRef(registry.GetEntityWithIdAndVersion(entity.GetId(), entity.GetVersion()), *this);
+				}
+				// However the component was copied, its asset references are the ones of the source, so it takes its own.
+				for (const SerializedAttribute* attribute : assetAttributes)
+				{
+					AssetManager::Get().AcquireAssetAttribute(attribute->GetAttributeType(), component->GetAttributePtr(attribute->GetAttributeId()));
+				}
+				if (componentForm.IsScriptComponent)
+				{
+					static_cast<ScriptComponent*>(component)->Setup(EntityRef(entities[componentIndex], *this), componentId);
+				}
+			}
+		}
+	);
+}
 // End SceneRef
 
 }
@@ -93,6 +93,10 @@ public:
 	void SetName(const DString& name);
 	Entity CreateEntity(const stringType& entityName);
 	void GetName(DString& outName) const;
+	// Makes this scene, which must have no entities, a copy of source, e.g. to play a copy of a scene being edited.
+	// The component pools are copied in bulk and only the components that can't be copied byte by byte are
+	// constructed again. The entity references to source are made to refer to this scene.
+	void CopyEntitiesFrom(SceneRef source);
 public:
 	InternalSceneRefType GetInternalSceneRef()
 	{
@@ -154,6 +158,14 @@ public:
 		return m_ref->GetAsset().GetRegistry().CreateEntity(componentIds, componentSizes, numberOfComponents, function);
 	}
 
+	template <class Func>
+	void CreateEntities(const ComponentIdType* componentIds, const size_t* componentSizes, size_t numberOfComponents, size_t numberOfEntities, Entity* outEntities, Func function)
+	{
+		DASSERT_E(IsValid());
+		ReadWriteLockGuard guard(LockType::WriteLock, *m_lockData);
+		m_ref->GetAsset().GetRegistry().CreateEntities(componentIds, componentSizes, numberOfComponents, numberOfEntities, outEntities, function);
+	}
+
 	template <class Component, class ...Components, class TupleArg, class ...TupleArgs>
 	Entity CreateEntity(TupleArg&& tupleArg, TupleArgs&& ...tupleArgs)
 	{
@@ -0,0 +1,178 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+
+namespace DCore
+{
+
+static constexpr uint32_t texture2DSRGBFlag{1 << 0};
+static constexpr uint32_t texture2DAlphaMaskFlag{1 << 1};
+static constexpr uint32_t texture2DFilterShift{8};
+static constexpr uint32_t texture2DFilterMask{0xff};
+
+static bool IsEntryLess(const AssetPack::Entry& entry, const UUIDType& uuid)
+{
+	return entry.UUIDHigh < uuid.GetHigh() || (entry.UUIDHigh == uuid.GetHigh() && entry.UUIDLow < uuid.GetLow());
+}
+
+AssetPack::AssetPack()
+	:
+	m_entries(nullptr),
+	m_numberOfEntries(0),
+	m_stringTable(nullptr),
+	m_stringTableSize(0)
+{}
+
+AssetPack::AssetPack(AssetPack&& other) noexcept
+	:
+	m_file(std::move(other.m_file)),
+	m_entries(other.m_entries),
+	m_numberOfEntries(other.m_numberOfEntries),
+	m_stringTable(other.m_stringTable),
+	m_stringTableSize(other.m_stringTableSize)
+{
+	other.m_entries = nullptr;
+	other.m_numberOfEntries = 0;
+	other.m_stringTable = nullptr;
+	other.m_stringTableSize = 0;
+}
+
+bool AssetPack::Open(const pathType& path)
+{
+	Close();
+	MappedFile file;
+	if (!file.Open(path))
+	{
+		return false;
+	}
+	const char* data(file.GetData());
+	const size_t fileSize(file.GetSize());
+	const auto isInFile
+	(
+		[&](uint64_t offset, uint64_t size) -> bool
+		{
+			return offset <= fileSize && size <= fileSize - offset;
+		}
+	);
+	if (fileSize < sizeof(Header))
+	{
+		return false;
+	}
+	const Header& header(*reinterpret_cast<const Header*>(data));
+	if (header.Magic != magic || header.Version != version ||
+		header.NumberOfEntries > fileSize / sizeof(Entry) ||
+		header.EntriesOffset % alignof(Entry) != 0 ||
+		!isInFile(header.EntriesOffset, header.NumberOfEntries * sizeof(Entry)) ||
+		!isInFile(header.StringTableOffset, header.StringTableSize) ||
+		header.StringTableSize == 0 || data[header.StringTableOffset + header.StringTableSize - 1] != '\0')
+	{
+		return false;
+	}
+	const Entry* entries(reinterpret_cast<const Entry*>(data + header.EntriesOffset));
+	for (uint64_t i(0); i < header.NumberOfEntries; i++)
+	{
+		const Entry& entry(entries[i]);
+		if (!isInFile(entry.Offset, entry.Size) || entry.Offset % payloadAlignment != 0 || entry.NameOffset >= header.StringTableSize)
+		{
+			return false;
+		}
+		// The lookups need the table sorted and without repeated UUIDs.
+		if (i > 0 && !IsEntryLess(entries[i - 1], GetUUID(entry)))
+		{
+			return false;
+		}
+	}
+	m_file = std::move(file);
+	m_entries = entries;
+	m_numberOfEntries = static_cast<size_t>(header.NumberOfEntries);
+	m_stringTable = data + header.StringTableOffset;
+	m_stringTableSize = static_cast<size_t>(header.StringTableSize);
+	return true;
+}
+
+void AssetPack::Close()
+{
+	m_file.Close();
+	m_entries = nullptr;
+	m_numberOfEntries = 0;
+	m_stringTable = nullptr;
+	m_stringTableSize = 0;
+}
+
+const AssetPack::Entry* AssetPack::Find(const UUIDType& uuid) const
+{
+	const Entry* end(m_entries + m_numberOfEntries);
+	const Entry* entry(std::lower_bound(m_entries, end, uuid, IsEntryLess));
+	if (entry == end || entry->UUIDHigh != uuid.GetHigh() || entry->UUIDLow != uuid.GetLow())
+	{
+		return nullptr;
+	}
+	return entry;
+}
+
+const AssetPack::Entry* AssetPack::Find(const UUIDType& uuid, AssetPackEntryType type) const
+{
+	const Entry* entry(Find(uuid));
+	return entry != nullptr && entry->Type == type ? entry : nullptr;
+}
+
+const AssetPack::Entry* AssetPack::FindWithName(const char* name, AssetPackEntryType type) const
+{
+	for (size_t i(0); i < m_numberOfEntries; i++)
+	{
+		if (m_entries[i].Type == type && std::strcmp(GetName(m_entries[i]), name) == 0)
+		{
+			return &m_entries[i];
+		}
+	}
+	return nullptr;
+}
+
+uint32_t AssetPack::Texture2DMetadataToFlags(Texture2DMetadata metadata)
+{
+	uint32_t flags(0);
+	if (metadata.IsSRGB())
+	{
+		flags |= texture2DSRGBFlag;
+	}
+	if (metadata.IsAlphaMask())
+	{
+		flags |= texture2DAlphaMaskFlag;
+	}
+	flags |= (static_cast<uint32_t>(metadata.GetFilterMethod()) & texture2DFilterMask) << texture2DFilterShift;
+	return flags;
+}
+
+Texture2DMetadata AssetPack::FlagsToTexture2DMetadata(uint32_t flags)
+{
+	const uint32_t filter((flags >> texture2DFilterShift) & texture2DFilterMask);
+	return Texture2DMetadata
+	(
+		(flags & texture2DSRGBFlag) != 0,
+		(flags & texture2DAlphaMaskFlag) != 0,
+		filter < static_cast<uint32_t>(Texture2DFilter::Default) ? static_cast<Texture2DFilter>(filter) : Texture2DFilter::Bilinear
+	);
+}
+
+AssetPack& AssetPack::operator=(AssetPack&& other) noexcept
+{
+	if (&other == this)
+	{
+		return *this;
+	}
+	m_file = std::move(other.m_file);
+	m_entries = other.m_entries;
+	m_numberOfEntries = other.m_numberOfEntries;
+	m_stringTable = other.m_stringTable;
+	m_stringTableSize = other.m_stringTableSize;
+	other.m_entries = nullptr;
+	other.m_numberOfEntries = 0;
+	other.m_stringTable = nullptr;
+	other.m_stringTableSize = 0;
+	return *this;
+}
+
+}
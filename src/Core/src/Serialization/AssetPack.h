@@ -0,0 +1,128 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Texture2D.h"
+#include "UUID.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+
+
+namespace DCore
+{
+
+enum class AssetPackEntryType : uint32_t
+{
+	Scene,
+	Texture2D,
+	SpriteMaterial,
+	Animation,
+	AnimationStateMachine
+};
+
+// Single file holding the cooked forms of the assets of a project, to be loaded from a mapped file without reading
+// the asset maps of the project.
+//
+// Layout:
+// Header
+// Entry[NumberOfEntries]: sorted by UUID, so an asset is found with a binary search.
+// String table: null terminated names of the assets.
+// Payloads: the cooked files of the assets, each one starting at a multiple of payloadAlignment.
+//
+// The payload of a scene is a cooked scene (CookedScene.h), of a texture a cooked texture (CookedTexture2D.h), whose
+// metadata is kept in the flags of the entry, of a sprite material a cooked sprite material (CookedSpriteMaterial.h),
+// of an animation a cooked animation (CookedAnimation.h) and of an animation state machine a cooked animation state
+// machine (CookedAnimationStateMachine.h).
+class AssetPack
+{
+public:
+	using pathType = std::filesystem::path;
+public:
+	static constexpr uint32_t magic{0x4b435044}; // DPCK
+	static constexpr uint32_t version{1};
+	static constexpr uint64_t payloadAlignment{16};
+	static constexpr const char* fileExtension{".dpack"};
+public:
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t NumberOfEntries;
+		uint64_t EntriesOffset;
+		uint64_t StringTableOffset;
+		uint64_t StringTableSize;
+	};
+
+	// The UUID is split in its halves, so the table has no padding and is sorted as UUIDs are compared.
+	struct Entry
+	{
+		uint64_t UUIDHigh;
+		uint64_t UUIDLow;
+		uint64_t Offset;
+		uint64_t Size;
+		AssetPackEntryType Type;
+		uint32_t Flags;
+		uint32_t NameOffset;
+		uint32_t Padding;
+	};
+public:
+	AssetPack();
+	AssetPack(const AssetPack&) = delete;
+	AssetPack(AssetPack&&) noexcept;
+	~AssetPack() = default;
+public:
+	// Fails, leaving the pack closed, if the file can't be mapped or its header, table or names are broken.
+	bool Open(const pathType&);
+	void Close();
+	// nullptr if there is no asset with the UUID.
+	const Entry* Find(const UUIDType&) const;
+	const Entry* Find(const UUIDType&, AssetPackEntryType) const;
+	// Linear, for the assets loaded by name.
+	const Entry* FindWithName(const char* name, AssetPackEntryType) const;
+public:
+	bool IsOpen() const
+	{
+		return m_file.IsOpen();
+	}
+
+	size_t GetNumberOfEntries() const
+	{
+		return m_numberOfEntries;
+	}
+
+	const Entry& GetEntry(size_t index) const
+	{
+		return m_entries[index];
+	}
+
+	const char* GetPayload(const Entry& entry) const
+	{
+		return m_file.GetData() + entry.Offset;
+	}
+
+	const char* GetName(const Entry& entry) const
+	{
+		return m_stringTable + entry.NameOffset;
+	}
+
+	static UUIDType GetUUID(const Entry& entry)
+	{
+		return UUIDType(entry.UUIDHigh, entry.UUIDLow);
+	}
+
+	static uint32_t Texture2DMetadataToFlags(Texture2DMetadata);
+	static Texture2DMetadata FlagsToTexture2DMetadata(uint32_t flags);
+public:
+	AssetPack& operator=(const AssetPack&) = delete;
+	AssetPack& operator=(AssetPack&&) noexcept;
+private:
+	MappedFile m_file;
+	const Entry* m_entries;
+	size_t m_numberOfEntries;
+	const char* m_stringTable;
+	size_t m_stringTableSize;
+};
+
+}
@@ -1,4 +1,10 @@
 #include "ComponentForm.h"
+#include "EntityRef.h"
+#include "SpriteMaterial.h"
+#include "AnimationStateMachine.h"
+#include "PhysicsMaterial.h"
+#include "PhysicsAPI.h"
+#include "SoundEventInstance.h"
 
 
 
@@ -33,6 +39,53 @@ SerializedAttribute& SerializedAttribute::operator=(SerializedAttribute&& other)
 	m_attributeId = other.m_attributeId;
 	return *this;
 }
+
+size_t SerializedAttribute::GetArgumentSizeBytes() const
+{
+	switch (m_attributeType)
+	{
+	case AttributeType::Integer:
+		return sizeof(DInt);
+	case AttributeType::UInteger:
+		return sizeof(DUInt);
+	case AttributeType::Float:
+		return sizeof(DFloat);
+	case AttributeType::Size:
+		return sizeof(DSize);
+	case AttributeType::Logic:
+		return sizeof(DLogic);
+	case AttributeType::Vector2:
+	case AttributeType::UIVector2:
+		return sizeof(DVec2);
+	case AttributeType::Vector3:
+		return sizeof(DVec3);
+	case AttributeType::String:
+		return sizeof(DString);
+	case AttributeType::UUID:
+		return sizeof(UUIDType);
+	case AttributeType::EntityReference:
+		return sizeof(EntityRef);
+	case AttributeType::SpriteMaterial:
+		return sizeof(SpriteMaterialRef);
+	case AttributeType::TaggedList:
+		return sizeof(size_t);
+	case AttributeType::Color:
+		return sizeof(DVec4);
+	case AttributeType::AnimationStateMachine:
+		return sizeof(AnimationStateMachineRef);
+	case AttributeType::PhysicsBodyType:
+		return sizeof(DBodyType);
+	case AttributeType::PhysicsMaterial:
+		return sizeof(PhysicsMaterialRef);
+	case AttributeType::PhysicsLayer:
+	case AttributeType::PhysicsLayers:
+		return sizeof(Physics::PhysicsLayer);
+	case AttributeType::SoundEventInstance:
+		return sizeof(SoundEventInstance);
+	default:
+		return 0;
+	}
+}
  
 ComponentForm::ComponentForm(
 	ComponentIdType id, 
@@ -43,16 +96,20 @@ ComponentForm::ComponentForm(
 	serializedAttributeContainerType&& serializedAttributes, 
 	constructorFunctionType&& placementNewConstructor, 
 	destructorFunctionType&& destructor, 
-	const void* defaultArgs)
+	const void* defaultArgs,
+	bool handlesAnimationEvents,
+	copyConstructorFunctionType&& copyConstructor)
 	:
 	Id(id),
 	Name(std::move(name)),
 	IsScriptComponent(isScriptComponent),
+	HandlesAnimationEvents(handlesAnimationEvents),
 	TotalSize(totalSize),
 	SerializedSize(serializedSize),
 	SerializedAttributes(std::move(serializedAttributes)),
 	PlacementNewConstructor(std::move(placementNewConstructor)),
 	Destructor(std::move(destructor)),
+	CopyConstructor(std::move(copyConstructor)),
 	DefaultArgs(defaultArgs)
 {}
 
@@ -61,11 +118,13 @@ ComponentForm::ComponentForm(ComponentForm&& other) noexcept
 	Id(other.Id),
 	Name(std::move(other.Name)),
 	IsScriptComponent(other.IsScriptComponent),
+	HandlesAnimationEvents(other.HandlesAnimationEvents),
 	TotalSize(other.TotalSize),
 	SerializedSize(other.SerializedSize),
 	SerializedAttributes(std::move(other.SerializedAttributes)),
 	PlacementNewConstructor(std::move(other.PlacementNewConstructor)),
 	Destructor(std::move(other.Destructor)),
+	CopyConstructor(std::move(other.CopyConstructor)),
 	DefaultArgs(other.DefaultArgs)
 {
 	other.DefaultArgs = nullptr;
@@ -88,6 +147,10 @@ void ComponentForms::AddComponentForm(ComponentForm&& componentForm)
 	if (m_componentForms.back().IsScriptComponent)
 	{
 		m_scriptComponentIds.push_back(m_componentForms.back().Id);
+		if (m_componentForms.back().HandlesAnimationEvents)
+		{
+			m_animationEventScriptComponentIds.push_back(m_componentForms.back().Id);
+		}
 	}
 	std::sort(m_componentForms.begin(), m_componentForms.end(), ComponentFormComparator());
 }
@@ -215,6 +215,9 @@ public:
 	{
 		return GetAttributeSizeBytes() / GetNumberOfAttributeComponents();
 	}
+
+	// Size of the attribute in the constructor arguments of its component. Zero for the types without a size there.
+	size_t GetArgumentSizeBytes() const;
 public:
 	SerializedAttribute& operator=(SerializedAttribute&&) noexcept;
 private:
@@ -228,6 +231,7 @@ struct ComponentForm
 	using serializedAttributeContainerType = std::vector<SerializedAttribute>;
 	using constructorFunctionType = std::function<void(void*, const void*)>;
 	using destructorFunctionType = std::function<void(void*)>;
+	using copyConstructorFunctionType = std::function<void(void*, const void*)>;
 
 	ComponentForm(
 		ComponentIdType, 
@@ -238,18 +242,24 @@ struct ComponentForm
 		serializedAttributeContainerType&&, 
 		constructorFunctionType&&, 
 		destructorFunctionType&&, 
-		const void*);
+		const void*,
+		bool handlesAnimationEvents = false,
+		copyConstructorFunctionType&& copyConstructor = nullptr);
 
 	ComponentForm(ComponentForm&&) noexcept;
 
 	ComponentIdType Id;
 	std::string Name;
 	bool IsScriptComponent;
+	// Set for the script components that override OnAnimationEvent, and for the ones whose generator doesn't tell.
+	bool HandlesAnimationEvents;
 	size_t TotalSize;
 	size_t SerializedSize;
 	serializedAttributeContainerType SerializedAttributes;
 	constructorFunctionType PlacementNewConstructor;
 	destructorFunctionType Destructor;
+	// Only set for the components that can't be copied byte by byte, e.g. the ones owning memory.
+	copyConstructorFunctionType CopyConstructor;
 	const void* DefaultArgs;
 
 	bool TryGetNumberOfAttributeComponents(AttributeIdType, size_t& out) const;
@@ -259,11 +269,13 @@ struct ComponentForm
 		Id = other.Id;
 		Name = std::move(other.Name);
 		IsScriptComponent = other.IsScriptComponent;
+		HandlesAnimationEvents = other.HandlesAnimationEvents;
 		TotalSize = other.TotalSize;
 		SerializedSize = other.SerializedSize;
 		SerializedAttributes = std::move(other.SerializedAttributes);
 		PlacementNewConstructor = std::move(other.PlacementNewConstructor);
 		Destructor = std::move(other.Destructor);
+		CopyConstructor = std::move(other.CopyConstructor);
 		DefaultArgs = other.DefaultArgs;
 		other.DefaultArgs = nullptr;
 		return *this;
@@ -331,6 +343,12 @@ public:
 	{
 		return m_scriptComponentIds;
 	}
+
+	// The script components that override ScriptComponent::OnAnimationEvent.
+	const scriptComponentIdContainerType& GetAnimationEventScriptComponentIds() const
+	{
+		return m_animationEventScriptComponentIds;
+	}
 public:
 	const ComponentForm& operator[](ComponentIdType componentId)
 	{
@@ -343,6 +361,7 @@ private:
 	componentFormContainerType m_componentForms;
 	componentFormWithNameContainerType m_componentFormWithName;
 	scriptComponentIdContainerType m_scriptComponentIds;
+	scriptComponentIdContainerType m_animationEventScriptComponentIds;
 };
 
 class ComponentFormGenerator
@@ -369,7 +388,8 @@ protected:
 		std::vector<SerializedAttribute>&& serializedAttributes,
 		std::function<void(void*, const void*)>&& placementNewConstructor,
 		ComponentForm::destructorFunctionType&& destructor,
-		const void* defaultArgs)
+		const void* defaultArgs,
+		bool handlesAnimationEvents = true)
 		:
 		ComponentFormGenerator(
 			{
@@ -381,7 +401,8 @@ protected:
 				std::move(serializedAttributes),
 				std::move(placementNewConstructor),
 				std::move(destructor),
-				defaultArgs})
+				defaultArgs,
+				handlesAnimationEvents})
 	{}
 };
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DCore
+{
+
+// Compiled form of an animation (see CompiledAnimation), made by cooking its YAML source, to be loaded from a mapped
+// file with a validation pass and a copy of its tables, without parsing or sorting keyframes.
+//
+// Layout:
+// Header
+// ChannelEntry[NumberOfChannels]
+// TrackEntry[NumberOfTracks]: as CompiledAnimation::Track.
+// float[NumberOfKeyframes]: the keyframe times, sorted within each track.
+// uint32_t[NumberOfKeyframes]: the keyframe values, as the bits of a CompiledAnimation::KeyframeValue.
+// MetachannelEntry[NumberOfMetachannels]
+// String table: null terminated strings.
+//
+// Every table starts at a multiple of alignof(std::max_align_t).
+namespace CookedAnimation
+{
+	static constexpr uint32_t magic{0x4d4e4144}; // DANM
+	static constexpr uint32_t version{1};
+	static constexpr const char* fileExtension{".dcanim"};
+
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		float Duration;
+		uint32_t NameOffset;
+		uint32_t NumberOfChannels;
+		uint32_t NumberOfTracks;
+		uint32_t NumberOfKeyframes;
+		uint32_t NumberOfMetachannels;
+		uint64_t ChannelsOffset;
+		uint64_t TracksOffset;
+		uint64_t KeyframeTimesOffset;
+		uint64_t KeyframeValuesOffset;
+		uint64_t MetachannelsOffset;
+		uint64_t StringTableOffset;
+		uint64_t StringTableSize;
+	};
+
+	// Components are matched by name when loaded, since the ids of the script components depend on the order they
+	// were registered. The name of the attribute tells if the attribute id still refers to the same attribute.
+	struct ChannelEntry
+	{
+		uint32_t ComponentNameOffset;
+		uint32_t AttributeNameOffset;
+		uint32_t AttributeId;
+		uint32_t KeyframeType;
+		uint32_t FirstTrack;
+		uint32_t NumberOfTracks;
+	};
+
+	struct TrackEntry
+	{
+		uint32_t FirstKeyframe;
+		uint32_t NumberOfKeyframes;
+	};
+
+	struct MetachannelEntry
+	{
+		uint64_t Id;
+		float Time;
+		uint32_t Padding;
+	};
+}
+
+}
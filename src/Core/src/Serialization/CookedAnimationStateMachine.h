@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DCore
+{
+
+// Graph of an animation state machine, made by cooking its YAML source, to be loaded from a mapped file without
+// parsing it or looking up states and parameters by name.
+//
+// Layout:
+// Header
+// ParameterEntry[NumberOfParameters]: grouped by type, in the order of ParameterType, each group in index order.
+// StateEntry[NumberOfStates]: in index order.
+// TransitionEntry[NumberOfTransitions]: the transitions of every state one after the other.
+// ConditionEntry[NumberOfConditions]: the conditions of every transition one after the other.
+// String table: null terminated strings.
+//
+// Every table starts at a multiple of alignof(std::max_align_t). Values hold the bits of an int or a float, or 0 or 1
+// for logic and trigger parameters.
+namespace CookedAnimationStateMachine
+{
+	static constexpr uint32_t magic{0x4d534144}; // DASM
+	static constexpr uint32_t version{1};
+	static constexpr const char* fileExtension{".dcasm"};
+
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t InitialStateIndex;
+		uint32_t NumberOfParameters;
+		uint32_t NumberOfStates;
+		uint32_t NumberOfTransitions;
+		uint32_t NumberOfConditions;
+		uint32_t NameOffset;
+		uint64_t ParametersOffset;
+		uint64_t StatesOffset;
+		uint64_t TransitionsOffset;
+		uint64_t ConditionsOffset;
+		uint64_t StringTableOffset;
+		uint64_t StringTableSize;
+	};
+
+	struct ParameterEntry
+	{
+		uint32_t NameOffset;
+		uint32_t Type;
+		uint32_t Value;
+	};
+
+	// Both halves of the UUID are 0 for a state without animation.
+	struct StateEntry
+	{
+		uint32_t NameOffset;
+		uint32_t FirstTransition;
+		uint32_t NumberOfTransitions;
+		uint32_t Padding;
+		uint64_t AnimationUUIDHigh;
+		uint64_t AnimationUUIDLow;
+	};
+
+	struct TransitionEntry
+	{
+		uint32_t ToStateIndex;
+		uint32_t FirstCondition;
+		uint32_t NumberOfConditions;
+	};
+
+	// ParameterIndex is the index of the parameter among the ones of its type.
+	struct ConditionEntry
+	{
+		uint32_t ParameterType;
+		uint32_t ParameterIndex;
+		uint32_t NumericCondition;
+		uint32_t Value;
+	};
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DCore
+{
+
+// Binary form of a scene, made by cooking its YAML source, to be loaded from a mapped file without parsing.
+//
+// Layout:
+// Header
+// ComponentFormEntry[NumberOfComponentForms]
+// ArchetypeEntry[NumberOfArchetypes]
+// uint32_t[]: the components of every archetype, as indexes into the component form table.
+// Arguments: for every archetype, the arguments of its entities one after the other. The arguments of an entity are
+// the ConstructorArgs of its components in the archetype order, laid out as the scene deserialization lays them out.
+// Attributes that can't be copied hold a uint32_t instead: entity references the index of the entity in the scene
+// (or nullIndex), UUIDs, assets and sound events the offset of their string in the string table.
+// String table: null terminated strings.
+// DependencyEntry[NumberOfDependencies]: every asset the scene needs, directly or through another asset (the maps of
+// its sprite materials, the animations of its animation state machines), sorted by type, then UUID, so the scene can
+// be preloaded without loading it.
+namespace CookedScene
+{
+	static constexpr uint32_t magic{0x4e435344}; // DSCN
+	static constexpr uint32_t version{2};
+	static constexpr uint32_t nullIndex{UINT32_MAX};
+	static constexpr const char* fileExtension{".dcscene"};
+
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t SceneNameOffset;
+		uint32_t NumberOfEntities;
+		uint32_t NumberOfComponentForms;
+		uint32_t NumberOfArchetypes;
+		uint64_t ComponentFormsOffset;
+		uint64_t ArchetypesOffset;
+		uint64_t ArchetypeComponentsOffset;
+		uint64_t ArgumentsOffset;
+		uint64_t StringTableOffset;
+		uint64_t StringTableSize;
+		uint64_t DependenciesOffset;
+		uint64_t NumberOfDependencies;
+	};
+
+	// Components are matched by name when loaded, since the ids of the script components depend on the order
+	// they were registered. The sizes are used to detect components that changed after cooking.
+	struct ComponentFormEntry
+	{
+		uint32_t NameOffset;
+		uint32_t NumberOfAttributes;
+		uint64_t SerializedSize;
+	};
+
+	// The entities of an archetype are cooked contiguously, so FirstEntity is also the index of the first of them
+	// in the scene, which is what entity references refer to. ArgumentsOffset is relative to Header::ArgumentsOffset.
+	struct ArchetypeEntry
+	{
+		uint32_t FirstComponent;
+		uint32_t NumberOfComponents;
+		uint32_t FirstEntity;
+		uint32_t NumberOfEntities;
+		uint64_t ArgumentsOffset;
+		uint64_t EntityArgumentsSize;
+	};
+
+	// In the order they are preloaded, so the assets that others refer to are loaded first.
+	enum class DependencyType : uint32_t
+	{
+		Texture2D,
+		SpriteMaterial,
+		Animation,
+		AnimationStateMachine,
+		PhysicsMaterial
+	};
+
+	struct DependencyEntry
+	{
+		uint64_t UUIDHigh;
+		uint64_t UUIDLow;
+		DependencyType Type;
+		uint32_t Padding;
+	};
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DCore
+{
+
+// Binary form of a sprite material, made by cooking its YAML source.
+//
+// Layout:
+// Header
+// Name: NameSize chars, null terminated.
+//
+// The maps are referred to by the halves of their UUIDs, both 0 for a map the material doesn't have.
+namespace CookedSpriteMaterial
+{
+	static constexpr uint32_t magic{0x544d5344}; // DSMT
+	static constexpr uint32_t version{1};
+
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Type;
+		float Glossiness;
+		float DiffuseColor[4];
+		uint64_t AmbientMapUUIDHigh;
+		uint64_t AmbientMapUUIDLow;
+		uint64_t DiffuseMapUUIDHigh;
+		uint64_t DiffuseMapUUIDLow;
+		uint64_t SpecularMapUUIDHigh;
+		uint64_t SpecularMapUUIDLow;
+		uint64_t NameSize;
+	};
+}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DCore
+{
+
+// Pixels of a texture with all its mip levels, made by cooking its image source, to be uploaded from a mapped file
+// without decoding it.
+//
+// Layout:
+// Header
+// MipLevelEntry[NumberOfMipLevels]: from the full size level down to 1x1.
+// Pixels: the levels one after the other, rows bottom to top, NumberOfChannels bytes per pixel and no row padding.
+//
+// The size, write time and hash of the source are the ones it had when cooked, to tell if the cooked file is stale.
+namespace CookedTexture2D
+{
+	static constexpr uint32_t magic{0x58455444}; // DTEX
+	static constexpr uint32_t version{1};
+	static constexpr uint32_t maximumNumberOfMipLevels{32};
+	static constexpr const char* fileExtension{".dtexc"};
+
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t NumberOfChannels;
+		uint32_t NumberOfMipLevels;
+		uint64_t SourceSize;
+		int64_t SourceWriteTime;
+		uint64_t SourceHash;
+	};
+
+	// Offset is relative to the beginning of the file.
+	struct MipLevelEntry
+	{
+		uint32_t Width;
+		uint32_t Height;
+		uint64_t Offset;
+		uint64_t Size;
+	};
+}
+
+}
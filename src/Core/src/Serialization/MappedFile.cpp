@@ -0,0 +1,155 @@
+#include "MappedFile.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif _WIN32
+#include <windows.h>
+#endif
+
+
+
+namespace DCore
+{
+
+MappedFile::MappedFile()
+	:
+	m_data(nullptr),
+	m_size(0)
+#ifdef _WIN32
+	,
+	m_fileHandle(nullptr),
+	m_mappingHandle(nullptr)
+#endif
+{}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	:
+	m_data(other.m_data),
+	m_size(other.m_size)
+#ifdef _WIN32
+	,
+	m_fileHandle(other.m_fileHandle),
+	m_mappingHandle(other.m_mappingHandle)
+#endif
+{
+	other.m_data = nullptr;
+	other.m_size = 0;
+#ifdef _WIN32
+	other.m_fileHandle = nullptr;
+	other.m_mappingHandle = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef __linux__
+bool MappedFile::Open(const pathType& path)
+{
+	Close();
+	const int fileDescriptor(open(path.c_str(), O_RDONLY));
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+	void* data(mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0));
+	// The mapping keeps the file referenced.
+	close(fileDescriptor);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	m_data = static_cast<const char*>(data);
+	m_size = static_cast<size_t>(fileStatus.st_size);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data == nullptr)
+	{
+		return;
+	}
+	munmap(const_cast<char*>(m_data), m_size);
+	m_data = nullptr;
+	m_size = 0;
+}
+#elif _WIN32
+bool MappedFile::Open(const pathType& path)
+{
+	Close();
+	HANDLE fileHandle(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+	HANDLE mappingHandle(CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr));
+	if (mappingHandle == nullptr)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+	void* data(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr)
+	{
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+	m_data = static_cast<const char*>(data);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data == nullptr)
+	{
+		return;
+	}
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mappingHandle);
+	CloseHandle(m_fileHandle);
+	m_data = nullptr;
+	m_size = 0;
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+}
+#endif
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	Close();
+	m_data = other.m_data;
+	m_size = other.m_size;
+	other.m_data = nullptr;
+	other.m_size = 0;
+#ifdef _WIN32
+	m_fileHandle = other.m_fileHandle;
+	m_mappingHandle = other.m_mappingHandle;
+	other.m_fileHandle = nullptr;
+	other.m_mappingHandle = nullptr;
+#endif
+	return *this;
+}
+
+}
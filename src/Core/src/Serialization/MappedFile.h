@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+
+
+namespace DCore
+{
+
+// Read only view of a whole file mapped into memory. Pages are only read from disk when touched.
+class MappedFile
+{
+public:
+	using pathType = std::filesystem::path;
+public:
+	MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) noexcept;
+	~MappedFile();
+public:
+	bool Open(const pathType&);
+	void Close();
+public:
+	bool IsOpen() const
+	{
+		return m_data != nullptr;
+	}
+
+	const char* GetData() const
+	{
+		return m_data;
+	}
+
+	size_t GetSize() const
+	{
+		return m_size;
+	}
+public:
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) noexcept;
+private:
+	const char* m_data;
+	size_t m_size;
+#ifdef _WIN32
+	void* m_fileHandle;
+	void* m_mappingHandle;
+#endif
+};
+
+}
@@ -52,6 +52,11 @@ public:
 		return m_bank == nullptr;
 	}
 
+	soundBankType* Internal_GetBank() const
+	{
+		return m_bank;
+	}
+
 	void Internal_SetPath(const char* path)
 	{
 		m_path = path;
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "DCoreAssert.h"
+#include "FlatHashMap.h"
+
+#include <future>
+#include <mutex>
+
+
+
+namespace DCore
+{
+
+// Deduplicates the concurrent loads of an asset. The first thread to begin the load of a key owns it and must end it,
+// telling whether it succeeded. The other threads get the future of that result to block on, instead of polling the
+// asset manager, so a failed load also wakes them up. The owner ends the load through a LoadGuard.
+template <class KeyType>
+class InFlightLoadTable
+{
+public:
+	using keyType = KeyType;
+	using futureType = std::shared_future<bool>;
+	using promiseType = std::promise<bool>;
+	using mutexType = std::mutex;
+	using lockGuardType = std::lock_guard<mutexType>;
+private:
+	struct Load
+	{
+		promiseType Promise;
+		futureType Future;
+	};
+private:
+	using loadContainerType = FlatHashMap<keyType, Load>;
+public:
+	InFlightLoadTable() = default;
+	InFlightLoadTable(const InFlightLoadTable&) = delete;
+	InFlightLoadTable(InFlightLoadTable&&) = delete;
+	~InFlightLoadTable() = default;
+public:
+	// Returns true if the calling thread now owns the load of key. Otherwise outFuture is set to the result of the
+	// load in progress.
+	bool TryBeginLoad(const keyType& key, futureType& outFuture)
+	{
+		lockGuardType guard(m_mutex);
+		const Load* load(m_loads.Find(key));
+		if (load != nullptr)
+		{
+			outFuture = load->Future;
+			return false;
+		}
+		Load newLoad;
+		newLoad.Future = newLoad.Promise.get_future().share();
+		m_loads.Insert(key, std::move(newLoad));
+		return true;
+	}
+
+	// To be called by the owner of the load of key. Wakes up the threads waiting for it.
+	void EndLoad(const keyType& key, bool succeeded)
+	{
+		promiseType promise;
+		{
+			lockGuardType guard(m_mutex);
+			Load* load(m_loads.Find(key));
+			DASSERT_E(load != nullptr);
+			promise = std::move(load->Promise);
+			m_loads.Remove(key);
+		}
+		promise.set_value(succeeded);
+	}
+
+	bool IsLoading(const keyType& key)
+	{
+		lockGuardType guard(m_mutex);
+		return m_loads.Contains(key);
+	}
+public:
+	// Owns the load of a key begun with TryBeginLoad. If it is destroyed before the load is ended through it, e.g. when
+	// the loader throws, the load is ended as failed, so the threads waiting for it are not blocked forever.
+	class LoadGuard
+	{
+	public:
+		LoadGuard(InFlightLoadTable& table, const keyType& key)
+			:
+			m_table(&table),
+			m_key(key)
+		{}
+		LoadGuard(const LoadGuard&) = delete;
+		LoadGuard(LoadGuard&& other) noexcept
+			:
+			m_table(other.m_table),
+			m_key(other.m_key)
+		{
+			other.m_table = nullptr;
+		}
+		~LoadGuard()
+		{
+			if (m_table != nullptr)
+			{
+				m_table->EndLoad(m_key, false);
+			}
+		}
+	public:
+		LoadGuard& operator=(const LoadGuard&) = delete;
+		LoadGuard& operator=(LoadGuard&&) = delete;
+	public:
+		void EndLoad(bool succeeded)
+		{
+			DASSERT_E(m_table != nullptr);
+			InFlightLoadTable* table(m_table);
+			m_table = nullptr;
+			table->EndLoad(m_key, succeeded);
+		}
+	private:
+		InFlightLoadTable* m_table;
+		keyType m_key;
+	};
+private:
+	loadContainerType m_loads;
+	mutexType m_mutex;
+};
+
+}
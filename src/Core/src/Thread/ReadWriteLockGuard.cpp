@@ -49,7 +49,9 @@ void ReadWriteLockGuard::HandleLock()
 		switch (m_desiredLock)
 		{
 		case DCore::ReadLock:
-			if (m_lockData.ReadingThreads.count(m_thisThreadId) > 0)
+			// The write lock also allows reading.
+			if (m_lockData.ReadingThreads.count(m_thisThreadId) > 0 ||
+				(m_lockData.IsThreadWriting && m_lockData.WritingThread == m_thisThreadId))
 			{
 				return;
 			}
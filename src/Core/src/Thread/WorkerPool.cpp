@@ -0,0 +1,136 @@
+#include "WorkerPool.h"
+#include "DCoreAssert.h"
+
+#include <algorithm>
+
+
+
+namespace DCore
+{
+
+WorkerPool::WorkerPool()
+	:
+	m_toStop(false)
+{
+	const size_t hardwareThreads(std::thread::hardware_concurrency());
+	const size_t numberOfWorkers(hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+	m_workers.reserve(numberOfWorkers);
+	for (size_t i(0); i < numberOfWorkers; i++)
+	{
+		m_workers.emplace_back(&WorkerPool::WorkerLoop, this);
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		lockGuardType guard(m_mutex);
+		m_toStop = true;
+	}
+	m_conditionVariable.notify_all();
+	for (threadType& worker : m_workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+}
+
+void WorkerPool::Submit(jobType&& job)
+{
+	DASSERT_E(job);
+	{
+		lockGuardType guard(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+	m_conditionVariable.notify_one();
+}
+
+void WorkerPool::ParallelFor(size_t count, size_t minimumBatchSize, const rangeJobType& job)
+{
+	DASSERT_E(job);
+	if (count == 0)
+	{
+		return;
+	}
+	minimumBatchSize = std::max<size_t>(minimumBatchSize, 1);
+	const size_t maximumNumberOfBatches(m_workers.size() + 1);
+	size_t batchSize(std::max(minimumBatchSize, (count + maximumNumberOfBatches - 1) / maximumNumberOfBatches));
+	const size_t numberOfBatches((count + batchSize - 1) / batchSize);
+	if (numberOfBatches == 1)
+	{
+		job(0, count);
+		return;
+	}
+	// The context is shared with the helpers because a helper may only be scheduled after all the batches are done.
+	std::shared_ptr<ParallelForContext> context(std::make_shared<ParallelForContext>(count, batchSize, numberOfBatches, job));
+	for (size_t i(0); i < numberOfBatches - 1; i++)
+	{
+		Submit
+		(
+			[context]() -> void
+			{
+				ExecuteBatches(*context);
+			}
+		);
+	}
+	ExecuteBatches(*context);
+	uniqueLockType lock(context->Mutex);
+	context->ConditionVariable.wait
+	(
+		lock,
+		[&]() -> bool
+		{
+			return context->FinishedBatches.load(std::memory_order_acquire) == numberOfBatches;
+		}
+	);
+}
+
+void WorkerPool::WorkerLoop()
+{
+	while (true)
+	{
+		jobType job;
+		{
+			uniqueLockType lock(m_mutex);
+			m_conditionVariable.wait
+			(
+				lock,
+				[&]() -> bool
+				{
+					return m_toStop || !m_jobs.empty();
+				}
+			);
+			if (m_toStop && m_jobs.empty())
+			{
+				return;
+			}
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+		job();
+	}
+}
+
+void WorkerPool::ExecuteBatches(ParallelForContext& context)
+{
+	while (true)
+	{
+		const size_t batch(context.NextBatch.fetch_add(1, std::memory_order_relaxed));
+		if (batch >= context.NumberOfBatches)
+		{
+			return;
+		}
+		const size_t begin(batch * context.BatchSize);
+		const size_t end(std::min(begin + context.BatchSize, context.Count));
+		context.Job(begin, end);
+		if (context.FinishedBatches.fetch_add(1, std::memory_order_acq_rel) + 1 == context.NumberOfBatches)
+		{
+			lockGuardType guard(context.Mutex);
+			context.ConditionVariable.notify_all();
+		}
+	}
+}
+
+}
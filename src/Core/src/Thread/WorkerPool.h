@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+namespace DCore
+{
+
+class WorkerPool
+{
+public:
+	using jobType = std::function<void()>;
+	using rangeJobType = std::function<void(size_t begin, size_t end)>;
+	using threadType = std::thread;
+	using threadContainerType = std::vector<threadType>;
+	using jobContainerType = std::deque<jobType>;
+	using mutexType = std::mutex;
+	using uniqueLockType = std::unique_lock<mutexType>;
+	using lockGuardType = std::lock_guard<mutexType>;
+	using conditionVariableType = std::condition_variable;
+public:
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool(WorkerPool&&) = delete;
+	~WorkerPool();
+public:
+	static WorkerPool& Get()
+	{
+		static WorkerPool instance;
+		return instance;
+	}
+public:
+	void Submit(jobType&&);
+	// Splits [0, count) in batches of at least minimumBatchSize and runs them on the workers.
+	// The calling thread also executes batches and only returns when all of them are done.
+	void ParallelFor(size_t count, size_t minimumBatchSize, const rangeJobType&);
+public:
+	size_t GetNumberOfWorkers() const
+	{
+		return m_workers.size();
+	}
+private:
+	WorkerPool();
+private:
+	struct ParallelForContext
+	{
+		ParallelForContext(size_t count, size_t batchSize, size_t numberOfBatches, const rangeJobType& job)
+			:
+			Count(count),
+			BatchSize(batchSize),
+			NumberOfBatches(numberOfBatches),
+			NextBatch(0),
+			FinishedBatches(0),
+			Job(job)
+		{}
+
+		const size_t Count;
+		const size_t BatchSize;
+		const size_t NumberOfBatches;
+		std::atomic<size_t> NextBatch;
+		std::atomic<size_t> FinishedBatches;
+		const rangeJobType& Job;
+		mutexType Mutex;
+		conditionVariableType ConditionVariable;
+	};
+private:
+	threadContainerType m_workers;
+	jobContainerType m_jobs;
+	mutexType m_mutex;
+	conditionVariableType m_conditionVariable;
+	bool m_toStop;
+private:
+	void WorkerLoop();
+	static void ExecuteBatches(ParallelForContext&);
+};
+
+}
@@ -1,70 +1,141 @@
 #include "UUID.h"
 
 #include <ostream>
+#include <type_traits>
+
+#ifdef __linux__
+#include <uuid/uuid.h>
+#elif _WIN32
+#pragma comment(lib, "rpcrt4.lib")
+
+#include <rpc.h>
+#endif
 
 
 
 namespace DCore
 {
 
-#ifdef __linux__
-UUIDWrapper::UUIDWrapper()
-{
-	uuid_clear(m_uuid);
-}
+static_assert(std::is_trivially_copyable<UUIDWrapper>::value && sizeof(UUIDWrapper) == UUIDWrapper::sizeBytes);
 
-UUIDWrapper::UUIDWrapper(const UUIDWrapper& other)
-{
-	uuid_copy(m_uuid, other.m_uuid);
-}
+static constexpr char hexDigits[]{"0123456789abcdef"};
 
-UUIDWrapper::UUIDWrapper(const stringType& uuidString)
+static bool IsDashIndex(size_t index)
 {
-	uuid_parse(uuidString.c_str(), m_uuid);
+	return index == 8 || index == 13 || index == 18 || index == 23;
 }
 
-std::ostream& operator<<(std::ostream& os, const UUIDWrapper& uuidWrapper)
+static int GetHexDigitValue(char digit)
 {
-	char uuidString[UUID_STR_LEN];
-	uuidString[UUID_STR_LEN - 1] = '\0';
-	uuid_unparse(uuidWrapper.m_uuid, uuidString);
-	os << uuidString;
-	return os;
+	if (digit >= '0' && digit <= '9')
+	{
+		return digit - '0';
+	}
+	if (digit >= 'a' && digit <= 'f')
+	{
+		return digit - 'a' + 10;
+	}
+	if (digit >= 'A' && digit <= 'F')
+	{
+		return digit - 'A' + 10;
+	}
+	return -1;
 }
 
-void UUIDGenerator::GenerateUUID(UUIDWrapper& outUUID) const
+// Writes the canonical form, without the null terminator.
+static void UnparseUUID(uint64_t high, uint64_t low, char* outString)
 {
-	uuid_generate(outUUID.m_uuid);
+	size_t digitIndex(0);
+	for (size_t i(0); i < UUIDWrapper::stringLength; i++)
+	{
+		if (IsDashIndex(i))
+		{
+			outString[i] = '-';
+			continue;
+		}
+		const uint64_t half(digitIndex < 16 ? high : low);
+		const size_t shift((15 - digitIndex % 16) * 4);
+		outString[i] = hexDigits[(half >> shift) & 0xf];
+		digitIndex++;
+	}
 }
-#elif _WIN32
-UUIDWrapper::UUIDWrapper()
-{}
 
-UUIDWrapper::UUIDWrapper(const UUIDWrapper& other)
+UUIDWrapper::UUIDWrapper(const stringType& uuidString)
 	:
-	m_uuid(other.m_uuid)
-{}
+	m_high(0),
+	m_low(0)
+{
+	if (uuidString.size() != stringLength)
+	{
+		return;
+	}
+	uint64_t halves[2]{0, 0};
+	size_t digitIndex(0);
+	for (size_t i(0); i < stringLength; i++)
+	{
+		if (IsDashIndex(i))
+		{
+			if (uuidString[i] != '-')
+			{
+				return;
+			}
+			continue;
+		}
+		const int value(GetHexDigitValue(uuidString[i]));
+		if (value < 0)
+		{
+			return;
+		}
+		uint64_t& half(halves[digitIndex / 16]);
+		half = (half << 4) | static_cast<uint64_t>(value);
+		digitIndex++;
+	}
+	m_high = halves[0];
+	m_low = halves[1];
+}
 
-UUIDWrapper::UUIDWrapper(const stringType& uuidString)
+UUIDWrapper::operator std::string() const
 {
-	stringType copy(uuidString);
-	UuidFromString(reinterpret_cast<unsigned char*>(copy.data()), &m_uuid);
+	std::string returnValue(stringLength, '\0');
+	UnparseUUID(m_high, m_low, returnValue.data());
+	return returnValue;
 }
 
 std::ostream& operator<<(std::ostream& os, const UUIDWrapper& uuidWrapper)
 {
-	unsigned char uuidString[UUIDWrapper::uuidStringLen];
-	uuidString[UUIDWrapper::uuidStringLen - 1] = '\0';
-	UuidToString(&uuidWrapper.m_uuid, reinterpret_cast<unsigned char**>(&uuidString));
+	char uuidString[UUIDWrapper::stringLength + 1];
+	UnparseUUID(uuidWrapper.m_high, uuidWrapper.m_low, uuidString);
+	uuidString[UUIDWrapper::stringLength] = '\0';
 	os << uuidString;
 	return os;
 }
 
+#ifdef __linux__
 void UUIDGenerator::GenerateUUID(UUIDWrapper& outUUID) const
 {
-	UuidCreate(&outUUID.m_uuid);
+	uuid_t uuid;
+	uuid_generate(uuid);
+	outUUID.m_high = 0;
+	outUUID.m_low = 0;
+	for (size_t i(0); i < 8; i++)
+	{
+		outUUID.m_high = (outUUID.m_high << 8) | uuid[i];
+		outUUID.m_low = (outUUID.m_low << 8) | uuid[i + 8];
+	}
+}
+#elif _WIN32
+void UUIDGenerator::GenerateUUID(UUIDWrapper& outUUID) const
+{
+	UUID uuid;
+	UuidCreate(&uuid);
+	// The canonical form writes the first three fields as numbers, then the bytes of Data4.
+	outUUID.m_high = (static_cast<uint64_t>(uuid.Data1) << 32) | (static_cast<uint64_t>(uuid.Data2) << 16) | uuid.Data3;
+	outUUID.m_low = 0;
+	for (size_t i(0); i < 8; i++)
+	{
+		outUUID.m_low = (outUUID.m_low << 8) | uuid.Data4[i];
+	}
 }
-
 #endif
 
 }
@@ -1,13 +1,10 @@
 #pragma once
 
-#include <bitset>
-
-
-
-#ifdef __linux__
-
-#include <uuid/uuid.h>
-#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
 
 
 
@@ -18,6 +15,8 @@ class UUIDWrapper;
 
 using UUIDType = UUIDWrapper;
 
+// Trivially copyable 128 bits UUID. m_high holds the first 8 bytes of its canonical form
+// (xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx) and m_low the last 8, most significant first, on every platform.
 class UUIDWrapper
 {
 	friend class UUIDGenerator;
@@ -25,168 +24,65 @@ class UUIDWrapper
 public:
 	using stringType = std::string;
 public:
-	static constexpr size_t sizeBytes{ sizeof(uuid_t) };
-	static constexpr size_t sizeBits{ sizeBytes * CHAR_BIT };
+	static constexpr size_t sizeBytes{16};
+	static constexpr size_t stringLength{36};
 public:
-	UUIDWrapper();
-	UUIDWrapper(const UUIDWrapper&);
+	constexpr UUIDWrapper()
+		:
+		m_high(0),
+		m_low(0)
+	{}
+	constexpr UUIDWrapper(uint64_t high, uint64_t low)
+		:
+		m_high(high),
+		m_low(low)
+	{}
+	// An ill formed string gives the nil UUID.
 	UUIDWrapper(const stringType& uuidString);
+	UUIDWrapper(const UUIDWrapper&) = default;
 	~UUIDWrapper() = default;
 public:
-	bool operator==(const UUIDWrapper& other) const
-	{
-		return uuid_compare(m_uuid, other.m_uuid) == 0;
-	}
-
-	bool operator!=(const UUIDWrapper& other) const
-	{
-		return uuid_compare(m_uuid, other.m_uuid) != 0;
-	}
+	UUIDWrapper& operator=(const UUIDWrapper&) = default;
 
-	UUIDWrapper& operator=(const UUIDWrapper& other)
-	{
-		uuid_copy(m_uuid, other.m_uuid);
-		return *this;
-	}
-
-	operator std::string() const
-	{
-		char unparsed[UUID_STR_LEN];
-		unparsed[UUID_STR_LEN - 1] = '\0';
-		uuid_unparse(m_uuid, unparsed);
-		return std::string(unparsed);
-	}
-
-	const unsigned char* Raw() const
-	{
-		return m_uuid;
-	}
-private:
-	uuid_t m_uuid;
-};
-
-}
-
-template <>
-struct std::hash<DCore::UUIDType>
-{
-	using BitsType = std::bitset<DCore::UUIDType::sizeBits>;
-
-	void GetUUIDBinaryRepresentation(const DCore::UUIDType& s, BitsType& outRepresentation) const
-	{
-		for (size_t i(0); i < DCore::UUIDType::sizeBytes; i++)
-		{
-			BitsType temp(s.Raw()[i]);
-			temp <<= i * CHAR_BIT;
-			outRepresentation |= temp;
-		}
-	}
-
-	std::size_t operator()(const DCore::UUIDType& s) const noexcept
-	{
-		BitsType binary;
-		GetUUIDBinaryRepresentation(s, binary);
-		return std::hash<BitsType>{}(binary);
-	}
-};
-#elif _WIN32
-#pragma comment(lib, "rpcrt4.lib")
-
-#include "DCoreAssert.h"
-
-#include <rpc.h>
-
-
-
-namespace DCore
-{
-
-class UUIDWrapper;
-
-using UUIDType = UUIDWrapper;
-
-class UUIDWrapper
-{
-	friend class UUIDGenerator;
-	friend std::ostream& operator<<(std::ostream&, const UUIDWrapper&);
-public:
-	using stringType = std::string;
-public:
-	static constexpr size_t uuidStringLen{37};
-public:
-	UUIDWrapper();
-	UUIDWrapper(const UUIDWrapper&);
-	UUIDWrapper(const stringType& uuidString);
-	~UUIDWrapper() = default;
-public:
 	bool operator==(const UUIDWrapper& other) const
 	{
-		UUID left(m_uuid);
-		UUID right(other.m_uuid);
-		RPC_STATUS status;
-		signed int result(UuidCompare(&left, &right, &status));
-		DASSERT_E(status == RPC_S_OK);
-		return result == 0;
+		return ((m_high ^ other.m_high) | (m_low ^ other.m_low)) == 0;
 	}
 
 	bool operator!=(const UUIDWrapper& other) const
 	{
-		UUID left(m_uuid);
-		UUID right(other.m_uuid);	
-		RPC_STATUS status;
-		signed int result(UuidCompare(&left, &right, &status));
-		DASSERT_E(status == RPC_S_OK);
-		return result != 0;
+		return ((m_high ^ other.m_high) | (m_low ^ other.m_low)) != 0;
 	}
 
-	UUIDWrapper& operator=(const UUIDWrapper& other)
-	{
-		m_uuid = other.m_uuid;
-		return *this;
-	}
-
-	operator std::string() const
+	operator std::string() const;
+public:
+	uint64_t GetHigh() const
 	{
-		RPC_CSTR uuidString(nullptr);
-		RPC_STATUS status(UuidToString(&m_uuid, &uuidString));
-		DASSERT_E(status == RPC_S_OK);
-		stringType returnValue(reinterpret_cast<char*>(uuidString));
-		RpcStringFree(&uuidString);
-		return returnValue;
+		return m_high;
 	}
 
-	const UUID& Raw() const
+	uint64_t GetLow() const
 	{
-		return m_uuid;
+		return m_low;
 	}
 
-	UUID& Raw()
+	// The halves are folded and then mixed with the finalizer of MurmurHash3, so every bit of the result depends on
+	// every bit of the UUID. Open addressing maps take the slot from the low bits.
+	size_t Hash() const
 	{
-		return m_uuid;
+		uint64_t hash(m_high ^ (m_low * 0x9e3779b97f4a7c15ull));
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ull;
+		hash ^= hash >> 33;
+		return static_cast<size_t>(hash);
 	}
 private:
-	UUID m_uuid;
+	uint64_t m_high;
+	uint64_t m_low;
 };
 
-}
-
-template <>
-struct std::hash<DCore::UUIDType>
-{
-	size_t operator()(const DCore::UUIDType& s) const noexcept
-	{
-		DCore::UUIDType uuid(s);
-		RPC_STATUS status;
-		unsigned short result(UuidHash(&uuid.Raw(), &status));
-		DASSERT_E(status == RPC_S_OK);
-		return static_cast<size_t>(result);
-	}
-};
-#endif 
-
-namespace DCore
-{
-
 class UUIDGenerator
 {
 public:
@@ -205,5 +101,11 @@ private:
 
 }
 
-
-
+template <>
+struct std::hash<DCore::UUIDType>
+{
+	std::size_t operator()(const DCore::UUIDType& uuid) const noexcept
+	{
+		return uuid.Hash();
+	}
+};
@@ -13,7 +13,9 @@ EditorAnimationStateMachine::EditorAnimationStateMachine(const uuidType& uuid)
 EditorAnimationStateMachine::EditorAnimationStateMachine(EditorAnimationStateMachine&& other) noexcept
 	:
 	m_animationStateMachine(std::move(other.m_animationStateMachine)),
-	m_statePositions(std::move(other.m_statePositions))
+	m_statePositions(std::move(other.m_statePositions)),
+	m_instance(std::move(other.m_instance)),
+	m_attachedEntity(other.m_attachedEntity)
 {}
 
 EditorAnimationStateMachine::createStateResult EditorAnimationStateMachine::CreateState(const stringType& stateName, const dVec2& statePosition, stateConstRefType* outState)
@@ -121,26 +123,43 @@ void EditorAnimationStateMachine::DeleteCondition(size_t fromStateIndex, size_t
 
 void EditorAnimationStateMachine::AttachTo(entityRefType entity)
 {
-	m_animationStateMachine.AttachTo(entity);
+	m_attachedEntity = entity;
 }
 
 void EditorAnimationStateMachine::Setup()
 {
-	m_animationStateMachine.Setup();
+	m_animationStateMachine.Compile();
+	m_animationStateMachine.SetupInstance(m_instance);
 }
 
 void EditorAnimationStateMachine::Tick(float deltaTime)
 {
-	DCore::ReadWriteLockGuard sceneGuard(DCore::LockType::ReadLock, *static_cast<DCore::SceneAssetManager*>(&DCore::AssetManager::Get()));
+	// Ticking writes into the components of the attached entity without locking.
+	DCore::ReadWriteLockGuard sceneGuard(DCore::LockType::WriteLock, *static_cast<DCore::SceneAssetManager*>(&DCore::AssetManager::Get()));
 	DCore::ReadWriteLockGuard animationGuard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
 	DCore::ReadWriteLockGuard asmGuard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationStateMachineAssetManager*>(&DCore::AssetManager::Get()));
-	m_animationStateMachine.Tick(deltaTime, [](DCore::EntityRef, size_t){});
+	m_animationStateMachine.Tick(m_instance, m_attachedEntity, deltaTime, [](DCore::EntityRef, size_t){});
+	// Shows the triggers consumed by the preview as unset.
+	m_animationStateMachine.IterateOnParameters<parameterType::Trigger>
+	(
+		[&](DCore::triggerParameterConstRefType parameter) -> bool
+		{
+			const DCore::ParameterValue* parameterValue(m_instance.TryGetParameterValue(parameterType::Trigger, parameter.GetIndex()));
+			if (parameterValue != nullptr && !parameterValue->Logic)
+			{
+				m_animationStateMachine.SetParameterValue<parameterType::Trigger>(parameter.GetIndex(), DCore::TriggerParameter{false});
+			}
+			return false;
+		}
+	);
 }
 
 EditorAnimationStateMachine& EditorAnimationStateMachine::operator=(EditorAnimationStateMachine&& other) noexcept
 {
 	m_animationStateMachine = std::move(other.m_animationStateMachine);
 	m_statePositions = std::move(m_statePositions);
+	m_instance = std::move(other.m_instance);
+	m_attachedEntity = other.m_attachedEntity;
 	return *this;
 }
 
@@ -14,6 +14,7 @@ class EditorAnimationStateMachine
 {
 public:
 	using animationStateMachineType = DCore::AnimationStateMachine;
+	using animationStateMachineInstanceType = DCore::AnimationStateMachineInstance;
 	using stateIdType = animationStateMachineType::stateContainerType::idType;
 	using stateContainerType = animationStateMachineType::stateContainerType;
 	using dVec2 = DCore::DVec2;
@@ -144,10 +145,12 @@ public:
 		m_animationStateMachine.DeleteParameter(parameter);
 	}
 
+	// Sets the value the parameter starts with and, while previewing, its value in the preview.
 	template <parameterType ParameterType, class ParameterValueType>
 	void SetParameterValue(size_t parameterIndex, ParameterValueType value)
 	{
 		m_animationStateMachine.SetParameterValue<ParameterType>(parameterIndex, value);
+		m_instance.SetParameterValue<ParameterType>(parameterIndex, value);
 	}
 
 	template <class Func>
@@ -188,6 +191,8 @@ public:
 private:
 	animationStateMachineType m_animationStateMachine;
 	positionContainerType m_statePositions;
+	animationStateMachineInstanceType m_instance;
+	entityRefType m_attachedEntity;
 };
 
 }
@@ -1,4 +1,5 @@
 #include "AnimationManager.h"
+#include "AssetPackManager.h"
 #include "ProgramContext.h"
 #include "Log.h"
 #include "Path.h"
@@ -6,8 +7,14 @@
 
 #include "yaml-cpp/yaml.h"
 
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <thread>
 
 
 
@@ -40,6 +47,11 @@ static constexpr float s_defaultAnimationDuration = Animation::s_defaultDuration
 
 AnimationManager::AnimationManager()
 {
+	if (AssetPackManager::Get().GetAssetPack() != nullptr)
+	{
+		// The animations are loaded from the pack.
+		return;
+	}
 	pathType animationsPath(GetAnimationsPath() / s_animationsFileName);
 	std::ofstream ostream(animationsPath, std::ios_base::out | std::ios_base::app);
 	DASSERT_E(ostream);
@@ -342,6 +354,7 @@ void AnimationManager::DeleteAnimation(const uuidType& animationUUID)
 	DASSERT_E(s_animationsNode[uuidString]);
 	const pathType animationPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_animationsNode[uuidString].as<stringType>());
 	std::filesystem::remove(animationPath);
+	std::filesystem::remove(GetCookedAnimationPath(animationPath));
 	YAML::Node newAnimationsNode;
 	for (YAML::const_iterator it(s_animationsNode.begin()); it != s_animationsNode.end(); it++)
 	{
@@ -372,38 +385,95 @@ void AnimationManager::DeleteAnimation(const uuidType& animationUUID)
 AnimationManager::coreAnimationRefType AnimationManager::LoadCoreAnimation(const uuidType& uuid)
 {
 	using coreAnimationType = DCore::Animation;
+	while (true)
 	{
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
+			if (DCore::AssetManager::Get().IsAnimationLoaded(uuid))
+			{
+				return DCore::AssetManager::Get().GetAnimation(uuid);
+			}
+		}
+		loadFutureType loadFuture;
+		if (m_animationsLoading.TryBeginLoad(uuid, loadFuture))
+		{
+			break;
+		}
+		// The asset is looked up again after the load, as it may have been unloaded in between.
+		if (!loadFuture.get())
+		{
+			return coreAnimationRefType();
+		}
+	}
+	loadGuardType loadGuard(m_animationsLoading, uuid);
+	{
+		// The load may have ended between the lookup and the beginning of this one.
 		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
 		if (DCore::AssetManager::Get().IsAnimationLoaded(uuid))
 		{
+			loadGuard.EndLoad(true);
 			return DCore::AssetManager::Get().GetAnimation(uuid);
 		}
 	}
+	coreAnimationType coreAnimation(stringType(), 0.0f);
+	const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+	if (assetPack != nullptr)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-		if (m_animationsLoading.count(uuid) == 0)
+		const DCore::AssetPack::Entry* entry(assetPack->Find(uuid, DCore::AssetPackEntryType::Animation));
+		if (entry == nullptr || !ReadCookedAnimation(assetPack->GetPayload(*entry), static_cast<size_t>(entry->Size), coreAnimation))
 		{
-			m_animationsLoading.insert(uuid);
-			goto LoadAnimation;
+			Log::Get().TerminalLog("Fail to load animation %s from the asset pack.", ((stringType)uuid).c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load animation %s from the asset pack.", ((stringType)uuid).c_str());
+			loadGuard.EndLoad(false);
+			return coreAnimationRefType();
 		}
 	}
-	while (true)
+	else
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
-		if (DCore::AssetManager::Get().IsAnimationLoaded(uuid))
+		const stringType uuidString(uuid);
+		DASSERT_E(s_animationsNode[uuidString]);
+		const pathType animationPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_animationsNode[uuidString].as<stringType>());
+		if (!std::filesystem::exists(animationPath))
 		{
-			return DCore::AssetManager::Get().GetAnimation(uuid);
+			Log::Get().TerminalLog("Fail to load animation at path: %s", animationPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load animation at path: %s", animationPath.string().c_str());
+			loadGuard.EndLoad(false);
+			return coreAnimationRefType();
+		}
+		if (!OpenCookedAnimation(animationPath, coreAnimation))
+		{
+			cookedAnimationType cookedAnimation;
+			coreAnimation = CookAnimation(uuid, animationPath, cookedAnimation);
 		}
 	}
-LoadAnimation:
-	Animation editorAnimation(LoadAnimation(uuid));
-	coreAnimationType coreAnimation(editorAnimation.GenerateCoreAnimation());
 	coreAnimationRefType coreAnimationRef(DCore::AssetManager::Get().LoadAnimation(uuid, std::move(coreAnimation)));
-	DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-	m_animationsLoading.erase(uuid);
+	loadGuard.EndLoad(true);
 	return coreAnimationRef;
 }
 
+bool AnimationManager::ReloadCoreAnimation(const pathType& animationPath)
+{
+	for (YAML::const_iterator it(s_animationsNode.begin()); it != s_animationsNode.end(); it++)
+	{
+		if ((ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second.as<stringType>()).lexically_normal() != animationPath.lexically_normal())
+		{
+			continue;
+		}
+		const uuidType uuid(it->first.as<stringType>());
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
+			if (!DCore::AssetManager::Get().IsAnimationLoaded(uuid))
+			{
+				return true;
+			}
+		}
+		cookedAnimationType cookedAnimation;
+		DCore::AssetManager::Get().ReloadAnimation(uuid, CookAnimation(uuid, animationPath, cookedAnimation));
+		return true;
+	}
+	return false;
+}
+
 bool AnimationManager::RenameAnimation(const uuidType& uuid, const stringType& newName)
 {
 	for (YAML::const_iterator it(s_animationsNode.begin()); it != s_animationsNode.end(); it++)
@@ -434,6 +504,8 @@ bool AnimationManager::RenameAnimation(const uuidType& uuid, const stringType& n
 	pathType newPath(oldPath);
 	newPath.replace_filename(newName + ".danim");
 	std::filesystem::rename(oldPath, newPath);
+	// Cooked again, with the new name, when next loaded.
+	std::filesystem::remove(GetCookedAnimationPath(oldPath));
 	s_animationsNode[uuidString] = Path::Get().MakePathRelativeToAssetsDirectory(newPath).string();
 	SaveAnimationsMap();
 	DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
@@ -444,6 +516,287 @@ bool AnimationManager::RenameAnimation(const uuidType& uuid, const stringType& n
 	return true;
 }
 
+void AnimationManager::IterateOnCookedAnimations(cookedAnimationIterationCallbackType callback)
+{
+	cookedAnimationType cookedAnimation;
+	for (YAML::const_iterator it(s_animationsNode.begin()); it != s_animationsNode.end(); it++)
+	{
+		const uuidType uuid(it->first.as<stringType>());
+		const pathType animationPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second.as<stringType>());
+		if (!std::filesystem::exists(animationPath))
+		{
+			Log::Get().TerminalLog("Fail to cook animation at path: %s", animationPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Warning, "Fail to cook animation at path: %s", animationPath.string().c_str());
+			continue;
+		}
+		const pathType cookedAnimationPath(GetCookedAnimationPath(animationPath));
+		cookedAnimation.clear();
+		if (IsCookedAnimationUpToDate(animationPath, cookedAnimationPath))
+		{
+			std::ifstream istream(cookedAnimationPath, std::ios_base::binary);
+			cookedAnimation.assign(std::istreambuf_iterator<char>(istream), std::istreambuf_iterator<char>());
+		}
+		DCore::Animation animation(stringType(), 0.0f);
+		if (!ReadCookedAnimation(cookedAnimation.data(), cookedAnimation.size(), animation))
+		{
+			CookAnimation(uuid, animationPath, cookedAnimation);
+		}
+		// The animations are named after their files.
+		if (callback(uuid, animationPath.stem().string(), cookedAnimation))
+		{
+			return;
+		}
+	}
+}
+
+AnimationManager::pathType AnimationManager::GetCookedAnimationPath(const pathType& animationPath) const
+{
+	pathType cookedAnimationPath(animationPath);
+	cookedAnimationPath.replace_extension(DCore::CookedAnimation::fileExtension);
+	return cookedAnimationPath;
+}
+
+bool AnimationManager::IsCookedAnimationUpToDate(const pathType& animationPath, const pathType& cookedAnimationPath) const
+{
+	std::error_code errorCode;
+	const std::filesystem::file_time_type cookedAnimationWriteTime(std::filesystem::last_write_time(cookedAnimationPath, errorCode));
+	if (errorCode)
+	{
+		return false;
+	}
+	const std::filesystem::file_time_type animationWriteTime(std::filesystem::last_write_time(animationPath, errorCode));
+	return !errorCode && cookedAnimationWriteTime >= animationWriteTime;
+}
+
+bool AnimationManager::OpenCookedAnimation(const pathType& animationPath, DCore::Animation& outAnimation) const
+{
+	const pathType cookedAnimationPath(GetCookedAnimationPath(animationPath));
+	if (!IsCookedAnimationUpToDate(animationPath, cookedAnimationPath))
+	{
+		return false;
+	}
+	DCore::MappedFile cookedAnimation;
+	return cookedAnimation.Open(cookedAnimationPath) && ReadCookedAnimation(cookedAnimation.GetData(), cookedAnimation.GetSize(), outAnimation);
+}
+
+DCore::Animation AnimationManager::CookAnimation(const uuidType& uuid, const pathType& animationPath, cookedAnimationType& outCookedAnimation)
+{
+	const Animation editorAnimation(LoadAnimation(uuid));
+	DCore::Animation animation(editorAnimation.GenerateCoreAnimation());
+	animation.Compile();
+	WriteCookedAnimation(animation, outCookedAnimation);
+	const pathType cookedAnimationPath(GetCookedAnimationPath(animationPath));
+	// Renamed into place once written, as another thread may be mapping the cooked animation meanwhile.
+	pathType temporaryPath(cookedAnimationPath);
+	temporaryPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+	std::ofstream ostream(temporaryPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+	ostream.write(outCookedAnimation.data(), outCookedAnimation.size());
+	ostream.close();
+	std::error_code errorCode;
+	if (ostream)
+	{
+		std::filesystem::rename(temporaryPath, cookedAnimationPath, errorCode);
+	}
+	if (!ostream || errorCode)
+	{
+		std::filesystem::remove(temporaryPath, errorCode);
+		Log::Get().TerminalLog("Fail to write the cooked animation at path: %s", cookedAnimationPath.string().c_str());
+		Log::Get().ConsoleLog(LogLevel::Warning, "Fail to write the cooked animation at path: %s", cookedAnimationPath.string().c_str());
+	}
+	return animation;
+}
+
+bool AnimationManager::ReadCookedAnimation(const char* cookedAnimation, size_t cookedAnimationSize, DCore::Animation& outAnimation) const
+{
+	using headerType = DCore::CookedAnimation::Header;
+	using channelEntryType = DCore::CookedAnimation::ChannelEntry;
+	using trackEntryType = DCore::CookedAnimation::TrackEntry;
+	using metachannelEntryType = DCore::CookedAnimation::MetachannelEntry;
+	using compiledAnimationType = DCore::CompiledAnimation;
+	static_assert(sizeof(trackEntryType) == sizeof(compiledAnimationType::Track), "The cooked tracks are copied as the compiled ones.");
+	static_assert(sizeof(uint32_t) == sizeof(compiledAnimationType::KeyframeValue), "The cooked keyframe values are copied as the compiled ones.");
+	if (cookedAnimation == nullptr || cookedAnimationSize < sizeof(headerType))
+	{
+		return false;
+	}
+	const headerType& header(*reinterpret_cast<const headerType*>(cookedAnimation));
+	// The tables are read in place, so their offsets must also be aligned to their entries.
+	const auto isTableInFile
+	(
+		[&](uint64_t offset, uint64_t size, size_t alignment) -> bool
+		{
+			return offset % alignment == 0 && offset <= cookedAnimationSize && size <= cookedAnimationSize - offset;
+		}
+	);
+	if (header.Magic != DCore::CookedAnimation::magic || header.Version != DCore::CookedAnimation::version || !(header.Duration >= 0.0f) ||
+		!isTableInFile(header.ChannelsOffset, static_cast<uint64_t>(header.NumberOfChannels) * sizeof(channelEntryType), alignof(channelEntryType)) ||
+		!isTableInFile(header.TracksOffset, static_cast<uint64_t>(header.NumberOfTracks) * sizeof(trackEntryType), alignof(trackEntryType)) ||
+		!isTableInFile(header.KeyframeTimesOffset, static_cast<uint64_t>(header.NumberOfKeyframes) * sizeof(float), alignof(float)) ||
+		!isTableInFile(header.KeyframeValuesOffset, static_cast<uint64_t>(header.NumberOfKeyframes) * sizeof(uint32_t), alignof(uint32_t)) ||
+		!isTableInFile(header.MetachannelsOffset, static_cast<uint64_t>(header.NumberOfMetachannels) * sizeof(metachannelEntryType), alignof(metachannelEntryType)) ||
+		!isTableInFile(header.StringTableOffset, header.StringTableSize, 1) ||
+		header.StringTableSize == 0 || cookedAnimation[header.StringTableOffset + header.StringTableSize - 1] != '\0' ||
+		header.NameOffset >= header.StringTableSize)
+	{
+		return false;
+	}
+	const char* stringTable(cookedAnimation + header.StringTableOffset);
+	const channelEntryType* channelEntries(reinterpret_cast<const channelEntryType*>(cookedAnimation + header.ChannelsOffset));
+	const trackEntryType* trackEntries(reinterpret_cast<const trackEntryType*>(cookedAnimation + header.TracksOffset));
+	const float* keyframeTimes(reinterpret_cast<const float*>(cookedAnimation + header.KeyframeTimesOffset));
+	const metachannelEntryType* metachannelEntries(reinterpret_cast<const metachannelEntryType*>(cookedAnimation + header.MetachannelsOffset));
+	compiledAnimationType::channelContainerType channels;
+	channels.reserve(header.NumberOfChannels);
+	uint32_t numberOfTracks(0);
+	for (uint32_t i(0); i < header.NumberOfChannels; i++)
+	{
+		const channelEntryType& channelEntry(channelEntries[i]);
+		if (channelEntry.ComponentNameOffset >= header.StringTableSize || channelEntry.AttributeNameOffset >= header.StringTableSize ||
+			channelEntry.FirstTrack != numberOfTracks || channelEntry.NumberOfTracks > header.NumberOfTracks - numberOfTracks)
+		{
+			return false;
+		}
+		const DCore::ComponentForm* componentForm(DCore::ComponentForms::Get().GetComponentFormWithName(stringTable + channelEntry.ComponentNameOffset));
+		if (componentForm == nullptr || channelEntry.AttributeId >= componentForm->SerializedAttributes.size())
+		{
+			return false;
+		}
+		const DCore::SerializedAttribute& attribute(componentForm->SerializedAttributes[channelEntry.AttributeId]);
+		const DCore::AttributeKeyframeType keyframeType(attribute.GetKeyframeType());
+		if (attribute.GetAttributeName().GetName() != stringTable + channelEntry.AttributeNameOffset ||
+			keyframeType == DCore::AttributeKeyframeType::NotDefined || static_cast<uint32_t>(keyframeType) != channelEntry.KeyframeType ||
+			channelEntry.NumberOfTracks != attribute.GetNumberOfAttributeComponents())
+		{
+			return false;
+		}
+		channels.push_back({componentForm->Id, channelEntry.AttributeId, keyframeType, channelEntry.FirstTrack, channelEntry.NumberOfTracks});
+		numberOfTracks += channelEntry.NumberOfTracks;
+	}
+	if (numberOfTracks != header.NumberOfTracks)
+	{
+		return false;
+	}
+	for (uint32_t i(0); i < header.NumberOfTracks; i++)
+	{
+		const trackEntryType& trackEntry(trackEntries[i]);
+		if (trackEntry.NumberOfKeyframes == 0 || trackEntry.FirstKeyframe > header.NumberOfKeyframes ||
+			trackEntry.NumberOfKeyframes > header.NumberOfKeyframes - trackEntry.FirstKeyframe)
+		{
+			return false;
+		}
+		for (uint32_t keyframe(trackEntry.FirstKeyframe + 1); keyframe < trackEntry.FirstKeyframe + trackEntry.NumberOfKeyframes; keyframe++)
+		{
+			if (!(keyframeTimes[keyframe - 1] <= keyframeTimes[keyframe]))
+			{
+				return false;
+			}
+		}
+	}
+	for (uint32_t i(0); i < header.NumberOfMetachannels; i++)
+	{
+		if (!(metachannelEntries[i].Time >= 0.0f))
+		{
+			return false;
+		}
+	}
+	compiledAnimationType::trackContainerType tracks(header.NumberOfTracks);
+	compiledAnimationType::keyframeTimeContainerType times(header.NumberOfKeyframes);
+	compiledAnimationType::keyframeValueContainerType values(header.NumberOfKeyframes);
+	std::memcpy(tracks.data(), trackEntries, tracks.size() * sizeof(trackEntryType));
+	std::memcpy(times.data(), keyframeTimes, times.size() * sizeof(float));
+	std::memcpy(values.data(), cookedAnimation + header.KeyframeValuesOffset, values.size() * sizeof(uint32_t));
+	outAnimation = DCore::Animation
+	(
+		stringTable + header.NameOffset,
+		header.Duration,
+		compiledAnimationType(std::move(channels), std::move(tracks), std::move(times), std::move(values))
+	);
+	for (uint32_t i(0); i < header.NumberOfMetachannels; i++)
+	{
+		DCore::Animation::metachannelContainerType::Ref metachannel(outAnimation.MakeMetachannel());
+		metachannel->SetId(static_cast<size_t>(metachannelEntries[i].Id));
+		metachannel->SetTime(metachannelEntries[i].Time);
+	}
+	return true;
+}
+
+void AnimationManager::WriteCookedAnimation(const DCore::Animation& animation, cookedAnimationType& outCookedAnimation) const
+{
+	using headerType = DCore::CookedAnimation::Header;
+	using channelEntryType = DCore::CookedAnimation::ChannelEntry;
+	using trackEntryType = DCore::CookedAnimation::TrackEntry;
+	using metachannelEntryType = DCore::CookedAnimation::MetachannelEntry;
+	const DCore::CompiledAnimation& compiledAnimation(animation.GetCompiledAnimation());
+	stringType stringTable;
+	const auto addString
+	(
+		[&](const stringType& string) -> uint32_t
+		{
+			const uint32_t offset(static_cast<uint32_t>(stringTable.size()));
+			stringTable.append(string).push_back('\0');
+			return offset;
+		}
+	);
+	headerType header;
+	std::memset(&header, 0, sizeof(headerType));
+	header.Magic = DCore::CookedAnimation::magic;
+	header.Version = DCore::CookedAnimation::version;
+	header.Duration = animation.GetDuration();
+	header.NameOffset = addString(animation.GetName());
+	std::vector<channelEntryType> channelEntries;
+	channelEntries.reserve(compiledAnimation.GetChannels().size());
+	for (const DCore::CompiledAnimation::Channel& channel : compiledAnimation.GetChannels())
+	{
+		const DCore::ComponentForm& componentForm(DCore::ComponentForms::Get()[channel.ComponentId]);
+		channelEntryType channelEntry;
+		channelEntry.ComponentNameOffset = addString(componentForm.Name);
+		channelEntry.AttributeNameOffset = addString(componentForm.SerializedAttributes[channel.AttributeId].GetAttributeName().GetName());
+		channelEntry.AttributeId = static_cast<uint32_t>(channel.AttributeId);
+		channelEntry.KeyframeType = static_cast<uint32_t>(channel.KeyframeType);
+		channelEntry.FirstTrack = channel.FirstTrack;
+		channelEntry.NumberOfTracks = channel.NumberOfTracks;
+		channelEntries.push_back(channelEntry);
+	}
+	std::vector<metachannelEntryType> metachannelEntries;
+	animation.IterateOnMetachannels
+	(
+		[&](DCore::Animation::metachannelContainerType::ConstRef metachannel) -> bool
+		{
+			metachannelEntries.push_back({static_cast<uint64_t>(metachannel->GetId()), metachannel->GetTime(), 0});
+			return false;
+		}
+	);
+	const auto align
+	(
+		[](uint64_t offset) -> uint64_t
+		{
+			constexpr uint64_t alignment(alignof(std::max_align_t));
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	);
+	header.NumberOfChannels = static_cast<uint32_t>(channelEntries.size());
+	header.NumberOfTracks = static_cast<uint32_t>(compiledAnimation.GetTracks().size());
+	header.NumberOfKeyframes = static_cast<uint32_t>(compiledAnimation.GetKeyframeTimes().size());
+	header.NumberOfMetachannels = static_cast<uint32_t>(metachannelEntries.size());
+	header.ChannelsOffset = align(sizeof(headerType));
+	header.TracksOffset = align(header.ChannelsOffset + channelEntries.size() * sizeof(channelEntryType));
+	header.KeyframeTimesOffset = align(header.TracksOffset + compiledAnimation.GetTracks().size() * sizeof(trackEntryType));
+	header.KeyframeValuesOffset = align(header.KeyframeTimesOffset + compiledAnimation.GetKeyframeTimes().size() * sizeof(float));
+	header.MetachannelsOffset = align(header.KeyframeValuesOffset + compiledAnimation.GetKeyframeValues().size() * sizeof(uint32_t));
+	header.StringTableOffset = align(header.MetachannelsOffset + metachannelEntries.size() * sizeof(metachannelEntryType));
+	header.StringTableSize = stringTable.size();
+	// Resized from empty, so the padding between the tables is zeroed.
+	outCookedAnimation.clear();
+	outCookedAnimation.resize(header.StringTableOffset + header.StringTableSize);
+	std::memcpy(outCookedAnimation.data(), &header, sizeof(headerType));
+	std::memcpy(outCookedAnimation.data() + header.ChannelsOffset, channelEntries.data(), channelEntries.size() * sizeof(channelEntryType));
+	std::memcpy(outCookedAnimation.data() + header.TracksOffset, compiledAnimation.GetTracks().data(), compiledAnimation.GetTracks().size() * sizeof(trackEntryType));
+	std::memcpy(outCookedAnimation.data() + header.KeyframeTimesOffset, compiledAnimation.GetKeyframeTimes().data(), compiledAnimation.GetKeyframeTimes().size() * sizeof(float));
+	std::memcpy(outCookedAnimation.data() + header.KeyframeValuesOffset, compiledAnimation.GetKeyframeValues().data(), compiledAnimation.GetKeyframeValues().size() * sizeof(uint32_t));
+	std::memcpy(outCookedAnimation.data() + header.MetachannelsOffset, metachannelEntries.data(), metachannelEntries.size() * sizeof(metachannelEntryType));
+	std::memcpy(outCookedAnimation.data() + header.StringTableOffset, stringTable.data(), stringTable.size());
+}
+
 AnimationManager::pathType AnimationManager::GetAnimationsPath() const
 {
 	pathType animationsPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_animationDirectory);
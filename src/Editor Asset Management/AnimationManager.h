@@ -5,7 +5,8 @@
 #include "EditorAnimation.h"
 
 #include <filesystem>
-#include <unordered_set>
+#include <functional>
+#include <vector>
 
 
 
@@ -17,10 +18,13 @@ class AnimationManager
 public:
 	using uuidType = DCore::UUIDType;
 	using coreAnimationRefType = DCore::AnimationRef;
-	using lockDataType = DCore::LockData;
 	using stringType = std::string;
 	using pathType = std::filesystem::path;
-	using animationsLoadingSetType = std::unordered_set<uuidType>;
+	using animationsLoadingTableType = DCore::InFlightLoadTable<uuidType>;
+	using loadGuardType = animationsLoadingTableType::LoadGuard;
+	using loadFutureType = animationsLoadingTableType::futureType;
+	using cookedAnimationType = std::vector<char>;
+	using cookedAnimationIterationCallbackType = std::function<bool(const uuidType&, const stringType& animationName, const cookedAnimationType&)>;
 public:
 	~AnimationManager() = default;
 public:
@@ -33,15 +37,28 @@ public:
 	void CreateAnimation(const stringType& animationName, const pathType& thumbnailDirectory);
 	Animation LoadAnimation(const uuidType& animationUUID);
 	[[nodiscard]] coreAnimationRefType LoadCoreAnimation(const uuidType& animationUUID);
+	// Reads the animation whose file is at the path again and replaces it in place, if loaded. False if no animation
+	// is at the path.
+	bool ReloadCoreAnimation(const pathType& animationPath);
 	void SaveChanges(const Animation&);
 	void DeleteAnimation(const uuidType&);
 	bool RenameAnimation(const uuidType&, const stringType& newName);
+	// Cooks the animations whose cooked file is missing or stale (see CookedAnimation.h) and gives the cooked form of
+	// every animation.
+	void IterateOnCookedAnimations(cookedAnimationIterationCallbackType);
 private:
 	AnimationManager();
 private:
-	lockDataType m_lockData;
-	animationsLoadingSetType m_animationsLoading;
+	animationsLoadingTableType m_animationsLoading;
 private:
+	pathType GetCookedAnimationPath(const pathType& animationPath) const;
+	bool IsCookedAnimationUpToDate(const pathType& animationPath, const pathType& cookedAnimationPath) const;
+	// False if the cooked file is stale or broken, or refers to components or attributes that changed.
+	bool OpenCookedAnimation(const pathType& animationPath, DCore::Animation& outAnimation) const;
+	// Generates the core animation from the source and writes its cooked file.
+	DCore::Animation CookAnimation(const uuidType&, const pathType& animationPath, cookedAnimationType& outCookedAnimation);
+	bool ReadCookedAnimation(const char* cookedAnimation, size_t cookedAnimationSize, DCore::Animation& outAnimation) const;
+	void WriteCookedAnimation(const DCore::Animation&, cookedAnimationType& outCookedAnimation) const;
 	pathType GetAnimationsPath() const;
 	void GenerateAnimationThumbnail(const pathType& thumbailPath, const stringType& uuidString, const stringType& animationName);
 	void SaveAnimationsMap();
@@ -1,4 +1,5 @@
 #include "AnimationStateMachineManager.h"
+#include "AssetPackManager.h"
 #include "Parameter.h"
 #include "ProgramContext.h"
 #include "Log.h"
@@ -7,8 +8,16 @@
 
 #include "yaml-cpp/yaml.h"
 
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <ios>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 
 
@@ -39,6 +48,11 @@ static const char* s_conditionValueKey{"Value"};
 
 AnimationStateMachineManager::AnimationStateMachineManager()
 {
+	if (AssetPackManager::Get().GetAssetPack() != nullptr)
+	{
+		// The animation state machines are loaded from the pack.
+		return;
+	}
 	pathType asmPath(GetAnimationStateMachinesPath() / s_asmsFileNameAndExtension);
 	std::ofstream fstream(asmPath, std::ios_base::out | std::ios_base::app);
 	DASSERT_E(fstream);
@@ -436,6 +450,74 @@ void AnimationStateMachineManager::SaveChanges(const animationStateMachineType&
 	DASSERT_E(fstream);
 }
 
+AnimationStateMachineManager::coreAnimationStateMachineRefType AnimationStateMachineManager::LoadCoreAnimationStateMachine(const uuidType& uuid)
+{
+	while (true)
+	{
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationStateMachineAssetManager*>(&DCore::AssetManager::Get()));
+			if (DCore::AssetManager::Get().IsAnimationStateMachineLoaded(uuid))
+			{
+				return DCore::AssetManager::Get().GetAnimationStateMachine(uuid);
+			}
+		}
+		loadFutureType loadFuture;
+		if (m_animationStateMachinesLoading.TryBeginLoad(uuid, loadFuture))
+		{
+			break;
+		}
+		// The asset is looked up again after the load, as it may have been unloaded in between.
+		if (!loadFuture.get())
+		{
+			return coreAnimationStateMachineRefType();
+		}
+	}
+	loadGuardType loadGuard(m_animationStateMachinesLoading, uuid);
+	{
+		// The load may have ended between the lookup and the beginning of this one.
+		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationStateMachineAssetManager*>(&DCore::AssetManager::Get()));
+		if (DCore::AssetManager::Get().IsAnimationStateMachineLoaded(uuid))
+		{
+			loadGuard.EndLoad(true);
+			return DCore::AssetManager::Get().GetAnimationStateMachine(uuid);
+		}
+	}
+	coreAnimationStateMachineType animationStateMachine;
+	const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+	if (assetPack != nullptr)
+	{
+		const DCore::AssetPack::Entry* entry(assetPack->Find(uuid, DCore::AssetPackEntryType::AnimationStateMachine));
+		if (entry == nullptr || !ReadCookedAnimationStateMachine(uuid, assetPack->GetPayload(*entry), static_cast<size_t>(entry->Size), animationStateMachine))
+		{
+			Log::Get().TerminalLog("Fail to load animation state machine %s from the asset pack.", ((stringType)uuid).c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load animation state machine %s from the asset pack.", ((stringType)uuid).c_str());
+			loadGuard.EndLoad(false);
+			return coreAnimationStateMachineRefType();
+		}
+	}
+	else
+	{
+		const stringType uuidString(uuid);
+		DASSERT_E(s_asmNode[uuidString]);
+		const pathType asmPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_asmNode[uuidString].as<stringType>());
+		if (!std::filesystem::exists(asmPath))
+		{
+			Log::Get().TerminalLog("Fail to load animation state machine at path: %s", asmPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load animation state machine at path: %s", asmPath.string().c_str());
+			loadGuard.EndLoad(false);
+			return coreAnimationStateMachineRefType();
+		}
+		if (!OpenCookedAnimationStateMachine(uuid, asmPath, animationStateMachine))
+		{
+			cookedAnimationStateMachineType cookedAnimationStateMachine;
+			animationStateMachine = CookAnimationStateMachine(uuid, asmPath, cookedAnimationStateMachine);
+		}
+	}
+	coreAnimationStateMachineRefType animationStateMachineRef(DCore::AssetManager::Get().LoadAnimationStateMachine(uuid, std::move(animationStateMachine)));
+	loadGuard.EndLoad(true);
+	return animationStateMachineRef;
+}
+
 AnimationStateMachineManager::stringType AnimationStateMachineManager::GetAnimationStateMachineName(const uuidType& uuid) 
 {
 	const stringType uuidString(uuid);
@@ -480,6 +562,7 @@ void AnimationStateMachineManager::DeleteAnimationStateMachine(const uuidType& a
 	DASSERT_E(s_asmNode[uuidString]);
 	const pathType asmPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_asmNode[uuidString].as<stringType>());
 	std::filesystem::remove(asmPath);
+	std::filesystem::remove(GetCookedAnimationStateMachinePath(asmPath));
 	YAML::Node newAsmNode;
 	for (YAML::const_iterator it(s_asmNode.begin()); it != s_asmNode.end(); it++)
 	{
@@ -499,7 +582,7 @@ void AnimationStateMachineManager::DeleteAnimationStateMachine(const uuidType& a
 	ostream << emitter.c_str();
 	ostream.close();
 	DASSERT_E(ostream);
-	DCore::AssetManager::Get().RemoveAllAnimationStateMachineInstancesWithUUID(asmUUID);
+	DCore::AssetManager::Get().UnloadAnimationStateMachine(asmUUID, true);
 }
 
 bool AnimationStateMachineManager::RenameAnimationStateMachine(const uuidType& uuid, const stringType& newName)
@@ -522,6 +605,8 @@ bool AnimationStateMachineManager::RenameAnimationStateMachine(const uuidType& u
 	s_asmNode[uuidString] = Path::Get().MakePathRelativeToAssetsDirectory(newPath).string();
 	SaveAnimationStateMachineMap();
 	std::filesystem::rename(oldPath, newPath);
+	// Cooked again, with the new name, when next loaded.
+	std::filesystem::remove(GetCookedAnimationStateMachinePath(oldPath));
 	DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationStateMachineAssetManager*>(&DCore::AssetManager::Get()));
 	DCore::AssetManager::Get().IterateOnAnimationStateMachines
 	(
@@ -537,6 +622,532 @@ bool AnimationStateMachineManager::RenameAnimationStateMachine(const uuidType& u
 	return true;
 }
 
+void AnimationStateMachineManager::IterateOnCookedAnimationStateMachines(cookedAnimationStateMachineIterationCallbackType callback)
+{
+	cookedAnimationStateMachineType cookedAnimationStateMachine;
+	for (YAML::const_iterator it(s_asmNode.begin()); it != s_asmNode.end(); it++)
+	{
+		const uuidType uuid(it->first.as<stringType>());
+		const pathType asmPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second.as<stringType>());
+		const pathType cookedAsmPath(GetCookedAnimationStateMachinePath(asmPath));
+		cookedAnimationStateMachine.clear();
+		if (IsCookedAnimationStateMachineUpToDate(asmPath, cookedAsmPath))
+		{
+			std::ifstream istream(cookedAsmPath, std::ios_base::binary);
+			cookedAnimationStateMachine.assign(std::istreambuf_iterator<char>(istream), std::istreambuf_iterator<char>());
+		}
+		const DCore::CookedAnimationStateMachine::Header* header(reinterpret_cast<const DCore::CookedAnimationStateMachine::Header*>(cookedAnimationStateMachine.data()));
+		if (cookedAnimationStateMachine.size() < sizeof(DCore::CookedAnimationStateMachine::Header) ||
+			header->Magic != DCore::CookedAnimationStateMachine::magic || header->Version != DCore::CookedAnimationStateMachine::version)
+		{
+			CookAnimationStateMachine(uuid, asmPath, cookedAnimationStateMachine);
+		}
+		if (cookedAnimationStateMachine.empty())
+		{
+			Log::Get().TerminalLog("Fail to cook animation state machine at path: %s", asmPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Warning, "Fail to cook animation state machine at path: %s", asmPath.string().c_str());
+			continue;
+		}
+		if (callback(uuid, asmPath.stem().string(), cookedAnimationStateMachine))
+		{
+			return;
+		}
+	}
+}
+
+AnimationStateMachineManager::pathType AnimationStateMachineManager::GetCookedAnimationStateMachinePath(const pathType& asmPath) const
+{
+	pathType cookedAsmPath(asmPath);
+	cookedAsmPath.replace_extension(DCore::CookedAnimationStateMachine::fileExtension);
+	return cookedAsmPath;
+}
+
+bool AnimationStateMachineManager::IsCookedAnimationStateMachineUpToDate(const pathType& asmPath, const pathType& cookedAsmPath) const
+{
+	std::error_code errorCode;
+	const std::filesystem::file_time_type cookedAsmWriteTime(std::filesystem::last_write_time(cookedAsmPath, errorCode));
+	if (errorCode)
+	{
+		return false;
+	}
+	const std::filesystem::file_time_type asmWriteTime(std::filesystem::last_write_time(asmPath, errorCode));
+	return !errorCode && cookedAsmWriteTime >= asmWriteTime;
+}
+
+bool AnimationStateMachineManager::OpenCookedAnimationStateMachine(const uuidType& uuid, const pathType& asmPath, coreAnimationStateMachineType& outAnimationStateMachine) const
+{
+	const pathType cookedAsmPath(GetCookedAnimationStateMachinePath(asmPath));
+	if (!IsCookedAnimationStateMachineUpToDate(asmPath, cookedAsmPath))
+	{
+		return false;
+	}
+	DCore::MappedFile cookedAnimationStateMachine;
+	return cookedAnimationStateMachine.Open(cookedAsmPath) &&
+		ReadCookedAnimationStateMachine(uuid, cookedAnimationStateMachine.GetData(), cookedAnimationStateMachine.GetSize(), outAnimationStateMachine);
+}
+
+AnimationStateMachineManager::coreAnimationStateMachineType AnimationStateMachineManager::CookAnimationStateMachine(
+	const uuidType& uuid, 
+	const pathType& asmPath, 
+	cookedAnimationStateMachineType& outCookedAnimationStateMachine)
+{
+	coreAnimationStateMachineType animationStateMachine(std::move(LoadAnimationStateMachine(uuid, asmPath.stem().string()).GetCoreAnimationStateMachine()));
+	const pathType cookedAsmPath(GetCookedAnimationStateMachinePath(asmPath));
+	if (!WriteCookedAnimationStateMachine(animationStateMachine, outCookedAnimationStateMachine))
+	{
+		outCookedAnimationStateMachine.clear();
+		std::filesystem::remove(cookedAsmPath);
+		return animationStateMachine;
+	}
+	// Written aside and renamed, so a cooked animation state machine is never mapped partly written.
+	pathType temporaryPath(cookedAsmPath);
+	temporaryPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+	std::ofstream ostream(temporaryPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+	ostream.write(outCookedAnimationStateMachine.data(), outCookedAnimationStateMachine.size());
+	ostream.close();
+	std::error_code errorCode;
+	if (ostream)
+	{
+		std::filesystem::rename(temporaryPath, cookedAsmPath, errorCode);
+	}
+	if (!ostream || errorCode)
+	{
+		std::filesystem::remove(temporaryPath, errorCode);
+		Log::Get().TerminalLog("Fail to write the cooked animation state machine at path: %s", cookedAsmPath.string().c_str());
+		Log::Get().ConsoleLog(LogLevel::Warning, "Fail to write the cooked animation state machine at path: %s", cookedAsmPath.string().c_str());
+	}
+	return animationStateMachine;
+}
+
+bool AnimationStateMachineManager::ReadCookedAnimationStateMachine(
+	const uuidType& uuid, 
+	const char* cookedAnimationStateMachine, 
+	size_t cookedAnimationStateMachineSize, 
+	coreAnimationStateMachineType& outAnimationStateMachine) const
+{
+	using headerType = DCore::CookedAnimationStateMachine::Header;
+	using parameterEntryType = DCore::CookedAnimationStateMachine::ParameterEntry;
+	using stateEntryType = DCore::CookedAnimationStateMachine::StateEntry;
+	using transitionEntryType = DCore::CookedAnimationStateMachine::TransitionEntry;
+	using conditionEntryType = DCore::CookedAnimationStateMachine::ConditionEntry;
+	using parameterType = DCore::ParameterType;
+	using numericConditionType = DCore::NumericConditionType;
+	using stateConstRefType = DCore::AnimationStateMachine::stateConstRefType;
+	using createStateResult = DCore::AnimationStateMachine::CreateStateResult;
+	using createParameterResult = DCore::AnimationStateMachine::CreateParameterResult;
+	using createTransitionResult = DCore::AnimationStateMachine::CreateTransitionResult;
+	using createConditionResult = DCore::AnimationStateMachine::CreateConditionResult;
+	if (cookedAnimationStateMachine == nullptr || cookedAnimationStateMachineSize < sizeof(headerType))
+	{
+		return false;
+	}
+	const headerType& header(*reinterpret_cast<const headerType*>(cookedAnimationStateMachine));
+	// The tables are read in place, so their offsets must also be aligned to their entries.
+	const auto isTableInFile
+	(
+		[&](uint64_t offset, uint64_t size, size_t alignment) -> bool
+		{
+			return offset % alignment == 0 && offset <= cookedAnimationStateMachineSize && size <= cookedAnimationStateMachineSize - offset;
+		}
+	);
+	if (header.Magic != DCore::CookedAnimationStateMachine::magic || header.Version != DCore::CookedAnimationStateMachine::version ||
+		!isTableInFile(header.ParametersOffset, static_cast<uint64_t>(header.NumberOfParameters) * sizeof(parameterEntryType), alignof(parameterEntryType)) ||
+		!isTableInFile(header.StatesOffset, static_cast<uint64_t>(header.NumberOfStates) * sizeof(stateEntryType), alignof(stateEntryType)) ||
+		!isTableInFile(header.TransitionsOffset, static_cast<uint64_t>(header.NumberOfTransitions) * sizeof(transitionEntryType), alignof(transitionEntryType)) ||
+		!isTableInFile(header.ConditionsOffset, static_cast<uint64_t>(header.NumberOfConditions) * sizeof(conditionEntryType), alignof(conditionEntryType)) ||
+		!isTableInFile(header.StringTableOffset, header.StringTableSize, 1) ||
+		header.StringTableSize == 0 || cookedAnimationStateMachine[header.StringTableOffset + header.StringTableSize - 1] != '\0' ||
+		header.NameOffset >= header.StringTableSize || (header.NumberOfStates > 0 && header.InitialStateIndex >= header.NumberOfStates))
+	{
+		return false;
+	}
+	const char* stringTable(cookedAnimationStateMachine + header.StringTableOffset);
+	const parameterEntryType* parameterEntries(reinterpret_cast<const parameterEntryType*>(cookedAnimationStateMachine + header.ParametersOffset));
+	const stateEntryType* stateEntries(reinterpret_cast<const stateEntryType*>(cookedAnimationStateMachine + header.StatesOffset));
+	const transitionEntryType* transitionEntries(reinterpret_cast<const transitionEntryType*>(cookedAnimationStateMachine + header.TransitionsOffset));
+	const conditionEntryType* conditionEntries(reinterpret_cast<const conditionEntryType*>(cookedAnimationStateMachine + header.ConditionsOffset));
+	// The indices are validated before the graph is built. The animations of the states are loaded last, once the graph
+	// is built, so they are only released again if one of them fails to load.
+	std::array<uint32_t, DCore::numberOfParameterTypes> numberOfParameters{};
+	for (uint32_t i(0); i < header.NumberOfParameters; i++)
+	{
+		const parameterEntryType& parameterEntry(parameterEntries[i]);
+		if (parameterEntry.Type >= DCore::numberOfParameterTypes || parameterEntry.NameOffset >= header.StringTableSize ||
+			(i > 0 && parameterEntry.Type < parameterEntries[i - 1].Type))
+		{
+			return false;
+		}
+		numberOfParameters[parameterEntry.Type]++;
+	}
+	uint32_t numberOfTransitions(0);
+	for (uint32_t i(0); i < header.NumberOfStates; i++)
+	{
+		const stateEntryType& stateEntry(stateEntries[i]);
+		if (stateEntry.NameOffset >= header.StringTableSize || stateEntry.FirstTransition != numberOfTransitions ||
+			stateEntry.NumberOfTransitions > header.NumberOfTransitions - numberOfTransitions)
+		{
+			return false;
+		}
+		numberOfTransitions += stateEntry.NumberOfTransitions;
+	}
+	if (numberOfTransitions != header.NumberOfTransitions)
+	{
+		return false;
+	}
+	uint32_t numberOfConditions(0);
+	for (uint32_t i(0); i < header.NumberOfTransitions; i++)
+	{
+		const transitionEntryType& transitionEntry(transitionEntries[i]);
+		if (transitionEntry.ToStateIndex >= header.NumberOfStates || transitionEntry.FirstCondition != numberOfConditions ||
+			transitionEntry.NumberOfConditions > header.NumberOfConditions - numberOfConditions)
+		{
+			return false;
+		}
+		numberOfConditions += transitionEntry.NumberOfConditions;
+	}
+	if (numberOfConditions != header.NumberOfConditions)
+	{
+		return false;
+	}
+	for (uint32_t i(0); i < header.NumberOfConditions; i++)
+	{
+		const conditionEntryType& conditionEntry(conditionEntries[i]);
+		if (conditionEntry.ParameterType >= DCore::numberOfParameterTypes || conditionEntry.ParameterIndex >= numberOfParameters[conditionEntry.ParameterType] ||
+			conditionEntry.NumericCondition > static_cast<uint32_t>(numericConditionType::Bigger))
+		{
+			return false;
+		}
+	}
+	coreAnimationStateMachineType animationStateMachine(uuid);
+	animationStateMachine.SetName(stringTable + header.NameOffset);
+	for (uint32_t i(0); i < header.NumberOfParameters; i++)
+	{
+		const parameterEntryType& parameterEntry(parameterEntries[i]);
+		const stringType parameterName(stringTable + parameterEntry.NameOffset);
+		createParameterResult result(createParameterResult::Ok);
+		switch (static_cast<parameterType>(parameterEntry.Type))
+		{
+		case parameterType::Integer:
+		{
+			DCore::integerParameterConstRefType parameter;
+			int value;
+			std::memcpy(&value, &parameterEntry.Value, sizeof(int));
+			result = animationStateMachine.CreateParameter<parameterType::Integer>(parameterName, parameter);
+			if (result == createParameterResult::Ok)
+			{
+				animationStateMachine.SetParameterValue<parameterType::Integer>(parameter.GetIndex(), value);
+			}
+			break;
+		}
+		case parameterType::Float:
+		{
+			DCore::floatParameterConstRefType parameter;
+			float value;
+			std::memcpy(&value, &parameterEntry.Value, sizeof(float));
+			result = animationStateMachine.CreateParameter<parameterType::Float>(parameterName, parameter);
+			if (result == createParameterResult::Ok)
+			{
+				animationStateMachine.SetParameterValue<parameterType::Float>(parameter.GetIndex(), value);
+			}
+			break;
+		}
+		case parameterType::Logic:
+		{
+			DCore::logicParameterConstRefType parameter;
+			result = animationStateMachine.CreateParameter<parameterType::Logic>(parameterName, parameter);
+			if (result == createParameterResult::Ok)
+			{
+				animationStateMachine.SetParameterValue<parameterType::Logic>(parameter.GetIndex(), DCore::LogicParameter{parameterEntry.Value != 0});
+			}
+			break;
+		}
+		case parameterType::Trigger:
+		{
+			DCore::triggerParameterConstRefType parameter;
+			result = animationStateMachine.CreateParameter<parameterType::Trigger>(parameterName, parameter);
+			if (result == createParameterResult::Ok)
+			{
+				animationStateMachine.SetParameterValue<parameterType::Trigger>(parameter.GetIndex(), DCore::TriggerParameter{parameterEntry.Value != 0});
+			}
+			break;
+		}
+		}
+		if (result != createParameterResult::Ok)
+		{
+			return false;
+		}
+	}
+	for (uint32_t i(0); i < header.NumberOfStates; i++)
+	{
+		const stateEntryType& stateEntry(stateEntries[i]);
+		stateConstRefType state;
+		if (animationStateMachine.CreateState(stringTable + stateEntry.NameOffset, &state) != createStateResult::Ok || state.GetIndex() != i)
+		{
+			return false;
+		}
+	}
+	for (uint32_t fromStateIndex(0); fromStateIndex < header.NumberOfStates; fromStateIndex++)
+	{
+		const stateEntryType& stateEntry(stateEntries[fromStateIndex]);
+		for (uint32_t i(stateEntry.FirstTransition); i < stateEntry.FirstTransition + stateEntry.NumberOfTransitions; i++)
+		{
+			const transitionEntryType& transitionEntry(transitionEntries[i]);
+			DCore::transitionConstRefType transition;
+			if (animationStateMachine.CreateTransition(fromStateIndex, transitionEntry.ToStateIndex, &transition) != createTransitionResult::Ok)
+			{
+				return false;
+			}
+			for (uint32_t j(transitionEntry.FirstCondition); j < transitionEntry.FirstCondition + transitionEntry.NumberOfConditions; j++)
+			{
+				const conditionEntryType& conditionEntry(conditionEntries[j]);
+				DCore::conditionConstRefType condition;
+				if (animationStateMachine.CreateCondition(fromStateIndex, transition.GetIndex(), &condition) != createConditionResult::Ok)
+				{
+					return false;
+				}
+				const parameterType conditionParameterType(static_cast<parameterType>(conditionEntry.ParameterType));
+				const numericConditionType numericCondition(static_cast<numericConditionType>(conditionEntry.NumericCondition));
+				animationStateMachine.SetConditionParameter(fromStateIndex, transition.GetIndex(), condition.GetIndex(), conditionParameterType, conditionEntry.ParameterIndex);
+				switch (conditionParameterType)
+				{
+				case parameterType::Integer:
+				{
+					int value;
+					std::memcpy(&value, &conditionEntry.Value, sizeof(int));
+					animationStateMachine.SetNumericCondition(fromStateIndex, transition.GetIndex(), condition.GetIndex(), numericCondition);
+					animationStateMachine.SetValueOfCondition<parameterType::Integer>(fromStateIndex, transition.GetIndex(), condition.GetIndex(), value);
+					break;
+				}
+				case parameterType::Float:
+				{
+					float value;
+					std::memcpy(&value, &conditionEntry.Value, sizeof(float));
+					animationStateMachine.SetNumericCondition(fromStateIndex, transition.GetIndex(), condition.GetIndex(), numericCondition);
+					animationStateMachine.SetValueOfCondition<parameterType::Float>(fromStateIndex, transition.GetIndex(), condition.GetIndex(), value);
+					break;
+				}
+				case parameterType::Logic:
+					animationStateMachine.SetValueOfCondition<parameterType::Logic>(fromStateIndex, transition.GetIndex(), condition.GetIndex(), DCore::LogicParameter{conditionEntry.Value != 0});
+					break;
+				case parameterType::Trigger:
+					break;
+				}
+			}
+		}
+	}
+	if (header.NumberOfStates > 0)
+	{
+		animationStateMachine.SetInitialStateIndex(header.InitialStateIndex);
+	}
+	std::vector<DCore::AnimationRef> animations;
+	for (uint32_t i(0); i < header.NumberOfStates; i++)
+	{
+		const stateEntryType& stateEntry(stateEntries[i]);
+		const uuidType animationUUID(stateEntry.AnimationUUIDHigh, stateEntry.AnimationUUIDLow);
+		if (animationUUID.GetHigh() == 0 && animationUUID.GetLow() == 0)
+		{
+			continue;
+		}
+		DCore::AnimationRef animation(AnimationManager::Get().LoadCoreAnimation(animationUUID));
+		if (!animation.IsValid())
+		{
+			for (DCore::AnimationRef& loadedAnimation : animations)
+			{
+				loadedAnimation.Unload();
+			}
+			return false;
+		}
+		animations.push_back(animation);
+		animationStateMachine.SetStateAnimation(i, animation);
+	}
+	outAnimationStateMachine = std::move(animationStateMachine);
+	return true;
+}
+
+bool AnimationStateMachineManager::WriteCookedAnimationStateMachine(const coreAnimationStateMachineType& animationStateMachine, cookedAnimationStateMachineType& outCookedAnimationStateMachine) const
+{
+	using headerType = DCore::CookedAnimationStateMachine::Header;
+	using parameterEntryType = DCore::CookedAnimationStateMachine::ParameterEntry;
+	using stateEntryType = DCore::CookedAnimationStateMachine::StateEntry;
+	using transitionEntryType = DCore::CookedAnimationStateMachine::TransitionEntry;
+	using conditionEntryType = DCore::CookedAnimationStateMachine::ConditionEntry;
+	using parameterType = DCore::ParameterType;
+	using stateConstRefType = DCore::AnimationStateMachine::stateConstRefType;
+	stringType stringTable;
+	const auto addString
+	(
+		[&](const stringType& string) -> uint32_t
+		{
+			const uint32_t offset(static_cast<uint32_t>(stringTable.size()));
+			stringTable.append(string).push_back('\0');
+			return offset;
+		}
+	);
+	bool hasHoles(false);
+	std::vector<parameterEntryType> parameterEntries;
+	const auto addParameter
+	(
+		[&](parameterType type, size_t index, size_t numberOfParametersOfType, const stringType& name, const void* value, size_t valueSize) -> bool
+		{
+			// The conditions refer to the parameters by their indexes, which are given again in order when loaded.
+			if (index != numberOfParametersOfType)
+			{
+				hasHoles = true;
+				return true;
+			}
+			parameterEntryType parameterEntry{addString(name), static_cast<uint32_t>(type), 0};
+			std::memcpy(&parameterEntry.Value, value, valueSize);
+			parameterEntries.push_back(parameterEntry);
+			return false;
+		}
+	);
+	size_t numberOfParametersOfType(0);
+	animationStateMachine.IterateOnParameters<parameterType::Integer>
+	(
+		[&](DCore::integerParameterConstRefType parameter) -> bool
+		{
+			const int value(parameter->GetValue());
+			return addParameter(parameterType::Integer, parameter.GetIndex(), numberOfParametersOfType++, parameter->GetName(), &value, sizeof(int));
+		}
+	);
+	numberOfParametersOfType = 0;
+	animationStateMachine.IterateOnParameters<parameterType::Float>
+	(
+		[&](DCore::floatParameterConstRefType parameter) -> bool
+		{
+			const float value(parameter->GetValue());
+			return addParameter(parameterType::Float, parameter.GetIndex(), numberOfParametersOfType++, parameter->GetName(), &value, sizeof(float));
+		}
+	);
+	numberOfParametersOfType = 0;
+	animationStateMachine.IterateOnParameters<parameterType::Logic>
+	(
+		[&](DCore::logicParameterConstRefType parameter) -> bool
+		{
+			const uint32_t value(parameter->GetValue().Value ? 1 : 0);
+			return addParameter(parameterType::Logic, parameter.GetIndex(), numberOfParametersOfType++, parameter->GetName(), &value, sizeof(uint32_t));
+		}
+	);
+	numberOfParametersOfType = 0;
+	animationStateMachine.IterateOnParameters<parameterType::Trigger>
+	(
+		[&](DCore::triggerParameterConstRefType parameter) -> bool
+		{
+			const uint32_t value(parameter->GetValueWithoutReset().Value ? 1 : 0);
+			return addParameter(parameterType::Trigger, parameter.GetIndex(), numberOfParametersOfType++, parameter->GetName(), &value, sizeof(uint32_t));
+		}
+	);
+	std::vector<stateEntryType> stateEntries;
+	std::vector<transitionEntryType> transitionEntries;
+	std::vector<conditionEntryType> conditionEntries;
+	animationStateMachine.IterateOnStates
+	(
+		[&](stateConstRefType state) -> bool
+		{
+			// The transitions refer to the states by their indexes, which are given again in order when loaded.
+			if (hasHoles || state.GetIndex() != stateEntries.size())
+			{
+				hasHoles = true;
+				return true;
+			}
+			const DCore::AnimationRef animation(state->GetAnimation());
+			stateEntryType stateEntry;
+			stateEntry.NameOffset = addString(state->GetName());
+			stateEntry.FirstTransition = static_cast<uint32_t>(transitionEntries.size());
+			stateEntry.NumberOfTransitions = 0;
+			stateEntry.Padding = 0;
+			stateEntry.AnimationUUIDHigh = 0;
+			stateEntry.AnimationUUIDLow = 0;
+			if (animation.IsValid())
+			{
+				const uuidType animationUUID(animation.GetUUID());
+				stateEntry.AnimationUUIDHigh = animationUUID.GetHigh();
+				stateEntry.AnimationUUIDLow = animationUUID.GetLow();
+			}
+			state->IterateOnTransitions
+			(
+				[&](DCore::transitionConstRefType transition) -> bool
+				{
+					transitionEntryType transitionEntry{static_cast<uint32_t>(transition->GetToStateIndex()), static_cast<uint32_t>(conditionEntries.size()), 0};
+					transition->IterateOnConditions
+					(
+						[&](DCore::conditionConstRefType condition) -> bool
+						{
+							conditionEntryType conditionEntry{static_cast<uint32_t>(condition->GetParameterType()), static_cast<uint32_t>(condition->GetParameterIndex()), static_cast<uint32_t>(condition->GetNumericCondition()), 0};
+							switch (condition->GetParameterType())
+							{
+							case parameterType::Integer:
+							{
+								const int value(condition->GetValue<parameterType::Integer>());
+								std::memcpy(&conditionEntry.Value, &value, sizeof(int));
+								break;
+							}
+							case parameterType::Float:
+							{
+								const float value(condition->GetValue<parameterType::Float>());
+								std::memcpy(&conditionEntry.Value, &value, sizeof(float));
+								break;
+							}
+							case parameterType::Logic:
+								conditionEntry.Value = condition->GetValue<parameterType::Logic>().Value ? 1 : 0;
+								break;
+							case parameterType::Trigger:
+								break;
+							}
+							conditionEntries.push_back(conditionEntry);
+							transitionEntry.NumberOfConditions++;
+							return false;
+						}
+					);
+					transitionEntries.push_back(transitionEntry);
+					stateEntry.NumberOfTransitions++;
+					return false;
+				}
+			);
+			stateEntries.push_back(stateEntry);
+			return false;
+		}
+	);
+	if (hasHoles)
+	{
+		return false;
+	}
+	headerType header;
+	std::memset(&header, 0, sizeof(headerType));
+	header.Magic = DCore::CookedAnimationStateMachine::magic;
+	header.Version = DCore::CookedAnimationStateMachine::version;
+	header.InitialStateIndex = static_cast<uint32_t>(animationStateMachine.GetInitialStateIndex());
+	header.NumberOfParameters = static_cast<uint32_t>(parameterEntries.size());
+	header.NumberOfStates = static_cast<uint32_t>(stateEntries.size());
+	header.NumberOfTransitions = static_cast<uint32_t>(transitionEntries.size());
+	header.NumberOfConditions = static_cast<uint32_t>(conditionEntries.size());
+	header.NameOffset = addString(animationStateMachine.GetName());
+	const auto align
+	(
+		[](uint64_t offset) -> uint64_t
+		{
+			constexpr uint64_t alignment(alignof(std::max_align_t));
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	);
+	header.ParametersOffset = align(sizeof(headerType));
+	header.StatesOffset = align(header.ParametersOffset + parameterEntries.size() * sizeof(parameterEntryType));
+	header.TransitionsOffset = align(header.StatesOffset + stateEntries.size() * sizeof(stateEntryType));
+	header.ConditionsOffset = align(header.TransitionsOffset + transitionEntries.size() * sizeof(transitionEntryType));
+	header.StringTableOffset = align(header.ConditionsOffset + conditionEntries.size() * sizeof(conditionEntryType));
+	header.StringTableSize = stringTable.size();
+	// Resized from empty, so the padding between the tables is zeroed.
+	outCookedAnimationStateMachine.clear();
+	outCookedAnimationStateMachine.resize(header.StringTableOffset + header.StringTableSize);
+	std::memcpy(outCookedAnimationStateMachine.data(), &header, sizeof(headerType));
+	std::memcpy(outCookedAnimationStateMachine.data() + header.ParametersOffset, parameterEntries.data(), parameterEntries.size() * sizeof(parameterEntryType));
+	std::memcpy(outCookedAnimationStateMachine.data() + header.StatesOffset, stateEntries.data(), stateEntries.size() * sizeof(stateEntryType));
+	std::memcpy(outCookedAnimationStateMachine.data() + header.TransitionsOffset, transitionEntries.data(), transitionEntries.size() * sizeof(transitionEntryType));
+	std::memcpy(outCookedAnimationStateMachine.data() + header.ConditionsOffset, conditionEntries.data(), conditionEntries.size() * sizeof(conditionEntryType));
+	std::memcpy(outCookedAnimationStateMachine.data() + header.StringTableOffset, stringTable.data(), stringTable.size());
+	return true;
+}
+
 AnimationStateMachineManager::pathType AnimationStateMachineManager::GetAnimationStateMachinesPath() const
 {
 	pathType asmPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_asmDirectory);
@@ -6,7 +6,9 @@
 #include "DommusCore.h"
 
 #include <filesystem>
+#include <functional>
 #include <string>
+#include <vector>
 
 
 
@@ -24,6 +26,11 @@ public:
 	using coreAnimationStateMachineRefType = DCore::AnimationStateMachineRef;
 	using pathType = std::filesystem::path;
 	using stringType = std::string;
+	using animationStateMachinesLoadingTableType = DCore::InFlightLoadTable<uuidType>;
+	using loadGuardType = animationStateMachinesLoadingTableType::LoadGuard;
+	using loadFutureType = animationStateMachinesLoadingTableType::futureType;
+	using cookedAnimationStateMachineType = std::vector<char>;
+	using cookedAnimationStateMachineIterationCallbackType = std::function<bool(const uuidType&, const stringType& animationStateMachineName, const cookedAnimationStateMachineType&)>;
 public:
 	~AnimationStateMachineManager() = default;
 public:
@@ -35,14 +42,30 @@ public:
 public:
 	void CreateAnimationStateMachine(const stringType& name, const pathType& thumbnailDirectoryPath);
 	EditorAnimationStateMachine LoadAnimationStateMachine(const uuidType&, const stringType& name, parameterInfoContainerType* outParameterInfos = nullptr);
+	// Thread safe. The animation state machine is loaded once, even if asked by many threads at once.
+	[[nodiscard]] coreAnimationStateMachineRefType LoadCoreAnimationStateMachine(const uuidType&);
 	void SaveChanges(const animationStateMachineType&, const parameterInfoContainerType&);
 	stringType GetAnimationStateMachineName(const uuidType&);
 	void RemoveAnimationReferences(const uuidType& animationUUID);
 	void DeleteAnimationStateMachine(const uuidType& asmUUID);
 	bool RenameAnimationStateMachine(const uuidType& uuid, const stringType& newName);
+	// Cooks the animation state machines whose cooked file is missing or stale (see CookedAnimationStateMachine.h)
+	// and gives the cooked form of every one of them.
+	void IterateOnCookedAnimationStateMachines(cookedAnimationStateMachineIterationCallbackType);
 private:
 	AnimationStateMachineManager();
 private:
+	animationStateMachinesLoadingTableType m_animationStateMachinesLoading;
+private:
+	pathType GetCookedAnimationStateMachinePath(const pathType& asmPath) const;
+	bool IsCookedAnimationStateMachineUpToDate(const pathType& asmPath, const pathType& cookedAsmPath) const;
+	bool OpenCookedAnimationStateMachine(const uuidType&, const pathType& asmPath, coreAnimationStateMachineType& outAnimationStateMachine) const;
+	// Loads the animation state machine from the source and writes its cooked file.
+	coreAnimationStateMachineType CookAnimationStateMachine(const uuidType&, const pathType& asmPath, cookedAnimationStateMachineType& outCookedAnimationStateMachine);
+	// Loads the animations of the states.
+	bool ReadCookedAnimationStateMachine(const uuidType&, const char* cookedAnimationStateMachine, size_t cookedAnimationStateMachineSize, coreAnimationStateMachineType& outAnimationStateMachine) const;
+	// False if states or parameters were deleted from the animation state machine, as their indexes would change.
+	bool WriteCookedAnimationStateMachine(const coreAnimationStateMachineType&, cookedAnimationStateMachineType& outCookedAnimationStateMachine) const;
 	pathType GetAnimationStateMachinesPath() const;
 	void GenerateThumbnail(const pathType& path, const stringType& uuidString);
 	void SaveAnimationStateMachineMap();
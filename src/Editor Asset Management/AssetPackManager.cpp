@@ -0,0 +1,197 @@
+#include "AssetPackManager.h"
+#include "AnimationManager.h"
+#include "AnimationStateMachineManager.h"
+#include "MaterialManager.h"
+#include "ProgramContext.h"
+#include "SceneManager.h"
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+
+namespace DEditor
+{
+
+static const char* s_assetPackFileName = "assets";
+
+AssetPackManager::returnErrorType AssetPackManager::BuildAssetPack(const pathType& packPath)
+{
+	using headerType = DCore::AssetPack::Header;
+	using entryType = DCore::AssetPack::Entry;
+
+	// Payload holds the cooked assets that are not written to files.
+	struct PackEntry
+	{
+		DCore::UUIDType UUID;
+		DCore::AssetPackEntryType Type;
+		uint32_t Flags;
+		std::string Name;
+		pathType CookedPath;
+		std::vector<char> Payload;
+	};
+
+	returnErrorType returnError;
+	if (GetAssetPack() != nullptr)
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Cannot build an asset pack while one is open.");
+		return returnError;
+	}
+	SceneManager::Get().CookScenes();
+	TextureManager::Get().CookTextures();
+	std::vector<PackEntry> packEntries;
+	SceneManager::Get().IterateOnCookedScenes
+	(
+		[&](const DCore::UUIDType& uuid, const std::string& sceneName, const pathType& cookedScenePath) -> bool
+		{
+			packEntries.push_back({uuid, DCore::AssetPackEntryType::Scene, 0, sceneName, cookedScenePath, {}});
+			return false;
+		}
+	);
+	TextureManager::Get().IterateOnCookedTextures
+	(
+		[&](const DCore::UUIDType& uuid, const std::string& textureName, const pathType& cookedTexturePath, DCore::Texture2DMetadata metadata) -> bool
+		{
+			packEntries.push_back({uuid, DCore::AssetPackEntryType::Texture2D, DCore::AssetPack::Texture2DMetadataToFlags(metadata), textureName, cookedTexturePath, {}});
+			return false;
+		}
+	);
+	MaterialManager::Get().IterateOnCookedSpriteMaterials
+	(
+		[&](const DCore::UUIDType& uuid, const std::string& materialName, const std::vector<char>& cookedSpriteMaterial) -> bool
+		{
+			packEntries.push_back({uuid, DCore::AssetPackEntryType::SpriteMaterial, 0, materialName, pathType(), cookedSpriteMaterial});
+			return false;
+		}
+	);
+	AnimationManager::Get().IterateOnCookedAnimations
+	(
+		[&](const DCore::UUIDType& uuid, const std::string& animationName, const std::vector<char>& cookedAnimation) -> bool
+		{
+			packEntries.push_back({uuid, DCore::AssetPackEntryType::Animation, 0, animationName, pathType(), cookedAnimation});
+			return false;
+		}
+	);
+	AnimationStateMachineManager::Get().IterateOnCookedAnimationStateMachines
+	(
+		[&](const DCore::UUIDType& uuid, const std::string& animationStateMachineName, const std::vector<char>& cookedAnimationStateMachine) -> bool
+		{
+			packEntries.push_back({uuid, DCore::AssetPackEntryType::AnimationStateMachine, 0, animationStateMachineName, pathType(), cookedAnimationStateMachine});
+			return false;
+		}
+	);
+	for (PackEntry& packEntry : packEntries)
+	{
+		if (packEntry.CookedPath.empty())
+		{
+			continue;
+		}
+		std::ifstream istream(packEntry.CookedPath, std::ios_base::binary);
+		if (istream)
+		{
+			packEntry.Payload.assign(std::istreambuf_iterator<char>(istream), std::istreambuf_iterator<char>());
+		}
+		if (!istream.good() && !istream.eof())
+		{
+			returnError.Ok = false;
+			returnError.Message.Append("Fail to read the cooked asset at path: ").Append(packEntry.CookedPath.string().c_str()).Append(".");
+			return returnError;
+		}
+	}
+	std::sort
+	(
+		packEntries.begin(), packEntries.end(),
+		[](const PackEntry& a, const PackEntry& b) -> bool
+		{
+			return a.UUID.GetHigh() < b.UUID.GetHigh() || (a.UUID.GetHigh() == b.UUID.GetHigh() && a.UUID.GetLow() < b.UUID.GetLow());
+		}
+	);
+	const auto alignPayloadOffset
+	(
+		[](uint64_t offset) -> uint64_t
+		{
+			return (offset + DCore::AssetPack::payloadAlignment - 1) / DCore::AssetPack::payloadAlignment * DCore::AssetPack::payloadAlignment;
+		}
+	);
+	std::vector<entryType> entries(packEntries.size());
+	std::string stringTable;
+	for (size_t i(0); i < packEntries.size(); i++)
+	{
+		entries[i].UUIDHigh = packEntries[i].UUID.GetHigh();
+		entries[i].UUIDLow = packEntries[i].UUID.GetLow();
+		entries[i].Size = packEntries[i].Payload.size();
+		entries[i].Type = packEntries[i].Type;
+		entries[i].Flags = packEntries[i].Flags;
+		entries[i].NameOffset = static_cast<uint32_t>(stringTable.size());
+		entries[i].Padding = 0;
+		stringTable.append(packEntries[i].Name).push_back('\0');
+	}
+	if (stringTable.empty())
+	{
+		stringTable.push_back('\0');
+	}
+	headerType header;
+	header.Magic = DCore::AssetPack::magic;
+	header.Version = DCore::AssetPack::version;
+	header.NumberOfEntries = entries.size();
+	header.EntriesOffset = sizeof(headerType);
+	header.StringTableOffset = header.EntriesOffset + entries.size() * sizeof(entryType);
+	header.StringTableSize = stringTable.size();
+	uint64_t payloadOffset(header.StringTableOffset + header.StringTableSize);
+	for (entryType& entry : entries)
+	{
+		payloadOffset = alignPayloadOffset(payloadOffset);
+		entry.Offset = payloadOffset;
+		payloadOffset += entry.Size;
+	}
+	// Written aside and then renamed, so a failed build leaves the previous pack as it was.
+	pathType temporaryPath(packPath);
+	temporaryPath += ".tmp";
+	std::ofstream ostream(temporaryPath, std::ios_base::binary | std::ios_base::trunc);
+	ostream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ostream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(entryType));
+	ostream.write(stringTable.data(), stringTable.size());
+	uint64_t writtenSize(header.StringTableOffset + header.StringTableSize);
+	static constexpr char padding[DCore::AssetPack::payloadAlignment]{};
+	for (size_t i(0); i < entries.size(); i++)
+	{
+		ostream.write(padding, entries[i].Offset - writtenSize);
+		ostream.write(packEntries[i].Payload.data(), packEntries[i].Payload.size());
+		writtenSize = entries[i].Offset + entries[i].Size;
+	}
+	ostream.close();
+	std::error_code errorCode;
+	if (ostream)
+	{
+		std::filesystem::rename(temporaryPath, packPath, errorCode);
+	}
+	if (!ostream || errorCode)
+	{
+		std::filesystem::remove(temporaryPath, errorCode);
+		returnError.Ok = false;
+		returnError.Message.Append("Fail to write the asset pack at path: ").Append(packPath.string().c_str()).Append(".");
+	}
+	return returnError;
+}
+
+bool AssetPackManager::OpenAssetPack(const pathType& packPath)
+{
+	return m_assetPack.Open(packPath);
+}
+
+AssetPackManager::pathType AssetPackManager::GetAssetPackPath() const
+{
+	pathType packPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_assetPackFileName);
+	packPath += DCore::AssetPack::fileExtension;
+	return packPath;
+}
+
+}
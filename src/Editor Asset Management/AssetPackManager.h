@@ -0,0 +1,47 @@
+#pragma once
+
+#include "DommusCore.h"
+
+#include <filesystem>
+
+
+
+namespace DEditor
+{
+
+// Builds the asset pack of the project (see AssetPack.h) and holds the one it runs from, if any. While a pack is
+// open, the scenes, textures, sprite materials, animations and animation state machines are loaded from it and the
+// asset maps of the project are not read.
+class AssetPackManager
+{
+public:
+	using pathType = std::filesystem::path;
+	using returnErrorType = DCore::ReturnError;
+public:
+	~AssetPackManager() = default;
+public:
+	static AssetPackManager& Get()
+	{
+		static AssetPackManager assetPackManager;
+		return assetPackManager;
+	}
+public:
+	// Cooks the stale scenes, textures, animations and animation state machines, then writes them, with the cooked
+	// sprite materials, to the pack. Fails if a pack is open, as the assets are then read from it, not from their sources.
+	returnErrorType BuildAssetPack(const pathType& packPath);
+	// To be called before any asset is loaded, as the asset managers read their maps when first used.
+	bool OpenAssetPack(const pathType& packPath);
+	pathType GetAssetPackPath() const;
+public:
+	// nullptr if no pack is open.
+	const DCore::AssetPack* GetAssetPack() const
+	{
+		return m_assetPack.IsOpen() ? &m_assetPack : nullptr;
+	}
+private:
+	AssetPackManager() = default;
+private:
+	DCore::AssetPack m_assetPack;
+};
+
+}
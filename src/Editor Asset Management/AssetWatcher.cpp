@@ -0,0 +1,179 @@
+#include "AssetWatcher.h"
+#include "AnimationManager.h"
+#include "AssetPackManager.h"
+#include "Log.h"
+#include "MaterialManager.h"
+#include "ProgramContext.h"
+#include "TextureManager.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <system_error>
+
+
+
+namespace DEditor
+{
+
+AssetWatcher::AssetWatcher()
+	:
+	m_fileDescriptor(-1),
+	m_debounce(std::chrono::milliseconds(defaultDebounce)),
+	m_reloadedAssetsCounter(DCore::ProfilingStats::Get().GetCounter("Assets/Hot Reload/Reloaded Assets")),
+	m_reloadMicrosecondsCounter(DCore::ProfilingStats::Get().GetCounter("Assets/Hot Reload/Reload Microseconds")),
+	m_lastReloadMicrosecondsCounter(DCore::ProfilingStats::Get().GetCounter("Assets/Hot Reload/Last Reload Microseconds"))
+{
+#ifdef __linux__
+	if (AssetPackManager::Get().GetAssetPack() != nullptr)
+	{
+		// The assets are loaded from the pack.
+		return;
+	}
+	m_fileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_fileDescriptor < 0)
+	{
+		Log::Get().TerminalLog("Fail to watch the assets directory. The assets changed will not be reloaded.");
+		Log::Get().ConsoleLog(LogLevel::Warning, "Fail to watch the assets directory. The assets changed will not be reloaded.");
+		return;
+	}
+	WatchDirectory(ProgramContext::Get().GetProjectAssetsDirectoryPath());
+#endif
+}
+
+AssetWatcher::~AssetWatcher()
+{
+#ifdef __linux__
+	if (m_fileDescriptor >= 0)
+	{
+		close(m_fileDescriptor);
+	}
+#endif
+}
+
+void AssetWatcher::ReloadChangedAssets()
+{
+	if (m_fileDescriptor < 0)
+	{
+		return;
+	}
+	ReadChanges();
+	const clockType::time_point reloadStart(clockType::now());
+	int64_t numberOfReloadedAssets(0);
+	for (changedFileContainerType::iterator it(m_changedFiles.begin()); it != m_changedFiles.end();)
+	{
+		if (reloadStart - it->second < m_debounce)
+		{
+			it++;
+			continue;
+		}
+		if (ReloadAsset(it->first))
+		{
+			numberOfReloadedAssets++;
+		}
+		it = m_changedFiles.erase(it);
+	}
+	if (numberOfReloadedAssets == 0)
+	{
+		return;
+	}
+	// The GL textures of the textures reloaded are created later, by the upload queue.
+	const int64_t reloadMicroseconds(std::chrono::duration_cast<std::chrono::microseconds>(clockType::now() - reloadStart).count());
+	m_reloadedAssetsCounter.fetch_add(numberOfReloadedAssets, std::memory_order_relaxed);
+	m_reloadMicrosecondsCounter.fetch_add(reloadMicroseconds, std::memory_order_relaxed);
+	m_lastReloadMicrosecondsCounter.store(reloadMicroseconds, std::memory_order_relaxed);
+}
+
+void AssetWatcher::SetDebounce(uint64_t milliseconds)
+{
+	m_debounce = std::chrono::milliseconds(milliseconds);
+}
+
+#ifdef __linux__
+void AssetWatcher::WatchDirectory(const pathType& directoryPath)
+{
+	const int watchDescriptor(inotify_add_watch(m_fileDescriptor, directoryPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE));
+	if (watchDescriptor < 0)
+	{
+		Log::Get().TerminalLog("Fail to watch directory at path: %s", directoryPath.string().c_str());
+		Log::Get().ConsoleLog(LogLevel::Warning, "Fail to watch directory at path: %s", directoryPath.string().c_str());
+		return;
+	}
+	m_watchedDirectories[watchDescriptor] = directoryPath;
+	std::error_code errorCode;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directoryPath, errorCode))
+	{
+		if (entry.is_directory(errorCode))
+		{
+			WatchDirectory(entry.path());
+		}
+	}
+}
+
+void AssetWatcher::ReadChanges()
+{
+	alignas(inotify_event) char buffer[1 << 12];
+	while (true)
+	{
+		// The descriptor doesn't block, so the read fails once there are no more events.
+		const ssize_t size(read(m_fileDescriptor, buffer, sizeof(buffer)));
+		if (size <= 0)
+		{
+			return;
+		}
+		const clockType::time_point now(clockType::now());
+		for (ssize_t offset(0); offset < size;)
+		{
+			const inotify_event& event(*reinterpret_cast<const inotify_event*>(buffer + offset));
+			offset += sizeof(inotify_event) + event.len;
+			if ((event.mask & IN_Q_OVERFLOW) != 0)
+			{
+				Log::Get().TerminalLog("Too many changes in the assets directory. Some assets changed may not be reloaded.");
+				Log::Get().ConsoleLog(LogLevel::Warning, "Too many changes in the assets directory. Some assets changed may not be reloaded.");
+				continue;
+			}
+			if ((event.mask & IN_IGNORED) != 0)
+			{
+				m_watchedDirectories.erase(event.wd);
+				continue;
+			}
+			watchedDirectoryContainerType::const_iterator watchedDirectory(m_watchedDirectories.find(event.wd));
+			if (watchedDirectory == m_watchedDirectories.end() || event.len == 0)
+			{
+				continue;
+			}
+			const pathType path(watchedDirectory->second / event.name);
+			if ((event.mask & IN_ISDIR) != 0)
+			{
+				if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+				{
+					WatchDirectory(path);
+				}
+				continue;
+			}
+			if ((event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0)
+			{
+				m_changedFiles[path] = now;
+			}
+		}
+	}
+}
+#else
+void AssetWatcher::WatchDirectory(const pathType&)
+{}
+
+void AssetWatcher::ReadChanges()
+{}
+#endif
+
+bool AssetWatcher::ReloadAsset(const pathType& path)
+{
+	return
+		TextureManager::Get().ReloadTexture2D(path) ||
+		MaterialManager::Get().ReloadSpriteMaterial(path) ||
+		AnimationManager::Get().ReloadCoreAnimation(path);
+}
+
+}
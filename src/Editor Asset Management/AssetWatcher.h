@@ -0,0 +1,63 @@
+#pragma once
+
+#include "DommusCore.h"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+
+
+
+namespace DEditor
+{
+
+// Watches the project assets directory and reloads in place the textures, sprite materials and animations whose files
+// change, so the scenes using them show the changes without being loaded again. A file is reloaded once it has not
+// changed for the debounce time, as editors write a file more than once when saving it. Nothing is watched while an
+// asset pack is open, or on platforms other than Linux.
+class AssetWatcher
+{
+public:
+	using pathType = std::filesystem::path;
+	using clockType = std::chrono::steady_clock;
+	using counterType = DCore::ProfilingStats::counterType;
+public:
+	// Milliseconds.
+	static constexpr uint64_t defaultDebounce{250};
+public:
+	~AssetWatcher();
+public:
+	static AssetWatcher& Get()
+	{
+		static AssetWatcher assetWatcher;
+		return assetWatcher;
+	}
+public:
+	// To be called once per frame by the main thread, between frames, so the reloaded assets are swapped while no
+	// ref to them is in use.
+	void ReloadChangedAssets();
+	void SetDebounce(uint64_t milliseconds);
+private:
+	using changedFileContainerType = std::map<pathType, clockType::time_point>;
+	using watchedDirectoryContainerType = std::unordered_map<int, pathType>;
+private:
+	AssetWatcher();
+private:
+	int m_fileDescriptor;
+	watchedDirectoryContainerType m_watchedDirectories;
+	// Last time each file changed.
+	changedFileContainerType m_changedFiles;
+	clockType::duration m_debounce;
+	counterType& m_reloadedAssetsCounter;
+	counterType& m_reloadMicrosecondsCounter;
+	counterType& m_lastReloadMicrosecondsCounter;
+private:
+	// Also watches the directories inside it.
+	void WatchDirectory(const pathType&);
+	void ReadChanges();
+	// False if the file is not the source of an asset that can be reloaded.
+	bool ReloadAsset(const pathType&);
+};
+
+}
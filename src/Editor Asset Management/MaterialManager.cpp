@@ -5,10 +5,12 @@
 #include "Path.h"
 #include "TextureManager.h"
 #include "SceneManager.h"
+#include "AssetPackManager.h"
 
 #include "yaml-cpp/yaml.h"
 
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iterator>
 
@@ -31,6 +33,11 @@ static const char* s_materialDirectory = "material";
 
 MaterialManager::MaterialManager()
 {
+	if (AssetPackManager::Get().GetAssetPack() != nullptr)
+	{
+		// The materials are loaded from the pack.
+		return;
+	}
 	std::filesystem::path materialsPath(GetMaterialsPath() / s_materialsFileName);
 	std::ofstream ostream(materialsPath, std::ios_base::out | std::ios_base::app);
 	DASSERT_K(ostream);
@@ -89,80 +96,151 @@ void MaterialManager::CreateSpriteMaterial(spriteMaterialType type, const string
 
 DCore::SpriteMaterialRef MaterialManager::LoadSpriteMaterial(const DCore::UUIDType& uuid)
 {
+	while (true)
 	{
-		DCore::ReadWriteLockGuard materialGuard(DCore::LockType::ReadLock, *static_cast<DCore::SpriteMaterialAssetManager*>(&DCore::AssetManager::Get()));
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SpriteMaterialAssetManager*>(&DCore::AssetManager::Get()));
+			if (DCore::AssetManager::Get().IsSpriteMaterialLoaded(uuid))
+			{
+				return DCore::AssetManager::Get().GetSpriteMaterial(uuid);
+			}
+		}
+		loadFutureType loadFuture;
+		if (m_resourcesLoading.TryBeginLoad(uuid, loadFuture))
+		{
+			break;
+		}
+		// The asset is looked up again after the load, as it may have been unloaded in between.
+		if (!loadFuture.get())
+		{
+			return DCore::SpriteMaterialRef();
+		}
+	}
+	loadGuardType loadGuard(m_resourcesLoading, uuid);
+	{
+		// The load may have ended between the lookup and the beginning of this one.
+		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SpriteMaterialAssetManager*>(&DCore::AssetManager::Get()));
 		if (DCore::AssetManager::Get().IsSpriteMaterialLoaded(uuid))
 		{
+			loadGuard.EndLoad(true);
 			return DCore::AssetManager::Get().GetSpriteMaterial(uuid);
 		}
 	}
+	SpriteMaterialInfo info;
+	const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+	if (assetPack != nullptr)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-		if (m_resourcesLoading.count(uuid) == 0)
+		const DCore::AssetPack::Entry* entry(assetPack->Find(uuid, DCore::AssetPackEntryType::SpriteMaterial));
+		if (entry == nullptr || !ReadCookedSpriteMaterial(assetPack->GetPayload(*entry), static_cast<size_t>(entry->Size), info))
 		{
-			m_resourcesLoading.insert(uuid);
-			goto LoadMaterial;
+			Log::Get().TerminalLog("Fail to load sprite material %s from the asset pack.", ((stringType)uuid).c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load sprite material %s from the asset pack.", ((stringType)uuid).c_str());
+			loadGuard.EndLoad(false);
+			return DCore::SpriteMaterialRef();
 		}
 	}
-	while (true)
+	else
 	{
-		DCore::ReadWriteLockGuard materialGuard(DCore::LockType::ReadLock, *static_cast<DCore::SpriteMaterialAssetManager*>(&DCore::AssetManager::Get()));
-		if (DCore::AssetManager::Get().IsSpriteMaterialLoaded(uuid))
+		const stringType uuidString(((stringType)uuid).c_str());
+		DASSERT_E(s_materialsNode[uuidString.c_str()]);	
+		pathType materialPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_materialsNode[uuidString.c_str()].as<stringType>());
+		if (!ReadSpriteMaterial(materialPath, info))
 		{
-			return DCore::AssetManager::Get().GetSpriteMaterial(uuid);
+			Log::Get().TerminalLog("Fail to load sprite material at path: %s", materialPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load sprite material at path: %s", materialPath.string().c_str());
+			loadGuard.EndLoad(false);
+			return DCore::SpriteMaterialRef();
 		}
 	}
-LoadMaterial:
-	const stringType uuidString(((stringType)uuid).c_str());
-	DASSERT_E(s_materialsNode[uuidString.c_str()]);	
-	pathType materialPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_materialsNode[uuidString.c_str()].as<stringType>());
-	YAML::Node materialNode(YAML::LoadFile(materialPath.string()));
-	DASSERT_E(materialNode[s_typeKey]);
-	DASSERT_E(materialNode[s_nameKey]);
-	DASSERT_E(materialNode[s_ambientMapKey]);
-	DASSERT_E(materialNode[s_diffuseMapKey]);
-	DASSERT_E(materialNode[s_specularMapKey]);
-	DASSERT_E(materialNode[s_glossinessKey]);
-	DASSERT_E(materialNode[s_diffuseColorKey]);
-	const stringType typeString(materialNode[s_typeKey].as<stringType>().c_str());
-	const stringType ambientMapString(materialNode[s_ambientMapKey].as<stringType>().c_str());
-	const stringType diffuseMapString(materialNode[s_diffuseMapKey].as<stringType>().c_str());
-	const stringType specularMapString(materialNode[s_specularMapKey].as<stringType>().c_str());
-	DCore::DFloat glossiness(materialNode[s_glossinessKey].as<float>());
-	YAML::Node diffuseColorNode(materialNode[s_diffuseColorKey]);
-	DCore::DVec4 diffuseColor(diffuseColorNode[0].as<float>(), diffuseColorNode[1].as<float>(), diffuseColorNode[2].as<float>(), diffuseColorNode[3].as<float>());
-	bool ambientMapDefined(ambientMapString != "");
-	bool diffuseMapDefined(diffuseMapString != "");
-	bool specularMapDefined(specularMapString != "");
-	DCore::SpriteMaterialType type(DCore::SpriteMaterial::StringToSpriteMaterialType(typeString));
-	DCore::SpriteMaterial spriteMaterial(type);
-	spriteMaterial.SetGlossiness(glossiness);
-	spriteMaterial.SetDiffuseColor(diffuseColor);
-	spriteMaterial.SetName(materialNode[s_nameKey].as<std::string>());
-	if (ambientMapDefined)
+	DCore::SpriteMaterial spriteMaterial(CreateSpriteMaterial(info));
+	DCore::SpriteMaterialRef spriteMaterialRef(DCore::AssetManager::Get().LoadSpriteMaterial(uuid, std::move(spriteMaterial)));
+	loadGuard.EndLoad(true);
+	return spriteMaterialRef;
+}
+
+bool MaterialManager::ReloadSpriteMaterial(const pathType& materialPath)
+{
+	for (YAML::const_iterator it(s_materialsNode.begin()); it != s_materialsNode.end(); it++)
 	{
-		uuidType uuid(ambientMapString.c_str());
-		DCore::Texture2DRef ambientMapRef(TextureManager::Get().LoadTexture2D(uuid));
-		spriteMaterial.SetAmbientMapRef(ambientMapRef);
+		if ((ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second.as<stringType>()).lexically_normal() != materialPath.lexically_normal())
+		{
+			continue;
+		}
+		const uuidType uuid(it->first.as<stringType>());
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SpriteMaterialAssetManager*>(&DCore::AssetManager::Get()));
+			if (!DCore::AssetManager::Get().IsSpriteMaterialLoaded(uuid))
+			{
+				return true;
+			}
+		}
+		SpriteMaterialInfo info;
+		if (!ReadSpriteMaterial(materialPath, info))
+		{
+			Log::Get().TerminalLog("Fail to reload sprite material at path: %s", materialPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to reload sprite material at path: %s", materialPath.string().c_str());
+			return true;
+		}
+		DCore::AssetManager::Get().ReloadSpriteMaterial(uuid, CreateSpriteMaterial(info));
+		return true;
 	}
-	if (diffuseMapDefined)
+	return false;
+}
+
+void MaterialManager::IterateOnCookedSpriteMaterials(cookedSpriteMaterialIterationCallbackType callback)
+{
+	cookedSpriteMaterialType cookedSpriteMaterial;
+	for (YAML::const_iterator it(s_materialsNode.begin()); it != s_materialsNode.end(); it++)
 	{
-		uuidType uuid(diffuseMapString.c_str());
-		DCore::Texture2DRef diffuseMapRef(TextureManager::Get().LoadTexture2D(uuid));
-		spriteMaterial.SetDiffuseMapRef(diffuseMapRef);
+		const pathType materialPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second.as<stringType>());
+		SpriteMaterialInfo info;
+		if (!ReadSpriteMaterial(materialPath, info))
+		{
+			Log::Get().TerminalLog("Fail to cook sprite material at path: %s", materialPath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Warning, "Fail to cook sprite material at path: %s", materialPath.string().c_str());
+			continue;
+		}
+		CookSpriteMaterial(info, cookedSpriteMaterial);
+		if (callback(uuidType(it->first.as<stringType>()), info.Name, cookedSpriteMaterial))
+		{
+			return;
+		}
 	}
-	if (specularMapDefined)
+}
+
+DCore::SpriteMaterial MaterialManager::CreateSpriteMaterial(const SpriteMaterialInfo& info) const
+{
+	DCore::SpriteMaterial spriteMaterial(info.Type);
+	spriteMaterial.SetGlossiness(info.Glossiness);
+	spriteMaterial.SetDiffuseColor(info.DiffuseColor);
+	spriteMaterial.SetName(info.Name);
+	// The maps are loaded together, so they are decoded in parallel.
+	uuidType mapUUIDs[numberOfMaps];
+	DCore::Texture2DRef mapRefs[numberOfMaps];
+	uint8_t numberOfDefinedMaps(0);
+	for (uint8_t i(0); i < numberOfMaps; i++)
 	{
-		uuidType uuid(specularMapString.c_str());
-		DCore::Texture2DRef specularMapRef(TextureManager::Get().LoadTexture2D(uuid));
-		spriteMaterial.SetSpecularMapRef(specularMapRef);
+		if (info.MapUUIDs[i] != uuidType())
+		{
+			mapUUIDs[numberOfDefinedMaps++] = info.MapUUIDs[i];
+		}
 	}
-	DCore::SpriteMaterialRef spriteMaterialRef(DCore::AssetManager::Get().LoadSpriteMaterial(uuid, std::move(spriteMaterial)));
+	TextureManager::Get().LoadTextures2D(mapUUIDs, numberOfDefinedMaps, mapRefs);
+	void (DCore::SpriteMaterial::*setMapRefs[numberOfMaps])(DCore::Texture2DRef)
+	{
+		&DCore::SpriteMaterial::SetAmbientMapRef,
+		&DCore::SpriteMaterial::SetDiffuseMapRef,
+		&DCore::SpriteMaterial::SetSpecularMapRef
+	};
+	uint8_t mapIndex(0);
+	for (uint8_t i(0); i < numberOfMaps; i++)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-		m_resourcesLoading.erase(uuid);
+		if (info.MapUUIDs[i] != uuidType())
+		{
+			(spriteMaterial.*setMapRefs[i])(mapRefs[mapIndex++]);
+		}
 	}
-	return spriteMaterialRef;
+	return spriteMaterial;
 }
 
 MaterialManager::pathType MaterialManager::GetMaterialsPath() const
@@ -334,6 +412,81 @@ bool MaterialManager::SpriteMaterialExists(const uuidType& uuid)
 	return false;
 }
 
+bool MaterialManager::ReadSpriteMaterial(const pathType& materialPath, SpriteMaterialInfo& outInfo) const
+{
+	if (!std::filesystem::exists(materialPath))
+	{
+		return false;
+	}
+	YAML::Node materialNode(YAML::LoadFile(materialPath.string()));
+	DASSERT_E(materialNode[s_typeKey]);
+	DASSERT_E(materialNode[s_nameKey]);
+	DASSERT_E(materialNode[s_ambientMapKey]);
+	DASSERT_E(materialNode[s_diffuseMapKey]);
+	DASSERT_E(materialNode[s_specularMapKey]);
+	DASSERT_E(materialNode[s_glossinessKey]);
+	DASSERT_E(materialNode[s_diffuseColorKey]);
+	outInfo.Type = DCore::SpriteMaterial::StringToSpriteMaterialType(materialNode[s_typeKey].as<stringType>());
+	outInfo.Name = materialNode[s_nameKey].as<stringType>();
+	outInfo.Glossiness = materialNode[s_glossinessKey].as<float>();
+	YAML::Node diffuseColorNode(materialNode[s_diffuseColorKey]);
+	outInfo.DiffuseColor = DCore::DVec4(diffuseColorNode[0].as<float>(), diffuseColorNode[1].as<float>(), diffuseColorNode[2].as<float>(), diffuseColorNode[3].as<float>());
+	const char* mapKeys[numberOfMaps]{s_ambientMapKey, s_diffuseMapKey, s_specularMapKey};
+	for (uint8_t i(0); i < numberOfMaps; i++)
+	{
+		const stringType mapUUIDString(materialNode[mapKeys[i]].as<stringType>());
+		outInfo.MapUUIDs[i] = mapUUIDString.empty() ? uuidType() : uuidType(mapUUIDString);
+	}
+	return true;
+}
+
+bool MaterialManager::ReadCookedSpriteMaterial(const char* cookedSpriteMaterial, size_t cookedSpriteMaterialSize, SpriteMaterialInfo& outInfo) const
+{
+	using cookedHeaderType = DCore::CookedSpriteMaterial::Header;
+	if (cookedSpriteMaterialSize < sizeof(cookedHeaderType))
+	{
+		return false;
+	}
+	const cookedHeaderType& header(*reinterpret_cast<const cookedHeaderType*>(cookedSpriteMaterial));
+	if (header.Magic != DCore::CookedSpriteMaterial::magic || header.Version != DCore::CookedSpriteMaterial::version ||
+		header.NameSize == 0 || header.NameSize > cookedSpriteMaterialSize - sizeof(cookedHeaderType) ||
+		cookedSpriteMaterial[sizeof(cookedHeaderType) + header.NameSize - 1] != '\0')
+	{
+		return false;
+	}
+	outInfo.Type = static_cast<spriteMaterialType>(header.Type);
+	outInfo.Name = cookedSpriteMaterial + sizeof(cookedHeaderType);
+	outInfo.Glossiness = header.Glossiness;
+	outInfo.DiffuseColor = DCore::DVec4(header.DiffuseColor[0], header.DiffuseColor[1], header.DiffuseColor[2], header.DiffuseColor[3]);
+	outInfo.MapUUIDs[0] = uuidType(header.AmbientMapUUIDHigh, header.AmbientMapUUIDLow);
+	outInfo.MapUUIDs[1] = uuidType(header.DiffuseMapUUIDHigh, header.DiffuseMapUUIDLow);
+	outInfo.MapUUIDs[2] = uuidType(header.SpecularMapUUIDHigh, header.SpecularMapUUIDLow);
+	return true;
+}
+
+void MaterialManager::CookSpriteMaterial(const SpriteMaterialInfo& info, cookedSpriteMaterialType& outCookedSpriteMaterial) const
+{
+	DCore::CookedSpriteMaterial::Header header;
+	header.Magic = DCore::CookedSpriteMaterial::magic;
+	header.Version = DCore::CookedSpriteMaterial::version;
+	header.Type = static_cast<uint32_t>(info.Type);
+	header.Glossiness = info.Glossiness;
+	for (DCore::DUInt i(0); i < 4; i++)
+	{
+		header.DiffuseColor[i] = info.DiffuseColor[i];
+	}
+	header.AmbientMapUUIDHigh = info.MapUUIDs[0].GetHigh();
+	header.AmbientMapUUIDLow = info.MapUUIDs[0].GetLow();
+	header.DiffuseMapUUIDHigh = info.MapUUIDs[1].GetHigh();
+	header.DiffuseMapUUIDLow = info.MapUUIDs[1].GetLow();
+	header.SpecularMapUUIDHigh = info.MapUUIDs[2].GetHigh();
+	header.SpecularMapUUIDLow = info.MapUUIDs[2].GetLow();
+	header.NameSize = info.Name.size() + 1;
+	outCookedSpriteMaterial.resize(sizeof(header) + header.NameSize);
+	std::memcpy(outCookedSpriteMaterial.data(), &header, sizeof(header));
+	std::memcpy(outCookedSpriteMaterial.data() + sizeof(header), info.Name.c_str(), header.NameSize);
+}
+
 void MaterialManager::GenerateSpriteMaterialThumbnail(const pathType& thumbailPath, const stringType& uuidString, const stringType& spriteMaterialTypeString, const stringType& materialName)
 {
 	std::ofstream ostream(thumbailPath);
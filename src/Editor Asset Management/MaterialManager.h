@@ -3,9 +3,10 @@
 #include "DommusCore.h"
 
 #include <filesystem>
+#include <functional>
 #include <string>
-#include <unordered_set>
 #include <mutex>
+#include <vector>
 
 
 
@@ -18,10 +19,13 @@ public:
 	using uuidType = DCore::UUIDType;
 	using spriteMaterialType = DCore::SpriteMaterialType;
 	using spriteMaterialRefType = DCore::SpriteMaterialRef;
-	using lockDataType = DCore::LockData;
 	using stringType = std::string;
 	using pathType = std::filesystem::path;
-	using materialsLoadingSetType = std::unordered_set<uuidType>;
+	using materialsLoadingTableType = DCore::InFlightLoadTable<uuidType>;
+	using loadGuardType = materialsLoadingTableType::LoadGuard;
+	using loadFutureType = materialsLoadingTableType::futureType;
+	using cookedSpriteMaterialType = std::vector<char>;
+	using cookedSpriteMaterialIterationCallbackType = std::function<bool(const uuidType&, const stringType& materialName, const cookedSpriteMaterialType&)>;
 public:
 	~MaterialManager() = default;
 public:
@@ -38,12 +42,33 @@ public:
 	void DeleteSpriteMaterial(const uuidType& materialUUID);
 	bool RenameSpriteMaterial(const uuidType&, const stringType& newName);
 	bool SpriteMaterialExists(const uuidType&);
+	// Reads the sprite material whose file is at the path again and replaces it in place, if loaded. False if no
+	// sprite material is at the path.
+	bool ReloadSpriteMaterial(const pathType& materialPath);
+	// Cooks every sprite material in memory (see CookedSpriteMaterial.h).
+	void IterateOnCookedSpriteMaterials(cookedSpriteMaterialIterationCallbackType);
+private:
+	static constexpr uint8_t numberOfMaps{3};
+private:
+	struct SpriteMaterialInfo
+	{
+		spriteMaterialType Type;
+		stringType Name;
+		DCore::DFloat Glossiness;
+		DCore::DVec4 DiffuseColor;
+		// Ambient, diffuse and specular. Nil if the material doesn't have the map.
+		uuidType MapUUIDs[numberOfMaps];
+	};
 private:
 	MaterialManager();
 private:
-	lockDataType m_lockData;
-	materialsLoadingSetType m_resourcesLoading;
+	materialsLoadingTableType m_resourcesLoading;
 private:
+	bool ReadSpriteMaterial(const pathType& materialPath, SpriteMaterialInfo& outInfo) const;
+	bool ReadCookedSpriteMaterial(const char* cookedSpriteMaterial, size_t cookedSpriteMaterialSize, SpriteMaterialInfo& outInfo) const;
+	void CookSpriteMaterial(const SpriteMaterialInfo&, cookedSpriteMaterialType& outCookedSpriteMaterial) const;
+	// Loads the maps of the material.
+	DCore::SpriteMaterial CreateSpriteMaterial(const SpriteMaterialInfo&) const;
 	pathType GetMaterialsPath() const;
 	void GenerateSpriteMaterialThumbnail(const pathType& thumbailPath, const stringType& uuidString, const stringType& spriteMaterialTypeString, const stringType& materialName);
 	void SaveMaterialsMap();
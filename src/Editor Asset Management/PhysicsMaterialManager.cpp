@@ -69,33 +69,47 @@ void PhysicsMaterialManager::CreatePhysicsMaterial(const stringType& physicsMate
 
 PhysicsMaterialManager::physicsMaterialRefType PhysicsMaterialManager::LoadPhysicsMaterial(const uuidType& uuid)
 {
+	while (true)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::PhysicsMaterialAssetManager*>(&DCore::AssetManager::Get()));
-		if (DCore::AssetManager::Get().IsPhysicsMaterialLoaded(uuid))
 		{
-			return DCore::AssetManager::Get().GetPhysicsMaterial(uuid);
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::PhysicsMaterialAssetManager*>(&DCore::AssetManager::Get()));
+			if (DCore::AssetManager::Get().IsPhysicsMaterialLoaded(uuid))
+			{
+				return DCore::AssetManager::Get().GetPhysicsMaterial(uuid);
+			}
 		}
-	}
-	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-		if (m_loadingPhysicsMaterials.count(uuid) == 0)
+		loadFutureType loadFuture;
+		if (m_loadingPhysicsMaterials.TryBeginLoad(uuid, loadFuture))
 		{
-			m_loadingPhysicsMaterials.insert(uuid);
-			goto LoadPhysicsMaterial;
+			break;
+		}
+		// The asset is looked up again after the load, as it may have been unloaded in between.
+		if (!loadFuture.get())
+		{
+			return physicsMaterialRefType();
 		}
 	}
-	while (true)
+	loadGuardType loadGuard(m_loadingPhysicsMaterials, uuid);
 	{
+		// The load may have ended between the lookup and the beginning of this one.
 		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::PhysicsMaterialAssetManager*>(&DCore::AssetManager::Get()));
 		if (DCore::AssetManager::Get().IsPhysicsMaterialLoaded(uuid))
 		{
+			loadGuard.EndLoad(true);
 			return DCore::AssetManager::Get().GetPhysicsMaterial(uuid);
 		}
 	}
-LoadPhysicsMaterial:
 	stringType uuidString(uuid);
 	DASSERT_E(s_physicsMaterialsNode[uuidString]);
-	YAML::Node physicsMaterialNode(YAML::LoadFile((ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_physicsMaterialsNode[uuidString].as<stringType>()).string()));
+	const pathType physicsMaterialPath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_physicsMaterialsNode[uuidString].as<stringType>());
+	if (!std::filesystem::exists(physicsMaterialPath))
+	{
+		Log::Get().TerminalLog("Fail to load physics material at path: %s", physicsMaterialPath.string().c_str());
+		Log::Get().ConsoleLog(LogLevel::Error, "Fail to load physics material at path: %s", physicsMaterialPath.string().c_str());
+		loadGuard.EndLoad(false);
+		return physicsMaterialRefType();
+	}
+	YAML::Node physicsMaterialNode(YAML::LoadFile(physicsMaterialPath.string()));
 	DASSERT_E(physicsMaterialNode[s_densityKey]);
 	DASSERT_E(physicsMaterialNode[s_frictionKey]);
 	DASSERT_E(physicsMaterialNode[s_restitutionKey]);
@@ -105,8 +119,7 @@ LoadPhysicsMaterial:
 	DCore::PhysicsMaterial physicsMaterial(density, friction, restitution);
 	physicsMaterial.SetName(pathType(s_physicsMaterialsNode[uuidString].as<stringType>()).stem().string());
 	DCore::PhysicsMaterialRef physicsMaterialRef(DCore::AssetManager::Get().LoadPhysicsMaterial(uuid, std::move(physicsMaterial)));
-	DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-	m_loadingPhysicsMaterials.erase(uuid);
+	loadGuard.EndLoad(true);
 	return physicsMaterialRef;
 }
 
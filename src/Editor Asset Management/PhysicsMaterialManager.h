@@ -4,7 +4,6 @@
 
 #include <string>
 #include <filesystem>
-#include <unordered_set>
 
 
 
@@ -16,10 +15,11 @@ class PhysicsMaterialManager
 public:
 	using physicsMaterialRefType = DCore::PhysicsMaterialRef;
 	using uuidType = DCore::UUIDType;
-	using lockDataType = DCore::LockData;
 	using stringType = std::string;
 	using pathType = std::filesystem::path;
-	using loadingPhysicsMaterialsSetType = std::unordered_set<uuidType>;
+	using loadingPhysicsMaterialsTableType = DCore::InFlightLoadTable<uuidType>;
+	using loadGuardType = loadingPhysicsMaterialsTableType::LoadGuard;
+	using loadFutureType = loadingPhysicsMaterialsTableType::futureType;
 public:
 	~PhysicsMaterialManager() = default;
 public:;
@@ -37,8 +37,7 @@ public:
 private:
 	PhysicsMaterialManager();
 private:
-	lockDataType m_lockData;
-	loadingPhysicsMaterialsSetType m_loadingPhysicsMaterials;
+	loadingPhysicsMaterialsTableType m_loadingPhysicsMaterials;
 private:
 	pathType GetPhysicsMaterialsPath() const;
 	void GeneratePhysicsMaterialThumbnail(const pathType& thumbailPath, const stringType& uuidString, const stringType& physicsMaterialName);
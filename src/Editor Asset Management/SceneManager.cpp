@@ -3,6 +3,12 @@
 #include "ProgramContext.h"
 #include "Log.h"
 #include "SceneSerialization.h"
+#include "AssetPackManager.h"
+#include "TextureManager.h"
+#include "MaterialManager.h"
+#include "AnimationManager.h"
+#include "AnimationStateMachineManager.h"
+#include "PhysicsMaterialManager.h"
 
 #include "yaml-cpp/yaml.h"
 
@@ -25,12 +31,6 @@ static const char* s_sceneKey = "Scene";
 
 SceneManager::SceneManager()
 {
-	const std::filesystem::path scenesPath(GetSceneDirectoryPath() / s_scenesFileName);
-	std::ofstream ostream(scenesPath, std::ios_base::out | std::ios_base::app);
-	DASSERT_E(ostream);
-	ostream.close();
-	DASSERT_E(ostream);
-	s_scenesNode = YAML::LoadFile(scenesPath.string());
 	DCore::SceneLoader::Get().SetLoadSceneFunc(
 		[&](const stringType& sceneName) -> sceneRefType 
 		{
@@ -38,6 +38,22 @@ SceneManager::SceneManager()
 			LoadSceneWithName(sceneName, &scene); 
 			return scene;
 		});
+	DCore::SceneLoader::Get().SetPreloadSceneFunc(
+		[&](const stringType& sceneName, DCore::ScenePreload& scenePreload) -> void
+		{
+			PreloadScene(sceneName, scenePreload);
+		});
+	if (AssetPackManager::Get().GetAssetPack() != nullptr)
+	{
+		// The scenes are loaded from the pack.
+		return;
+	}
+	const std::filesystem::path scenesPath(GetSceneDirectoryPath() / s_scenesFileName);
+	std::ofstream ostream(scenesPath, std::ios_base::out | std::ios_base::app);
+	DASSERT_E(ostream);
+	ostream.close();
+	DASSERT_E(ostream);
+	s_scenesNode = YAML::LoadFile(scenesPath.string());
 }
 
 void SceneManager::CreateScene(const stringType& sceneName, const pathType& thumbnailDirectory)
@@ -78,6 +94,14 @@ void SceneManager::CreateScene(const stringType& sceneName, const pathType& thum
 
 void SceneManager::LoadScene(const DCore::UUIDType& uuid, sceneRefType* outScene)
 {
+	const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+	if (assetPack != nullptr)
+	{
+		const DCore::AssetPack::Entry* entry(assetPack->Find(uuid, DCore::AssetPackEntryType::Scene));
+		DASSERT_E(entry != nullptr);
+		LoadSceneFromAssetPack(*assetPack, *entry, outScene);
+		return;
+	}
 	//  Its assumed that the user will never try to load the same scene at same time.
 	const DCore::DString uuidString((std::string)uuid);
 	DASSERT_E(s_scenesNode[uuidString.Data()]);
@@ -96,6 +120,22 @@ void SceneManager::LoadScene(const DCore::UUIDType& uuid, sceneRefType* outScene
 	DCore::Scene scene(sceneName);
 	DCore::SceneRef sceneRef(DCore::AssetManager::Get().LoadScene(uuid, std::move(scene)));
 	const std::filesystem::path scenePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_scenesNode[uuidString.Data()][s_pathKey].as<std::string>());
+	const std::filesystem::path cookedScenePath(GetCookedScenePath(scenePath));
+	if (IsCookedSceneUpToDate(scenePath, cookedScenePath))
+	{
+		DCore::ReturnError cookedError(SceneSerialization::Get().DeserializeCookedScene(cookedScenePath, sceneRef));
+		if (cookedError.Ok)
+		{
+			if (outScene != nullptr)
+			{
+				*outScene = sceneRef;
+			}
+			return;
+		}
+		// Nothing was created in the scene, so it can be loaded from its source.
+		Log::Get().TerminalLog(cookedError.Message);
+		Log::Get().ConsoleLog(LogLevel::Warning, "%s", cookedError.Message.Data());
+	}
 	DCore::ReturnError error(SceneSerialization::Get().DeserializeScene(scenePath, sceneRef));
 	if (!error.Ok)
 	{
@@ -111,6 +151,16 @@ void SceneManager::LoadScene(const DCore::UUIDType& uuid, sceneRefType* outScene
 
 void SceneManager::LoadSceneWithName(const stringType& sceneName, sceneRefType* outSceneRef)
 {
+	const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+	if (assetPack != nullptr)
+	{
+		const DCore::AssetPack::Entry* entry(assetPack->FindWithName(sceneName.c_str(), DCore::AssetPackEntryType::Scene));
+		if (entry != nullptr)
+		{
+			LoadSceneFromAssetPack(*assetPack, *entry, outSceneRef);
+		}
+		return;
+	}
 	for (YAML::const_iterator it(s_scenesNode.begin()); it != s_scenesNode.end(); it++)
 	{
 		YAML::Node sceneInfoNode(it->second);
@@ -124,6 +174,61 @@ void SceneManager::LoadSceneWithName(const stringType& sceneName, sceneRefType*
 	}
 }
 
+void SceneManager::PreloadScene(const stringType& sceneName, DCore::ScenePreload& scenePreload)
+{
+	const auto preloadCookedScene
+	(
+		[&](const char* cookedScene, size_t cookedSceneSize, const char* sourceName) -> void
+		{
+			cookedDependencyContainerType dependencies;
+			DCore::ReturnError error(SceneSerialization::Get().ReadCookedSceneDependencies(cookedScene, cookedSceneSize, sourceName, dependencies));
+			if (!error.Ok)
+			{
+				Log::Get().TerminalLog(error.Message);
+				Log::Get().ConsoleLog(LogLevel::Warning, "%s", error.Message.Data());
+				return;
+			}
+			PreloadSceneDependencies(dependencies, scenePreload);
+		}
+	);
+	const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+	if (assetPack != nullptr)
+	{
+		const DCore::AssetPack::Entry* entry(assetPack->FindWithName(sceneName.c_str(), DCore::AssetPackEntryType::Scene));
+		if (entry != nullptr)
+		{
+			preloadCookedScene(assetPack->GetPayload(*entry), static_cast<size_t>(entry->Size), sceneName.c_str());
+		}
+		return;
+	}
+	for (YAML::const_iterator it(s_scenesNode.begin()); it != s_scenesNode.end(); it++)
+	{
+		DASSERT_E(it->second[s_nameKey]);
+		DASSERT_E(it->second[s_pathKey]);
+		if (it->second[s_nameKey].as<stringType>() != sceneName)
+		{
+			continue;
+		}
+		const pathType scenePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second[s_pathKey].as<stringType>());
+		const pathType cookedScenePath(GetCookedScenePath(scenePath));
+		if (!IsCookedSceneUpToDate(scenePath, cookedScenePath))
+		{
+			Log::Get().TerminalLog("Scene %s has no up to date cooked file, so its assets are not preloaded.", sceneName.c_str());
+			Log::Get().ConsoleLog(LogLevel::Warning, "Scene %s has no up to date cooked file, so its assets are not preloaded.", sceneName.c_str());
+			return;
+		}
+		DCore::MappedFile cookedScene;
+		if (!cookedScene.Open(cookedScenePath))
+		{
+			Log::Get().TerminalLog("Bad cooked scene file (can't be mapped): %s.", cookedScenePath.string().c_str());
+			Log::Get().ConsoleLog(LogLevel::Warning, "Bad cooked scene file (can't be mapped): %s.", cookedScenePath.string().c_str());
+			return;
+		}
+		preloadCookedScene(cookedScene.GetData(), cookedScene.GetSize(), cookedScenePath.string().c_str());
+		return;
+	}
+}
+
 void SceneManager::GetSceneName(const uuidType& sceneUUID, stringType& outSceneName)
 {
 	const stringType uuidString((stringType)sceneUUID);
@@ -146,6 +251,14 @@ void SceneManager::SaveLoadedScenes()
 			DASSERT_E(s_scenesNode[uuidString.Data()][s_pathKey]);
 			std::filesystem::path scenePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_scenesNode[uuidString.Data()][s_pathKey].as<std::string>());
 			SceneSerialization::Get().SerializeScene(scenePath, sceneRef);
+			DCore::ReturnError error(SceneSerialization::Get().CookScene(GetCookedScenePath(scenePath), sceneRef));
+			if (!error.Ok)
+			{
+				// The stale cooked scene must not be loaded instead of the saved one.
+				std::filesystem::remove(GetCookedScenePath(scenePath));
+				Log::Get().TerminalLog(error.Message);
+				Log::Get().ConsoleLog(LogLevel::Warning, "%s", error.Message.Data());
+			}
 			return false;
 		}
 	);
@@ -158,6 +271,7 @@ void SceneManager::DeleteScene(const uuidType& uuid)
 	DASSERT_E(s_scenesNode[uuidString][s_pathKey]);
 	const std::filesystem::path scenePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_scenesNode[uuidString][s_pathKey].as<std::string>());
 	std::filesystem::remove(scenePath);
+	std::filesystem::remove(GetCookedScenePath(scenePath));
 	// Remove its key from s_scenesNode.
 	YAML::Node newScenesNode;
 	for (YAML::const_iterator it(s_scenesNode.begin()); it != s_scenesNode.end(); it++)
@@ -215,6 +329,8 @@ bool SceneManager::RenameScene(const uuidType& uuid, const stringType& newName)
 	ostream.close();
 	DASSERT_E(ostream);
 	std::filesystem::rename(oldPath, newPath);
+	// The cooked scene has the old name. It is cooked again when the scene is saved.
+	std::filesystem::remove(GetCookedScenePath(oldPath));
 	DASSERT_E(s_scenesNode[uuidString][s_nameKey]);
 	s_scenesNode[uuidString][s_nameKey] = newName;
 	s_scenesNode[uuidString][s_pathKey] = Path::Get().MakePathRelativeToAssetsDirectory(newPath).string().c_str();
@@ -227,10 +343,202 @@ bool SceneManager::RenameScene(const uuidType& uuid, const stringType& newName)
 	return true;
 }
 
+void SceneManager::CookScenes()
+{
+	for (YAML::const_iterator it(s_scenesNode.begin()); it != s_scenesNode.end(); it++)
+	{
+		DASSERT_E(it->second[s_pathKey]);
+		const uuidType uuid(it->first.as<stringType>());
+		const pathType scenePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second[s_pathKey].as<stringType>());
+		const pathType cookedScenePath(GetCookedScenePath(scenePath));
+		if (IsCookedSceneUpToDate(scenePath, cookedScenePath))
+		{
+			continue;
+		}
+		bool isSceneLoaded(false);
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SceneAssetManager*>(&DCore::AssetManager::Get()));
+			isSceneLoaded = DCore::AssetManager::Get().IsSceneLoaded(uuid);
+		}
+		if (isSceneLoaded)
+		{
+			// Cooking it would take the changes not saved yet.
+			Log::Get().TerminalLog("Scene %s is open and its cooked file is stale. Save it to cook it.", it->second[s_nameKey].as<stringType>().c_str());
+			Log::Get().ConsoleLog(LogLevel::Warning, "Scene %s is open and its cooked file is stale. Save it to cook it.", it->second[s_nameKey].as<stringType>().c_str());
+			continue;
+		}
+		sceneRefType sceneRef;
+		LoadScene(uuid, &sceneRef);
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SceneAssetManager*>(&DCore::AssetManager::Get()));
+			DCore::ReturnError error(SceneSerialization::Get().CookScene(cookedScenePath, sceneRef));
+			if (!error.Ok)
+			{
+				std::filesystem::remove(cookedScenePath);
+				Log::Get().TerminalLog(error.Message);
+				Log::Get().ConsoleLog(LogLevel::Warning, "%s", error.Message.Data());
+			}
+		}
+		DCore::AssetManager::Get().UnloadScene(uuid);
+	}
+}
+
+void SceneManager::IterateOnCookedScenes(cookedSceneIterationCallbackType callback)
+{
+	for (YAML::const_iterator it(s_scenesNode.begin()); it != s_scenesNode.end(); it++)
+	{
+		DASSERT_E(it->second[s_nameKey]);
+		DASSERT_E(it->second[s_pathKey]);
+		const pathType scenePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second[s_pathKey].as<stringType>());
+		if (callback(uuidType(it->first.as<stringType>()), it->second[s_nameKey].as<stringType>(), GetCookedScenePath(scenePath)))
+		{
+			return;
+		}
+	}
+}
+
+void SceneManager::LoadSceneFromAssetPack(const DCore::AssetPack& assetPack, const DCore::AssetPack::Entry& entry, sceneRefType* outSceneRef)
+{
+	const uuidType uuid(DCore::AssetPack::GetUUID(entry));
+	const char* sceneName(assetPack.GetName(entry));
+	{
+		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SceneAssetManager*>(&DCore::AssetManager::Get()));
+		if (DCore::AssetManager::Get().IsSceneLoaded(uuid))
+		{
+			Log::Get().TerminalLog("Scene \"%s\" is already loaded.", sceneName);
+			Log::Get().ConsoleLog(LogLevel::Error, "Scene \"%s\" is already loaded.", sceneName);
+			return;
+		}
+	}
+	DCore::Scene scene(sceneName);
+	DCore::SceneRef sceneRef(DCore::AssetManager::Get().LoadScene(uuid, std::move(scene)));
+	DCore::ReturnError error(SceneSerialization::Get().DeserializeCookedScene(assetPack.GetPayload(entry), static_cast<size_t>(entry.Size), sceneName, sceneRef));
+	if (!error.Ok)
+	{
+		Log::Get().TerminalLog(error.Message);
+		Log::Get().ConsoleLog(LogLevel::Error, "%s", error.Message.Data());
+		DASSERT_E(false);
+	}
+	if (outSceneRef != nullptr)
+	{
+		*outSceneRef = sceneRef;
+	}
+}
+
+void SceneManager::PreloadSceneDependencies(const cookedDependencyContainerType& dependencies, DCore::ScenePreload& scenePreload)
+{
+	using dependencyType = DCore::CookedScene::DependencyType;
+	using uuidContainerType = std::vector<uuidType>;
+	const auto getUUIDs
+	(
+		[&](dependencyType type) -> uuidContainerType
+		{
+			uuidContainerType uuids;
+			for (const DCore::CookedScene::DependencyEntry& dependency : dependencies)
+			{
+				if (dependency.Type == type)
+				{
+					uuids.push_back(uuidType(dependency.UUIDHigh, dependency.UUIDLow));
+				}
+			}
+			return uuids;
+		}
+	);
+	const auto loadInParallel
+	(
+		[&](dependencyType type, auto loadAsset) -> void
+		{
+			const uuidContainerType uuids(getUUIDs(type));
+			DCore::WorkerPool::Get().ParallelFor
+			(
+				uuids.size(), 1,
+				[&](size_t begin, size_t end) -> void
+				{
+					for (size_t i(begin); i < end; i++)
+					{
+						loadAsset(uuids[i]);
+					}
+				}
+			);
+		}
+	);
+	scenePreload.SetNumberOfAssets(dependencies.size());
+	// In the order of the types, so the maps of the materials and the animations of the state machines are loaded
+	// when these are.
+	{
+		const uuidContainerType uuids(getUUIDs(dependencyType::Texture2D));
+		std::vector<DCore::Texture2DRef> textures(uuids.size());
+		TextureManager::Get().LoadTextures2D(uuids.data(), uuids.size(), textures.data());
+		for (DCore::Texture2DRef texture : textures)
+		{
+			scenePreload.AddTexture2D(texture);
+		}
+	}
+	loadInParallel
+	(
+		dependencyType::SpriteMaterial,
+		[&](const uuidType& uuid) -> void
+		{
+			scenePreload.AddSpriteMaterial(MaterialManager::Get().LoadSpriteMaterial(uuid));
+		}
+	);
+	loadInParallel
+	(
+		dependencyType::Animation,
+		[&](const uuidType& uuid) -> void
+		{
+			scenePreload.AddAnimation(AnimationManager::Get().LoadCoreAnimation(uuid));
+		}
+	);
+	loadInParallel
+	(
+		dependencyType::AnimationStateMachine,
+		[&](const uuidType& uuid) -> void
+		{
+			scenePreload.AddAnimationStateMachine(AnimationStateMachineManager::Get().LoadCoreAnimationStateMachine(uuid));
+		}
+	);
+	loadInParallel
+	(
+		dependencyType::PhysicsMaterial,
+		[&](const uuidType& uuid) -> void
+		{
+			scenePreload.AddPhysicsMaterial(PhysicsMaterialManager::Get().LoadPhysicsMaterial(uuid));
+		}
+	);
+}
+
 std::filesystem::path SceneManager::GetSceneDirectoryPath() const
 {
 	return std::filesystem::path(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_scenesDirectory);
 }
+
+SceneManager::pathType SceneManager::GetCookedScenePath(const pathType& scenePath) const
+{
+	pathType cookedScenePath(scenePath);
+	cookedScenePath.replace_extension(DCore::CookedScene::fileExtension);
+	return cookedScenePath;
+}
+
+bool SceneManager::IsCookedSceneUpToDate(const pathType& scenePath, const pathType& cookedScenePath) const
+{
+	std::error_code errorCode;
+	const std::filesystem::file_time_type cookedSceneWriteTime(std::filesystem::last_write_time(cookedScenePath, errorCode));
+	if (errorCode)
+	{
+		return false;
+	}
+	const std::filesystem::file_time_type sceneWriteTime(std::filesystem::last_write_time(scenePath, errorCode));
+	if (errorCode || cookedSceneWriteTime < sceneWriteTime)
+	{
+		return false;
+	}
+	// Files cooked in an older format are cooked again.
+	uint32_t magicAndVersion[2]{0, 0};
+	std::ifstream istream(cookedScenePath, std::ios_base::in | std::ios_base::binary);
+	istream.read(reinterpret_cast<char*>(magicAndVersion), sizeof(magicAndVersion));
+	return istream && magicAndVersion[0] == DCore::CookedScene::magic && magicAndVersion[1] == DCore::CookedScene::version;
+}
  
 void SceneManager::GenerateSceneThumbnail(const stringType& uuidString, const pathType& thumbnailPath) const
 {
@@ -3,7 +3,9 @@
 #include "DommusCore.h"
 
 #include <filesystem>
+#include <functional>
 #include <string>
+#include <vector>
 
 
 
@@ -17,6 +19,8 @@ public:
 	using sceneRefType = DCore::SceneRef;
 	using stringType = std::string;
 	using pathType = std::filesystem::path;
+	using cookedSceneIterationCallbackType = std::function<bool(const uuidType&, const stringType& sceneName, const pathType& cookedScenePath)>;
+	using cookedDependencyContainerType = std::vector<DCore::CookedScene::DependencyEntry>;
 public:
 	~SceneManager() = default;
 public:
@@ -29,14 +33,24 @@ public:
 	void CreateScene(const stringType& sceneName, const pathType& thumbnailDirectory);
 	void LoadScene(const uuidType&, sceneRefType* outSceneRef = nullptr);
 	void LoadSceneWithName(const stringType&, sceneRefType* outSceneRef = nullptr);
+	// Loads the assets listed in the cooked scene, in parallel. A scene without an up to date cooked file has nothing
+	// preloaded, as its assets are only known once it is loaded.
+	void PreloadScene(const stringType& sceneName, DCore::ScenePreload&);
 	void GetSceneName(const uuidType&, stringType& outSceneName);
 	void SaveLoadedScenes();
 	void DeleteScene(const uuidType&);
 	bool RenameScene(const uuidType&, const stringType& newName);
+	// Cooks the scenes whose cooked file is missing or stale. The ones not loaded are loaded only to be cooked.
+	void CookScenes();
+	void IterateOnCookedScenes(cookedSceneIterationCallbackType);
 private:
 	SceneManager();
 private:
+	void LoadSceneFromAssetPack(const DCore::AssetPack&, const DCore::AssetPack::Entry&, sceneRefType* outSceneRef);
+	void PreloadSceneDependencies(const cookedDependencyContainerType&, DCore::ScenePreload&);
 	pathType GetSceneDirectoryPath() const;
+	pathType GetCookedScenePath(const pathType& scenePath) const;
+	bool IsCookedSceneUpToDate(const pathType& scenePath, const pathType& cookedScenePath) const;
 	void GenerateSceneThumbnail(const stringType& uuidString, const pathType& thumbnailPath) const;
 	void SaveScenesMap() const;
 };
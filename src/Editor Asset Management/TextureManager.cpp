@@ -4,13 +4,20 @@
 #include "Log.h"
 #include "Path.h"
 #include "MaterialManager.h"
+#include "AssetPackManager.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "yaml-cpp/yaml.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <string>
+#include <thread>
+#include <vector>
 
 
 
@@ -26,9 +33,89 @@ static const char* s_alphaMaskKey = "Alpha Mask";
 static const char* s_filterKey = "Filter";
 static const char* s_pathKey = "Path";
 static const char* s_thumbnailExtension = ".dttex";
+static const char* s_cookedTextureWriteFailure = "Fail to write the cooked texture.";
+
+struct TextureSourceInfo
+{
+	uint64_t Size;
+	int64_t WriteTime;
+};
+
+static bool GetTextureSourceInfo(const std::filesystem::path& texturePath, TextureSourceInfo& outSourceInfo)
+{
+	std::error_code errorCode;
+	const uintmax_t size(std::filesystem::file_size(texturePath, errorCode));
+	if (errorCode)
+	{
+		return false;
+	}
+	const std::filesystem::file_time_type writeTime(std::filesystem::last_write_time(texturePath, errorCode));
+	if (errorCode)
+	{
+		return false;
+	}
+	outSourceInfo.Size = static_cast<uint64_t>(size);
+	outSourceInfo.WriteTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+	return true;
+}
+
+// FNV-1a.
+static bool HashTextureSource(const std::filesystem::path& texturePath, uint64_t& outHash)
+{
+	std::ifstream istream(texturePath, std::ios_base::binary);
+	if (!istream)
+	{
+		return false;
+	}
+	uint64_t hash(0xcbf29ce484222325);
+	char buffer[1 << 16];
+	while (istream)
+	{
+		istream.read(buffer, sizeof(buffer));
+		const std::streamsize numberOfBytesRead(istream.gcount());
+		for (std::streamsize i(0); i < numberOfBytesRead; i++)
+		{
+			hash ^= static_cast<unsigned char>(buffer[i]);
+			hash *= 0x100000001b3;
+		}
+	}
+	outHash = hash;
+	return istream.eof();
+}
+
+// Box filter. The last row and column of a level with an odd size are averaged with themselves.
+static void DownsampleMipLevel(const unsigned char* source, uint32_t sourceWidth, uint32_t sourceHeight, unsigned char* destination, uint32_t width, uint32_t height, uint32_t numberOfChannels)
+{
+	for (uint32_t y(0); y < height; y++)
+	{
+		const uint32_t y0(std::min(y * 2, sourceHeight - 1));
+		const uint32_t y1(std::min(y * 2 + 1, sourceHeight - 1));
+		for (uint32_t x(0); x < width; x++)
+		{
+			const uint32_t x0(std::min(x * 2, sourceWidth - 1));
+			const uint32_t x1(std::min(x * 2 + 1, sourceWidth - 1));
+			for (uint32_t channel(0); channel < numberOfChannels; channel++)
+			{
+				const uint32_t sum
+				(
+					source[(y0 * sourceWidth + x0) * numberOfChannels + channel] +
+					source[(y0 * sourceWidth + x1) * numberOfChannels + channel] +
+					source[(y1 * sourceWidth + x0) * numberOfChannels + channel] +
+					source[(y1 * sourceWidth + x1) * numberOfChannels + channel]
+				);
+				destination[(y * width + x) * numberOfChannels + channel] = static_cast<unsigned char>((sum + 2) / 4);
+			}
+		}
+	}
+}
 
 TextureManager::TextureManager()
 {
+	if (AssetPackManager::Get().GetAssetPack() != nullptr)
+	{
+		// The textures are loaded from the pack.
+		return;
+	}
 	std::filesystem::path texturesPath(GetTextureDirectoryPath() / s_texturesFileName);
 	std::ofstream ostream(texturesPath, std::ios_base::out | std::ios_base::app);
 	DASSERT_E(ostream);
@@ -70,54 +157,239 @@ void TextureManager::ImportTexture(const std::filesystem::path& outsidePath, con
 	thumbnailPath += s_thumbnailExtension;
 	CreateTextureThumbnail(thumbnailPath, uuidString);
 	SaveTexturesMap();
+	const char* failureReason(nullptr);
+	if (!CookTexture(toPath, GetCookedTexturePath(toPath), &failureReason))
+	{
+		// It is cooked again when loaded.
+		Log::Get().TerminalLog("Fail to cook texture2D at path: %s. %s", toPath.string().c_str(), failureReason);
+	}
+}
+
+void TextureManager::CookTextures()
+{
+	struct TextureToCook
+	{
+		pathType Path;
+		pathType CookedPath;
+		bool Failed;
+		const char* FailureReason;
+	};
+
+	std::vector<TextureToCook> texturesToCook;
+	for (YAML::const_iterator it(s_texturesNode.begin()); it != s_texturesNode.end(); it++)
+	{
+		DASSERT_E(it->second[s_pathKey]);
+		const pathType texturePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second[s_pathKey].as<std::string>());
+		texturesToCook.push_back({texturePath, GetCookedTexturePath(texturePath), false, nullptr});
+	}
+	DCore::WorkerPool::Get().ParallelFor
+	(
+		texturesToCook.size(), 1,
+		[&](size_t begin, size_t end) -> void
+		{
+			for (size_t i(begin); i < end; i++)
+			{
+				TextureToCook& textureToCook(texturesToCook[i]);
+				DCore::MappedFile cookedTexture;
+				if (OpenCookedTexture(textureToCook.Path, textureToCook.CookedPath, cookedTexture))
+				{
+					continue;
+				}
+				textureToCook.Failed = !CookTexture(textureToCook.Path, textureToCook.CookedPath, &textureToCook.FailureReason);
+			}
+		}
+	);
+	for (const TextureToCook& textureToCook : texturesToCook)
+	{
+		if (textureToCook.Failed)
+		{
+			Log::Get().TerminalLog("Fail to cook texture2D at path: %s. %s", textureToCook.Path.string().c_str(), textureToCook.FailureReason);
+			Log::Get().ConsoleLog(LogLevel::Warning, "Fail to cook texture2D at path: %s. %s", textureToCook.Path.string().c_str(), textureToCook.FailureReason);
+		}
+	}
 }
 
 DCore::Texture2DRef TextureManager::LoadTexture2D(const DCore::UUIDType& uuid)
 {
+	DCore::Texture2DRef ref;
+	LoadTextures2D(&uuid, 1, &ref);
+	return ref;
+}
+
+void TextureManager::LoadTextures2D(const uuidType* uuids, size_t numberOfTextures, textureRefType* outTextures)
+{
+	struct TextureToLoad
+	{
+		size_t Index;
+		pathType Path;
+		DCore::Texture2DMetadata Metadata;
+		DCore::MappedFile CookedTexture;
+		const char* FailureReason;
+		loadGuardType LoadGuard;
+	};
+
+	struct LoadToWait
+	{
+		size_t Index;
+		loadFutureType Future;
+	};
+
+	std::vector<TextureToLoad> texturesToLoad;
+	std::vector<LoadToWait> loadsToWait;
+	for (size_t i(0); i < numberOfTextures; i++)
+	{
+		const uuidType& uuid(uuids[i]);
+		outTextures[i] = textureRefType();
+		{
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::Texture2DAssetManager*>(&DCore::AssetManager::Get()));
+			if (DCore::AssetManager::Get().IsTexture2DLoaded(uuid))
+			{
+				outTextures[i] = DCore::AssetManager::Get().GetTexture2DRef(uuid);
+				continue;
+			}
+		}
+		loadFutureType loadFuture;
+		if (!m_texturesLoading.TryBeginLoad(uuid, loadFuture))
+		{
+			loadsToWait.push_back({i, std::move(loadFuture)});
+			continue;
+		}
+		loadGuardType loadGuard(m_texturesLoading, uuid);
+		{
+			// The load may have ended between the lookup and the beginning of this one.
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::Texture2DAssetManager*>(&DCore::AssetManager::Get()));
+			if (DCore::AssetManager::Get().IsTexture2DLoaded(uuid))
+			{
+				loadGuard.EndLoad(true);
+				outTextures[i] = DCore::AssetManager::Get().GetTexture2DRef(uuid);
+				continue;
+			}
+		}
+		const DCore::AssetPack* assetPack(AssetPackManager::Get().GetAssetPack());
+		if (assetPack != nullptr)
+		{
+			const DCore::AssetPack::Entry* entry(assetPack->Find(uuid, DCore::AssetPackEntryType::Texture2D));
+			if (entry == nullptr || !DCore::Texture2DAssetManager::IsCookedTexture2DValid(assetPack->GetPayload(*entry), static_cast<size_t>(entry->Size)))
+			{
+				Log::Get().TerminalLog("Fail to load texture2D %s from the asset pack.", ((std::string)uuid).c_str());
+				Log::Get().ConsoleLog(LogLevel::Error, "Fail to load texture2D %s from the asset pack.", ((std::string)uuid).c_str());
+				loadGuard.EndLoad(false);
+				continue;
+			}
+			outTextures[i] = DCore::AssetManager::Get().LoadTexture2DDeferred
+			(
+				uuid,
+				assetPack->GetPayload(*entry),
+				static_cast<size_t>(entry->Size),
+				DCore::AssetPack::FlagsToTexture2DMetadata(entry->Flags)
+			);
+			loadGuard.EndLoad(true);
+			continue;
+		}
+		// The textures map is only read by this thread, the workers only map and cook.
+		const DCore::DString uuidString(((std::string)uuid).c_str());
+		DASSERT_E(s_texturesNode[uuidString.Data()]);
+		DASSERT_E(s_texturesNode[uuidString.Data()][s_pathKey]);
+		texturesToLoad.push_back
+		(
+			{
+				i,
+				ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_texturesNode[uuidString.Data()][s_pathKey].as<std::string>(),
+				GetTexture2DMetadata(uuidString),
+				DCore::MappedFile(),
+				nullptr,
+				std::move(loadGuard)
+			}
+		);
+	}
+	DCore::WorkerPool::Get().ParallelFor
+	(
+		texturesToLoad.size(), 1,
+		[&](size_t begin, size_t end) -> void
+		{
+			for (size_t i(begin); i < end; i++)
+			{
+				TextureToLoad& textureToLoad(texturesToLoad[i]);
+				const pathType cookedTexturePath(GetCookedTexturePath(textureToLoad.Path));
+				if (OpenCookedTexture(textureToLoad.Path, cookedTexturePath, textureToLoad.CookedTexture))
+				{
+					continue;
+				}
+				if (CookTexture(textureToLoad.Path, cookedTexturePath, &textureToLoad.FailureReason) &&
+					!OpenCookedTexture(textureToLoad.Path, cookedTexturePath, textureToLoad.CookedTexture))
+				{
+					textureToLoad.FailureReason = s_cookedTextureWriteFailure;
+				}
+			}
+		}
+	);
+	for (TextureToLoad& textureToLoad : texturesToLoad)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::Texture2DAssetManager*>(&DCore::AssetManager::Get()));
-		if (DCore::AssetManager::Get().IsTexture2DLoaded(uuid))
+		const uuidType& uuid(uuids[textureToLoad.Index]);
+		if (!textureToLoad.CookedTexture.IsOpen())
 		{
-			return DCore::AssetManager::Get().GetTexture2DRef(uuid);
+			Log::Get().TerminalLog("Fail to load texture2D at path: %s. %s", textureToLoad.Path.string().c_str(), textureToLoad.FailureReason);
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to load texture2D at path: %s. %s", textureToLoad.Path.string().c_str(), textureToLoad.FailureReason);
+			textureToLoad.LoadGuard.EndLoad(false);
+			continue;
 		}
+		// The GL texture is created by the upload queue, on the main thread.
+		outTextures[textureToLoad.Index] = DCore::AssetManager::Get().LoadTexture2DDeferred
+		(
+			uuid,
+			std::move(textureToLoad.CookedTexture),
+			textureToLoad.Metadata
+		);
+		textureToLoad.LoadGuard.EndLoad(true);
 	}
+	// Waited last, as the same texture may be more than once in uuids.
+	for (LoadToWait& loadToWait : loadsToWait)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-		if (m_texturesLoading.count(uuid) == 0)
+		// The texture is looked up again after the load, as it may have been unloaded in between.
+		if (loadToWait.Future.get())
 		{
-			m_texturesLoading.insert(uuid);
-			goto LoadTexture;
+			outTextures[loadToWait.Index] = LoadTexture2D(uuids[loadToWait.Index]);
 		}
 	}
-	while (true)
+}
+
+bool TextureManager::ReloadTexture2D(const pathType& texturePath)
+{
+	for (YAML::const_iterator it(s_texturesNode.begin()); it != s_texturesNode.end(); it++)
 	{
-		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::Texture2DAssetManager*>(&DCore::AssetManager::Get()));
-		if (DCore::AssetManager::Get().IsTexture2DLoaded(uuid))
+		DASSERT_E(it->second[s_pathKey]);
+		if ((ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second[s_pathKey].as<std::string>()).lexically_normal() != texturePath.lexically_normal())
 		{
-			return DCore::AssetManager::Get().GetTexture2DRef(uuid);
+			continue;
+		}
+		const uuidType uuid(it->first.as<std::string>());
+		{
+			// A texture not loaded is cooked again when it is, as its cooked file is stale.
+			DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::Texture2DAssetManager*>(&DCore::AssetManager::Get()));
+			if (!DCore::AssetManager::Get().IsTexture2DLoaded(uuid))
+			{
+				return true;
+			}
+		}
+		const pathType cookedTexturePath(GetCookedTexturePath(texturePath));
+		const char* failureReason(s_cookedTextureWriteFailure);
+		DCore::MappedFile cookedTexture;
+		if (!CookTexture(texturePath, cookedTexturePath, &failureReason) || !OpenCookedTexture(texturePath, cookedTexturePath, cookedTexture))
+		{
+			Log::Get().TerminalLog("Fail to reload texture2D at path: %s. %s", texturePath.string().c_str(), failureReason);
+			Log::Get().ConsoleLog(LogLevel::Error, "Fail to reload texture2D at path: %s. %s", texturePath.string().c_str(), failureReason);
+			return true;
 		}
+		DCore::AssetManager::Get().ReloadTexture2D(uuid, std::move(cookedTexture));
+		return true;
 	}
-LoadTexture:
-	const DCore::DString uuidString(((std::string)uuid).c_str());
-	DASSERT_E(s_texturesNode[uuidString.Data()]);
-	DASSERT_E(s_texturesNode[uuidString.Data()][s_pathKey]);
-	std::filesystem::path texturePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_texturesNode[uuidString.Data()][s_pathKey].as<std::string>());
-	DCore::Texture2DMetadata metadata(GetTexture2DMetadata((std::string)uuid));
-	int width(0), height(0), numberChannels(0);
-	stbi_set_flip_vertically_on_load(true);
-	unsigned char* binary(stbi_load(texturePath.string().c_str(), &width, &height, &numberChannels, 0));
-	DASSERT_E(binary != nullptr);
-	DCore::Texture2DRef ref(DCore::AssetManager::Get().LoadTexture2D(uuid, binary, {width, height}, numberChannels, metadata));
-	stbi_image_free(binary);
-	DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, m_lockData);
-	m_texturesLoading.erase(uuid);
-	return ref;
+	return false;
 }
 
 DCore::Texture2D TextureManager::LoadRawTexture2D(const std::filesystem::path& path)
 {
 	int width(0), height(0), numberChannels(0);
-	stbi_set_flip_vertically_on_load(true);
+	stbi_set_flip_vertically_on_load_thread(true);
 	unsigned char* binary(stbi_load(path.string().c_str(), &width, &height, &numberChannels, 0));
 	DASSERT_E(binary != nullptr && "Fail to load texture. Check program command line args.");
 	DCore::DVec2 size(width, height);
@@ -129,7 +401,7 @@ DCore::Texture2D TextureManager::LoadRawTexture2D(const std::filesystem::path& p
 TextureInfo TextureManager::GetTextureInfo(const pathType& path)
 {
 	int width(0), height(0), numberChannels(0);
-	stbi_set_flip_vertically_on_load(true);
+	stbi_set_flip_vertically_on_load_thread(true);
 	unsigned char* binary(stbi_load(path.string().c_str(), &width, &height, &numberChannels, 0));
 	DASSERT_E(binary != nullptr && "Fail to load texture. Check program command line args.");
 	DCore::DVec2 sizes(width, height);
@@ -142,6 +414,7 @@ void TextureManager::DeleteTexture(const uuidType& uuid)
 	DASSERT_E(s_texturesNode[uuidString][s_pathKey]);
 	const pathType texturePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_texturesNode[uuidString][s_pathKey].as<std::string>());
 	std::filesystem::remove(texturePath);
+	std::filesystem::remove(GetCookedTexturePath(texturePath));
 	YAML::Node newTexturesNode;
 	for (YAML::const_iterator it(s_texturesNode.begin()); it != s_texturesNode.end(); it++)
 	{
@@ -189,6 +462,9 @@ bool TextureManager::RenameTexture(const uuidType& uuid, const stringType& newNa
 	pathType newPath(oldPath);
 	newPath.replace_filename(newName + ".png");
 	std::filesystem::rename(oldPath, newPath);
+	// Renaming keeps the size and the write time of the source, so the cooked texture stays up to date.
+	std::error_code errorCode;
+	std::filesystem::rename(GetCookedTexturePath(oldPath), GetCookedTexturePath(newPath), errorCode);
 	s_texturesNode[uuidString][s_pathKey] = Path::Get().MakePathRelativeToAssetsDirectory(newPath).string();
 	SaveTexturesMap();
 	return true;
@@ -215,6 +491,19 @@ void TextureManager::IterateOnTextures(textureIterationCallbackType callback)
 	}
 }
 
+void TextureManager::IterateOnCookedTextures(cookedTextureIterationCallbackType callback)
+{
+	for (YAML::const_iterator it(s_texturesNode.begin()); it != s_texturesNode.end(); it++)
+	{
+		const stringType uuidString(it->first.as<stringType>());
+		const pathType texturePath(ProgramContext::Get().GetProjectAssetsDirectoryPath() / it->second[s_pathKey].as<stringType>());
+		if (callback(uuidType(uuidString), texturePath.stem().string(), GetCookedTexturePath(texturePath), GetTexture2DMetadata(uuidString.c_str())))
+		{
+			return;
+		}
+	}
+}
+
 bool TextureManager::TextureExists(const uuidType& uuid)
 {
 	const stringType uuidString(uuid);
@@ -235,6 +524,127 @@ TextureManager::pathType TextureManager::GetTextureDirectoryPath() const
 	return ProgramContext::Get().GetProjectAssetsDirectoryPath() / s_textureDirectoryName;
 }
 
+TextureManager::pathType TextureManager::GetCookedTexturePath(const pathType& texturePath) const
+{
+	pathType cookedTexturePath(texturePath);
+	cookedTexturePath.replace_extension(DCore::CookedTexture2D::fileExtension);
+	return cookedTexturePath;
+}
+
+bool TextureManager::OpenCookedTexture(const pathType& texturePath, const pathType& cookedTexturePath, DCore::MappedFile& outCookedTexture) const
+{
+	DCore::MappedFile cookedTexture;
+	if (!cookedTexture.Open(cookedTexturePath) || !DCore::Texture2DAssetManager::IsCookedTexture2DValid(cookedTexture.GetData(), cookedTexture.GetSize()))
+	{
+		return false;
+	}
+	const DCore::CookedTexture2D::Header& header(*reinterpret_cast<const DCore::CookedTexture2D::Header*>(cookedTexture.GetData()));
+	TextureSourceInfo sourceInfo;
+	if (!GetTextureSourceInfo(texturePath, sourceInfo) || sourceInfo.Size != header.SourceSize)
+	{
+		return false;
+	}
+	if (sourceInfo.WriteTime != header.SourceWriteTime)
+	{
+		// The source may have been written without being changed.
+		uint64_t sourceHash(0);
+		if (!HashTextureSource(texturePath, sourceHash) || sourceHash != header.SourceHash)
+		{
+			return false;
+		}
+		std::fstream stream(cookedTexturePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+		stream.seekp(offsetof(DCore::CookedTexture2D::Header, SourceWriteTime));
+		stream.write(reinterpret_cast<const char*>(&sourceInfo.WriteTime), sizeof(sourceInfo.WriteTime));
+	}
+	outCookedTexture = std::move(cookedTexture);
+	return true;
+}
+
+bool TextureManager::CookTexture(const pathType& texturePath, const pathType& cookedTexturePath, const char** outFailureReason) const
+{
+	DCore::CookedTexture2D::Header header;
+	header.Magic = DCore::CookedTexture2D::magic;
+	header.Version = DCore::CookedTexture2D::version;
+	TextureSourceInfo sourceInfo;
+	if (!GetTextureSourceInfo(texturePath, sourceInfo) || !HashTextureSource(texturePath, header.SourceHash))
+	{
+		*outFailureReason = "Fail to read the texture.";
+		return false;
+	}
+	header.SourceSize = sourceInfo.Size;
+	header.SourceWriteTime = sourceInfo.WriteTime;
+	int width(0), height(0), numberOfChannels(0);
+	// The flip is set per thread, as other threads may be decoding with other settings.
+	stbi_set_flip_vertically_on_load_thread(true);
+	unsigned char* binary(stbi_load(texturePath.string().c_str(), &width, &height, &numberOfChannels, 0));
+	if (binary == nullptr)
+	{
+		*outFailureReason = stbi_failure_reason();
+		return false;
+	}
+	header.Width = static_cast<uint32_t>(width);
+	header.Height = static_cast<uint32_t>(height);
+	header.NumberOfChannels = static_cast<uint32_t>(numberOfChannels);
+	header.NumberOfMipLevels = 1;
+	while ((header.Width >> header.NumberOfMipLevels) > 0 || (header.Height >> header.NumberOfMipLevels) > 0)
+	{
+		header.NumberOfMipLevels++;
+	}
+	DASSERT_E(header.NumberOfMipLevels <= DCore::CookedTexture2D::maximumNumberOfMipLevels);
+	std::vector<DCore::CookedTexture2D::MipLevelEntry> mipLevelEntries(header.NumberOfMipLevels);
+	const uint64_t pixelsOffset(sizeof(DCore::CookedTexture2D::Header) + mipLevelEntries.size() * sizeof(DCore::CookedTexture2D::MipLevelEntry));
+	uint64_t pixelsSize(0);
+	for (uint32_t level(0); level < header.NumberOfMipLevels; level++)
+	{
+		DCore::CookedTexture2D::MipLevelEntry& mipLevelEntry(mipLevelEntries[level]);
+		mipLevelEntry.Width = std::max(header.Width >> level, 1u);
+		mipLevelEntry.Height = std::max(header.Height >> level, 1u);
+		mipLevelEntry.Offset = pixelsOffset + pixelsSize;
+		mipLevelEntry.Size = static_cast<uint64_t>(mipLevelEntry.Width) * mipLevelEntry.Height * header.NumberOfChannels;
+		pixelsSize += mipLevelEntry.Size;
+	}
+	std::vector<unsigned char> pixels(pixelsSize);
+	std::copy(binary, binary + mipLevelEntries[0].Size, pixels.begin());
+	stbi_image_free(binary);
+	for (uint32_t level(1); level < header.NumberOfMipLevels; level++)
+	{
+		const DCore::CookedTexture2D::MipLevelEntry& sourceEntry(mipLevelEntries[level - 1]);
+		const DCore::CookedTexture2D::MipLevelEntry& mipLevelEntry(mipLevelEntries[level]);
+		DownsampleMipLevel
+		(
+			pixels.data() + (sourceEntry.Offset - pixelsOffset), sourceEntry.Width, sourceEntry.Height,
+			pixels.data() + (mipLevelEntry.Offset - pixelsOffset), mipLevelEntry.Width, mipLevelEntry.Height,
+			header.NumberOfChannels
+		);
+	}
+	// Written aside and then renamed, so a cooked texture being mapped by another thread is never partially written.
+	pathType temporaryPath(cookedTexturePath);
+	temporaryPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream ostream(temporaryPath, std::ios_base::binary | std::ios_base::trunc);
+		ostream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		ostream.write(reinterpret_cast<const char*>(mipLevelEntries.data()), mipLevelEntries.size() * sizeof(DCore::CookedTexture2D::MipLevelEntry));
+		ostream.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+		ostream.close();
+		if (!ostream)
+		{
+			std::error_code errorCode;
+			std::filesystem::remove(temporaryPath, errorCode);
+			*outFailureReason = s_cookedTextureWriteFailure;
+			return false;
+		}
+	}
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryPath, cookedTexturePath, errorCode);
+	if (errorCode)
+	{
+		std::filesystem::remove(temporaryPath, errorCode);
+		*outFailureReason = s_cookedTextureWriteFailure;
+		return false;
+	}
+	return true;
+}
+
 void TextureManager::SaveTexturesMap() const
 {
 	std::ofstream ostream(GetTextureDirectoryPath() / s_texturesFileName);
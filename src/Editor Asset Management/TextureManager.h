@@ -4,7 +4,6 @@
 
 #include <filesystem>
 #include <functional>
-#include <unordered_set>
 
 
 namespace DEditor
@@ -24,11 +23,13 @@ class TextureManager
 public:
 	using uuidType = DCore::UUIDType;
 	using textureRefType = DCore::Texture2DRef;
-	using lockDataType = DCore::LockData;
 	using stringType = std::string;
 	using pathType = std::filesystem::path;
 	using textureIterationCallbackType = std::function<bool(const uuidType&, const stringType&)>;
-	using loadingTexturesSetType = std::unordered_set<uuidType>;
+	using cookedTextureIterationCallbackType = std::function<bool(const uuidType&, const stringType& textureName, const pathType& cookedTexturePath, DCore::Texture2DMetadata)>;
+	using loadingTexturesTableType = DCore::InFlightLoadTable<uuidType>;
+	using loadGuardType = loadingTexturesTableType::LoadGuard;
+	using loadFutureType = loadingTexturesTableType::futureType;
 public:
 	~TextureManager() = default;
 public:
@@ -39,7 +40,15 @@ public:
 	}
 public:
 	void ImportTexture(const pathType& outsidePath, const pathType& thumbnailDirectory);
+	// Cooks in parallel the textures whose cooked file is missing or stale, so they are not decoded when loaded.
+	void CookTextures();
 	[[nodiscard]] DCore::Texture2DRef LoadTexture2D(const DCore::UUIDType&);
+	// Maps the cooked files of the textures that are not loaded yet in parallel, cooking the stale ones, and queues
+	// their upload. The refs of the textures that fail to load are left invalid.
+	void LoadTextures2D(const uuidType* uuids, size_t numberOfTextures, textureRefType* outTextures);
+	// Cooks the texture whose source is at the path again and replaces it in place, if loaded. False if no texture
+	// has its source at the path.
+	bool ReloadTexture2D(const pathType& texturePath);
 	[[nodiscard]] DCore::Texture2D LoadRawTexture2D(const pathType&);
 	DCore::Texture2D LoadRawTexture2D(const pathType&, unsigned char** outBinary); 
 	TextureInfo GetTextureInfo(const pathType&);
@@ -47,14 +56,20 @@ public:
 	bool RenameTexture(const uuidType&, const stringType& newName);
 	void SaveTexture(textureRefType);
 	void IterateOnTextures(textureIterationCallbackType);
+	// The cooked files may be missing or stale, if the textures weren't cooked.
+	void IterateOnCookedTextures(cookedTextureIterationCallbackType);
 	bool TextureExists(const uuidType&);
 private:
 	TextureManager(); 
 private:
-	lockDataType m_lockData;
-	loadingTexturesSetType m_texturesLoading;
+	loadingTexturesTableType m_texturesLoading;
 private:
 	pathType GetTextureDirectoryPath() const;
+	pathType GetCookedTexturePath(const pathType& texturePath) const;
+	// Maps the cooked texture if it is well formed and was cooked from the current source.
+	bool OpenCookedTexture(const pathType& texturePath, const pathType& cookedTexturePath, DCore::MappedFile& outCookedTexture) const;
+	// Thread safe. Decodes the source and writes its pixels and mip levels to the cooked file.
+	bool CookTexture(const pathType& texturePath, const pathType& cookedTexturePath, const char** outFailureReason) const;
 	void SaveTexturesMap() const;
 	void CreateTextureThumbnail(const pathType& thumbnailPath, const DCore::DString&) const;
 	DCore::Texture2DMetadata GetTexture2DMetadata(const DCore::DString& uuidString);
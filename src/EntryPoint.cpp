@@ -2,6 +2,9 @@
 #include "ProgramContext.h"
 #include "Log.h"
 #include "GlobalConfigurationSerializer.h"
+#include "TextureManager.h"
+#include "AssetPackManager.h"
+#include "AssetWatcher.h"
 #include "Window.h"
 
 #include "DommusCore.h"
@@ -37,9 +40,15 @@ int main(int argc, char** argv)
 		return EXIT_FAILURE;
 	}
 #endif
-	DASSERT_E(argc == 3);
+	// The optional third argument is the path of an asset pack to load the assets from.
+	DASSERT_E(argc == 3 || argc == 4);
 	DEditor::ProgramContext::Get().SetProjectAssetsDirectoryPath(argv[1]);
 	DEditor::ProgramContext::Get().SetEditorAssetsDirectoryPath(argv[2]);
+	if (argc == 4 && !DEditor::AssetPackManager::Get().OpenAssetPack(argv[3]))
+	{
+		std::cout << "Fail to open asset pack at path: " << argv[3] << std::endl;
+		return EXIT_FAILURE;
+	}
 	DEditor::GlobalConfigurationSerializer::Get();
 	glfwSetErrorCallback(GLFWErrorCallback);
 	if (!glfwInit())
@@ -75,6 +84,8 @@ int main(int argc, char** argv)
 	DCore::Input::Get().SetUserCallback(ImGui_ImplGlfw_KeyCallback);
 	ImGuizmo::Enable(true);
 	//
+	// Before the panels load any texture, so the stale ones are cooked in parallel instead of one by one.
+	DEditor::TextureManager::Get().CookTextures();
 	while (!glfwWindowShouldClose(window))
 	{
 		//DCore::Timer<std::chrono::microseconds> timer("Main thread loop");
@@ -85,6 +96,12 @@ int main(int argc, char** argv)
         ImGui::NewFrame();
 		ImGuizmo::BeginFrame();
 		ImGui::DockSpaceOverViewport();
+		// Between frames, so no ref to an unloaded asset is in use.
+		DCore::AssetManager::Get().DestroyUnloadedAssets();
+		// Before the upload, so the textures reloaded are uploaded this frame.
+		DEditor::AssetWatcher::Get().ReloadChangedAssets();
+		// Before the panels render, so the textures uploaded this frame are already drawn.
+		DCore::AssetManager::Get().UploadPendingTextures2D();
 		DEditor::Panels::Get().RenderPanels();
 //	ImGui::ShowDemoWindow();
 		ImGui::Render();
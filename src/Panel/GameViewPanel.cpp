@@ -78,8 +78,13 @@ void GameViewPanel::Render()
 			SceneHierarchyPanel::Get().ClearEntitySelection();
 			DCore::AssetManager::Get().GetScenesInfo(m_scenes, m_loadedScenes);
 			DCore::ReadWriteLockGuard globalConfigGuard(DCore::LockType::ReadLock, DCore::GlobalConfig::Get());
-			DCore::SceneRef scene;
-			SceneManager::Get().LoadScene(DCore::GlobalConfig::Get().GetStartingSceneUUID(), &scene);
+			const DCore::UUIDType startingSceneUUID(DCore::GlobalConfig::Get().GetStartingSceneUUID());
+			// The starting scene is copied from the one opened in the editor, if it is, instead of loaded from its file.
+			DCore::SceneRef scene(DCore::AssetManager::Get().LoadSceneCopy(startingSceneUUID, m_scenes, m_loadedScenes));
+			if (!scene.IsValid())
+			{
+				SceneManager::Get().LoadScene(startingSceneUUID, &scene);
+			}
 			scene.LoadingCompleted();
 			m_runtime.Begin();
 			m_currentGameState = GameState::Playing;
@@ -98,7 +103,7 @@ void GameViewPanel::Render()
 			m_runtime.End();
 			DCore::AssetManager::Get().SetScenesInfo(std::move(m_scenes), std::move(m_loadedScenes));
 			m_scenes.Clear();
-			m_loadedScenes.clear();
+			m_loadedScenes.Clear();
 			SceneHierarchyPanel::Get().ClearEntitySelection();
 			m_currentGameState = GameState::NotPlaying;
 			break;
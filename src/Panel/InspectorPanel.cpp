@@ -904,8 +904,15 @@ bool InspectorPanel::DrawAnimationStateMachineField(const char* fieldName, coreA
 		if (payload != nullptr)
 		{
 			AnimationStateMachinePayload& animationStateMachinePayload(*static_cast<AnimationStateMachinePayload*>(payload->Data));
-			coreAnimationStateMachineType newAnimationStateMachine(std::move(AnimationStateMachineManager::Get().LoadAnimationStateMachine(animationStateMachinePayload.UUID, animationStateMachinePayload.Name.Data()).GetCoreAnimationStateMachine()));
-			out = DCore::AssetManager::Get().AddAnimationStateMachine(std::move(newAnimationStateMachine));
+			if (DCore::AssetManager::Get().IsAnimationStateMachineLoaded(animationStateMachinePayload.UUID))
+			{
+				out = DCore::AssetManager::Get().GetAnimationStateMachine(animationStateMachinePayload.UUID);
+			}
+			else
+			{
+				coreAnimationStateMachineType newAnimationStateMachine(std::move(AnimationStateMachineManager::Get().LoadAnimationStateMachine(animationStateMachinePayload.UUID, animationStateMachinePayload.Name.Data()).GetCoreAnimationStateMachine()));
+				out = DCore::AssetManager::Get().LoadAnimationStateMachine(animationStateMachinePayload.UUID, std::move(newAnimationStateMachine));
+			}
 			result = true;
 		}
 		ImGui::EndDragDropTarget();
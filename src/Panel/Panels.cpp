@@ -14,6 +14,7 @@
 #include "SpriteMaterialPanel.h"
 #include "TexturePanel.h"
 #include "SpriteSheetGenPanel.h"
+#include "ProfilingPanel.h"
 
 
 
@@ -31,6 +32,7 @@ void Panels::RenderPanels()
 	GameViewPanel::Get().Render();
 	ConfigurationPanel::Get().Render();
 	GameStatePanel::Get().Render();
+	ProfilingPanel::Get().Render();
 	AnimationPanel::RenderAnimationPanels();
 	AnimationStateMachinePanel::RenderPanels();
 	PhysicsMaterialPanel::RenderPanels();
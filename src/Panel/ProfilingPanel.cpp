@@ -0,0 +1,60 @@
+#include "ProfilingPanel.h"
+
+#include "imgui.h"
+
+#include <cinttypes>
+#include <string>
+
+
+
+namespace DEditor
+{
+
+ProfilingPanel::ProfilingPanel()
+	:
+	m_isOpened(false)
+{}
+
+void ProfilingPanel::Render()
+{
+	if (!m_isOpened)
+	{
+		return;
+	}
+	if (!ImGui::Begin("Profiling", &m_isOpened))
+	{
+		ImGui::End();
+		return;
+	}
+	if (ImGui::BeginTable("Profiling Counters", 2, ImGuiTableFlags_RowBg))
+	{
+		// The counters are iterated in name order, so the ones of a group are next to each other.
+		std::string currentGroup;
+		DCore::ProfilingStats::Get().IterateOnCounters
+		(
+			[&](const std::string& name, int64_t value) -> bool
+			{
+				const size_t groupEnd(name.rfind('/'));
+				const std::string group(groupEnd == std::string::npos ? std::string() : name.substr(0, groupEnd));
+				if (group != currentGroup)
+				{
+					currentGroup = group;
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextDisabled("%s", currentGroup.c_str());
+					ImGui::TableNextColumn();
+				}
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", groupEnd == std::string::npos ? name.c_str() : name.c_str() + groupEnd + 1);
+				ImGui::TableNextColumn();
+				ImGui::Text("%" PRId64, value);
+				return false;
+			}
+		);
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+}
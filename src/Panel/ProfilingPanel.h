@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Panel.h"
+
+#include "DommusCore.h"
+
+
+
+namespace DEditor
+{
+
+// Shows the counters of DCore::ProfilingStats, grouped by the prefix of their names (e.g. "Physics/Body Pool").
+class ProfilingPanel : public Panel
+{
+public:
+	ProfilingPanel(const ProfilingPanel&) = delete;
+	ProfilingPanel(ProfilingPanel&&) = delete;
+	~ProfilingPanel() = default;
+public:
+	static ProfilingPanel& Get()
+	{
+		static ProfilingPanel profilingPanel;
+		return profilingPanel;
+	}
+public:
+	void Render();
+public:
+	void Open()
+	{
+		m_isOpened = true;
+	}
+private:
+	ProfilingPanel();
+private:
+	bool m_isOpened;
+};
+
+}
@@ -86,6 +86,7 @@ ResourcesPanel::ResourceItem::ResourceItem(ResourceItem&& other) noexcept
 	m_name(other.m_name),
 	m_uuid(other.m_uuid),
 	m_thumbnailTextureId(other.m_thumbnailTextureId),
+	m_thumbnailTexture2D(other.m_thumbnailTexture2D),
 	OnClick(other.OnClick),
 	OnDoubleClick(other.OnDoubleClick),
 	OnRightClick(other.OnRightClick),
@@ -102,6 +103,7 @@ ResourcesPanel::ResourceItem& ResourcesPanel::ResourceItem::operator=(ResourceIt
 	m_name = other.m_name;
 	m_uuid = other.m_uuid;
 	m_thumbnailTextureId = other.m_thumbnailTextureId;
+	m_thumbnailTexture2D = other.m_thumbnailTexture2D;
 	OnClick = other.OnClick;
 	OnDoubleClick = other.OnDoubleClick;
 	OnRightClick = other.OnRightClick;
@@ -414,13 +416,14 @@ void ResourcesPanel::ProbeCurrentDirectory()
 					texture2DId,
 					dirEntry.path().filename().stem().string(),
 					uuid,
-					TextureManager::Get().LoadTexture2D(uuid).GetId(),		// Texture 2D "leak".
+					0,
 					&ResourcesPanel::OnTexture2DClick,
 					&ResourcesPanel::OnTexture2DDoubleClick,
 					&ResourcesPanel::OnTexture2DRightClick,
 					&ResourcesPanel::OnRenderTexture2D
 				)
 			);
+			m_resourceItems.back().SetThumbnailTexture2D(TextureManager::Get().LoadTexture2D(uuid));		// Texture 2D "leak".
 			continue;
 		}
 		if (extension == ".dtsprmat")
@@ -1204,7 +1207,8 @@ private:
 			{
 				static_cast<%s*>(componentAddress)->~%s();
 			},
-			&m_defaultArgs
+			&m_defaultArgs,
+			DCore::OverridesOnAnimationEvent<%s>()
 		)
 	{}
 private:
@@ -1235,6 +1239,7 @@ private:
 			name.c_str(),
 			name.c_str(),
 			name.c_str(),
+			name.c_str(),
 			name.c_str());	
 	ofstream << script;
 	DASSERT_E(ofstream);
@@ -74,9 +74,16 @@ private:
 			return m_uuid;
 		}
 
+		// The GL texture of a texture thumbnail is created after the item, so its id is taken from the texture
+		// when rendering.
 		DCore::DUInt GetThumbnailTextureId() const
 		{
-			return m_thumbnailTextureId;
+			return m_thumbnailTexture2D.IsValid() ? m_thumbnailTexture2D.GetId() : m_thumbnailTextureId;
+		}
+
+		void SetThumbnailTexture2D(DCore::Texture2DRef texture2D)
+		{
+			m_thumbnailTexture2D = texture2D;
 		}
 
 	public:
@@ -86,6 +93,7 @@ private:
 		DCore::DString m_name;
 		DCore::UUIDType m_uuid;
 		DCore::DUInt m_thumbnailTextureId;
+		DCore::Texture2DRef m_thumbnailTexture2D;
 	};
 private:
 	static ResourcesPanel& Get()
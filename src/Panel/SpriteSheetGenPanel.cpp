@@ -601,6 +601,8 @@ void SpriteSheetGenPanel::SubmitEntity(entityType entity, registryType& registry
 		if (spriteComponent->GetSpriteMaterial().GetDiffuseMapRef().IsValid())
 		{
 			diffuseTextureId = spriteComponent->GetSpriteMaterial().GetDiffuseMapRef().GetId();
+			// Textures waiting for their upload have no id yet.
+			toUseDiffuseTexture = diffuseTextureId != 0;
 		}
 		else
 		{
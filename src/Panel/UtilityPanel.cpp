@@ -9,7 +9,9 @@
 #include "GameViewPanel.h"
 #include "ConfigurationPanel.h"
 #include "SceneManager.h"
+#include "AssetPackManager.h"
 #include "GameStatePanel.h"
+#include "ProfilingPanel.h"
 #include "Log.h"
 
 #include "imgui.h"
@@ -39,6 +41,30 @@ void UtilityPanel::Render()
 					Log::Get().ConsoleLog(LogLevel::Error, "%s", "Cannot save scenes while the game is playing.");
 				}
 			}
+			if (ImGui::MenuItem("Build Asset Pack", nullptr, false, AssetPackManager::Get().GetAssetPack() == nullptr))
+			{
+				if (GameStatePanel::Get().GetGameState() == GameState::NotPlaying)
+				{
+					// Saved first, so the open scenes are cooked as they are.
+					SceneManager::Get().SaveLoadedScenes();
+					const std::filesystem::path packPath(AssetPackManager::Get().GetAssetPackPath());
+					DCore::ReturnError error(AssetPackManager::Get().BuildAssetPack(packPath));
+					if (error.Ok)
+					{
+						Log::Get().ConsoleLog(LogLevel::Default, "Asset pack written to: %s", packPath.string().c_str());
+					}
+					else
+					{
+						Log::Get().TerminalLog(error.Message);
+						Log::Get().ConsoleLog(LogLevel::Error, "%s", error.Message.Data());
+					}
+				}
+				else
+				{
+					Log::Get().TerminalLog("%s", "Cannot build the asset pack while the game is playing.");
+					Log::Get().ConsoleLog(LogLevel::Error, "%s", "Cannot build the asset pack while the game is playing.");
+				}
+			}
 			if (ImGui::MenuItem("Configuration"))
 			{
 				ConfigurationPanel::Get().Open();
@@ -67,6 +93,10 @@ void UtilityPanel::Render()
 			{
 				GameViewPanel::Get().Open();
 			}
+			if (ImGui::MenuItem("Profiling"))
+			{
+				ProfilingPanel::Get().Open();
+			}
 			if (ImGui::BeginMenu("Viewports"))
 			{
 				for (size_t i(0); i < EditorGameViewPanels::numberOfPanels; i++)
@@ -10,12 +10,19 @@
 #include "yaml-cpp/yaml.h"
 #include "glm/gtc/integer.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 
 
@@ -24,12 +31,10 @@ namespace DEditor
 
 SceneSerialization::returnErrorType SceneSerialization::DeserializeScene(const pathType& scenePath, sceneRefType sceneRef)
 {
-	using entityRefType = DCore::EntityRef;
 	using componentFormType = DCore::ComponentForm;
-	using uuidComponentType = DCore::UUIDComponent;
 	using attributeNameType = DCore::AttributeName;
-	using componentFormType = DCore::ComponentForm;
 	using attributeType = DCore::AttributeType;
+	using componentIdContainerType = std::vector<DCore::ComponentIdType>;
 	using nodeType = YAML::Node;
  	nodeType root;
 	try 
@@ -51,16 +56,22 @@ SceneSerialization::returnErrorType SceneSerialization::DeserializeScene(const p
 		returnError.Message.Append("Bad scene file: ").Append(scenePath.string().c_str()).Append(".");
 		return returnError;
 	}
-	sceneRef.SetName(sceneNameNode.as<std::string>().c_str());
-	// Create the entities with the UUID Component only.
-	entityRefType* entities(new entityRefType[entitiesNode.size()]);
-	const componentFormType& uuidComponentForm(DCore::ComponentForms::Get()[DCore::ComponentId::GetId<uuidComponentType>()]);
-	for (size_t index(0); index < entitiesNode.size(); index++)
-	{
-		nodeType uuidNode(entitiesNode[index][uuidComponentForm.Name]);
-		const auto& uuidComponentAttribute(uuidComponentForm.SerializedAttributes[0]);
-		const attributeNameType& attributeName(uuidComponentAttribute.GetAttributeName());
-		nodeType uuidAttributeNode(uuidNode[attributeName.GetName().c_str()]);
+	// Per entity buffers of the load. Reused by the next load in the same thread.
+	static thread_local DCore::ScratchArena scratchArena;
+	scratchArena.Reset();
+	const size_t numberOfEntities(entitiesNode.size());
+	// Group the entities by their components before creating them, so each entity is created in its final archetype
+	// with the others of the archetype. The components are sorted, so the same components in another order are the
+	// same archetype.
+	const componentFormType& uuidComponentForm(DCore::ComponentForms::Get()[DCore::ComponentId::GetId<DCore::UUIDComponent>()]);
+	const stringType& uuidAttributeName(uuidComponentForm.SerializedAttributes[0].GetAttributeName().GetName());
+	std::map<componentIdContainerType, std::vector<size_t>> archetypes;
+	std::unordered_map<stringType, size_t> entityIndexes;
+	componentIdContainerType componentIds;
+	for (size_t entityIndex(0); entityIndex < numberOfEntities; entityIndex++)
+	{
+		nodeType entityNode(entitiesNode[entityIndex]);
+		nodeType uuidAttributeNode(entityNode[uuidComponentForm.Name][uuidAttributeName]);
 		if (!uuidAttributeNode)
 		{
 			returnErrorType returnError;
@@ -68,21 +79,11 @@ SceneSerialization::returnErrorType SceneSerialization::DeserializeScene(const p
 			returnError.Message.Append("Fail to deserialize uuid component in scene in the path: ").Append(scenePath.string().c_str()).Append(".");
 			return returnError;
 		}
-		DCore::ConstructorArgs<DCore::UUIDComponent> args{uuidNode[attributeName.GetName()].as<std::string>()};
-		new (&entities[index]) entityRefType(sceneRef.CreateEntity<DCore::UUIDComponent>(std::make_tuple(args)), sceneRef);
-	}
-	size_t entityIndex(0);
-	for (YAML::const_iterator entityIt(entitiesNode.begin()); entityIt != entitiesNode.end(); entityIt++)
-	{
-		size_t totalSerializedSize(0);
-		size_t componentIndex(0);
-		const size_t numberOfComponents(entityIt->size());
-		// Recall that uuidComponent must not be included in componentIds and componentSizes.
-		DCore::ComponentIdType* componentIds(static_cast<DCore::ComponentIdType*>(new DCore::ComponentIdType[numberOfComponents - 1]));
-		size_t* componentSizes(static_cast<size_t*>(new size_t[numberOfComponents - 1]));
-		for (YAML::const_iterator componentIt(entityIt->begin()); componentIt != entityIt->end(); componentIt++)
+		entityIndexes.insert({uuidAttributeNode.as<stringType>(), entityIndex});
+		componentIds.clear();
+		for (YAML::const_iterator componentIt(entityNode.begin()); componentIt != entityNode.end(); componentIt++)
 		{
-			const stringType componentName(componentIt->first.as<std::string>());
+			const stringType componentName(componentIt->first.as<stringType>());
 			const componentFormType* componentForm(DCore::ComponentForms::Get().GetComponentFormWithName(componentName));
 			if (componentForm == nullptr)
 			{
@@ -91,342 +92,269 @@ SceneSerialization::returnErrorType SceneSerialization::DeserializeScene(const p
 				returnError.Message.Append("Fail to deserialize component with name ").Append(componentName.c_str()).Append(" in scene file: ").Append(scenePath.string().c_str()).Append(".");
 				return returnError;
 			}
-			if (*componentForm == uuidComponentForm)
-			{
-				continue;
-			}
-			totalSerializedSize += componentForm->SerializedSize;
-			componentIds[componentIndex] = componentForm->Id;
-			componentSizes[componentIndex] = componentForm->TotalSize;
-			componentIndex++;
+			componentIds.push_back(componentForm->Id);
 		}
-		componentIndex = 0;
-		size_t argsBufferOffset(0);
-		size_t componentFormRefsOffset(0);
-		char* argsBuffer(new char[totalSerializedSize]);
-		for (YAML::const_iterator componentIt(entityIt->begin()); componentIt != entityIt->end(); componentIt++)
+		std::sort(componentIds.begin(), componentIds.end());
+		archetypes[componentIds].push_back(entityIndex);
+	}
+	sceneRef.SetName(sceneNameNode.as<std::string>().c_str());
+	std::vector<DCore::Entity> entities(numberOfEntities);
+	std::vector<DCore::Entity> archetypeEntities;
+	entityReferenceFixupContainerType entityReferenceFixups;
+	for (const auto& archetype : archetypes)
+	{
+		const componentIdContainerType& archetypeComponentIds(archetype.first);
+		const std::vector<size_t>& archetypeEntityIndexes(archetype.second);
+		const size_t numberOfComponents(archetypeComponentIds.size());
+		size_t* componentSizes(scratchArena.Allocate<size_t>(numberOfComponents));
+		size_t* componentArgumentsOffsets(scratchArena.Allocate<size_t>(numberOfComponents));
+		size_t entityArgumentsSize(0);
+		for (size_t componentIndex(0); componentIndex < numberOfComponents; componentIndex++)
 		{
-			if (componentIt->first.as<stringType>() == DCore::ComponentForms::Get()[DCore::ComponentId::GetId<DCore::UUIDComponent>()].Name)
-			{
-				continue;
-			}
-			size_t componentArgsOffset(argsBufferOffset);
-			nodeType attributeMap(componentIt->second);
-			const componentFormType& componentForm(DCore::ComponentForms::Get()[componentIds[componentIndex++]]);
-			for (const auto& attributeInfo : componentForm.SerializedAttributes)
+			const componentFormType& componentForm(DCore::ComponentForms::Get()[archetypeComponentIds[componentIndex]]);
+			componentSizes[componentIndex] = componentForm.TotalSize;
+			componentArgumentsOffsets[componentIndex] = entityArgumentsSize;
+			entityArgumentsSize += componentForm.SerializedSize;
+		}
+		char* archetypeArgsBuffer(static_cast<char*>(scratchArena.Allocate(entityArgumentsSize * archetypeEntityIndexes.size())));
+		for (size_t archetypeEntityIndex(0); archetypeEntityIndex < archetypeEntityIndexes.size(); archetypeEntityIndex++)
+		{
+			const size_t entityIndex(archetypeEntityIndexes[archetypeEntityIndex]);
+			nodeType entityNode(entitiesNode[entityIndex]);
+			char* argsBuffer(archetypeArgsBuffer + archetypeEntityIndex * entityArgumentsSize);
+			for (YAML::const_iterator componentIt(entityNode.begin()); componentIt != entityNode.end(); componentIt++)
 			{
-				const attributeNameType& attributeName(attributeInfo.GetAttributeName());
-				const attributeType attributeType(attributeInfo.GetAttributeType());
-				if (!attributeMap[attributeName.GetName().c_str()])
-				{
-					continue;
-				}
-				switch (attributeType) 
-				{
-				case attributeType::Integer:
-				{
-					*((DCore::DInt*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DInt>();
-					argsBufferOffset += sizeof(DCore::DInt);
-					break;
-				}
-				case attributeType::UInteger:	
-				{
-					*((DCore::DUInt*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DUInt>();
-					argsBufferOffset += sizeof(DCore::DUInt);
-					break;
-				}
-				case attributeType::Float:
-				{
-					*((DCore::DFloat*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DFloat>();
-					argsBufferOffset += sizeof(DCore::DFloat);
-					break;
-				}
-				case attributeType::Size:
+				nodeType attributeMap(componentIt->second);
+				const componentFormType& componentForm(*DCore::ComponentForms::Get().GetComponentFormWithName(componentIt->first.as<stringType>()));
+				const size_t componentIndex(std::lower_bound(archetypeComponentIds.begin(), archetypeComponentIds.end(), componentForm.Id) - archetypeComponentIds.begin());
+				size_t argsBufferOffset(componentArgumentsOffsets[componentIndex]);
+				for (const auto& attributeInfo : componentForm.SerializedAttributes)
 				{
-					*((DCore::DSize*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DSize>();
-					argsBufferOffset += sizeof(DCore::DSize);
-					break;
-				}
-				case attributeType::Logic:
-				{
-					*((DCore::DLogic*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DLogic>();
-					argsBufferOffset += sizeof(DCore::DLogic);
-					break;
-				}
-				case attributeType::Vector2:
-				{
-					YAML::Node vector2Node(attributeMap[attributeName.GetName().c_str()]);
-					DCore::DVec2 vec2(vector2Node[0].as<float>(), vector2Node[1].as<float>());
-					*((DCore::DVec2*)&argsBuffer[argsBufferOffset]) = vec2;
-					argsBufferOffset += sizeof(DCore::DVec2);
-					break;
-				}
-				case attributeType::UIVector2:
-				{
-					YAML::Node vector2Node(attributeMap[attributeName.GetName().c_str()]);
-					DCore::DVec2 vec2(vector2Node[0].as<float>(), vector2Node[1].as<float>());
-					*((DCore::DVec2*)&argsBuffer[argsBufferOffset]) = vec2;
-					argsBufferOffset += sizeof(DCore::DVec2);
-					break;
-				}
-				case attributeType::Vector3:
-				{
-					YAML::Node vector3Node(attributeMap[attributeName.GetName().c_str()]);
-					DCore::DVec3 vec3(vector3Node[0].as<float>(), vector3Node[1].as<float>(), vector3Node[2].as<float>());
-					*((DCore::DVec3*)&argsBuffer[argsBufferOffset]) = vec3;
-					argsBufferOffset += sizeof(DCore::DVec3);
-					break;
-				}
-				case attributeType::String:
-				{
-					std::strcpy(&argsBuffer[argsBufferOffset], attributeMap[attributeName.GetName().c_str()].as<std::string>().c_str());
-					argsBufferOffset += sizeof(DCore::DString); 
-					break;
-				}
-				case attributeType::EntityReference:
-				{
-					std::string uuidString(attributeMap[attributeName.GetName().c_str()].as<std::string>());
-					if (uuidString.empty())
+					const attributeNameType& attributeName(attributeInfo.GetAttributeName());
+					const attributeType attributeType(attributeInfo.GetAttributeType());
+					if (!attributeMap[attributeName.GetName().c_str()])
 					{
-						new (&argsBuffer[argsBufferOffset]) DCore::EntityRef();;
+						continue;
 					}
-					DCore::UUIDType uuid(uuidString);
-					DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *sceneRef.GetLockData());
-					sceneRef.Iterate<DCore::UUIDComponent>
-					(
-						[&](DCore::Entity entity, DCore::ComponentRef<DCore::UUIDComponent> uuidComponent) -> bool
-						{
-							DCore::UUIDType entityUUID;
-							uuidComponent.GetUUID(entityUUID);
-							if (entityUUID != uuid)
-							{
-								return false;
-							}
-							new (&argsBuffer[argsBufferOffset]) DCore::EntityRef(entity, sceneRef);
-							return true;
-						}
-					);
-					argsBufferOffset += sizeof(DCore::EntityRef);
-					break;
-				}
-				case attributeType::SpriteMaterial:
-				{
-					const stringType spriteMaterialUUIDString(attributeMap[attributeName.GetName().c_str()].as<std::string>());
-					DCore::SpriteMaterialRef spriteMaterialRef;
-					if (!spriteMaterialUUIDString.empty())
+					switch (attributeType) 
+					{
+					case attributeType::Integer:
 					{
-						spriteMaterialRef = MaterialManager::Get().LoadSpriteMaterial(DCore::UUIDType(spriteMaterialUUIDString));
+						*((DCore::DInt*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DInt>();
+						argsBufferOffset += sizeof(DCore::DInt);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) DCore::SpriteMaterialRef(spriteMaterialRef);
-					argsBufferOffset += sizeof(DCore::SpriteMaterialRef);
-					break;
-				}
-				case attributeType::TaggedList:
-				{
-					const stringType tagName(attributeMap[attributeName.GetName().c_str()].as<stringType>());
-					size_t tagIndex(0);
-					for (size_t index(0); index < attributeName.GetNumberOfComponents(); index++)
+					case attributeType::UInteger:	
 					{
-						if (tagName == attributeName.GetComponentAtIndex(index))
-						{
-							tagIndex = index;
-							break;
-						}
+						*((DCore::DUInt*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DUInt>();
+						argsBufferOffset += sizeof(DCore::DUInt);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) size_t(tagIndex);
-					argsBufferOffset += sizeof(size_t);
-					break;
-				}
-				case attributeType::Color:
-				{
-					YAML::Node colorNode(attributeMap[attributeName.GetName().c_str()]);
-					DCore::DVec4 vec4(colorNode[0].as<float>(), colorNode[1].as<float>(), colorNode[2].as<float>(), colorNode[3].as<float>());
-					new (&argsBuffer[argsBufferOffset]) DCore::DVec4(vec4);
-					argsBufferOffset += sizeof(DCore::DVec4);
-					break;
-				}
-				case attributeType::AnimationStateMachine:
-				{
-					using coreAnimationStateMachineType = DCore::AnimationStateMachine;
-					using coreAnimationStateMachineRefType = DCore::AnimationStateMachineRef;
-					const stringType animationStateMachineUUIDString(attributeMap[attributeName.GetName().c_str()].as<stringType>());
-					coreAnimationStateMachineRefType animationStateMachineRef;
-					if (!animationStateMachineUUIDString.empty())
-					{
-						const uuidType animationStateMachineUUID(animationStateMachineUUIDString);
-						const stringType animationStateMachineName(AnimationStateMachineManager::Get().GetAnimationStateMachineName(animationStateMachineUUID));
-						coreAnimationStateMachineType animationStateMachine(std::move(AnimationStateMachineManager::Get().LoadAnimationStateMachine(animationStateMachineUUID, animationStateMachineName).GetCoreAnimationStateMachine()));
-						animationStateMachineRef = DCore::AssetManager::Get().AddAnimationStateMachine(std::move(animationStateMachine));
-						DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationStateMachineAssetManager*>(&DCore::AssetManager::Get()));
-						DASSERT_E(animationStateMachineRef.IsValid());
-						animationStateMachineRef.AttachTo(entities[entityIndex]);
+					case attributeType::Float:
+					{
+						*((DCore::DFloat*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DFloat>();
+						argsBufferOffset += sizeof(DCore::DFloat);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) coreAnimationStateMachineRefType(animationStateMachineRef);
-					argsBufferOffset += sizeof(coreAnimationStateMachineRefType);
-					break;
-				}
-				case attributeType::PhysicsBodyType:
-				{
-					const stringType bodyTypeName(attributeMap[attributeName.GetName()].as<stringType>());
-					DCore::DBodyType bodyType;
-					if (bodyTypeName == "Static")
+					case attributeType::Size:
 					{
-						bodyType = DCore::DBodyType::Static;
+						*((DCore::DSize*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DSize>();
+						argsBufferOffset += sizeof(DCore::DSize);
+						break;
 					}
-					else if (bodyTypeName == "Kinematic")
+					case attributeType::Logic:
 					{
-						bodyType = DCore::DBodyType::Kinematic;
+						*((DCore::DLogic*)&argsBuffer[argsBufferOffset]) = attributeMap[attributeName.GetName().c_str()].as<DCore::DLogic>();
+						argsBufferOffset += sizeof(DCore::DLogic);
+						break;
 					}
-					else if (bodyTypeName == "Dynamic")
+					case attributeType::Vector2:
 					{
-						bodyType = DCore::DBodyType::Dynamic;
+						YAML::Node vector2Node(attributeMap[attributeName.GetName().c_str()]);
+						DCore::DVec2 vec2(vector2Node[0].as<float>(), vector2Node[1].as<float>());
+						*((DCore::DVec2*)&argsBuffer[argsBufferOffset]) = vec2;
+						argsBufferOffset += sizeof(DCore::DVec2);
+						break;
 					}
-					else
+					case attributeType::UIVector2:
 					{
-						DASSERT_E(false);
+						YAML::Node vector2Node(attributeMap[attributeName.GetName().c_str()]);
+						DCore::DVec2 vec2(vector2Node[0].as<float>(), vector2Node[1].as<float>());
+						*((DCore::DVec2*)&argsBuffer[argsBufferOffset]) = vec2;
+						argsBufferOffset += sizeof(DCore::DVec2);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) DCore::DBodyType(bodyType);
-					argsBufferOffset += sizeof(DCore::DBodyType);
-					break;
-				}
-				case attributeType::PhysicsMaterial:
-				{
-					using physicsMaterialRefType = DCore::PhysicsMaterialRef;
-					const stringType physicsMaterialUUIDString(attributeMap[attributeName.GetName().c_str()].as<stringType>());
-					physicsMaterialRefType physicsMaterial;
-					if (!physicsMaterialUUIDString.empty())
+					case attributeType::Vector3:
 					{
-						const uuidType physicsMaterialUUID(attributeMap[attributeName.GetName().c_str()].as<stringType>());
-						physicsMaterial = PhysicsMaterialManager::Get().LoadPhysicsMaterial(physicsMaterialUUID);
+						YAML::Node vector3Node(attributeMap[attributeName.GetName().c_str()]);
+						DCore::DVec3 vec3(vector3Node[0].as<float>(), vector3Node[1].as<float>(), vector3Node[2].as<float>());
+						*((DCore::DVec3*)&argsBuffer[argsBufferOffset]) = vec3;
+						argsBufferOffset += sizeof(DCore::DVec3);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) physicsMaterialRefType(physicsMaterial);
-					argsBufferOffset += sizeof(physicsMaterialRefType);
-					break;	
-				}
-				case attributeType::PhysicsLayer:
-				{
-					using physicsLayerType = DCore::Physics::PhysicsLayer;
-					const std::string physicsLayerTypeName(attributeMap[attributeName.GetName().c_str()].as<stringType>());
-					physicsLayerType physicsLayer;
-					for (size_t i(0); i < DCore::Physics::numberOfPhysicsLayers; i++)
+					case attributeType::String:
+					{
+						std::strcpy(&argsBuffer[argsBufferOffset], attributeMap[attributeName.GetName().c_str()].as<std::string>().c_str());
+						argsBufferOffset += sizeof(DCore::DString); 
+						break;
+					}
+					case attributeType::UUID:
+					{
+						new (&argsBuffer[argsBufferOffset]) uuidType(attributeMap[attributeName.GetName().c_str()].as<stringType>());
+						argsBufferOffset += sizeof(uuidType);
+						break;
+					}
+					case attributeType::EntityReference:
 					{
-						if (std::strcmp(physicsLayerTypeName.c_str(), TypeNames::physicsLayerNames[i]) == 0)
+						// Set after all the entities exist, since it can refer to an entity of an archetype created later.
+						new (&argsBuffer[argsBufferOffset]) DCore::EntityRef();
+						auto it(entityIndexes.find(attributeMap[attributeName.GetName().c_str()].as<stringType>()));
+						if (it != entityIndexes.end())
 						{
-							physicsLayer = static_cast<physicsLayerType>(i == 0 ? 0 : 1<<(i-1));
-							break;
+							entityReferenceFixups.push_back({entityIndex, componentForm.Id, attributeInfo.GetAttributeId(), it->second});
 						}
+						argsBufferOffset += sizeof(DCore::EntityRef);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) physicsLayerType(physicsLayer);
-					argsBufferOffset += sizeof(physicsLayerType);
-					break;
-				}
-				case attributeType::PhysicsLayers:
-				{
-					using physicsLayerType = DCore::Physics::PhysicsLayer;
-					physicsLayerType physicsLayers(static_cast<physicsLayerType>(0));
-					YAML::Node physicsLayersNode(attributeMap[attributeName.GetName()]);
-					for (YAML::const_iterator it(physicsLayersNode.begin()); it != physicsLayersNode.end(); it++)
+					case attributeType::SpriteMaterial:
 					{
-						const stringType physicsLayerName(it->as<stringType>());
-						for (size_t i(0); i < DCore::Physics::numberOfPhysicsLayers - 1; i++)
+						const DCore::SpriteMaterialRef spriteMaterialRef(LoadSpriteMaterial(attributeMap[attributeName.GetName().c_str()].as<std::string>()));
+						new (&argsBuffer[argsBufferOffset]) DCore::SpriteMaterialRef(spriteMaterialRef);
+						argsBufferOffset += sizeof(DCore::SpriteMaterialRef);
+						break;
+					}
+					case attributeType::TaggedList:
+					{
+						const stringType tagName(attributeMap[attributeName.GetName().c_str()].as<stringType>());
+						size_t tagIndex(0);
+						for (size_t index(0); index < attributeName.GetNumberOfComponents(); index++)
 						{
-							if (std::strcmp(physicsLayerName.c_str(), TypeNames::physicsLayerNames[i + 1]) == 0)
+							if (tagName == attributeName.GetComponentAtIndex(index))
 							{
-								physicsLayers = static_cast<physicsLayerType>(static_cast<uint64_t>(physicsLayers) | static_cast<uint64_t>(1)<<i);
+								tagIndex = index;
+								break;
 							}
 						}
+						new (&argsBuffer[argsBufferOffset]) size_t(tagIndex);
+						argsBufferOffset += sizeof(size_t);
+						break;
 					}
-					new (&argsBuffer[argsBufferOffset]) physicsLayerType(physicsLayers);
-					argsBufferOffset += sizeof(physicsLayerType);
-					break;
-				}
-				case attributeType::SoundEventInstance:
-				{
-					const std::string eventPath(attributeMap[attributeName.GetName()].as<stringType>());
-					DCore::SoundEventInstance eventInstance(eventPath);
-					DCore::Sound::Get().IterateOnLoadedBanks
-					(
-						[&](DCore::Sound::bankType* bank) -> bool
+					case attributeType::Color:
+					{
+						YAML::Node colorNode(attributeMap[attributeName.GetName().c_str()]);
+						DCore::DVec4 vec4(colorNode[0].as<float>(), colorNode[1].as<float>(), colorNode[2].as<float>(), colorNode[3].as<float>());
+						new (&argsBuffer[argsBufferOffset]) DCore::DVec4(vec4);
+						argsBufferOffset += sizeof(DCore::DVec4);
+						break;
+					}
+					case attributeType::AnimationStateMachine:
+					{
+						using coreAnimationStateMachineRefType = DCore::AnimationStateMachineRef;
+						const coreAnimationStateMachineRefType animationStateMachineRef(LoadAnimationStateMachine(attributeMap[attributeName.GetName().c_str()].as<stringType>()));
+						new (&argsBuffer[argsBufferOffset]) coreAnimationStateMachineRefType(animationStateMachineRef);
+						argsBufferOffset += sizeof(coreAnimationStateMachineRefType);
+						break;
+					}
+					case attributeType::PhysicsBodyType:
+					{
+						const stringType bodyTypeName(attributeMap[attributeName.GetName()].as<stringType>());
+						DCore::DBodyType bodyType;
+						if (bodyTypeName == "Static")
+						{
+							bodyType = DCore::DBodyType::Static;
+						}
+						else if (bodyTypeName == "Kinematic")
+						{
+							bodyType = DCore::DBodyType::Kinematic;
+						}
+						else if (bodyTypeName == "Dynamic")
+						{
+							bodyType = DCore::DBodyType::Dynamic;
+						}
+						else
 						{
-							int count(0);
-							FMOD_RESULT result(bank->getEventCount(&count));
-							DASSERT_E(result == FMOD_OK);
-							if (count == 0)
+							DASSERT_E(false);
+						}
+						new (&argsBuffer[argsBufferOffset]) DCore::DBodyType(bodyType);
+						argsBufferOffset += sizeof(DCore::DBodyType);
+						break;
+					}
+					case attributeType::PhysicsMaterial:
+					{
+						using physicsMaterialRefType = DCore::PhysicsMaterialRef;
+						const physicsMaterialRefType physicsMaterial(LoadPhysicsMaterial(attributeMap[attributeName.GetName().c_str()].as<stringType>()));
+						new (&argsBuffer[argsBufferOffset]) physicsMaterialRefType(physicsMaterial);
+						argsBufferOffset += sizeof(physicsMaterialRefType);
+						break;	
+					}
+					case attributeType::PhysicsLayer:
+					{
+						using physicsLayerType = DCore::Physics::PhysicsLayer;
+						const std::string physicsLayerTypeName(attributeMap[attributeName.GetName().c_str()].as<stringType>());
+						physicsLayerType physicsLayer;
+						for (size_t i(0); i < DCore::Physics::numberOfPhysicsLayers; i++)
+						{
+							if (std::strcmp(physicsLayerTypeName.c_str(), TypeNames::physicsLayerNames[i]) == 0)
 							{
-								return false;
+								physicsLayer = static_cast<physicsLayerType>(i == 0 ? 0 : 1<<(i-1));
+								break;
 							}
-							FMOD::Studio::EventDescription** eventDescriptions(static_cast<FMOD::Studio::EventDescription**>(malloc(count * sizeof(char*))));
-							result = bank->getEventList(eventDescriptions, count, nullptr);
-							DASSERT_E(result == FMOD_OK);
-							for (size_t i(0); i < count; i++)
+						}
+						new (&argsBuffer[argsBufferOffset]) physicsLayerType(physicsLayer);
+						argsBufferOffset += sizeof(physicsLayerType);
+						break;
+					}
+					case attributeType::PhysicsLayers:
+					{
+						using physicsLayerType = DCore::Physics::PhysicsLayer;
+						physicsLayerType physicsLayers(static_cast<physicsLayerType>(0));
+						YAML::Node physicsLayersNode(attributeMap[attributeName.GetName()]);
+						for (YAML::const_iterator it(physicsLayersNode.begin()); it != physicsLayersNode.end(); it++)
+						{
+							const stringType physicsLayerName(it->as<stringType>());
+							for (size_t i(0); i < DCore::Physics::numberOfPhysicsLayers - 1; i++)
 							{
-								FMOD::Studio::EventDescription* eventDescription(eventDescriptions[i]);
-								int pathSize(0);
-								result = eventDescription->getPath(nullptr, 0, &pathSize);
-								DASSERT_E(result == FMOD_OK);
-								char* path(static_cast<char*>(malloc(pathSize * sizeof(char))));
-								result = eventDescription->getPath(path, pathSize, nullptr);
-								DASSERT_E(result == FMOD_OK);
-								if (std::strcmp(path, eventPath.c_str()) == 0)
+								if (std::strcmp(physicsLayerName.c_str(), TypeNames::physicsLayerNames[i + 1]) == 0)
 								{
-									eventInstance.Internal_SetBank(bank);
-									free(eventDescriptions);
-									free(path);
-									return true;
+									physicsLayers = static_cast<physicsLayerType>(static_cast<uint64_t>(physicsLayers) | static_cast<uint64_t>(1)<<i);
 								}
-								free(path);
 							}
-							free(eventDescriptions);
-							return false;
 						}
-					);
-					if (eventInstance.Internal_IsBankNull() && !eventInstance.GetPath().Empty())
+						new (&argsBuffer[argsBufferOffset]) physicsLayerType(physicsLayers);
+						argsBufferOffset += sizeof(physicsLayerType);
+						break;
+					}
+					case attributeType::SoundEventInstance:
 					{
-						Log::Get().TerminalLog("Sound Event Instance attribute refer to a non-existing sound bank path: %s", eventInstance.GetPath().Data());
-						Log::Get().ConsoleLog(LogLevel::Warning, "Sound Event Instance attribute refer to a non-existing sound bank path: %s", eventInstance.GetPath().Data());
+						DCore::SoundEventInstance eventInstance(LoadSoundEventInstance(attributeMap[attributeName.GetName()].as<stringType>()));
+						new (&argsBuffer[argsBufferOffset]) DCore::SoundEventInstance(std::move(eventInstance));
+						argsBufferOffset += sizeof(DCore::SoundEventInstance);
+						break;
+					}
+					default:
+						DASSERT_E(false);
+						continue;	
 					}
-					new (&argsBuffer[argsBufferOffset]) DCore::SoundEventInstance(std::move(eventInstance));
-					argsBufferOffset += sizeof(DCore::SoundEventInstance);
-					break;
-				}
-				default:
-					DASSERT_E(false);
-					continue;	
 				}
 			}
 		}
-		argsBufferOffset = 0;
-		entityRefType entityRef(entities[entityIndex++]);
-		entityRef.AddComponents
+		archetypeEntities.resize(archetypeEntityIndexes.size());
+		sceneRef.CreateEntities
 		(
-			componentIds, componentSizes, numberOfComponents - 1,
-			[&](DCore::ComponentIdType componentId, void* componentAddress) -> void
+			archetypeComponentIds.data(), componentSizes, numberOfComponents, archetypeEntityIndexes.size(), archetypeEntities.data(),
+			[&](size_t archetypeEntityIndex, DCore::ComponentIdType componentId, void* componentAddress) -> void
 			{
-				const DCore::ComponentForm& componentForm(DCore::ComponentForms::Get()[componentId]);
-				componentForm.PlacementNewConstructor(componentAddress, &argsBuffer[argsBufferOffset]);
-				argsBufferOffset += componentForm.SerializedSize;
-			}
-		);
-		delete[] argsBuffer;
-		delete[] componentIds;
-		delete[] componentSizes;
-		DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *sceneRef.GetLockData());
-		entityRef.IterateOnComponents
-		(
-			[&](DCore::ComponentIdType componentId, void* componentAddress) -> bool
-			{
-				const DCore::ComponentForm& componentForm(DCore::ComponentForms::Get()[componentId]);
-				if (componentForm.IsScriptComponent)
-				{
-					DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, *sceneRef.GetLockData());
-					DCore::ScriptComponent* scriptComponent(static_cast<DCore::ScriptComponent*>(componentAddress));
-					scriptComponent->Setup(entityRef, componentId);
-				}
-				return false;
+				const size_t componentIndex(std::lower_bound(archetypeComponentIds.begin(), archetypeComponentIds.end(), componentId) - archetypeComponentIds.begin());
+				const char* componentArgs(archetypeArgsBuffer + archetypeEntityIndex * entityArgumentsSize + componentArgumentsOffsets[componentIndex]);
+				DCore::ComponentForms::Get()[componentId].PlacementNewConstructor(componentAddress, componentArgs);
 			}
 		);
+		for (size_t archetypeEntityIndex(0); archetypeEntityIndex < archetypeEntityIndexes.size(); archetypeEntityIndex++)
+		{
+			entities[archetypeEntityIndexes[archetypeEntityIndex]] = archetypeEntities[archetypeEntityIndex];
+		}
 	}
-	delete[] entities;
+	SetupDeserializedEntities(sceneRef, entities.data(), entities.size(), entityReferenceFixups);
 	return returnErrorType();
 }
 
@@ -719,4 +647,651 @@ SceneSerialization::returnErrorType SceneSerialization::SerializeScene(const pat
 	return returnError;
 }
 
+SceneSerialization::returnErrorType SceneSerialization::CookScene(const pathType& cookedScenePath, sceneRefType sceneRef)
+{
+	using componentIdContainerType = std::vector<DCore::ComponentIdType>;
+	using entityContainerType = std::vector<DCore::Entity>;
+	using cookedSceneHeaderType = DCore::CookedScene::Header;
+	using cookedComponentFormType = DCore::CookedScene::ComponentFormEntry;
+	using cookedArchetypeType = DCore::CookedScene::ArchetypeEntry;
+	using cookedDependencyType = DCore::CookedScene::DependencyEntry;
+	using dependencyType = DCore::CookedScene::DependencyType;
+	using stateConstRefType = DCore::AnimationStateMachine::stateConstRefType;
+	// Group the entities by their components, sorted so the same components in another order are the same archetype.
+	std::map<componentIdContainerType, entityContainerType> archetypes;
+	sceneRef.IterateOnEntities
+	(
+		[&](DCore::Entity entity) -> bool
+		{
+			DCore::EntityRef entityRef(entity, sceneRef);
+			componentIdContainerType componentIds(entityRef.GetNumberOfComponents());
+			entityRef.GetComponentIds(componentIds.data());
+			std::sort(componentIds.begin(), componentIds.end());
+			archetypes[componentIds].push_back(entity);
+			return false;
+		}
+	);
+	std::unordered_map<size_t, uint32_t> cookedEntityIndexes;
+	uint32_t numberOfEntities(0);
+	for (const auto& archetype : archetypes)
+	{
+		for (DCore::Entity entity : archetype.second)
+		{
+			cookedEntityIndexes.insert({entity.GetIndex(), numberOfEntities++});
+		}
+	}
+	std::string stringTable;
+	std::unordered_map<std::string, uint32_t> stringOffsets;
+	const auto addString
+	(
+		[&](const std::string& string) -> uint32_t
+		{
+			auto it(stringOffsets.find(string));
+			if (it != stringOffsets.end())
+			{
+				return it->second;
+			}
+			const uint32_t offset(static_cast<uint32_t>(stringTable.size()));
+			stringTable.append(string);
+			stringTable.push_back('\0');
+			stringOffsets.insert({string, offset});
+			return offset;
+		}
+	);
+	std::vector<cookedComponentFormType> cookedComponentForms;
+	std::unordered_map<DCore::ComponentIdType, uint32_t> cookedComponentFormIndexes;
+	std::vector<cookedArchetypeType> cookedArchetypes;
+	std::vector<uint32_t> archetypeComponents;
+	std::vector<char> arguments;
+	// Ordered as the dependency table is sorted.
+	std::set<std::tuple<dependencyType, uint64_t, uint64_t>> dependencies;
+	const auto addDependency
+	(
+		[&](dependencyType type, const DCore::UUIDType& uuid) -> void
+		{
+			dependencies.insert({type, uuid.GetHigh(), uuid.GetLow()});
+		}
+	);
+	returnErrorType returnError;
+	for (const auto& archetype : archetypes)
+	{
+		cookedArchetypeType cookedArchetype;
+		cookedArchetype.FirstComponent = static_cast<uint32_t>(archetypeComponents.size());
+		cookedArchetype.NumberOfComponents = static_cast<uint32_t>(archetype.first.size());
+		cookedArchetype.FirstEntity = cookedEntityIndexes[archetype.second.front().GetIndex()];
+		cookedArchetype.NumberOfEntities = static_cast<uint32_t>(archetype.second.size());
+		cookedArchetype.ArgumentsOffset = arguments.size();
+		cookedArchetype.EntityArgumentsSize = 0;
+		for (DCore::ComponentIdType componentId : archetype.first)
+		{
+			const DCore::ComponentForm& componentForm(DCore::ComponentForms::Get()[componentId]);
+			auto it(cookedComponentFormIndexes.find(componentId));
+			if (it == cookedComponentFormIndexes.end())
+			{
+				it = cookedComponentFormIndexes.insert({componentId, static_cast<uint32_t>(cookedComponentForms.size())}).first;
+				cookedComponentForms.push_back({addString(componentForm.Name), static_cast<uint32_t>(componentForm.SerializedAttributes.size()), componentForm.SerializedSize});
+			}
+			archetypeComponents.push_back(it->second);
+			cookedArchetype.EntityArgumentsSize += componentForm.SerializedSize;
+		}
+		for (DCore::Entity entity : archetype.second)
+		{
+			DCore::EntityRef entityRef(entity, sceneRef);
+			for (DCore::ComponentIdType componentId : archetype.first)
+			{
+				const DCore::ComponentForm& componentForm(DCore::ComponentForms::Get()[componentId]);
+				DCore::ComponentRef<DCore::Component> component(entityRef.GetComponent(componentId));
+				const size_t componentArgumentsOffset(arguments.size());
+				arguments.resize(componentArgumentsOffset + componentForm.SerializedSize, 0);
+				size_t argumentOffset(componentArgumentsOffset);
+				for (const DCore::SerializedAttribute& attribute : componentForm.SerializedAttributes)
+				{
+					const DCore::AttributeType attributeType(attribute.GetAttributeType());
+					const DCore::AttributeIdType attributeId(attribute.GetAttributeId());
+					const size_t argumentSize(attribute.GetArgumentSizeBytes());
+					if (argumentSize == 0 || argumentOffset + argumentSize > componentArgumentsOffset + componentForm.SerializedSize)
+					{
+						returnError.Ok = false;
+						returnError.Message.Append("Fail to cook component ").Append(componentForm.Name.c_str()).Append(" of scene: ").Append(cookedScenePath.string().c_str()).Append(".");
+						return returnError;
+					}
+					uint32_t index(DCore::CookedScene::nullIndex);
+					switch (attributeType)
+					{
+					case DCore::AttributeType::UUID:
+					{
+						DCore::UUIDType uuid;
+						component.GetAttributePtr(attributeId, &uuid, sizeof(DCore::UUIDType));
+						index = addString((std::string)uuid);
+						break;
+					}
+					case DCore::AttributeType::EntityReference:
+					{
+						DCore::EntityRef referencedEntity;
+						component.GetAttributePtr(attributeId, &referencedEntity, sizeof(DCore::EntityRef));
+						if (referencedEntity.IsValid() && referencedEntity.GetSceneRef() == sceneRef)
+						{
+							auto it(cookedEntityIndexes.find(referencedEntity.GetEntity().GetIndex()));
+							if (it != cookedEntityIndexes.end())
+							{
+								index = it->second;
+							}
+						}
+						break;
+					}
+					case DCore::AttributeType::SpriteMaterial:
+					{
+						DCore::SpriteMaterialRef spriteMaterialRef;
+						component.GetAttributePtr(attributeId, &spriteMaterialRef, sizeof(DCore::SpriteMaterialRef));
+						DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::SpriteMaterialAssetManager*>(&DCore::AssetManager::Get()));
+						index = addString(spriteMaterialRef.IsValid() ? (std::string)spriteMaterialRef.GetUUID() : "");
+						if (spriteMaterialRef.IsValid())
+						{
+							addDependency(dependencyType::SpriteMaterial, spriteMaterialRef.GetUUID());
+							DCore::ReadWriteLockGuard texturesGuard(DCore::LockType::ReadLock, *static_cast<DCore::Texture2DAssetManager*>(&DCore::AssetManager::Get()));
+							for (DCore::Texture2DRef map : {spriteMaterialRef.GetAmbientMapRef(), spriteMaterialRef.GetDiffuseMapRef(), spriteMaterialRef.GetSpecularMapRef()})
+							{
+								if (map.IsValid())
+								{
+									addDependency(dependencyType::Texture2D, map.GetUUID());
+								}
+							}
+						}
+						break;
+					}
+					case DCore::AttributeType::AnimationStateMachine:
+					{
+						DCore::AnimationStateMachineRef animationStateMachine;
+						component.GetAttributePtr(attributeId, &animationStateMachine, sizeof(DCore::AnimationStateMachineRef));
+						DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationStateMachineAssetManager*>(&DCore::AssetManager::Get()));
+						index = addString(animationStateMachine.IsValid() ? (std::string)animationStateMachine.GetUUID() : "");
+						if (animationStateMachine.IsValid())
+						{
+							addDependency(dependencyType::AnimationStateMachine, animationStateMachine.GetUUID());
+							DCore::ReadWriteLockGuard animationsGuard(DCore::LockType::ReadLock, *static_cast<DCore::AnimationAssetManager*>(&DCore::AssetManager::Get()));
+							animationStateMachine.GetInternalRef()->GetAsset().IterateOnStates
+							(
+								[&](stateConstRefType state) -> bool
+								{
+									if (state->GetAnimation().IsValid())
+									{
+										addDependency(dependencyType::Animation, state->GetAnimation().GetUUID());
+									}
+									return false;
+								}
+							);
+						}
+						break;
+					}
+					case DCore::AttributeType::PhysicsMaterial:
+					{
+						DCore::PhysicsMaterialRef physicsMaterial;
+						component.GetAttributePtr(attributeId, &physicsMaterial, sizeof(DCore::PhysicsMaterialRef));
+						DCore::ReadWriteLockGuard guard(DCore::LockType::ReadLock, *static_cast<DCore::PhysicsMaterialAssetManager*>(&DCore::AssetManager::Get()));
+						index = addString(physicsMaterial.IsValid() ? (std::string)physicsMaterial.GetUUID() : "");
+						if (physicsMaterial.IsValid())
+						{
+							addDependency(dependencyType::PhysicsMaterial, physicsMaterial.GetUUID());
+						}
+						break;
+					}
+					case DCore::AttributeType::SoundEventInstance:
+					{
+						DCore::SoundEventInstance soundEventInstance;
+						component.GetAttributePtr(attributeId, &soundEventInstance, sizeof(DCore::SoundEventInstance));
+						index = addString(soundEventInstance.GetPath().Data());
+						break;
+					}
+					default:
+						component.GetAttributePtr(attributeId, &arguments[argumentOffset], argumentSize);
+						argumentOffset += argumentSize;
+						continue;
+					}
+					std::memcpy(&arguments[argumentOffset], &index, sizeof(uint32_t));
+					argumentOffset += argumentSize;
+				}
+			}
+		}
+		cookedArchetypes.push_back(cookedArchetype);
+	}
+	DCore::DString sceneName;
+	sceneRef.GetName(sceneName);
+	cookedSceneHeaderType header;
+	std::memset(&header, 0, sizeof(cookedSceneHeaderType));
+	header.Magic = DCore::CookedScene::magic;
+	header.Version = DCore::CookedScene::version;
+	header.SceneNameOffset = addString(sceneName.Data());
+	header.NumberOfEntities = numberOfEntities;
+	header.NumberOfComponentForms = static_cast<uint32_t>(cookedComponentForms.size());
+	header.NumberOfArchetypes = static_cast<uint32_t>(cookedArchetypes.size());
+	const auto align
+	(
+		[](uint64_t offset) -> uint64_t
+		{
+			constexpr uint64_t alignment(alignof(std::max_align_t));
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	);
+	header.ComponentFormsOffset = align(sizeof(cookedSceneHeaderType));
+	header.ArchetypesOffset = align(header.ComponentFormsOffset + cookedComponentForms.size() * sizeof(cookedComponentFormType));
+	header.ArchetypeComponentsOffset = align(header.ArchetypesOffset + cookedArchetypes.size() * sizeof(cookedArchetypeType));
+	header.ArgumentsOffset = align(header.ArchetypeComponentsOffset + archetypeComponents.size() * sizeof(uint32_t));
+	header.StringTableOffset = align(header.ArgumentsOffset + arguments.size());
+	header.StringTableSize = stringTable.size();
+	std::vector<cookedDependencyType> cookedDependencies;
+	cookedDependencies.reserve(dependencies.size());
+	for (const auto& dependency : dependencies)
+	{
+		cookedDependencies.push_back({std::get<1>(dependency), std::get<2>(dependency), std::get<0>(dependency), 0});
+	}
+	header.DependenciesOffset = align(header.StringTableOffset + stringTable.size());
+	header.NumberOfDependencies = cookedDependencies.size();
+	std::ofstream fileOutStream(cookedScenePath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+	if (!fileOutStream)
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Failure in opening the cooked scene file in path: ").Append(cookedScenePath.string().c_str()).Append(".");
+		return returnError;
+	}
+	const auto write
+	(
+		[&](uint64_t offset, const void* data, size_t size) -> void
+		{
+			const uint64_t padding(offset - static_cast<uint64_t>(fileOutStream.tellp()));
+			for (uint64_t i(0); i < padding; i++)
+			{
+				fileOutStream.put('\0');
+			}
+			fileOutStream.write(static_cast<const char*>(data), size);
+		}
+	);
+	write(0, &header, sizeof(cookedSceneHeaderType));
+	write(header.ComponentFormsOffset, cookedComponentForms.data(), cookedComponentForms.size() * sizeof(cookedComponentFormType));
+	write(header.ArchetypesOffset, cookedArchetypes.data(), cookedArchetypes.size() * sizeof(cookedArchetypeType));
+	write(header.ArchetypeComponentsOffset, archetypeComponents.data(), archetypeComponents.size() * sizeof(uint32_t));
+	write(header.ArgumentsOffset, arguments.data(), arguments.size());
+	write(header.StringTableOffset, stringTable.data(), stringTable.size());
+	write(header.DependenciesOffset, cookedDependencies.data(), cookedDependencies.size() * sizeof(cookedDependencyType));
+	fileOutStream.close();
+	if (!fileOutStream)
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Fail to write the cooked scene file in path: ").Append(cookedScenePath.string().c_str()).Append(".");
+	}
+	return returnError;
+}
+
+SceneSerialization::returnErrorType SceneSerialization::DeserializeCookedScene(const pathType& cookedScenePath, sceneRefType sceneRef)
+{
+	DCore::MappedFile file;
+	if (!file.Open(cookedScenePath))
+	{
+		returnErrorType returnError;
+		returnError.Ok = false;
+		returnError.Message.Append("Bad cooked scene file (can't be mapped): ").Append(cookedScenePath.string().c_str()).Append(".");
+		return returnError;
+	}
+	return DeserializeCookedScene(file.GetData(), file.GetSize(), cookedScenePath.string().c_str(), sceneRef);
+}
+
+SceneSerialization::returnErrorType SceneSerialization::DeserializeCookedScene(const char* data, size_t fileSize, const char* sourceName, sceneRefType sceneRef)
+{
+	using cookedSceneHeaderType = DCore::CookedScene::Header;
+	using cookedComponentFormType = DCore::CookedScene::ComponentFormEntry;
+	using cookedArchetypeType = DCore::CookedScene::ArchetypeEntry;
+	const auto badCookedScene
+	(
+		[&](const char* reason) -> returnErrorType
+		{
+			returnErrorType returnError;
+			returnError.Ok = false;
+			returnError.Message.Append("Bad cooked scene file (").Append(reason).Append("): ").Append(sourceName).Append(".");
+			return returnError;
+		}
+	);
+	const auto isInFile
+	(
+		[&](uint64_t offset, uint64_t size) -> bool
+		{
+			return offset <= fileSize && size <= fileSize - offset;
+		}
+	);
+	if (fileSize < sizeof(cookedSceneHeaderType))
+	{
+		return badCookedScene("truncated");
+	}
+	const cookedSceneHeaderType& header(*reinterpret_cast<const cookedSceneHeaderType*>(data));
+	if (header.Magic != DCore::CookedScene::magic || header.Version != DCore::CookedScene::version)
+	{
+		return badCookedScene("unknown format");
+	}
+	if (!isInFile(header.ComponentFormsOffset, static_cast<uint64_t>(header.NumberOfComponentForms) * sizeof(cookedComponentFormType)) ||
+		!isInFile(header.ArchetypesOffset, static_cast<uint64_t>(header.NumberOfArchetypes) * sizeof(cookedArchetypeType)) ||
+		!isInFile(header.StringTableOffset, header.StringTableSize) ||
+		header.StringTableSize == 0 || data[header.StringTableOffset + header.StringTableSize - 1] != '\0')
+	{
+		return badCookedScene("truncated");
+	}
+	const char* stringTable(data + header.StringTableOffset);
+	const auto getString
+	(
+		[&](uint32_t offset) -> const char*
+		{
+			return offset < header.StringTableSize ? stringTable + offset : nullptr;
+		}
+	);
+	// Everything is validated before the first entity is created, so a stale or broken file leaves the scene
+	// empty and the caller can load the YAML source instead.
+	const cookedComponentFormType* cookedComponentForms(reinterpret_cast<const cookedComponentFormType*>(data + header.ComponentFormsOffset));
+	std::vector<const DCore::ComponentForm*> componentForms(header.NumberOfComponentForms);
+	for (size_t i(0); i < componentForms.size(); i++)
+	{
+		const char* componentName(getString(cookedComponentForms[i].NameOffset));
+		componentForms[i] = componentName == nullptr ? nullptr : DCore::ComponentForms::Get().GetComponentFormWithName(componentName);
+		if (componentForms[i] == nullptr ||
+			componentForms[i]->SerializedSize != cookedComponentForms[i].SerializedSize ||
+			componentForms[i]->SerializedAttributes.size() != cookedComponentForms[i].NumberOfAttributes)
+		{
+			return badCookedScene("components changed since it was cooked");
+		}
+	}
+	const cookedArchetypeType* cookedArchetypes(reinterpret_cast<const cookedArchetypeType*>(data + header.ArchetypesOffset));
+	const uint32_t* archetypeComponents(reinterpret_cast<const uint32_t*>(data + header.ArchetypeComponentsOffset));
+	uint64_t numberOfArchetypeComponents(0);
+	for (size_t archetypeIndex(0); archetypeIndex < header.NumberOfArchetypes; archetypeIndex++)
+	{
+		const cookedArchetypeType& cookedArchetype(cookedArchetypes[archetypeIndex]);
+		numberOfArchetypeComponents = std::max(numberOfArchetypeComponents, static_cast<uint64_t>(cookedArchetype.FirstComponent) + cookedArchetype.NumberOfComponents);
+		if (static_cast<uint64_t>(cookedArchetype.FirstEntity) + cookedArchetype.NumberOfEntities > header.NumberOfEntities ||
+			!isInFile(header.ArgumentsOffset + cookedArchetype.ArgumentsOffset, cookedArchetype.EntityArgumentsSize * cookedArchetype.NumberOfEntities))
+		{
+			return badCookedScene("truncated");
+		}
+	}
+	if (!isInFile(header.ArchetypeComponentsOffset, numberOfArchetypeComponents * sizeof(uint32_t)))
+	{
+		return badCookedScene("truncated");
+	}
+	for (uint64_t i(0); i < numberOfArchetypeComponents; i++)
+	{
+		if (archetypeComponents[i] >= header.NumberOfComponentForms)
+		{
+			return badCookedScene("unknown component");
+		}
+	}
+	for (size_t archetypeIndex(0); archetypeIndex < header.NumberOfArchetypes; archetypeIndex++)
+	{
+		const cookedArchetypeType& cookedArchetype(cookedArchetypes[archetypeIndex]);
+		uint64_t entityArgumentsSize(0);
+		for (size_t i(0); i < cookedArchetype.NumberOfComponents; i++)
+		{
+			entityArgumentsSize += componentForms[archetypeComponents[cookedArchetype.FirstComponent + i]]->SerializedSize;
+		}
+		if (entityArgumentsSize != cookedArchetype.EntityArgumentsSize)
+		{
+			return badCookedScene("components changed since it was cooked");
+		}
+	}
+	const char* sceneName(getString(header.SceneNameOffset));
+	sceneRef.SetName(sceneName == nullptr ? "" : sceneName);
+	// Entity references are set after all the entities exist, since they can refer to entities of archetypes
+	// created later.
+	entityReferenceFixupContainerType entityReferenceFixups;
+	std::vector<DCore::Entity> entities(header.NumberOfEntities);
+	std::vector<DCore::ComponentIdType> componentIds;
+	std::vector<size_t> componentSizes;
+	std::vector<size_t> componentArgumentsOffsets;
+	std::vector<char> archetypeArguments;
+	for (size_t archetypeIndex(0); archetypeIndex < header.NumberOfArchetypes; archetypeIndex++)
+	{
+		const cookedArchetypeType& cookedArchetype(cookedArchetypes[archetypeIndex]);
+		if (cookedArchetype.NumberOfEntities == 0)
+		{
+			continue;
+		}
+		componentIds.clear();
+		componentSizes.clear();
+		componentArgumentsOffsets.clear();
+		size_t componentArgumentsOffset(0);
+		for (size_t i(0); i < cookedArchetype.NumberOfComponents; i++)
+		{
+			const DCore::ComponentForm& componentForm(*componentForms[archetypeComponents[cookedArchetype.FirstComponent + i]]);
+			componentIds.push_back(componentForm.Id);
+			componentSizes.push_back(componentForm.TotalSize);
+			componentArgumentsOffsets.push_back(componentArgumentsOffset);
+			componentArgumentsOffset += componentForm.SerializedSize;
+		}
+		// The arguments that can be copied are copied for all the entities at once. The others are constructed over
+		// their cooked indexes.
+		const size_t argumentsSize(cookedArchetype.EntityArgumentsSize * cookedArchetype.NumberOfEntities);
+		archetypeArguments.resize(argumentsSize);
+		std::memcpy(archetypeArguments.data(), data + header.ArgumentsOffset + cookedArchetype.ArgumentsOffset, argumentsSize);
+		for (size_t entityIndex(0); entityIndex < cookedArchetype.NumberOfEntities; entityIndex++)
+		{
+			char* entityArguments(archetypeArguments.data() + entityIndex * cookedArchetype.EntityArgumentsSize);
+			for (size_t i(0); i < componentIds.size(); i++)
+			{
+				const DCore::ComponentForm& componentForm(DCore::ComponentForms::Get()[componentIds[i]]);
+				size_t argumentOffset(componentArgumentsOffsets[i]);
+				for (const DCore::SerializedAttribute& attribute : componentForm.SerializedAttributes)
+				{
+					const DCore::AttributeType attributeType(attribute.GetAttributeType());
+					char* argument(entityArguments + argumentOffset);
+					argumentOffset += attribute.GetArgumentSizeBytes();
+					if (!IsCookedAsIndex(attributeType))
+					{
+						continue;
+					}
+					uint32_t index;
+					std::memcpy(&index, argument, sizeof(uint32_t));
+					const char* string(getString(index));
+					switch (attributeType)
+					{
+					case DCore::AttributeType::UUID:
+						new (argument) uuidType(stringType(string == nullptr ? "" : string));
+						break;
+					case DCore::AttributeType::EntityReference:
+						new (argument) DCore::EntityRef();
+						if (index < header.NumberOfEntities)
+						{
+							entityReferenceFixups.push_back({cookedArchetype.FirstEntity + entityIndex, componentForm.Id, attribute.GetAttributeId(), index});
+						}
+						break;
+					case DCore::AttributeType::SpriteMaterial:
+						new (argument) DCore::SpriteMaterialRef(LoadSpriteMaterial(string == nullptr ? "" : string));
+						break;
+					case DCore::AttributeType::AnimationStateMachine:
+						new (argument) DCore::AnimationStateMachineRef(LoadAnimationStateMachine(string == nullptr ? "" : string));
+						break;
+					case DCore::AttributeType::PhysicsMaterial:
+						new (argument) DCore::PhysicsMaterialRef(LoadPhysicsMaterial(string == nullptr ? "" : string));
+						break;
+					case DCore::AttributeType::SoundEventInstance:
+						new (argument) DCore::SoundEventInstance(LoadSoundEventInstance(string == nullptr ? "" : string));
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+		sceneRef.CreateEntities
+		(
+			componentIds.data(), componentSizes.data(), componentIds.size(), cookedArchetype.NumberOfEntities, &entities[cookedArchetype.FirstEntity],
+			[&](size_t entityIndex, DCore::ComponentIdType componentId, void* componentAddress) -> void
+			{
+				const size_t componentIndex(std::find(componentIds.begin(), componentIds.end(), componentId) - componentIds.begin());
+				const char* componentArguments(archetypeArguments.data() + entityIndex * cookedArchetype.EntityArgumentsSize + componentArgumentsOffsets[componentIndex]);
+				DCore::ComponentForms::Get()[componentId].PlacementNewConstructor(componentAddress, componentArguments);
+			}
+		);
+	}
+	SetupDeserializedEntities(sceneRef, entities.data(), entities.size(), entityReferenceFixups);
+	return returnErrorType();
+}
+
+SceneSerialization::returnErrorType SceneSerialization::ReadCookedSceneDependencies(const char* data, size_t fileSize, const char* sourceName, cookedDependencyContainerType& outDependencies) const
+{
+	using cookedSceneHeaderType = DCore::CookedScene::Header;
+	using cookedDependencyType = DCore::CookedScene::DependencyEntry;
+	returnErrorType returnError;
+	if (fileSize < sizeof(cookedSceneHeaderType))
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Bad cooked scene file (truncated): ").Append(sourceName).Append(".");
+		return returnError;
+	}
+	const cookedSceneHeaderType& header(*reinterpret_cast<const cookedSceneHeaderType*>(data));
+	if (header.Magic != DCore::CookedScene::magic || header.Version != DCore::CookedScene::version)
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Bad cooked scene file (unknown format): ").Append(sourceName).Append(".");
+		return returnError;
+	}
+	if (header.DependenciesOffset % alignof(cookedDependencyType) != 0)
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Bad cooked scene file (misaligned dependencies): ").Append(sourceName).Append(".");
+		return returnError;
+	}
+	if (header.DependenciesOffset > fileSize || header.NumberOfDependencies > (fileSize - header.DependenciesOffset) / sizeof(cookedDependencyType))
+	{
+		returnError.Ok = false;
+		returnError.Message.Append("Bad cooked scene file (truncated): ").Append(sourceName).Append(".");
+		return returnError;
+	}
+	const cookedDependencyType* dependencies(reinterpret_cast<const cookedDependencyType*>(data + header.DependenciesOffset));
+	outDependencies.assign(dependencies, dependencies + header.NumberOfDependencies);
+	return returnError;
+}
+
+void SceneSerialization::SetupDeserializedEntities(sceneRefType sceneRef, const DCore::Entity* entities, size_t numberOfEntities, const entityReferenceFixupContainerType& entityReferenceFixups) const
+{
+	DCore::ReadWriteLockGuard guard(DCore::LockType::WriteLock, *sceneRef.GetLockData());
+	DCore::Registry& registry(sceneRef.GetInternalSceneRef()->GetAsset().GetRegistry());
+	for (const EntityReferenceFixup& fixup : entityReferenceFixups)
+	{
+		registry.GetComponents
+		(
+			entities[fixup.EntityIndex], &fixup.ComponentId, 1,
+			[&](DCore::ComponentIdType, void* componentAddress) -> void
+			{
+				void* attribute(static_cast<DCore::Component*>(componentAddress)->GetAttributePtr(fixup.AttributeId));
+				DASSERT_E(attribute != nullptr);
+				*static_cast<DCore::EntityRef*>(attribute) = DCore::EntityRef(entities[fixup.ReferencedEntityIndex], sceneRef);
+			}
+		);
+	}
+	for (size_t entityIndex(0); entityIndex < numberOfEntities; entityIndex++)
+	{
+		DCore::EntityRef entityRef(entities[entityIndex], sceneRef);
+		entityRef.IterateOnComponents
+		(
+			[&](DCore::ComponentIdType componentId, void* componentAddress) -> bool
+			{
+				if (DCore::ComponentForms::Get()[componentId].IsScriptComponent)
+				{
+					static_cast<DCore::ScriptComponent*>(componentAddress)->Setup(entityRef, componentId);
+				}
+				return false;
+			}
+		);
+	}
+}
+
+DCore::SpriteMaterialRef SceneSerialization::LoadSpriteMaterial(const stringType& uuidString) const
+{
+	DCore::SpriteMaterialRef spriteMaterialRef;
+	if (!uuidString.empty())
+	{
+		spriteMaterialRef = MaterialManager::Get().LoadSpriteMaterial(DCore::UUIDType(uuidString));
+	}
+	return spriteMaterialRef;
+}
+
+DCore::AnimationStateMachineRef SceneSerialization::LoadAnimationStateMachine(const stringType& uuidString) const
+{
+	DCore::AnimationStateMachineRef animationStateMachineRef;
+	if (uuidString.empty())
+	{
+		return animationStateMachineRef;
+	}
+	// Invalid if its file is missing, as the other assets.
+	animationStateMachineRef = AnimationStateMachineManager::Get().LoadCoreAnimationStateMachine(uuidType(uuidString));
+	return animationStateMachineRef;
+}
+
+DCore::PhysicsMaterialRef SceneSerialization::LoadPhysicsMaterial(const stringType& uuidString) const
+{
+	DCore::PhysicsMaterialRef physicsMaterial;
+	if (!uuidString.empty())
+	{
+		physicsMaterial = PhysicsMaterialManager::Get().LoadPhysicsMaterial(uuidType(uuidString));
+	}
+	return physicsMaterial;
+}
+
+DCore::SoundEventInstance SceneSerialization::LoadSoundEventInstance(const stringType& eventPath) const
+{
+	DCore::SoundEventInstance eventInstance(eventPath);
+	DCore::Sound::Get().IterateOnLoadedBanks
+	(
+		[&](DCore::Sound::bankType* bank) -> bool
+		{
+			int count(0);
+			FMOD_RESULT result(bank->getEventCount(&count));
+			DASSERT_E(result == FMOD_OK);
+			if (count == 0)
+			{
+				return false;
+			}
+			FMOD::Studio::EventDescription** eventDescriptions(static_cast<FMOD::Studio::EventDescription**>(malloc(count * sizeof(char*))));
+			result = bank->getEventList(eventDescriptions, count, nullptr);
+			DASSERT_E(result == FMOD_OK);
+			for (size_t i(0); i < count; i++)
+			{
+				FMOD::Studio::EventDescription* eventDescription(eventDescriptions[i]);
+				int pathSize(0);
+				result = eventDescription->getPath(nullptr, 0, &pathSize);
+				DASSERT_E(result == FMOD_OK);
+				char* path(static_cast<char*>(malloc(pathSize * sizeof(char))));
+				result = eventDescription->getPath(path, pathSize, nullptr);
+				DASSERT_E(result == FMOD_OK);
+				if (std::strcmp(path, eventPath.c_str()) == 0)
+				{
+					eventInstance.Internal_SetBank(bank);
+					free(eventDescriptions);
+					free(path);
+					return true;
+				}
+				free(path);
+			}
+			free(eventDescriptions);
+			return false;
+		}
+	);
+	if (eventInstance.Internal_IsBankNull() && !eventInstance.GetPath().Empty())
+	{
+		Log::Get().TerminalLog("Sound Event Instance attribute refer to a non-existing sound bank path: %s", eventInstance.GetPath().Data());
+		Log::Get().ConsoleLog(LogLevel::Warning, "Sound Event Instance attribute refer to a non-existing sound bank path: %s", eventInstance.GetPath().Data());
+	}
+	return eventInstance;
+}
+
+bool SceneSerialization::IsCookedAsIndex(DCore::AttributeType attributeType)
+{
+	switch (attributeType)
+	{
+	case DCore::AttributeType::UUID:
+	case DCore::AttributeType::EntityReference:
+	case DCore::AttributeType::SpriteMaterial:
+	case DCore::AttributeType::AnimationStateMachine:
+	case DCore::AttributeType::PhysicsMaterial:
+	case DCore::AttributeType::SoundEventInstance:
+		return true;
+	default:
+		return false;
+	}
+}
+
 }
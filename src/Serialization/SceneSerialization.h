@@ -3,6 +3,7 @@
 #include "DommusCore.h"
 
 #include <filesystem>
+#include <vector>
 
 
 
@@ -17,6 +18,7 @@ public:
 	using stringType = std::string;
 	using pathType = std::filesystem::path;
 	using sceneRefType = DCore::SceneRef;
+	using cookedDependencyContainerType = std::vector<DCore::CookedScene::DependencyEntry>;
 public:
 	~SceneSerialization() = default;
 public:
@@ -30,8 +32,42 @@ public:
 
 	// Requires SceneAssetManager lock.
 	returnErrorType SerializeScene(const pathType& scenePath, sceneRefType);
+
+	// Writes the scene in the binary format of CookedScene.h, which is loaded without parsing. The YAML
+	// file stays the source of the scene; the cooked one must be written again when it changes.
+	// Requires SceneAssetManager lock.
+	returnErrorType CookScene(const pathType& cookedScenePath, sceneRefType);
+
+	// Fails without creating any entity if the cooked file is broken or the components changed since it
+	// was cooked.
+	returnErrorType DeserializeCookedScene(const pathType& cookedScenePath, sceneRefType);
+	// Same as above, from a cooked scene in memory. sourceName is used in the error messages.
+	returnErrorType DeserializeCookedScene(const char* cookedScene, size_t cookedSceneSize, const char* sourceName, sceneRefType);
+
+	// Reads the assets a cooked scene depends on (see CookedScene::DependencyEntry), without loading the scene.
+	returnErrorType ReadCookedSceneDependencies(const char* cookedScene, size_t cookedSceneSize, const char* sourceName, cookedDependencyContainerType& outDependencies) const;
+private:
+	struct EntityReferenceFixup
+	{
+		size_t EntityIndex;
+		DCore::ComponentIdType ComponentId;
+		DCore::AttributeIdType AttributeId;
+		size_t ReferencedEntityIndex;
+	};
+private:
+	using entityReferenceFixupContainerType = std::vector<EntityReferenceFixup>;
 private:
 	SceneSerialization() = default;
+private:
+	// If the attribute is cooked as a string table offset or an entity index, instead of its bytes.
+	static bool IsCookedAsIndex(DCore::AttributeType);
+private:
+	DCore::SpriteMaterialRef LoadSpriteMaterial(const stringType& uuidString) const;
+	DCore::AnimationStateMachineRef LoadAnimationStateMachine(const stringType& uuidString) const;
+	DCore::PhysicsMaterialRef LoadPhysicsMaterial(const stringType& uuidString) const;
+	DCore::SoundEventInstance LoadSoundEventInstance(const stringType& eventPath) const;
+	// Sets the entity references of the entities, which are indexes of entities, and sets up their script components.
+	void SetupDeserializedEntities(sceneRefType, const DCore::Entity* entities, size_t numberOfEntities, const entityReferenceFixupContainerType&) const;
 };
 
 }